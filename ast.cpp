@@ -2,6 +2,10 @@
 #include "visitor.h"
 #include <iostream>
 #include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <iterator>
+#include <unordered_set>
 
 using namespace std;
 
@@ -28,53 +32,111 @@ string Exp::binopToChar(BinaryOp op) {
 
 // ------------------ BinaryExp ------------------
 BinaryExp::BinaryExp(Exp* l, Exp* r, BinaryOp o)
-    : left(l), right(r), op(o) {}
+    : Exp(EXP_BINARIA), left(l), right(r), op(o) {}
 
 BinaryExp::BinaryExp(Exp* l, BinaryOp o, Exp* r)
-    : left(l), right(r), op(o) {}
+    : Exp(EXP_BINARIA), left(l), right(r), op(o) {}
 
 BinaryExp::~BinaryExp() {
+    Exp::liberar(left);
+    Exp::liberar(right);
 }
 
 // ------------------ NumberExp ------------------
 NumberExp::NumberExp(long long v)
-    : ivalue(v), fvalue(0.0), isFloat(false) {
+    : Exp(EXP_NUMERO), ivalue(v), fvalue(0.0), isFloat(false) {
     tipoDato = T_INT;
 }
 
 NumberExp::NumberExp(double fv)
-    : ivalue(0), fvalue(fv), isFloat(true) {
+    : Exp(EXP_NUMERO), ivalue(0), fvalue(fv), isFloat(true) {
     tipoDato = T_FLOAT;
 }
 
 NumberExp::~NumberExp() {}
 
 // ------------------ IdExp ------------------
-IdExp::IdExp(string v) : value(v) {}
+IdExp::IdExp(string v) : Exp(EXP_ID), value(v) {}
 IdExp::~IdExp() {}
 
+IndexExp::IndexExp(string n, Exp* i) : Exp(EXP_INDICE), nombre(n), indice(i) {}
+IndexExp::~IndexExp() { Exp::liberar(indice); }
+
 // ------------------ CastExp ------------------
 CastExp::~CastExp() {
+    Exp::liberar(expr);
+}
+
+// ------------------ FcallExp ------------------
+FcallExp::~FcallExp() {
+    for (auto* a : argumentos) Exp::liberar(a);
+}
+
+bool entregaVariable(Exp* e, const string& id) {
+    if (!e) return false;
+    switch (e->clase) {
+        case EXP_BINARIA: {
+            auto b = static_cast<BinaryExp*>(e);
+            return entregaVariable(b->left, id) || entregaVariable(b->right, id);
+        }
+        case EXP_CAST:   return entregaVariable(static_cast<CastExp*>(e)->expr, id);
+        case EXP_INDICE: return entregaVariable(static_cast<IndexExp*>(e)->indice, id);
+        case EXP_LLAMADA: {
+            auto f = static_cast<FcallExp*>(e);
+            for (size_t i = 0; i < f->argumentos.size(); ++i) {
+                Exp* a = f->argumentos[i];
+                if (f->porReferencia(i) && a && a->clase == EXP_ID &&
+                    static_cast<IdExp*>(a)->value == id) return true;
+                if (entregaVariable(a, id)) return true;
+            }
+            return false;
+        }
+        default:
+            return false;
+    }
 }
 
 // ------------------ Stm y derivados ------------------
 Stm::~Stm() {}
 
-PrintStm::~PrintStm() {}
-AssignStm::~AssignStm() {}
+PrintStm::~PrintStm() { Exp::liberar(e); }
+AssignStm::~AssignStm() {
+    Exp::liberar(e);
+    Exp::liberar(indice);
+}
+
+IfStm::~IfStm() {
+    Exp::liberar(condition);
+    delete then;
+    delete els;
+}
+
+WhileStm::~WhileStm() {
+    Exp::liberar(condition);
+    delete b;
+}
+
+ForStm::~ForStm() {
+    Exp::liberar(inicio);
+    Exp::liberar(fin);
+    delete b;
+}
 
 IfStm::IfStm(Exp* c, Body* t, Body* e)
-    : condition(c), then(t), els(e) {}
+    : Stm(STM_IF), condition(c), then(t), els(e) {}
 
 WhileStm::WhileStm(Exp* c, Body* t)
-    : condition(c), b(t) {}
+    : Stm(STM_WHILE), condition(c), b(t) {}
+
+ForStm::ForStm(string i, Exp* a, Exp* z, bool abajo, Body* cuerpo)
+    : Stm(STM_FOR), id(i), inicio(a), fin(z), descendente(abajo), b(cuerpo) {}
 
-PrintStm::PrintStm(Exp* expresion) {
+PrintStm::PrintStm(Exp* expresion) : Stm(STM_PRINT) {
     e = expresion;
 }
 
 AssignStm::AssignStm(string variable, Exp* expresion)
-    : id(variable), e(expresion) {}
+    : Stm(STM_ASIGNACION), id(variable), e(expresion) {}
 
 // ------------------ VarDec y Body ------------------
 VarDec::VarDec() {}
@@ -86,6 +148,17 @@ Body::Body() {
 }
 
 Body::~Body() {
+    for (auto* s : StmList)      delete s;
+    for (auto* d : declarations) delete d;
+}
+
+// ------------------ FunDec ------------------
+FunDec::~FunDec() {
+    delete cuerpo;
+    delete codigo;
+    // En orden inverso de creación: cada padre antes que sus hijos
+    // compartidos (su destructor todavía los consulta)
+    for (auto it = compartidos.rbegin(); it != compartidos.rend(); ++it) delete *it;
 }
 
 // ------------------ Program ------------------
@@ -103,22 +176,111 @@ int TypeAlias::accept(Visitor* v) { return v->visit(this); }
 // ------------------ ExpStm ------------------
 int ExpStm::accept(Visitor* v) { return v->visit(this); }
 
+// ------------------ TablaExpresiones ------------------
+size_t TablaExpresiones::HashClave::operator()(const Clave& k) const {
+    size_t h = hash<long long>()(k.a) * 31 + (size_t)k.clase;
+    h ^= hash<const void*>()(k.l) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h ^= hash<const void*>()(k.r) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    return h;
+}
+
+Exp* TablaExpresiones::buscar(const Clave& k) {
+    auto it = nodos.find(k);
+    if (it == nodos.end()) return nullptr;
+    reutilizados++;
+    return it->second;
+}
+
+Exp* TablaExpresiones::guardar(const Clave& k, Exp* e) {
+    e->compartido = true;
+    nodos.emplace(k, e);
+    propios.push_back(e);
+    creados++;
+    return e;
+}
+
+Exp* TablaExpresiones::numero(long long v) {
+    if (!activa) return new NumberExp(v);
+    Clave k{0, v, nullptr, nullptr};
+    if (Exp* e = buscar(k)) return e;
+    return guardar(k, new NumberExp(v));
+}
+
+Exp* TablaExpresiones::numero(double v) {
+    if (!activa) return new NumberExp(v);
+    long long bits;
+    memcpy(&bits, &v, sizeof bits);
+    Clave k{1, bits, nullptr, nullptr};
+    if (Exp* e = buscar(k)) return e;
+    return guardar(k, new NumberExp(v));
+}
+
+Exp* TablaExpresiones::id(const string& nombre) {
+    if (!activa) return new IdExp(nombre);
+    auto it = ids.find(nombre);
+    if (it != ids.end()) {
+        reutilizados++;
+        return it->second;
+    }
+    Exp* e = new IdExp(nombre);
+    e->compartido = true;
+    ids.emplace(nombre, e);
+    propios.push_back(e);
+    creados++;
+    return e;
+}
+
+Exp* TablaExpresiones::binaria(Exp* l, Exp* r, BinaryOp op) {
+    if (!activa || !l->compartido || !r->compartido) return new BinaryExp(l, r, op);
+    Clave k{2, op, l, r};
+    if (Exp* e = buscar(k)) return e;
+    return guardar(k, new BinaryExp(l, r, op));
+}
+
+Exp* TablaExpresiones::cast(Exp* e, Tipo destino) {
+    if (!activa || !e->compartido) return new CastExp(e, destino);
+    Clave k{3, destino, e, nullptr};
+    if (Exp* c = buscar(k)) return c;
+    return guardar(k, new CastExp(e, destino));
+}
+
+void TablaExpresiones::iniciarAmbito() {
+    nodos.clear();
+    ids.clear();
+}
+
+void TablaExpresiones::entregar(FunDec* fd) {
+    nodos.clear();
+    ids.clear();
+    fd->compartidos.insert(fd->compartidos.end(), propios.begin(), propios.end());
+    propios.clear();
+}
+
+TablaExpresiones::~TablaExpresiones() {
+    // Nodos de una función que no llegó a entregarse (error de sintaxis)
+    for (auto it = propios.rbegin(); it != propios.rend(); ++it) delete *it;
+}
+
 // -----------------------------------------------------
 // OPTIMIZACIÓN 1: CONSTANT FOLDING (plegado de constantes)
 // -----------------------------------------------------
 static Exp* foldConstants(Exp* e) {
     if (!e) return nullptr;
 
-    auto bin = dynamic_cast<BinaryExp*>(e);
-    if (!bin) return e;
+    if (e->clase == EXP_INDICE) {
+        auto ix = static_cast<IndexExp*>(e);
+        ix->indice = foldConstants(ix->indice);
+        return e;
+    }
+    if (e->clase != EXP_BINARIA) return e;
+    auto bin = static_cast<BinaryExp*>(e);
 
     bin->left  = foldConstants(bin->left);
     bin->right = foldConstants(bin->right);
 
-    auto lnum = dynamic_cast<NumberExp*>(bin->left);
-    auto rnum = dynamic_cast<NumberExp*>(bin->right);
-
-    if (!lnum || !rnum) return e;
+    if (bin->left->clase != EXP_NUMERO || bin->right->clase != EXP_NUMERO) return e;
+    auto lnum = static_cast<NumberExp*>(bin->left);
+    auto rnum = static_cast<NumberExp*>(bin->right);
 
     double lv = lnum->isFloat ? lnum->fvalue : static_cast<double>(lnum->ivalue);
     double rv = rnum->isFloat ? rnum->fvalue : static_cast<double>(rnum->ivalue);
@@ -159,9 +321,9 @@ static Exp* foldConstants(Exp* e) {
     }
 
     NumberExp* ne = nullptr;
-    if (bin->tipoDato == T_FLOAT) {
+    if (bin->tipoDato == T_FLOAT || bin->tipoDato == T_DOUBLE) {
         ne = new NumberExp(result);
-        ne->tipoDato = T_FLOAT;
+        ne->tipoDato = bin->tipoDato;
         ne->isFloat  = true;
     } else {
         long long iv = static_cast<long long>(result);
@@ -170,6 +332,7 @@ static Exp* foldConstants(Exp* e) {
         ne->isFloat  = false;
     }
 
+    Exp::liberar(bin);   // libera también los dos literales
     return ne;
 }
 
@@ -180,14 +343,17 @@ static Stm* removeDeadCode(Stm* stm) {
     if (!stm) return nullptr;
 
     // -------- WHILE --------
-    if (auto wh = dynamic_cast<WhileStm*>(stm)) {
+    if (stm->clase == STM_WHILE) {
+        auto wh = static_cast<WhileStm*>(stm);
         wh->condition = foldConstants(wh->condition);
 
-        if (auto num = dynamic_cast<NumberExp*>(wh->condition)) {
+        if (wh->condition->clase == EXP_NUMERO) {
+            auto num = static_cast<NumberExp*>(wh->condition);
             double v = num->isFloat ? num->fvalue
                                     : static_cast<double>(num->ivalue);
             if (v == 0.0) {
                 // while(0) => eliminar completamente
+                delete wh;
                 return nullptr;
             }
         }
@@ -195,25 +361,30 @@ static Stm* removeDeadCode(Stm* stm) {
     }
 
     // -------- IF --------
-    if (auto ifs = dynamic_cast<IfStm*>(stm)) {
+    if (stm->clase == STM_IF) {
+        auto ifs = static_cast<IfStm*>(stm);
         ifs->condition = foldConstants(ifs->condition);
 
-        if (auto num = dynamic_cast<NumberExp*>(ifs->condition)) {
+        if (ifs->condition->clase == EXP_NUMERO) {
+            auto num = static_cast<NumberExp*>(ifs->condition);
             double v = num->isFloat ? num->fvalue
                                     : static_cast<double>(num->ivalue);
 
             if (v == 0.0) {
                 if (ifs->els) {
+                    delete ifs->then;
                     ifs->then = ifs->els;
                     ifs->els  = nullptr;
-                    ifs->condition = new NumberExp(1LL);
                 } else {
+                    delete ifs;
                     return nullptr;
                 }
             } else {
+                delete ifs->els;
                 ifs->els = nullptr;
-                ifs->condition = new NumberExp(1LL);
             }
+            Exp::liberar(ifs->condition);
+            ifs->condition = new NumberExp(1LL);
         }
         return ifs;
     }
@@ -222,41 +393,583 @@ static Stm* removeDeadCode(Stm* stm) {
 }
 
 // -----------------------------------------------------
-// FUNCIÓN PRINCIPAL DE OPTIMIZACIÓN GLOBAL
+// OPTIMIZACIÓN 3: DESENROLLADO DE BUCLES
 // -----------------------------------------------------
-void optimizeAST(Program* prog) {
-    if (!prog) return;
+// Bucles con variable de inducción reconocible (ya con tipos):
+//   while v < E do begin ...; v := v + c; ... end      (también <=, >, >=,
+//                                                      <> y 'v - E')
+//   for v := K1 to K2 do ...                            (límites literales)
+// donde v es integer, c un literal, E no cambia dentro del cuerpo y v solo
+// cambia en su incremento.
+//   - Desenrollado completo: si el número de vueltas se conoce (for con
+//     límites literales, o while precedido de 'v := K' con E literal) y es
+//     pequeño, el bucle se reemplaza por copias del cuerpo. En un for, v se
+//     sustituye por su valor en cada copia.
+//   - Desenrollado parcial de un while por 'factor': antes del while
+//     original va otro cuya condición asegura 'factor' vueltas seguidas
+//     (calculada en long, sin desbordes) y cuyo cuerpo son 'factor' copias;
+//     el while original hace el resto.
+// Solo cuerpos sin declaraciones (las copias se juntan en una lista). Si v o
+// una variable de E es global, el cuerpo no puede llamar funciones. El
+// tamaño del resultado (nodos) está acotado por LIMITE_DESENROLLADO.
+
+static const int LIMITE_DESENROLLADO = 256;   // nodos del cuerpo desenrollado
+static const int VUELTAS_COMPLETO    = 16;    // máximo de copias sin bucle
+
+static int tamano(Exp* e);
+static int tamano(Body* b);
+
+static int tamano(Exp* e) {
+    if (!e) return 0;
+    switch (e->clase) {
+        case EXP_BINARIA: {
+            auto b = static_cast<BinaryExp*>(e);
+            return 1 + tamano(b->left) + tamano(b->right);
+        }
+        case EXP_CAST:   return 1 + tamano(static_cast<CastExp*>(e)->expr);
+        case EXP_INDICE: return 1 + tamano(static_cast<IndexExp*>(e)->indice);
+        case EXP_LLAMADA: {
+            int t = 1;
+            for (auto a : static_cast<FcallExp*>(e)->argumentos) t += tamano(a);
+            return t;
+        }
+        default:         return 1;
+    }
+}
 
-    // Recorre cada función del programa
-    for (auto& f : prog->fdlist) {
-        if (!f->cuerpo) continue;
+static int tamano(Stm* s) {
+    if (!s) return 0;
+    switch (s->clase) {
+        case STM_ASIGNACION: {
+            auto a = static_cast<AssignStm*>(s);
+            return 1 + tamano(a->e) + tamano(a->indice);
+        }
+        case STM_PRINT:  return 1 + tamano(static_cast<PrintStm*>(s)->e);
+        case STM_RETURN: return 1 + tamano(static_cast<ReturnStm*>(s)->e);
+        case STM_EXP:    return 1 + tamano(static_cast<ExpStm*>(s)->e);
+        case STM_IF: {
+            auto i = static_cast<IfStm*>(s);
+            return 1 + tamano(i->condition) + tamano(i->then) + tamano(i->els);
+        }
+        case STM_WHILE: {
+            auto w = static_cast<WhileStm*>(s);
+            return 1 + tamano(w->condition) + tamano(w->b);
+        }
+        case STM_FOR: {
+            auto f = static_cast<ForStm*>(s);
+            return 1 + tamano(f->inicio) + tamano(f->fin) + tamano(f->b);
+        }
+    }
+    return 1;
+}
+
+static int tamano(Body* b) {
+    if (!b) return 0;
+    int t = 0;
+    for (auto s : b->StmList) t += tamano(s);
+    return t;
+}
+
+// ¿e lee la variable 'id' o llama a una función?
+static bool usa(Exp* e, const string& id) {
+    if (!e) return false;
+    switch (e->clase) {
+        case EXP_ID:      return static_cast<IdExp*>(e)->value == id;
+        case EXP_BINARIA: {
+            auto b = static_cast<BinaryExp*>(e);
+            return usa(b->left, id) || usa(b->right, id);
+        }
+        case EXP_CAST:    return usa(static_cast<CastExp*>(e)->expr, id);
+        case EXP_INDICE:  return usa(static_cast<IndexExp*>(e)->indice, id);
+        case EXP_LLAMADA: {
+            for (auto a : static_cast<FcallExp*>(e)->argumentos)
+                if (usa(a, id)) return true;
+            return false;
+        }
+        default:          return false;
+    }
+}
+
+static bool llama(Exp* e) {
+    if (!e) return false;
+    switch (e->clase) {
+        case EXP_LLAMADA: return true;
+        case EXP_BINARIA: {
+            auto b = static_cast<BinaryExp*>(e);
+            return llama(b->left) || llama(b->right);
+        }
+        case EXP_CAST:    return llama(static_cast<CastExp*>(e)->expr);
+        case EXP_INDICE:  return llama(static_cast<IndexExp*>(e)->indice);
+        default:          return false;
+    }
+}
+
+// Asignaciones a 'id' en b (a cualquier profundidad; un for sobre 'id' o
+// pasarla por referencia a una llamada cuentan como asignación) y si alguna
+// expresión llama a una función
+static void recorrer(Body* b, const string& id, int& asignaciones, bool& llamadas) {
+    if (!b) return;
+    auto mirar = [&](Exp* e) {
+        if (entregaVariable(e, id)) asignaciones++;
+        llamadas = llamadas || llama(e);
+    };
+    for (auto s : b->StmList) {
+        if (!s) continue;
+        switch (s->clase) {
+            case STM_ASIGNACION: {
+                auto a = static_cast<AssignStm*>(s);
+                if (a->id == id && !a->indice) asignaciones++;
+                mirar(a->e);
+                mirar(a->indice);
+                break;
+            }
+            case STM_PRINT:  mirar(static_cast<PrintStm*>(s)->e);  break;
+            case STM_RETURN: mirar(static_cast<ReturnStm*>(s)->e); break;
+            case STM_EXP:    mirar(static_cast<ExpStm*>(s)->e);    break;
+            case STM_IF: {
+                auto i = static_cast<IfStm*>(s);
+                mirar(i->condition);
+                recorrer(i->then, id, asignaciones, llamadas);
+                recorrer(i->els, id, asignaciones, llamadas);
+                break;
+            }
+            case STM_WHILE: {
+                auto w = static_cast<WhileStm*>(s);
+                mirar(w->condition);
+                recorrer(w->b, id, asignaciones, llamadas);
+                break;
+            }
+            case STM_FOR: {
+                auto f = static_cast<ForStm*>(s);
+                if (f->id == id) asignaciones++;
+                mirar(f->inicio);
+                mirar(f->fin);
+                recorrer(f->b, id, asignaciones, llamadas);
+                break;
+            }
+        }
+    }
+}
+
+static int asignaciones(Body* b, const string& id) {
+    int n = 0;
+    bool llamadas = false;
+    recorrer(b, id, n, llamadas);
+    return n;
+}
 
-        // Elimina código muerto (Dead Code)
-        for (auto& s : f->cuerpo->StmList) {
-            s = removeDeadCode(s);
+// Copia de e con los mismos tipos y banderas. Un nodo compartido se reutiliza
+// (no cambia) salvo que haya que sustituir 'var' dentro de él por 'valor'.
+static Exp* clonar(Exp* e, const string* var = nullptr, Exp* valor = nullptr) {
+    if (!e) return nullptr;
+    if (e->compartido && !(var && usa(e, *var))) return e;
+
+    Exp* c = nullptr;
+    switch (e->clase) {
+        case EXP_BINARIA: {
+            auto b = static_cast<BinaryExp*>(e);
+            c = new BinaryExp(clonar(b->left, var, valor), clonar(b->right, var, valor), b->op);
+            break;
+        }
+        case EXP_NUMERO: {
+            auto n = static_cast<NumberExp*>(e);
+            c = n->isFloat ? new NumberExp(n->fvalue) : new NumberExp(n->ivalue);
+            break;
+        }
+        case EXP_ID: {
+            auto i = static_cast<IdExp*>(e);
+            if (var && i->value == *var) return clonar(valor);
+            c = new IdExp(i->value);
+            break;
+        }
+        case EXP_CAST: {
+            auto k = static_cast<CastExp*>(e);
+            c = new CastExp(clonar(k->expr, var, valor), k->destino);
+            break;
+        }
+        case EXP_INDICE: {
+            auto x = static_cast<IndexExp*>(e);
+            auto ix = new IndexExp(x->nombre, clonar(x->indice, var, valor));
+            ix->verificar = x->verificar;
+            c = ix;
+            break;
         }
+        case EXP_LLAMADA: {
+            auto f = static_cast<FcallExp*>(e);
+            auto fc = new FcallExp();
+            fc->nombre = f->nombre;
+            for (auto a : f->argumentos) fc->argumentos.push_back(clonar(a, var, valor));
+            fc->referencia = f->referencia;
+            c = fc;
+            break;
+        }
+    }
+    c->tipoDato = e->tipoDato;
+    return c;
+}
 
-        // Plegado de constantes (Constant Folding)
-        for (auto& s : f->cuerpo->StmList) {
-            if (!s) continue;
+static Body* clonar(Body* b, const string* var = nullptr, Exp* valor = nullptr);
 
-            if (auto a = dynamic_cast<AssignStm*>(s)) {
+static Stm* clonar(Stm* s, const string* var, Exp* valor) {
+    switch (s->clase) {
+        case STM_ASIGNACION: {
+            auto a = static_cast<AssignStm*>(s);
+            auto c = new AssignStm(a->id, clonar(a->e, var, valor));
+            c->indice    = clonar(a->indice, var, valor);
+            c->verificar = a->verificar;
+            return c;
+        }
+        case STM_PRINT:
+            return new PrintStm(clonar(static_cast<PrintStm*>(s)->e, var, valor));
+        case STM_RETURN: {
+            auto r = new ReturnStm();
+            r->e = clonar(static_cast<ReturnStm*>(s)->e, var, valor);
+            return r;
+        }
+        case STM_EXP:
+            return new ExpStm(clonar(static_cast<ExpStm*>(s)->e, var, valor));
+        case STM_IF: {
+            auto i = static_cast<IfStm*>(s);
+            return new IfStm(clonar(i->condition, var, valor),
+                             clonar(i->then, var, valor), clonar(i->els, var, valor));
+        }
+        case STM_WHILE: {
+            auto w = static_cast<WhileStm*>(s);
+            return new WhileStm(clonar(w->condition, var, valor), clonar(w->b, var, valor));
+        }
+        case STM_FOR: {
+            auto f = static_cast<ForStm*>(s);
+            return new ForStm(f->id, clonar(f->inicio, var, valor), clonar(f->fin, var, valor),
+                              f->descendente, clonar(f->b, var, valor));
+        }
+    }
+    return nullptr;
+}
+
+static Body* clonar(Body* b, const string* var, Exp* valor) {
+    if (!b) return nullptr;
+    auto c = new Body();
+    for (auto d : b->declarations) {
+        auto vd = new VarDec(*d);
+        c->declarations.push_back(vd);
+        // un bloque que redeclara la variable la oculta: no se sustituye
+        for (auto& n : d->vars)
+            if (var && n == *var) var = nullptr;
+    }
+    for (auto s : b->StmList)
+        if (s) c->StmList.push_back(clonar(s, var, valor));
+    return c;
+}
+
+// Literal entero del mismo tipo que 'tipo'
+static NumberExp* literal(long long v, Tipo tipo) {
+    auto n = new NumberExp(v);
+    n->tipoDato = tipo;
+    return n;
+}
+
+static bool literalEntero(Exp* e, long long& v) {
+    if (!e || e->clase != EXP_NUMERO || static_cast<NumberExp*>(e)->isFloat) return false;
+    v = static_cast<NumberExp*>(e)->ivalue;
+    return true;
+}
+
+// E no cambia dentro de b: literales y variables que b no asigna
+static bool invarianteEn(Exp* e, Body* b, const unordered_set<string>& locales, bool& global) {
+    switch (e->clase) {
+        case EXP_NUMERO: return true;
+        case EXP_ID: {
+            const string& id = static_cast<IdExp*>(e)->value;
+            if (!locales.count(id)) global = true;
+            return asignaciones(b, id) == 0;
+        }
+        case EXP_CAST:
+            return invarianteEn(static_cast<CastExp*>(e)->expr, b, locales, global);
+        case EXP_BINARIA: {
+            auto x = static_cast<BinaryExp*>(e);
+            return invarianteEn(x->left, b, locales, global) &&
+                   invarianteEn(x->right, b, locales, global);
+        }
+        default:
+            return false;
+    }
+}
+
+static BinaryOp invertir(BinaryOp op) {
+    switch (op) {
+        case LT_OP: return GT_OP;
+        case GT_OP: return LT_OP;
+        case LE_OP: return GE_OP;
+        case GE_OP: return LE_OP;
+        default:    return op;
+    }
+}
+
+// ¿Se cumple 'x op lim'?
+static bool cumple(long long x, BinaryOp op, long long lim) {
+    switch (op) {
+        case LT_OP: return x < lim;
+        case LE_OP: return x <= lim;
+        case GT_OP: return x > lim;
+        case GE_OP: return x >= lim;
+        default:    return x != lim;
+    }
+}
+
+// Desenrolla el while de *it si puede. 'previa': la sentencia anterior en
+// la misma lista (o nullptr). 'alias': la función tiene parámetros var, que
+// pueden referirse a cualquier variable no local (o a otro parámetro var).
+static void desenrollarWhile(list<Stm*>& lista, list<Stm*>::iterator it, Stm* previa,
+                             const unordered_set<string>& locales, int factor, bool alias) {
+    auto w = static_cast<WhileStm*>(*it);
+    Body* b = w->b;
+    if (!b || !b->declarations.empty() || b->StmList.empty()) return;
+
+    // Condición: v op E  (o E op v, o v - E / E - v, que es v <> E)
+    if (w->condition->clase != EXP_BINARIA) return;
+    auto c = static_cast<BinaryExp*>(w->condition);
+    BinaryOp op = c->op;
+    if (op == MINUS_OP && c->tipoDato == T_INT) op = NEQ_OP;
+    else if (op != LT_OP && op != LE_OP && op != GT_OP && op != GE_OP && op != NEQ_OP) return;
+
+    // v es el lado que el cuerpo asigna (una sola vez)
+    auto esVar = [&](Exp* e, Exp* otro) {
+        if (e->clase != EXP_ID || e->tipoDato != T_INT) return false;
+        const string& id = static_cast<IdExp*>(e)->value;
+        return !usa(otro, id) && asignaciones(b, id) == 1;
+    };
+    string v;
+    Exp* lim;
+    if (esVar(c->left, c->right)) {
+        v = static_cast<IdExp*>(c->left)->value;
+        lim = c->right;
+    } else if (esVar(c->right, c->left)) {
+        v = static_cast<IdExp*>(c->right)->value;
+        lim = c->left;
+        op = invertir(op);
+    } else {
+        return;
+    }
+    if (lim->tipoDato != T_INT && lim->tipoDato != T_LONG) return;
+
+    // Incremento: v := v + c / c + v / v - c, en el nivel superior del cuerpo
+    long long paso = 0;
+    for (auto s : b->StmList) {
+        if (!s || s->clase != STM_ASIGNACION) continue;
+        auto a = static_cast<AssignStm*>(s);
+        if (a->id != v || a->indice || a->e->clase != EXP_BINARIA) continue;
+        auto e = static_cast<BinaryExp*>(a->e);
+        auto esV = [&](Exp* x) { return x->clase == EXP_ID && static_cast<IdExp*>(x)->value == v; };
+        long long k;
+        if (e->op == PLUS_OP && esV(e->left) && literalEntero(e->right, k))       paso = k;
+        else if (e->op == PLUS_OP && esV(e->right) && literalEntero(e->left, k))  paso = k;
+        else if (e->op == MINUS_OP && esV(e->left) && literalEntero(e->right, k)) paso = -k;
+    }
+    if (paso == 0 || paso > INT32_MAX || paso < -INT32_MAX) return;
+    if (paso > 0 && op != LT_OP && op != LE_OP && op != NEQ_OP) return;
+    if (paso < 0 && op != GT_OP && op != GE_OP && op != NEQ_OP) return;
+
+    // Con v o E globales, una llamada del cuerpo (o un alias) podría cambiarlas
+    int n = 0;
+    bool llamadas = false;
+    recorrer(b, v, n, llamadas);
+    bool global = !locales.count(v);
+    if (!invarianteEn(lim, b, locales, global)) return;
+    if (global && (llamadas || alias)) return;
+
+    int tam = tamano(b);
+
+    // Completo: 'v := K' justo antes y E literal
+    long long x, tope;
+    if (previa && previa->clase == STM_ASIGNACION && literalEntero(lim, tope)) {
+        auto a = static_cast<AssignStm*>(previa);
+        if (a->id == v && !a->indice && literalEntero(a->e, x)) {
+            int vueltas = 0;
+            while (vueltas <= VUELTAS_COMPLETO && cumple(x, op, tope)) {
+                x += paso;
+                vueltas++;
+            }
+            if (vueltas <= VUELTAS_COMPLETO && vueltas * tam <= LIMITE_DESENROLLADO) {
+                for (int i = 0; i < vueltas; ++i)
+                    for (auto s : b->StmList) if (s) lista.insert(it, clonar(s, nullptr, nullptr));
+                delete w;
+                lista.erase(it);
+                return;
+            }
+        }
+    }
+
+    // Parcial: while v + (factor-1)*paso op' E do <factor copias>; el
+    // while original sigue detrás para las vueltas restantes
+    while (factor > 1 && factor * tam > LIMITE_DESENROLLADO) factor--;
+    if (factor < 2) return;
+
+    BinaryOp guarda = op;
+    if (op == NEQ_OP) guarda = paso > 0 ? LT_OP : GT_OP;
+
+    auto var = new IdExp(v);
+    var->tipoDato = T_INT;
+    auto adelante = new BinaryExp(new CastExp(var, T_LONG),
+                                  literal((factor - 1) * paso, T_LONG), PLUS_OP);
+    adelante->tipoDato = T_LONG;
+    Exp* l = clonar(lim);
+    if (l->tipoDato != T_LONG) l = new CastExp(l, T_LONG);
+    auto cond = new BinaryExp(adelante, l, guarda);
+    cond->tipoDato = T_INT;
+
+    auto copias = new Body();
+    for (int i = 0; i < factor; ++i)
+        for (auto s : b->StmList) if (s) copias->StmList.push_back(clonar(s, nullptr, nullptr));
+    lista.insert(it, new WhileStm(cond, copias));
+}
+
+// for v := K1 to K2 con pocas vueltas: copias del cuerpo con v sustituida
+static void desenrollarFor(list<Stm*>& lista, list<Stm*>::iterator it,
+                           const unordered_set<string>& locales, bool alias) {
+    auto f = static_cast<ForStm*>(*it);
+    Body* b = f->b;
+    long long ini, fin;
+    if (!b || !b->declarations.empty()) return;
+    if (!literalEntero(f->inicio, ini) || !literalEntero(f->fin, fin)) return;
+    if (f->inicio->tipoDato != T_INT || f->fin->tipoDato != T_INT) return;
+
+    long long vueltas = f->descendente ? ini - fin + 1 : fin - ini + 1;
+    if (vueltas < 1 || vueltas > VUELTAS_COMPLETO) return;
+    if (vueltas * tamano(b) > LIMITE_DESENROLLADO) return;
+
+    int asign = 0;
+    bool llamadas = false;
+    recorrer(b, f->id, asign, llamadas);
+    if (asign != 0) return;
+
+    // Una global la puede leer otra función: se actualiza en cada vuelta.
+    // Si además puede tener alias, el cuerpo podría cambiarla: no se toca.
+    bool global = !locales.count(f->id);
+    if (global && alias) return;
+    long long paso = f->descendente ? -1 : 1;
+    for (long long k = 0; k < vueltas; ++k) {
+        long long v = ini + k * paso;
+        if (global) lista.insert(it, new AssignStm(f->id, literal(v, T_INT)));
+        NumberExp* valor = literal(v, T_INT);
+        for (auto s : b->StmList) if (s) lista.insert(it, clonar(s, &f->id, valor));
+        delete valor;
+    }
+    // Al salir, la variable queda con el último valor recorrido
+    if (!global) lista.insert(it, new AssignStm(f->id, literal(fin, T_INT)));
+    delete f;
+    lista.erase(it);
+}
+
+static void desenrollar(Body* b, unordered_set<string> locales, int factor, bool alias) {
+    if (!b) return;
+    for (auto d : b->declarations)
+        for (auto& n : d->vars) locales.insert(n);
+
+    Stm* previa = nullptr;
+    for (auto it = b->StmList.begin(); it != b->StmList.end(); ) {
+        Stm* s = *it;
+        auto siguiente = std::next(it);
+        if (!s) { ++it; continue; }
+
+        // Primero los bucles internos
+        switch (s->clase) {
+            case STM_IF: {
+                auto i = static_cast<IfStm*>(s);
+                desenrollar(i->then, locales, factor, alias);
+                desenrollar(i->els, locales, factor, alias);
+                break;
+            }
+            case STM_WHILE:
+                desenrollar(static_cast<WhileStm*>(s)->b, locales, factor, alias);
+                desenrollarWhile(b->StmList, it, previa, locales, factor, alias);
+                break;
+            case STM_FOR:
+                desenrollar(static_cast<ForStm*>(s)->b, locales, factor, alias);
+                desenrollarFor(b->StmList, it, locales, alias);
+                break;
+            default:
+                break;
+        }
+        previa = siguiente == b->StmList.begin() ? nullptr : *std::prev(siguiente);
+        it = siguiente;
+    }
+}
+
+// -----------------------------------------------------
+// OPTIMIZACIÓN DE UNA FUNCIÓN
+// -----------------------------------------------------
+void optimizeFunDec(FunDec* f, int desenrollado) {
+    if (!f || !f->cuerpo) return;
+    if (f->codigo && f->codigo->deCache) return;   // ya compilada
+
+    // Elimina código muerto (Dead Code)
+    for (auto& s : f->cuerpo->StmList) {
+        s = removeDeadCode(s);
+    }
+
+    // Plegado de constantes (Constant Folding)
+    for (auto& s : f->cuerpo->StmList) {
+        if (!s) continue;
+
+        switch (s->clase) {
+            case STM_ASIGNACION: {
+                auto a = static_cast<AssignStm*>(s);
                 a->e = foldConstants(a->e);
+                a->indice = foldConstants(a->indice);
+                break;
             }
-            else if (auto p = dynamic_cast<PrintStm*>(s)) {
+            case STM_PRINT: {
+                auto p = static_cast<PrintStm*>(s);
                 p->e = foldConstants(p->e);
+                break;
             }
-            else if (auto i = dynamic_cast<IfStm*>(s)) {
+            case STM_IF: {
+                auto i = static_cast<IfStm*>(s);
                 i->condition = foldConstants(i->condition);
+                break;
             }
-            else if (auto w = dynamic_cast<WhileStm*>(s)) {
+            case STM_WHILE: {
+                auto w = static_cast<WhileStm*>(s);
                 w->condition = foldConstants(w->condition);
+                break;
+            }
+            case STM_FOR: {
+                auto fr = static_cast<ForStm*>(s);
+                fr->inicio = foldConstants(fr->inicio);
+                fr->fin    = foldConstants(fr->fin);
+                break;
             }
+            default:
+                break;
+        }
+    }
+
+    // Limpieza: eliminar sentencias nulas del Body
+    f->cuerpo->StmList.remove(nullptr);
+
+    // Desenrollado de bucles (los límites ya plegados)
+    if (desenrollado > 1) {
+        // Los parámetros var no son locales: pueden nombrar una global
+        unordered_set<string> locales;
+        bool alias = false;
+        for (size_t i = 0; i < f->Pnombres.size(); ++i) {
+            if (f->porReferencia(i)) alias = true;
+            else locales.insert(f->Pnombres[i]);
         }
+        desenrollar(f->cuerpo, locales, desenrollado, alias);
+    }
+}
+
+// -----------------------------------------------------
+// FUNCIÓN PRINCIPAL DE OPTIMIZACIÓN GLOBAL
+// -----------------------------------------------------
+void optimizeAST(Program* prog, ostream* log, int desenrollado) {
+    if (!prog) return;
 
-        // Limpieza: eliminar sentencias nulas del Body
-        f->cuerpo->StmList.remove(nullptr);
+    // Recorre cada función del programa
+    for (auto& f : prog->fdlist) {
+        optimizeFunDec(f, desenrollado);
     }
 
-    std::cout << "Optimizaciones aplicadas correctamente." << std::endl;
+    if (log) *log << "Optimizaciones aplicadas correctamente." << std::endl;
 }
@@ -6,6 +6,7 @@
 #include <ostream>
 #include <vector>
 #include <unordered_map>
+#include <cstdint>
 
 using namespace std;
 
@@ -21,7 +22,8 @@ enum Tipo {
     T_FLOAT,
     T_LONG,
     T_UNSIGNED,
-    T_BOOL
+    T_BOOL,
+    T_DOUBLE      // real / double: 64 bits
 };
 
 // ========================
@@ -42,15 +44,51 @@ enum BinaryOp {
     MOD_OP      // mod
 };
 
+// ========================
+//   Clase concreta del nodo
+//  (despacho sin RTTI, ver
+//   visitar() en visitor.h)
+// ========================
+enum ClaseExp : uint8_t {
+    EXP_BINARIA,
+    EXP_NUMERO,
+    EXP_ID,
+    EXP_LLAMADA,
+    EXP_CAST,
+    EXP_INDICE
+};
+
+enum ClaseStm : uint8_t {
+    STM_ASIGNACION,
+    STM_PRINT,
+    STM_IF,
+    STM_WHILE,
+    STM_RETURN,
+    STM_EXP,
+    STM_FOR
+};
+
 // ========================
 //       Expresión base
 // ========================
 class Exp {
 public:
+    const ClaseExp clase;
     Tipo tipoDato = T_INT;
+
+    explicit Exp(ClaseExp c) : clase(c) {}
+
+    // Hash-consing (ver TablaExpresiones): un nodo compartido aparece varias
+    // veces dentro de su función y lo libera la FunDec, nunca su padre.
+    bool compartido = false;
+    bool tipado     = false;   // ya analizado (solo en nodos compartidos)
+
     virtual int accept(Visitor* visitor) = 0;
     virtual ~Exp() = 0;
     static string binopToChar(BinaryOp op);
+
+    // delete salvo que el nodo sea compartido
+    static void liberar(Exp* e) { if (e && !e->compartido) delete e; }
 };
 
 // ========================
@@ -96,11 +134,30 @@ public:
     ~IdExp();
 };
 
+// ========================
+//   Elemento de arreglo a[i]
+// ========================
+// 'verificar' lo apaga el análisis de tipos cuando prueba que el índice
+// está siempre dentro de los límites (ver TypeCheckVisitor::rango).
+class IndexExp : public Exp {
+public:
+    string nombre;
+    Exp*   indice;
+    bool   verificar = true;
+
+    IndexExp(string nombre, Exp* indice);
+    int accept(Visitor* visitor);
+    ~IndexExp();
+};
+
 // ========================
 //     Statements base
 // ========================
 class Stm {
 public:
+    const ClaseStm clase;
+
+    explicit Stm(ClaseStm c) : clase(c) {}
     virtual int accept(Visitor* visitor) = 0;
     virtual ~Stm() = 0;
 };
@@ -110,9 +167,13 @@ public:
 // ========================
 class VarDec {
 public:
-    string type;
+    string type;          // en un arreglo, el tipo de los elementos
     list<string> vars;
 
+    // array[lo..hi] of type
+    bool      arreglo = false;
+    long long lo = 0, hi = 0;
+
     VarDec();
     int accept(Visitor* visitor);
     ~VarDec();
@@ -142,7 +203,7 @@ public:
 
     IfStm(Exp* condition, Body* thenBody, Body* elseBody);
     int accept(Visitor* visitor);
-    ~IfStm() {};
+    ~IfStm();
 };
 
 // ========================
@@ -155,7 +216,25 @@ public:
 
     WhileStm(Exp* condition, Body* b);
     int accept(Visitor* visitor);
-    ~WhileStm() {};
+    ~WhileStm();
+};
+
+// ========================
+//   for id := a to/downto b
+// ========================
+// Los límites se evalúan una vez, antes de la primera vuelta; el cuerpo se
+// ejecuta max(0, b - a + 1) veces (a - b + 1 con downto).
+class ForStm : public Stm {
+public:
+    string id;
+    Exp*   inicio;
+    Exp*   fin;
+    bool   descendente;   // downto
+    Body*  b;
+
+    ForStm(string id, Exp* inicio, Exp* fin, bool descendente, Body* b);
+    int accept(Visitor* visitor);
+    ~ForStm();
 };
 
 // ========================
@@ -165,6 +244,8 @@ class AssignStm : public Stm {
 public:
     string id;
     Exp*   e;
+    Exp*   indice = nullptr;    // id[indice] := e
+    bool   verificar = true;    // como IndexExp::verificar
 
     AssignStm(string id, Exp* e);
     int accept(Visitor* visitor);
@@ -194,8 +275,8 @@ public:
 class ReturnStm : public Stm {
 public:
     Exp* e;
-    ReturnStm() : e(nullptr) {}
-    ~ReturnStm() {}
+    ReturnStm() : Stm(STM_RETURN), e(nullptr) {}
+    ~ReturnStm() { Exp::liberar(e); }
     int accept(Visitor* visitor);
 };
 
@@ -207,9 +288,39 @@ public:
     string nombre;
     vector<Exp*> argumentos;
 
-    FcallExp() {}
+    // Argumentos que se pasan por referencia: los de readln (el parser) y
+    // los de parámetros var (el análisis de tipos, con la firma visible)
+    vector<bool> referencia;
+
+    FcallExp() : Exp(EXP_LLAMADA) {}
     int accept(Visitor* visitor);
-    ~FcallExp() {}
+    ~FcallExp();
+
+    bool porReferencia(size_t i) const { return i < referencia.size() && referencia[i]; }
+};
+
+// readln(...) llega como una FcallExp con ese nombre (palabra reservada,
+// no puede ser una función del programa) y asigna a sus argumentos
+inline bool esLectura(const Exp* e) {
+    return e && e->clase == EXP_LLAMADA &&
+           static_cast<const FcallExp*>(e)->nombre == "readln";
+}
+
+// ¿Alguna llamada dentro de e recibe la variable 'id' por referencia (y
+// por lo tanto puede asignarla)?
+bool entregaVariable(Exp* e, const string& id);
+
+// ========================
+//   Código de una función
+//   (generado o de caché)
+// ========================
+struct CodigoFuncion {
+    string         texto;       // ensamblador de la función
+    vector<uint32_t> floats;    // constantes float que usa (bits IEEE), en orden
+    vector<uint64_t> doubles;   // ídem, constantes double
+    bool           usaEscritura = false;   // llama a write_* / read_* (runtime
+    bool           usaLectura   = false;   // que hay que añadir al programa)
+    bool           deCache = false;
 };
 
 // ========================
@@ -218,14 +329,28 @@ public:
 class FunDec {
 public:
     string nombre;             // nombre de la función
-    string tipo;               // tipo de retorno ("integer", etc.)
+    string tipo;               // tipo de retorno ("integer", etc.; vacío en un procedure)
     Body*  cuerpo;             // cuerpo begin..end
     vector<string> Ptipos;     // tipos de parámetros
     vector<string> Pnombres;   // nombres de parámetros
+    vector<bool>   Pvar;       // parámetros var (por referencia)
+
+    // Caché incremental: hash de los tokens de la declaración, identificadores
+    // que aparecen en ella y código ya generado (si deCache, no se analiza ni
+    // se genera de nuevo).
+    uint64_t       hashTokens = 0;
+    vector<string> idsUsados;
+    CodigoFuncion* codigo = nullptr;
+
+    // Nodos de expresión compartidos de esta función (hash-consing)
+    vector<Exp*> compartidos;
 
     FunDec() : cuerpo(nullptr) {}
     int accept(Visitor* visitor);
-    ~FunDec() {}
+    ~FunDec();
+
+    bool porReferencia(size_t i) const { return i < Pvar.size() && Pvar[i]; }
+    bool esProcedimiento() const { return tipo.empty(); }
 };
 
 // ========================
@@ -248,8 +373,9 @@ class CastExp : public Exp {
 public:
     Exp* expr;
     Tipo destino;
+    bool implicito = false;   // insertado por el análisis de tipos
 
-    CastExp(Exp* e, Tipo d) : expr(e), destino(d) {
+    CastExp(Exp* e, Tipo d) : Exp(EXP_CAST), expr(e), destino(d) {
         this->tipoDato = d;
     }
     int accept(Visitor* visitor);
@@ -273,8 +399,62 @@ public:
 // ========================
 struct ExpStm : Stm {
     Exp* e;
-    ExpStm(Exp* _e) : e(_e) {}
+    ExpStm(Exp* _e) : Stm(STM_EXP), e(_e) {}
+    ~ExpStm() { Exp::liberar(e); }
     virtual int accept(Visitor* v);
 };
 
+// ========================
+//  Expresiones compartidas
+//     (hash-consing)
+// ========================
+// Con 'activa', las subexpresiones sin efectos estructuralmente iguales de
+// una misma función se crean una sola vez: literales, identificadores y
+// binarias / casts cuyos hijos ya son compartidos (nunca FcallExp ni nada que
+// la contenga). Como los hijos compartidos son únicos, la igualdad de una
+// binaria se decide comparando punteros. Sin 'activa', cada llamada crea un
+// nodo nuevo, igual que 'new'.
+class TablaExpresiones {
+public:
+    bool   activa = false;
+    size_t creados = 0, reutilizados = 0;   // nodos compartidos
+
+    Exp* numero(long long v);
+    Exp* numero(double v);
+    Exp* id(const string& nombre);
+    Exp* binaria(Exp* l, Exp* r, BinaryOp op);
+    Exp* cast(Exp* e, Tipo destino);
+
+    // Empieza una función o un bloque con variables propias: no se comparte
+    // nada con lo anterior (el mismo nombre puede ser otra variable)
+    void iniciarAmbito();
+    // fd pasa a ser dueña de los nodos creados desde el último entregar()
+    void entregar(FunDec* fd);
+
+    ~TablaExpresiones();
+
+private:
+    // clase 0: entero (a = valor), 1: real (a = bits), 2: binaria (a = op),
+    // 3: cast (a = destino)
+    struct Clave {
+        int        clase;
+        long long  a;
+        const Exp* l;
+        const Exp* r;
+        bool operator==(const Clave& o) const {
+            return clase == o.clase && a == o.a && l == o.l && r == o.r;
+        }
+    };
+    struct HashClave {
+        size_t operator()(const Clave& k) const;
+    };
+
+    unordered_map<Clave, Exp*, HashClave> nodos;
+    unordered_map<string, Exp*>           ids;
+    vector<Exp*>                          propios;
+
+    Exp* buscar(const Clave& k);
+    Exp* guardar(const Clave& k, Exp* e);
+};
+
 #endif // AST_H
@@ -0,0 +1,505 @@
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include "astbin.h"
+#include "visitor.h"
+
+using namespace std;
+
+namespace {
+
+const char    MAGIA[5] = {'P', 'C', 'A', 'S', 'T'};
+const uint8_t VERSION  = 5;
+
+// Etiquetas de nodo
+enum Etiqueta : uint8_t {
+    E_BINARIA = 1, E_NUMERO, E_ID, E_LLAMADA, E_CAST,
+    S_ASIGNACION, S_PRINT, S_IF, S_WHILE, S_RETURN, S_EXP, S_FOR,
+    E_INDICE
+};
+
+// Banderas de NumberExp
+const uint8_t NUM_FLOAT = 1;
+
+// -----------------------------
+// Escritura
+// -----------------------------
+class EscritorAST : public Visitor {
+public:
+    string nodos;
+
+    void entero(uint64_t v) {
+        while (v >= 0x80) {
+            nodos += (char)(v | 0x80);
+            v >>= 7;
+        }
+        nodos += (char)v;
+    }
+
+    void conSigno(int64_t v) { entero(((uint64_t)v << 1) ^ (uint64_t)(v >> 63)); }
+
+    void real(double d) {
+        uint64_t bits;
+        memcpy(&bits, &d, sizeof bits);
+        for (int i = 0; i < 8; ++i) nodos += (char)(bits >> (8 * i));
+    }
+
+    void cadena(const string& s) {
+        auto it = indices.find(s);
+        if (it == indices.end()) {
+            it = indices.emplace(s, (uint32_t)cadenas.size()).first;
+            cadenas.push_back(&it->first);
+        }
+        entero(it->second);
+    }
+
+    void etiqueta(Etiqueta e) { nodos += (char)e; }
+    void etiqueta(Etiqueta e, Tipo t) { nodos += (char)(e | (t << 4)); }
+
+    // Tabla de cadenas (en orden de primera aparición)
+    void escribirTabla(string& salida) const {
+        EscritorAST t;
+        t.entero(cadenas.size());
+        for (const string* s : cadenas) {
+            t.entero(s->size());
+            t.nodos += *s;
+        }
+        salida += t.nodos;
+    }
+
+    int visit(Program* p) override {
+        entero(p->tdefs.size());
+        for (auto& kv : p->tdefs) {
+            cadena(kv.first);
+            cadena(kv.second);
+        }
+        entero(p->vdlist.size());
+        for (auto* vd : p->vdlist) vd->accept(this);
+        entero(p->fdlist.size());
+        for (auto* fd : p->fdlist) fd->accept(this);
+        return 0;
+    }
+
+    int visit(VarDec* vd) override {
+        cadena(vd->type);
+        entero(vd->arreglo ? 1 : 0);
+        if (vd->arreglo) {
+            conSigno(vd->lo);
+            conSigno(vd->hi);
+        }
+        entero(vd->vars.size());
+        for (auto& v : vd->vars) cadena(v);
+        return 0;
+    }
+
+    int visit(FunDec* fd) override {
+        cadena(fd->nombre);
+        cadena(fd->tipo);
+        entero(fd->Pnombres.size());
+        for (size_t i = 0; i < fd->Pnombres.size(); ++i) {
+            cadena(fd->Pnombres[i]);
+            cadena(i < fd->Ptipos.size() ? fd->Ptipos[i] : string());
+            entero(fd->porReferencia(i));
+        }
+        cuerpoOpcional(fd->cuerpo);
+        return 0;
+    }
+
+    int visit(Body* b) override {
+        entero(b->declarations.size());
+        for (auto* d : b->declarations) d->accept(this);
+        entero(b->StmList.size());
+        for (auto* s : b->StmList) s->accept(this);
+        return 0;
+    }
+
+    int visit(AssignStm* s) override {
+        etiqueta(S_ASIGNACION);
+        cadena(s->id);
+        entero(!s->indice ? 0 : s->verificar ? 2 : 1);
+        if (s->indice) s->indice->accept(this);
+        s->e->accept(this);
+        return 0;
+    }
+
+    int visit(PrintStm* s) override {
+        etiqueta(S_PRINT);
+        s->e->accept(this);
+        return 0;
+    }
+
+    int visit(IfStm* s) override {
+        etiqueta(S_IF);
+        s->condition->accept(this);
+        cuerpoOpcional(s->then);
+        cuerpoOpcional(s->els);
+        return 0;
+    }
+
+    int visit(WhileStm* s) override {
+        etiqueta(S_WHILE);
+        s->condition->accept(this);
+        cuerpoOpcional(s->b);
+        return 0;
+    }
+
+    int visit(ForStm* s) override {
+        etiqueta(S_FOR);
+        cadena(s->id);
+        entero(s->descendente ? 1 : 0);
+        s->inicio->accept(this);
+        s->fin->accept(this);
+        cuerpoOpcional(s->b);
+        return 0;
+    }
+
+    int visit(ReturnStm* r) override {
+        etiqueta(S_RETURN);
+        entero(r->e ? 1 : 0);
+        if (r->e) r->e->accept(this);
+        return 0;
+    }
+
+    int visit(ExpStm* s) override {
+        etiqueta(S_EXP);
+        s->e->accept(this);
+        return 0;
+    }
+
+    int visit(BinaryExp* e) override {
+        etiqueta(E_BINARIA, e->tipoDato);
+        entero(e->op);
+        e->left->accept(this);
+        e->right->accept(this);
+        return 0;
+    }
+
+    int visit(NumberExp* e) override {
+        etiqueta(E_NUMERO, e->tipoDato);
+        entero(e->isFloat ? NUM_FLOAT : 0);
+        if (e->isFloat) real(e->fvalue);
+        else            conSigno(e->ivalue);
+        return 0;
+    }
+
+    int visit(IdExp* e) override {
+        etiqueta(E_ID, e->tipoDato);
+        cadena(e->value);
+        return 0;
+    }
+
+    int visit(FcallExp* f) override {
+        etiqueta(E_LLAMADA, f->tipoDato);
+        cadena(f->nombre);
+        entero(f->argumentos.size());
+        for (size_t i = 0; i < f->argumentos.size(); ++i) {
+            entero(f->porReferencia(i));
+            f->argumentos[i]->accept(this);
+        }
+        return 0;
+    }
+
+    int visit(IndexExp* e) override {
+        etiqueta(E_INDICE, e->tipoDato);
+        cadena(e->nombre);
+        entero(e->verificar ? 1 : 0);
+        e->indice->accept(this);
+        return 0;
+    }
+
+    int visit(CastExp* e) override {
+        etiqueta(E_CAST, e->tipoDato);
+        entero(e->destino);
+        e->expr->accept(this);
+        return 0;
+    }
+
+    int visit(TypeAlias*) override { return 0; }
+
+private:
+    unordered_map<string, uint32_t> indices;
+    vector<const string*>           cadenas;
+
+    void cuerpoOpcional(Body* b) {
+        entero(b ? 1 : 0);
+        if (b) b->accept(this);
+    }
+};
+
+// -----------------------------
+// Lectura
+// -----------------------------
+class LectorAST {
+public:
+    LectorAST(const char* datos, size_t tam)
+        : p((const uint8_t*)datos), fin((const uint8_t*)datos + tam) {}
+
+    Program* programa() {
+        if ((size_t)(fin - p) < 8 || memcmp(p, MAGIA, sizeof MAGIA) != 0)
+            throw runtime_error("No es un AST binario");
+        if (p[5] != VERSION)
+            throw runtime_error("Versión de AST binario no soportada: " + to_string(p[5]));
+        p += 8;
+
+        size_t nCadenas = cantidad();
+        cadenas.reserve(nCadenas);
+        for (size_t i = 0; i < nCadenas; ++i) {
+            size_t len = cantidad();
+            cadenas.emplace_back((const char*)p, len);
+            p += len;
+        }
+
+        unique_ptr<Program> prog(new Program());
+        for (size_t i = 0, n = cantidad(); i < n; ++i) {
+            const string& alias = cadena();
+            prog->tdefs[alias] = cadena();
+        }
+        for (size_t i = 0, n = cantidad(); i < n; ++i) prog->vdlist.push_back(varDec());
+        for (size_t i = 0, n = cantidad(); i < n; ++i) prog->fdlist.push_back(funDec());
+        if (p != fin) corrupto();
+        return prog.release();
+    }
+
+private:
+    const uint8_t* p;
+    const uint8_t* fin;
+    vector<string> cadenas;
+
+    // Anidamiento de cuerpos y expresiones: el lector (y las fases que
+    // recorren el AST después) son recursivos, y un archivo corrupto o
+    // manipulado no debe poder agotar la pila
+    static const int MAX_PROFUNDIDAD = 20000;
+    int profundidad = 0;
+
+    struct Nivel {
+        LectorAST& l;
+        explicit Nivel(LectorAST& lector) : l(lector) {
+            if (l.profundidad == MAX_PROFUNDIDAD) corrupto();
+            l.profundidad++;
+        }
+        ~Nivel() { l.profundidad--; }
+    };
+
+    [[noreturn]] static void corrupto() { throw runtime_error("AST binario corrupto"); }
+
+    uint8_t byte() {
+        if (p == fin) corrupto();
+        return *p++;
+    }
+
+    uint64_t entero() {
+        uint64_t v = 0;
+        for (int s = 0; s < 64; s += 7) {
+            uint8_t b = byte();
+            v |= (uint64_t)(b & 0x7f) << s;
+            if (!(b & 0x80)) return v;
+        }
+        corrupto();
+    }
+
+    // Un tamaño nunca supera los bytes que quedan (cada elemento ocupa al menos uno)
+    size_t cantidad() {
+        uint64_t v = entero();
+        if (v > (uint64_t)(fin - p)) corrupto();
+        return (size_t)v;
+    }
+
+    int64_t conSigno() {
+        uint64_t v = entero();
+        return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+    }
+
+    double real() {
+        if (fin - p < 8) corrupto();
+        uint64_t bits = 0;
+        for (int i = 0; i < 8; ++i) bits |= (uint64_t)p[i] << (8 * i);
+        p += 8;
+        double d;
+        memcpy(&d, &bits, sizeof d);
+        return d;
+    }
+
+    const string& cadena() {
+        uint64_t i = entero();
+        if (i >= cadenas.size()) corrupto();
+        return cadenas[i];
+    }
+
+    Tipo tipo(uint64_t t) {
+        if (t > T_DOUBLE) corrupto();
+        return (Tipo)t;
+    }
+
+    VarDec* varDec() {
+        unique_ptr<VarDec> vd(new VarDec());
+        vd->type = cadena();
+        if (entero()) {
+            vd->arreglo = true;
+            vd->lo = conSigno();
+            vd->hi = conSigno();
+            if (vd->lo > vd->hi) corrupto();
+        }
+        for (size_t i = 0, n = cantidad(); i < n; ++i) vd->vars.push_back(cadena());
+        return vd.release();
+    }
+
+    FunDec* funDec() {
+        unique_ptr<FunDec> fd(new FunDec());
+        fd->nombre = cadena();
+        fd->tipo   = cadena();
+        size_t n = cantidad();
+        fd->Pnombres.reserve(n);
+        fd->Ptipos.reserve(n);
+        fd->Pvar.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            fd->Pnombres.push_back(cadena());
+            fd->Ptipos.push_back(cadena());
+            fd->Pvar.push_back(entero() != 0);
+        }
+        fd->cuerpo = cuerpoOpcional();
+        return fd.release();
+    }
+
+    Body* cuerpoOpcional() { return entero() ? body() : nullptr; }
+
+    Body* body() {
+        Nivel nivel(*this);
+        unique_ptr<Body> b(new Body());
+        for (size_t i = 0, n = cantidad(); i < n; ++i) b->declarations.push_back(varDec());
+        for (size_t i = 0, n = cantidad(); i < n; ++i) b->StmList.push_back(stm());
+        return b.release();
+    }
+
+    Stm* stm() {
+        switch (byte()) {
+            case S_ASIGNACION: {
+                const string& id = cadena();
+                uint64_t indexado = entero();
+                if (indexado > 2) corrupto();
+                unique_ptr<Exp> i(indexado ? exp() : nullptr);
+                AssignStm* a = new AssignStm(id, exp());
+                a->indice    = i.release();
+                a->verificar = indexado == 2;
+                return a;
+            }
+            case S_PRINT:
+                return new PrintStm(exp());
+            case S_IF: {
+                unique_ptr<Exp>  c(exp());
+                unique_ptr<Body> t(cuerpoOpcional());
+                Body* e = cuerpoOpcional();
+                return new IfStm(c.release(), t.release(), e);
+            }
+            case S_WHILE: {
+                unique_ptr<Exp> c(exp());
+                Body* b = cuerpoOpcional();
+                return new WhileStm(c.release(), b);
+            }
+            case S_FOR: {
+                const string& id = cadena();
+                bool descendente = entero() != 0;
+                unique_ptr<Exp> a(exp());
+                unique_ptr<Exp> z(exp());
+                Body* b = cuerpoOpcional();
+                return new ForStm(id, a.release(), z.release(), descendente, b);
+            }
+            case S_RETURN: {
+                ReturnStm* r = new ReturnStm();
+                try {
+                    if (entero()) r->e = exp();
+                } catch (...) {
+                    delete r;
+                    throw;
+                }
+                return r;
+            }
+            case S_EXP:
+                return new ExpStm(exp());
+            default:
+                corrupto();
+        }
+    }
+
+    Exp* exp() {
+        Nivel nivel(*this);
+        uint8_t et = byte();
+        Tipo t = tipo(et >> 4);
+        Exp* e = nullptr;
+
+        switch (et & 0x0f) {
+            case E_BINARIA: {
+                uint64_t op = entero();
+                if (op > MOD_OP) corrupto();
+                unique_ptr<Exp> l(exp());
+                Exp* r = exp();
+                e = new BinaryExp(l.release(), r, (BinaryOp)op);
+                break;
+            }
+            case E_NUMERO: {
+                uint64_t banderas = entero();
+                if (banderas & NUM_FLOAT) e = new NumberExp(real());
+                else                      e = new NumberExp((long long)conSigno());
+                break;
+            }
+            case E_ID:
+                e = new IdExp(cadena());
+                break;
+            case E_LLAMADA: {
+                unique_ptr<FcallExp> f(new FcallExp());
+                f->nombre = cadena();
+                size_t n = cantidad();
+                f->argumentos.reserve(n);
+                f->referencia.reserve(n);
+                for (size_t i = 0; i < n; ++i) {
+                    f->referencia.push_back(entero() != 0);
+                    f->argumentos.push_back(exp());
+                }
+                e = f.release();
+                break;
+            }
+            case E_INDICE: {
+                const string& nombre = cadena();
+                bool verificar = entero() != 0;
+                IndexExp* x = new IndexExp(nombre, exp());
+                x->verificar = verificar;
+                e = x;
+                break;
+            }
+            case E_CAST: {
+                Tipo destino = tipo(entero());
+                e = new CastExp(exp(), destino);
+                break;
+            }
+            default:
+                corrupto();
+        }
+        e->tipoDato = t;
+        return e;
+    }
+};
+
+} // namespace
+
+void escribirASTBinario(Program* p, string& salida) {
+    EscritorAST w;
+    p->accept(&w);
+
+    salida.append(MAGIA, sizeof MAGIA);
+    salida += (char)VERSION;
+    salida.append(2, '\0');
+    w.escribirTabla(salida);
+    salida += w.nodos;
+}
+
+Program* leerASTBinario(const char* datos, size_t tam) {
+    LectorAST lector(datos, tam);
+    return lector.programa();
+}
+
+string nombreAST(const string& entrada) {
+    size_t dotPos = entrada.find_last_of('.');
+    string baseName = (dotPos == string::npos) ? entrada : entrada.substr(0, dotPos);
+    return baseName + ".ast";
+}
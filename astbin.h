@@ -0,0 +1,37 @@
+#ifndef ASTBIN_H
+#define ASTBIN_H
+
+#include <string>
+#include <cstddef>
+#include "ast.h"
+
+using namespace std;
+
+// --------------------------------------
+// AST binario (programa ya analizado)
+// --------------------------------------
+// Serialización compacta de un Program después del análisis de tipos: alias,
+// globales, funciones y todos los nodos con su tipoDato y los CastExp
+// insertados. Cargarlo sustituye al scanner, al parser y al análisis de
+// tipos; el resultado va directo a optimizeAST y a GenCodeVisitor.
+//
+// Formato (enteros en varint LEB128, con signo en zigzag):
+//   "PCAST" versión(1 byte) 0 0
+//   nº de cadenas, y por cada una: longitud + bytes   (tabla de cadenas)
+//   programa: alias, globales y funciones en preorden; cada nodo empieza
+//   con un byte de etiqueta (clase en los 4 bits bajos; en expresiones, el
+//   tipoDato en los 4 altos) y los nombres son índices en la tabla.
+// Los double se guardan como sus 8 bytes en little-endian.
+
+// Codifica p (debe estar ya analizado) y lo añade a 'salida'
+void escribirASTBinario(Program* p, string& salida);
+
+// Reconstruye el programa desde un buffer (p. ej. un archivo mapeado).
+// Lanza runtime_error si el contenido no es un AST binario válido (también
+// si anida cuerpos y expresiones a más de 20000 niveles).
+Program* leerASTBinario(const char* datos, size_t tam);
+
+// Nombre del .ast junto al archivo fuente
+string nombreAST(const string& entrada);
+
+#endif // ASTBIN_H
@@ -0,0 +1,1213 @@
+import os
+import math
+import socket
+import random
+import sys
+import time
+import shutil
+import tempfile
+import subprocess
+
+# Benchmarks del compilador.
+#   python3 benchmark.py batch [N]   N archivos: un proceso por archivo vs. un solo proceso
+#   python3 benchmark.py jobs [N]    N programas generados compilados con -j 1, 2, 4, ...
+#   python3 benchmark.py funcs [N]   un programa de N funciones compilado con -j 1, 2, 4, ...
+#   python3 benchmark.py cache [N]   editar una función de un programa de N funciones y recompilar
+#   python3 benchmark.py servidor [N] latencia de N peticiones: proceso en frío vs. servidor residente
+#   python3 benchmark.py streaming [N] memoria pico con un programa de N funciones: normal vs. --streaming
+#   python3 benchmark.py tuberia [N]  parseo de un programa de N funciones: scanner en línea vs. --scanner-hilo
+#   python3 benchmark.py lexer [N]    léxico por trozos de un programa de N funciones con -j 1, 2, 4, ...
+#   python3 benchmark.py ast [N]      recompilar un programa de N funciones desde la fuente vs. desde su .ast
+#   python3 benchmark.py profundas [N] [EXE] tiempo por fase con expresiones profundas (EXE: compilador de referencia)
+#   python3 benchmark.py compartir [N] memoria y tiempo de un programa repetitivo de N funciones con y sin --compartir-exp
+#   python3 benchmark.py simbolos [N] [EXE] tipos y codegen de N funciones con muchas variables locales (EXE: compilador de referencia)
+#   python3 benchmark.py floats [N] [EXE] codegen de un programa con N constantes float distintas (EXE: compilador de referencia)
+#   python3 benchmark.py bucles [N]   tiempo de ejecución de dos bucles anidados N x N: for vs. while equivalente
+#   python3 benchmark.py vector [N]  N programas aleatorios con --simd no/sse2/avx2 (misma salida) y tiempo de núcleos vectorizables
+#   python3 benchmark.py arreglos [N] suma de un arreglo y producto de matrices, N veces: límites constantes (sin verificar) vs. variables
+#   python3 benchmark.py escritura [N] [EXE] programa que escribe 2N enteros y N/10 floats (EXE: compilador de referencia)
+#   python3 benchmark.py lectura [N]  programa que lee N líneas "int long float" con readln vs. el mismo en C con scanf
+#   python3 benchmark.py referencias [N] suma y cantidad de dígitos de 1..N: dos funciones vs. un procedure con parámetros var
+#   python3 benchmark.py dobles [N]   pi con N pasos de la regla del punto medio en float y en double: tiempo y error
+#   python3 benchmark.py desenrollar [N] dos while de N vueltas con --desenrollar 1, 2, 4 y 8: ns y ciclos por vuelta
+
+programa = ["main.cpp", "driver.cpp", "threadpool.cpp", "cache.cpp", "server.cpp", "tuberia.cpp", "lexparalelo.cpp", "astbin.cpp", "runtime.cpp", "scanner.cpp", "token.cpp", "parser.cpp", "ast.cpp", "visitor.cpp"]
+
+
+def compilar_compilador(destino):
+    compile = ["g++", "-O2", "-o", destino] + programa
+    print("Compilando:", " ".join(compile))
+    result = subprocess.run(compile, capture_output=True, text=True)
+    if result.returncode != 0:
+        print("Error en compilación:\n", result.stderr)
+        exit(1)
+
+
+def copiar_inputs(directorio, n):
+    # Replica los programas de inputs/ hasta tener n archivos
+    base = sorted(f for f in os.listdir("inputs") if f.endswith(".txt"))
+    rutas = []
+    for i in range(n):
+        src = os.path.join("inputs", base[i % len(base)])
+        dst = os.path.join(directorio, f"prog{i}.txt")
+        shutil.copy(src, dst)
+        rutas.append(dst)
+    return rutas
+
+
+def generar_programa(rng, nfun, nstm, comentarios=False):
+    # Programa aleatorio válido: globales, nfun funciones y un main que las llama
+    lineas = ["program Gen;", "var g0, g1, g2 : integer;", "    h0 : float;"]
+    for f in range(nfun):
+        if comentarios:
+            lineas.append(f"{{ f{f}: combina a y b;\n  comentario de varias lineas }}")
+        lineas.append(f"function f{f}(a : integer; b : integer) : integer;")
+        lineas.append("var x, y : integer;")
+        lineas.append("begin")
+        lineas.append("    x := a; y := b;")
+        for _ in range(nstm):
+            k = rng.randint(0, 4)
+            c = rng.randint(1, 9)
+            if k == 0:
+                lineas.append(f"    x := x + y * {c} - (a div {c});")
+            elif k == 1:
+                lineas.append(f"    if x > y then y := y + {c} else x := x - {c};")
+            elif k == 2:
+                lineas.append(f"    while y > {c * 10} do y := y - {c};")
+            elif k == 3:
+                lineas.append(f"    g{c % 3} := g{c % 3} + x mod {c};")
+            else:
+                lineas.append(f"    h0 := h0 * 0.5 + {c}.{rng.randint(0, 99)};")
+        lineas.append(f"    f{f} := x + y;")
+        lineas.append("end;")
+    lineas.append("begin")
+    for f in range(nfun):
+        lineas.append(f"    g0 := f{f}(g0, {f});")
+    lineas.append("    writeln(g0);")
+    lineas.append("end.")
+    return "\n".join(lineas) + "\n"
+
+
+def generar_profundo(rng, nfun, profundidad):
+    # Expresiones anidadas: cadenas largas de operadores y paréntesis profundos
+    lineas = ["program Prof;", "var g : integer;", "    h : float;"]
+    for f in range(nfun):
+        lineas.append(f"function p{f}(a : integer; b : float) : integer;")
+        lineas.append("var x : integer;")
+        lineas.append("begin")
+        e = "a"
+        for _ in range(profundidad):
+            op = rng.choice(["+", "-", "*"])
+            e = f"({e} {op} {rng.choice(['a', 'x', str(rng.randint(1, 9))])})"
+        lineas.append(f"    x := {e};")
+        e = "b"
+        for _ in range(profundidad):
+            e = f"({e} * 0.5 + {rng.choice(['a', 'b', 'x'])})"
+        lineas.append(f"    h := {e};")
+        lineas.append(f"    if x > {rng.randint(1, 9)} then x := x - a;")
+        lineas.append("    p{0} := x;".format(f))
+        lineas.append("end;")
+    lineas.append("begin")
+    lineas.append("    g := p0(1, 2.0);")
+    lineas.append("    writeln(g);")
+    lineas.append("end.")
+    return "\n".join(lineas) + "\n"
+
+
+def generar_locales(rng, nfun, nlocales, nstm):
+    # Muchas funciones con muchas locales: lo que cuesta es entrar y salir de ámbitos
+    globales = [f"g{i}" for i in range(50)]
+    lineas = ["program Loc;", "var " + ", ".join(globales) + " : integer;"]
+    for f in range(nfun):
+        locales = [f"v{i}" for i in range(nlocales)]
+        lineas.append(f"function l{f}(a : integer; b : integer) : integer;")
+        lineas.append("var " + ", ".join(locales) + " : integer;")
+        lineas.append("begin")
+        for _ in range(nstm):
+            x, y = rng.choice(locales), rng.choice(locales + ["a", "b"])
+            lineas.append(f"    {x} := {y} + {rng.choice(globales)};")
+        lineas.append(f"    l{f} := {rng.choice(locales)};")
+        lineas.append("end;")
+    lineas.append("begin")
+    lineas.append("    g0 := l0(1, 2);")
+    lineas.append("    writeln(g0);")
+    lineas.append("end.")
+    return "\n".join(lineas) + "\n"
+
+
+def generar_floats(nfun, nconst):
+    # nconst literales float distintos repartidos en nfun funciones
+    lineas = ["program Flt;", "var h : float;"]
+    por_funcion = max(1, nconst // nfun)
+    k = 0
+    for f in range(nfun):
+        lineas.append(f"function c{f}(a : float) : float;")
+        lineas.append("begin")
+        for _ in range(por_funcion):
+            lineas.append(f"    a := a * 0.5 + {k // 100}.{k % 100:02d}25;")
+            k += 1
+        lineas.append(f"    c{f} := a;")
+        lineas.append("end;")
+    lineas.append("begin")
+    lineas.append("    h := c0(1.0);")
+    lineas.append("    writeln(h);")
+    lineas.append("end.")
+    return "\n".join(lineas) + "\n"
+
+
+def generar_bucles(n, con_for):
+    # Dos bucles anidados de n x n vueltas, con for o con while + contador
+    lineas = ["program Buc;", "var s : long;",
+              "function suma(n : integer) : long;", "var i, j : integer;", "    t : long;", "begin",
+              "    t := 0;"]
+    if con_for:
+        lineas += ["    for i := 1 to n do",
+                   "        for j := 1 to n do",
+                   "            t := t + i * j;"]
+    else:
+        lineas += ["    i := 1;",
+                   "    while i <= n do",
+                   "    begin",
+                   "        j := 1;",
+                   "        while j <= n do",
+                   "        begin",
+                   "            t := t + i * j;",
+                   "            j := j + 1;",
+                   "        end;",
+                   "        i := i + 1;",
+                   "    end;"]
+    lineas += ["    suma := t;", "end;", "begin", f"    s := suma({n});", "    writeln(s);", "end."]
+    return "\n".join(lineas) + "\n"
+
+
+def generar_arreglos(n, constantes):
+    # Suma de un arreglo de 4096 y producto de matrices 64 x 64 (en arreglos de
+    # una dimensión), n veces. Con límites constantes el análisis de rangos
+    # elimina todas las verificaciones de índice; con el límite 'm' (parámetro)
+    # quedan todas.
+    tope = "4095" if constantes else "m * 64 - 1"
+    lado = "63" if constantes else "m - 1"
+    return "\n".join([
+        "program Arr;",
+        "var r : long;",
+        "function suma(m : integer; n : integer) : long;",
+        "var v : array[0..4095] of long;",
+        "    k, rep : integer;",
+        "    t : long;",
+        "begin",
+        f"    for k := 0 to {tope} do",
+        "        v[k] := k;",
+        "    t := 0;",
+        "    for rep := 1 to n do",
+        f"        for k := 0 to {tope} do",
+        "            t := t + v[k];",
+        "    suma := t;",
+        "end;",
+        "function matmul(m : integer; n : integer) : long;",
+        "var a, b, c : array[0..4095] of integer;",
+        "    i, j, k, s, rep : integer;",
+        "    t : long;",
+        "begin",
+        f"    for i := 0 to {lado} do",
+        f"        for j := 0 to {lado} do",
+        "        begin",
+        "            a[i * 64 + j] := i + j;",
+        "            b[i * 64 + j] := i - j;",
+        "        end;",
+        "    t := 0;",
+        "    for rep := 1 to n do",
+        "    begin",
+        f"        for i := 0 to {lado} do",
+        f"            for j := 0 to {lado} do",
+        "            begin",
+        "                s := 0;",
+        f"                for k := 0 to {lado} do",
+        "                    s := s + a[i * 64 + k] * b[k * 64 + j];",
+        "                c[i * 64 + j] := s;",
+        "            end;",
+        "        t := t + c[4095];",
+        "    end;",
+        "    matmul := t;",
+        "end;",
+        "begin",
+        f"    r := suma(64, {n} * 20);",
+        "    writeln(r);",
+        f"    r := matmul(64, {n});",
+        "    writeln(r);",
+        "end.",
+    ]) + "\n"
+
+
+def generar_vectorial(rng):
+    # Programa aleatorio con bucles for vectorizables (y algunos que no lo
+    # son): elemento a elemento, sumas y mínimos/máximos sobre arreglos
+    # integer y float con desplazamientos y límites variados. Imprime las
+    # reducciones y una suma de control de cada arreglo. En la mitad de los
+    # programas un arreglo float tiene NaN (0/0) en algunas posiciones: el
+    # mínimo/máximo vectorial debe ignorarlos igual que la comparación escalar.
+    # En otra mitad se busca el mínimo y el máximo de -0.0 y +0.0 mezclados:
+    # el if escalar se queda con el primer cero y se imprime con su signo.
+    lo = {t: rng.randint(-5, 5) for t in ("ia", "ib", "ic", "fa", "fb", "fc")}
+    tam = 160
+    lineas = ["program Vec;", "var gi : array[0..199] of integer;", "    gf : array[0..199] of float;"]
+    lineas.append("function f(n : integer; k : integer; q : float) : integer;")
+    for t in lo:
+        tipo = "integer" if t[0] == "i" else "float"
+        lineas.append(f"var {t} : array[{lo[t]}..{lo[t] + tam - 1}] of {tipo};")
+    lineas += ["    i, s, mi, ma : integer;", "    x, y, z, w : float;", "begin"]
+    for t in lo:
+        valor = f"(i * {rng.randint(3, 37)}) mod {rng.randint(17, 101)} - {rng.randint(0, 30)}"
+        if t[0] == "f":
+            valor += f" + {rng.randint(0, 9)}.25"
+        lineas += [f"    for i := {lo[t]} to {lo[t] + tam - 1} do", f"        {t}[i] := {valor};"]
+    lineas += ["    for i := 0 to 199 do", "    begin", "        gi[i] := i mod 13;", "        gf[i] := i * 0.125;", "    end;"]
+    if rng.random() < 0.5:
+        t = rng.choice(["fa", "fb", "gf"])
+        desde = 0 if t == "gf" else lo[t]
+        hasta = 199 if t == "gf" else lo[t] + tam - 1
+        lineas += ["    z := 0;", f"    for i := {desde} to {hasta} do",
+                   f"        if i mod {rng.randint(5, 40)} = {rng.randint(0, 4)} then {t}[i] := z / z;"]
+    lineas += ["    s := 0;", "    mi := 1000000;", "    ma := 0 - 1000000;", "    x := 1000000;", "    y := 0 - 1000000;"]
+
+    def expr(tipo, c, prof):
+        arr = ["ia", "ib", "ic", "gi"] if tipo == "i" else ["fa", "fb", "fc", "gf"]
+        r = rng.random()
+        if prof == 0 or r < 0.3:
+            a = rng.choice(arr)
+            return f"{a}[i + {c + rng.randint(0, 3)}]"
+        if r < 0.4:
+            return rng.choice(["k", "n", "7"] if tipo == "i" else ["q", "0.5", "x"])
+        ops = ["+", "-", "*"] + (["/"] if tipo == "f" else [])
+        return f"({expr(tipo, c, prof - 1)} {rng.choice(ops)} {expr(tipo, c, prof - 1)})"
+
+    for _ in range(rng.randint(3, 6)):
+        desde = max(lo.values()) + rng.randint(0, 5)
+        hasta = min(lo.values()) + tam - 5 - rng.randint(0, 40)
+        fin = rng.choice([str(hasta), f"n + {hasta - 100}"])
+        lineas += [f"    for i := {desde} to {fin} do", "    begin"]
+        for _ in range(rng.randint(1, 3)):
+            tipo = rng.choice("if")
+            k = rng.randint(0, 4)
+            e = expr(tipo, 0, rng.randint(0, 3))
+            if k == 0 and tipo == "i":
+                lineas.append(f"        s := s + {e} + {expr(tipo, 0, 1)};")
+            elif k == 1:
+                v = "mi" if tipo == "i" else "x"
+                lineas.append(f"        if {e} < {v} then {v} := {e};")
+            elif k == 2:
+                v = "ma" if tipo == "i" else "y"
+                lineas.append(f"        if {v} < {e} then {v} := {e};")
+            else:
+                # el destino no se lee con otro desplazamiento (si no, no se vectoriza)
+                lineas.append(f"        {rng.choice(['ic', 'gi'] if tipo == 'i' else ['fc', 'gf'])}[i] := {e};")
+        lineas.append("    end;")
+
+    lineas += ["    writeln(s);", "    writeln(mi);", "    writeln(ma);", "    writeln(x);", "    writeln(y);"]
+    if rng.random() < 0.5:
+        desde = rng.randint(0, 2)
+        lineas += ["    z := 0;", "    for i := 0 to 199 do", f"        gf[i] := (i mod 3 - 1) * z;",
+                   "    w := 5;", f"    for i := {desde} to 199 do", "        if gf[i] < w then w := gf[i];",
+                   "    writeln(w);",
+                   "    w := 0 - 5;", f"    for i := {desde} to 199 do", "        if gf[i] > w then w := gf[i];",
+                   "    writeln(w);"]
+    lineas += ["    s := 0;", f"    for i := {lo['ic']} to {lo['ic'] + tam - 1} do", "        s := s + ic[i];", "    writeln(s);"]
+    lineas += ["    x := 0;", f"    for i := {lo['fc']} to {lo['fc'] + tam - 1} do", "        x := x + fc[i];", "    writeln(x);"]
+    lineas += ["    f := s;", "end;", "begin", "    writeln(f(100, 3, 1.5));", "end."]
+    return "\n".join(lineas) + "\n"
+
+
+def generar_nucleos(n):
+    # Núcleos vectorizables de 4096 elementos, n repeticiones cada uno
+    return "\n".join([
+        "program Nuc;",
+        "var x, y : array[0..4095] of float;",
+        "    v : array[0..4095] of integer;",
+        "    i, rep, s, m : integer;",
+        "begin",
+        "    for i := 0 to 4095 do",
+        "    begin",
+        "        x[i] := i * 0.25;",
+        "        y[i] := 1;",
+        "        v[i] := (i * 7) mod 1000;",
+        "    end;",
+        "    s := 0;",
+        "    m := 0;",
+        f"    for rep := 1 to {n} do",
+        "    begin",
+        "        for i := 0 to 4095 do",
+        "            y[i] := 0.5 * x[i] + y[i] * 0.75;",
+        "        for i := 0 to 4095 do",
+        "            s := s + v[i];",
+        "        for i := 0 to 4095 do",
+        "            if v[i] * rep > m then m := v[i] * rep;",
+        "    end;",
+        "    writeln(s);",
+        "    writeln(m);",
+        "    writeln(y[4095]);",
+        "end.",
+    ]) + "\n"
+
+
+def generar_desenrollado(n):
+    # El while de input18 (global, condición 'a - n') y una suma en una
+    # función (local, condición 'i < n'), de n vueltas cada uno
+    return "\n".join([
+        "program Des;",
+        "var a : integer;",
+        "    s : long;",
+        "function cuenta(n : integer) : long;",
+        "var i : integer;",
+        "    t : long;",
+        "begin",
+        "    t := 0;",
+        "    i := 0;",
+        "    while i < n do",
+        "    begin",
+        "        t := t + i;",
+        "        i := i + 1;",
+        "    end;",
+        "    cuenta := t;",
+        "end;",
+        "begin",
+        "    a := 0;",
+        f"    while (a - {n}) do",
+        "    begin",
+        "        a := a + 1;",
+        "    end;",
+        "    writeln(a);",
+        f"    s := cuenta({n});",
+        "    writeln(s);",
+        "end.",
+    ]) + "\n"
+
+
+def generar_escritura(n):
+    # n int y n long (estos, también negativos) y n/10 float con writeln
+    return "\n".join([
+        "program Esc;",
+        "var i : integer;",
+        "    l : long;",
+        "    x : float;",
+        "begin",
+        f"    for i := 1 to {n} do",
+        "    begin",
+        "        writeln(i * 7);",
+        "        l := i;",
+        "        writeln(l * 1000003 - 5000000000);",
+        "    end;",
+        "    x := 0.25;",
+        f"    for i := 1 to {n // 10} do",
+        "    begin",
+        "        writeln(x);",
+        "        x := x * 1.0001 + 0.5;",
+        "    end;",
+        "end.",
+    ]) + "\n"
+
+
+def generar_lectura(n):
+    # Programa que lee una cuenta y luego líneas "int long float"; escribe las sumas
+    return "\n".join([
+        "program Lee;",
+        "var n, i, a : integer;",
+        "    b, s, t : long;",
+        "    x, y : float;",
+        "begin",
+        "    readln(n);",
+        "    s := 0;",
+        "    t := 0;",
+        "    y := 0.0;",
+        "    for i := 1 to n do",
+        "    begin",
+        "        readln(a, b, x);",
+        "        s := s + a;",
+        "        t := t + b;",
+        "        y := y + x;",
+        "    end;",
+        "    writeln(s);",
+        "    writeln(t);",
+        "    writeln(y);",
+        "end.",
+    ]) + "\n"
+
+
+def generar_referencias(n, con_var):
+    # Suma y cantidad de dígitos de cada i en 1..n. Sin parámetros var hacen
+    # falta dos funciones que recorren los mismos dígitos; con var, un solo
+    # procedimiento.
+    if con_var:
+        funciones = [
+            "procedure digitos(n : integer; var suma, cantidad : integer);",
+            "begin",
+            "    suma := 0;",
+            "    cantidad := 0;",
+            "    while n > 0 do",
+            "    begin",
+            "        suma := suma + n mod 10;",
+            "        cantidad := cantidad + 1;",
+            "        n := n div 10;",
+            "    end;",
+            "end;",
+        ]
+        llamada = ["        digitos(i, s, c);"]
+    else:
+        funciones = []
+        for nombre, paso in [("sumaDigitos", "s := s + n mod 10;"), ("cantidadDigitos", "s := s + 1;")]:
+            funciones += [
+                f"function {nombre}(n : integer) : integer;",
+                "var s : integer;",
+                "begin",
+                "    s := 0;",
+                "    while n > 0 do",
+                "    begin",
+                f"        {paso}",
+                "        n := n div 10;",
+                "    end;",
+                f"    {nombre} := s;",
+                "end;",
+            ]
+        llamada = ["        s := sumaDigitos(i);", "        c := cantidadDigitos(i);"]
+    return "\n".join([
+        "program Ref;",
+        "var i, s, c : integer;",
+        "    ts, tc : longint;",
+    ] + funciones + [
+        "begin",
+        "    ts := 0;",
+        "    tc := 0;",
+        f"    for i := 1 to {n} do",
+        "    begin",
+    ] + llamada + [
+        "        ts := ts + s;",
+        "        tc := tc + c;",
+        "    end;",
+        "    writeln(ts);",
+        "    writeln(tc);",
+        "end.",
+    ]) + "\n"
+
+
+def generar_dobles(n, tipo):
+    # pi por la regla del punto medio sobre 4 / (1 + x^2) en [0, 1], con
+    # n pasos, en float o en double
+    return "\n".join([
+        "program Pi;",
+        "var i : integer;",
+        f"    h, x, s : {tipo};",
+        "begin",
+        f"    h := 1.0 / {n};",
+        "    s := 0;",
+        f"    for i := 1 to {n} do",
+        "    begin",
+        "        x := (i - 0.5) * h;",
+        "        s := s + 4.0 / (1.0 + x * x);",
+        "    end;",
+        "    writeln(s * h);",
+        "end.",
+    ]) + "\n"
+
+
+LECTURA_C = r"""#include <stdio.h>
+int main(void) {
+    int n, a; long b, s = 0, t = 0; float x, y = 0.0f;
+    if (scanf("%d", &n) != 1) n = 0;
+    for (int i = 1; i <= n; i++) {
+        if (scanf("%d %ld %f", &a, &b, &x) != 3) a = 0, b = 0, x = 0.0f;
+        s += a; t += b; y += x;
+    }
+    printf("%ld \n%ld \n%f \n", s, t, y);
+    return 0;
+}
+"""
+
+
+def mhz_cpu():
+    # Frecuencia nominal según /proc/cpuinfo (None si no se conoce)
+    try:
+        with open("/proc/cpuinfo") as fh:
+            for linea in fh:
+                if linea.startswith("cpu MHz"):
+                    return float(linea.split(":")[1])
+    except OSError:
+        pass
+    return None
+
+
+def ejecutar(binario, repeticiones):
+    # Mejor tiempo de ejecución y salida; main no fija el código de salida
+    mejor, salida = None, None
+    for _ in range(repeticiones):
+        t0 = time.perf_counter()
+        salida = subprocess.run([binario], capture_output=True, text=True).stdout
+        t = time.perf_counter() - t0
+        mejor = t if mejor is None else min(mejor, t)
+    return mejor, salida
+
+
+def generar_corpus(directorio, n, nfun=20, nstm=20, semilla=1):
+    rng = random.Random(semilla)
+    rutas = []
+    for i in range(n):
+        ruta = os.path.join(directorio, f"gen{i}.txt")
+        with open(ruta, "w") as fh:
+            fh.write(generar_programa(rng, nfun, nstm))
+        rutas.append(ruta)
+    return rutas
+
+
+def fases(exe, args):
+    # Ejecuta con --tiempos y devuelve {fase: ms} del primer archivo
+    r = subprocess.run([exe, "-q", "--tiempos"] + args, capture_output=True, text=True)
+    for linea in r.stdout.splitlines():
+        if ": parse " in linea:
+            partes = linea.split(": ", 1)[1].split(", ")
+            return {p.split(" ")[0]: float(p.split(" ")[1]) for p in partes}
+    return {}
+
+
+def cronometrar(cmds):
+    t0 = time.perf_counter()
+    for cmd in cmds:
+        r = subprocess.run(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+        if r.returncode != 0:
+            print("Fallo:", " ".join(cmd[:4]), "...")
+    return time.perf_counter() - t0
+
+
+def bench_batch(n):
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "pc")
+        compilar_compilador(exe)
+        rutas = copiar_inputs(tmp, n)
+
+        t_proc = cronometrar([[exe, r] for r in rutas])
+        t_batch = cronometrar([[exe, "-q"] + rutas])
+
+        print(f"\n{n} archivos")
+        print(f"  un proceso por archivo: {t_proc:8.3f} s")
+        print(f"  un solo proceso:        {t_batch:8.3f} s")
+        print(f"  aceleración:            {t_proc / t_batch:8.2f}x")
+
+
+def bench_jobs(n):
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "pc")
+        compilar_compilador(exe)
+        generar_corpus(tmp, n)
+        lista = os.path.join(tmp, "lista.txt")
+        with open(lista, "w") as fh:
+            fh.write("\n".join(os.path.join(tmp, f"gen{i}.txt") for i in range(n)))
+
+        nucleos = os.cpu_count() or 1
+        hilos = sorted({1, 2, 4, 8, 16, nucleos})
+        base = None
+        print(f"\n{n} programas generados, {nucleos} núcleos")
+        for j in hilos:
+            if j > max(nucleos, 4):
+                continue
+            t = cronometrar([[exe, "-q", "-j", str(j), "@" + lista]])
+            base = base or t
+            print(f"  -j {j:<3} {t:8.3f} s   aceleración {base / t:5.2f}x")
+
+
+def bench_funcs(n):
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "pc")
+        compilar_compilador(exe)
+        ruta = os.path.join(tmp, "grande.txt")
+        with open(ruta, "w") as fh:
+            fh.write(generar_programa(random.Random(1), n, 20))
+
+        nucleos = os.cpu_count() or 1
+        base = None
+        referencia = None
+        print(f"\n1 programa de {n} funciones, {nucleos} núcleos")
+        for j in sorted({1, 2, 4, 8, 16, nucleos}):
+            if j > max(nucleos, 4):
+                continue
+            t = cronometrar([[exe, "-q", "-j", str(j), ruta]])
+            with open(os.path.join(tmp, "grande.s")) as fh:
+                asm = fh.read()
+            referencia = referencia or asm
+            igual = "idéntico" if asm == referencia else "DIFERENTE"
+            base = base or t
+            f = fases(exe, ["-j", str(j), ruta])
+            print(f"  -j {j:<3} {t:8.3f} s   aceleración {base / t:5.2f}x   ({igual})"
+                  f"   tipos {f.get('tipos', 0):7.1f} ms   codegen {f.get('codegen', 0):7.1f} ms")
+
+
+def bench_cache(n):
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "pc")
+        compilar_compilador(exe)
+        ruta = os.path.join(tmp, "grande.txt")
+        fuente = generar_programa(random.Random(1), n, 20)
+        with open(ruta, "w") as fh:
+            fh.write(fuente)
+        cache = os.path.join(tmp, "cache")
+
+        t_sin = cronometrar([[exe, "-q", "-j", "1", ruta]])
+        t_frio = cronometrar([[exe, "-q", "-j", "1", "--cache", cache, ruta]])
+
+        # Editar una sola función (la del medio) y recompilar
+        i = fuente.index(f"function f{n // 2}(")
+        j = fuente.index("    x := a; y := b;", i) + len("    x := a; y := b;")
+        with open(ruta, "w") as fh:
+            fh.write(fuente[:j] + " x := x + 1;" + fuente[j:])
+        t_edit = cronometrar([[exe, "-q", "-j", "1", "--cache", cache, ruta]])
+        f_edit = fases(exe, ["-j", "1", "--cache", cache, ruta])
+
+        print(f"\n1 programa de {n} funciones, una función editada")
+        print(f"  sin caché:           {t_sin:8.3f} s")
+        print(f"  caché fría:          {t_frio:8.3f} s")
+        print(f"  tras editar (caché): {t_edit:8.3f} s   "
+              f"(tipos {f_edit.get('tipos', 0):.1f} ms, opt {f_edit.get('opt', 0):.1f} ms, "
+              f"codegen {f_edit.get('codegen', 0):.1f} ms)")
+
+
+def peticion(sock, ruta):
+    sock.sendall(f"COMPILAR sse2/u4 {ruta}\n".encode())
+    cab = b""
+    while not cab.endswith(b"\n"):
+        cab += sock.recv(1)
+    n = int(cab.split()[1])
+    datos = b""
+    while len(datos) < n:
+        datos += sock.recv(n - len(datos))
+    return cab.startswith(b"OK")
+
+
+def bench_servidor(n):
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "pc")
+        compilar_compilador(exe)
+        rutas = [os.path.abspath(r) for r in copiar_inputs(tmp, 18)]
+        sock_path = os.path.join(tmp, "pc.sock")
+        servidor = subprocess.Popen([exe, "--servidor", sock_path], stdout=subprocess.DEVNULL)
+        while not os.path.exists(sock_path):
+            time.sleep(0.01)
+
+        pedidos = [rutas[i % len(rutas)] for i in range(n)]
+        t_frio = cronometrar([[exe, "-q", r] for r in pedidos])
+        t_cli = cronometrar([[exe, "--cliente", sock_path, "-q", r] for r in pedidos])
+
+        s = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        s.connect(sock_path)
+        t0 = time.perf_counter()
+        for r in pedidos:
+            peticion(s, r)
+        t_sock = time.perf_counter() - t0
+        s.close()
+
+        subprocess.run([exe, "--detener", sock_path], stdout=subprocess.DEVNULL)
+        servidor.wait()
+
+        print(f"\n{n} peticiones (latencia media)")
+        print(f"  proceso en frío:         {t_frio / n * 1000:8.3f} ms")
+        print(f"  cliente + servidor:      {t_cli / n * 1000:8.3f} ms")
+        print(f"  socket directo:          {t_sock / n * 1000:8.3f} ms")
+
+
+def memoria_pico(cmd):
+    # Ejecuta cmd en un proceso hijo y devuelve (segundos, KB de RSS máximo)
+    codigo = ("import resource, subprocess, sys, time\n"
+              "t = time.perf_counter()\n"
+              "subprocess.run(sys.argv[1:], stdout=subprocess.DEVNULL)\n"
+              "t = time.perf_counter() - t\n"
+              "print(t, resource.getrusage(resource.RUSAGE_CHILDREN).ru_maxrss)\n")
+    r = subprocess.run([sys.executable, "-c", codigo] + cmd, capture_output=True, text=True)
+    t, kb = r.stdout.split()
+    return float(t), int(kb)
+
+
+def bench_streaming(n):
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "pc")
+        compilar_compilador(exe)
+        ruta = os.path.join(tmp, "grande.txt")
+        with open(ruta, "w") as fh:
+            fh.write(generar_programa(random.Random(1), n, 20))
+        tam = os.path.getsize(ruta) / 1e6
+
+        t_norm, m_norm = memoria_pico([exe, "-q", "-j", "1", ruta])
+        with open(os.path.join(tmp, "grande.s")) as fh:
+            referencia = fh.read()
+        t_str, m_str = memoria_pico([exe, "-q", "--streaming", ruta])
+        with open(os.path.join(tmp, "grande.s")) as fh:
+            igual = "idéntico" if fh.read() == referencia else "DIFERENTE"
+
+        print(f"\n1 programa de {n} funciones ({tam:.1f} MB)")
+        print(f"  normal:      {t_norm:8.3f} s   RSS pico {m_norm / 1024:8.1f} MB")
+        print(f"  streaming:   {t_str:8.3f} s   RSS pico {m_str / 1024:8.1f} MB   ({igual})")
+
+
+def bench_tuberia(n, repeticiones=5):
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "pc")
+        compilar_compilador(exe)
+        ruta = os.path.join(tmp, "grande.txt")
+        with open(ruta, "w") as fh:
+            fh.write(generar_programa(random.Random(1), n, 20))
+        tam = os.path.getsize(ruta) / 1e6
+
+        print(f"\n1 programa de {n} funciones ({tam:.1f} MB), {os.cpu_count()} núcleos")
+        if (os.cpu_count() or 1) < 2:
+            print("  (un solo núcleo: --scanner-hilo usa el camino secuencial)")
+        referencia = None
+        for nombre, extra in [("en línea", []), ("--scanner-hilo", ["--scanner-hilo"])]:
+            # El mejor de varios intentos: el parseo es corto y ruidoso
+            t = min(fases(exe, ["-j", "1"] + extra + [ruta]).get("parse", 0)
+                    for _ in range(repeticiones))
+            with open(os.path.join(tmp, "grande.s")) as fh:
+                asm = fh.read()
+            referencia = referencia or asm
+            igual = "idéntico" if asm == referencia else "DIFERENTE"
+            print(f"  {nombre:<15} parse {t:8.1f} ms   {tam / (t / 1000):6.1f} MB/s   ({igual})")
+
+        # Caracteres inválidos: el parser se recupera y los dos caminos deben
+        # terminar con los mismos diagnósticos
+        with open(ruta) as fh:
+            lineas = fh.read().split("\n")
+        for k in (len(lineas) // 3, 2 * len(lineas) // 3):
+            lineas[k] += " # @"
+        with open(ruta, "w") as fh:
+            fh.write("\n".join(lineas))
+        diagnosticos = {}
+        for nombre, extra in [("en línea", []), ("--scanner-hilo", ["--scanner-hilo"])]:
+            try:
+                r = subprocess.run([exe, "-q", "-j", "1"] + extra + [ruta],
+                                   capture_output=True, text=True, timeout=60)
+                diagnosticos[nombre] = r.stderr
+            except subprocess.TimeoutExpired:
+                diagnosticos[nombre] = None
+        if diagnosticos["--scanner-hilo"] is None:
+            print("  con caracteres inválidos: --scanner-hilo NO TERMINA")
+        else:
+            igual = "idénticos" if diagnosticos["en línea"] == diagnosticos["--scanner-hilo"] else "DIFERENTES"
+            print(f"  con caracteres inválidos: {diagnosticos['en línea'].count('error:')} errores ({igual})")
+
+
+def bench_lexer(n):
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "pc")
+        compilar_compilador(exe)
+        ruta = os.path.join(tmp, "grande.txt")
+        with open(ruta, "w") as fh:
+            fh.write(generar_programa(random.Random(1), n, 20, comentarios=True))
+        tam = os.path.getsize(ruta) / 1e6
+
+        cronometrar([[exe, "-q", "-j", "1", ruta]])
+        with open(os.path.join(tmp, "grande.s")) as fh:
+            referencia = fh.read()
+
+        nucleos = os.cpu_count() or 1
+        base = None
+        print(f"\n1 programa de {n} funciones ({tam:.1f} MB), {nucleos} núcleos")
+        for j in sorted({1, 2, 4, 8, 16, nucleos}):
+            if j > max(nucleos, 4):
+                continue
+            t = min(fases(exe, ["-j", str(j), "--lexer-paralelo", ruta]).get("lexer", 0)
+                    for _ in range(3))
+            with open(os.path.join(tmp, "grande.s")) as fh:
+                igual = "idéntico" if fh.read() == referencia else "DIFERENTE"
+            base = base or t
+            print(f"  -j {j:<3} lexer {t:8.1f} ms   {tam / (t / 1000):7.1f} MB/s"
+                  f"   aceleración {base / t:5.2f}x   ({igual})")
+
+
+def bench_ast(n, repeticiones=3):
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "pc")
+        compilar_compilador(exe)
+        ruta = os.path.join(tmp, "grande.txt")
+        with open(ruta, "w") as fh:
+            fh.write(generar_programa(random.Random(1), n, 20))
+        ruta_ast = os.path.join(tmp, "grande.ast")
+        cronometrar([[exe, "-q", "-j", "1", "--emitir-ast", ruta]])
+        with open(os.path.join(tmp, "grande.s")) as fh:
+            referencia = fh.read()
+
+        # Fuente: scanner + parser + tipos; .ast: solo la carga
+        t_fuente = min(sum(fases(exe, ["-j", "1", ruta]).get(f, 0) for f in ("parse", "tipos"))
+                       for _ in range(repeticiones))
+        t_ast = min(fases(exe, ["-j", "1", ruta_ast]).get("parse", 0)
+                    for _ in range(repeticiones))
+        with open(os.path.join(tmp, "grande.s")) as fh:
+            igual = "idéntico" if fh.read() == referencia else "DIFERENTE"
+
+        print(f"\n1 programa de {n} funciones")
+        print(f"  fuente  {os.path.getsize(ruta) / 1e6:6.1f} MB   parse + tipos {t_fuente:8.1f} ms")
+        print(f"  .ast    {os.path.getsize(ruta_ast) / 1e6:6.1f} MB   carga         {t_ast:8.1f} ms"
+              f"   {t_fuente / t_ast:5.2f}x más rápido   ({igual})")
+
+
+def bench_compartir(n, repeticiones=3):
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "pc")
+        compilar_compilador(exe)
+        ruta = os.path.join(tmp, "grande.txt")
+        with open(ruta, "w") as fh:
+            fh.write(generar_programa(random.Random(1), n, 40))
+        tam = os.path.getsize(ruta) / 1e6
+
+        r = subprocess.run([exe, "-j", "1", "--compartir-exp", ruta], capture_output=True, text=True)
+        nodos = next((l for l in r.stdout.splitlines() if l.startswith("Expresiones compartidas")), "")
+        print(f"\n1 programa de {n} funciones ({tam:.1f} MB)")
+        print(f"  {nodos}")
+
+        referencia = None
+        for nombre, extra in [("normal", []), ("--compartir-exp", ["--compartir-exp"])]:
+            t, kb = min(memoria_pico([exe, "-q", "-j", "1"] + extra + [ruta]) for _ in range(repeticiones))
+            f = fases(exe, ["-j", "1"] + extra + [ruta])
+            with open(os.path.join(tmp, "grande.s")) as fh:
+                asm = fh.read()
+            referencia = referencia or asm
+            igual = "idéntico" if asm == referencia else "DIFERENTE"
+            print(f"  {nombre:<16} {t:7.3f} s   RSS pico {kb / 1024:7.1f} MB   parse {f.get('parse', 0):7.1f} ms"
+                  f"   tipos {f.get('tipos', 0):6.1f} ms   ({igual})")
+
+
+def bench_profundas(n, referencia=None, repeticiones=5):
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "pc")
+        compilar_compilador(exe)
+        ruta = os.path.join(tmp, "profundo.txt")
+        with open(ruta, "w") as fh:
+            fh.write(generar_profundo(random.Random(1), n, 60))
+        tam = os.path.getsize(ruta) / 1e6
+
+        print(f"\n1 programa de {n} funciones con expresiones de profundidad 60 ({tam:.1f} MB)")
+        salida = None
+        for nombre, e in [("referencia", referencia), ("actual", exe)]:
+            if not e:
+                continue
+            mejores = {}
+            for _ in range(repeticiones):
+                for k, v in fases(e, ["-j", "1", ruta]).items():
+                    mejores[k] = min(v, mejores.get(k, v))
+            with open(os.path.join(tmp, "profundo.s")) as fh:
+                asm = fh.read()
+            salida = salida or asm
+            igual = "idéntico" if asm == salida else "DIFERENTE"
+            total = sum(mejores.get(k, 0) for k in ("parse", "tipos", "opt", "codegen"))
+            print(f"  {nombre:<11} parse {mejores.get('parse', 0):7.1f}  tipos {mejores.get('tipos', 0):6.1f}"
+                  f"  opt {mejores.get('opt', 0):6.1f}  codegen {mejores.get('codegen', 0):7.1f}"
+                  f"  total {total:7.1f} ms   ({igual})")
+
+
+def bench_simbolos(n, referencia=None, repeticiones=5):
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "pc")
+        compilar_compilador(exe)
+        ruta = os.path.join(tmp, "locales.txt")
+        with open(ruta, "w") as fh:
+            fh.write(generar_locales(random.Random(1), n, 40, 20))
+        tam = os.path.getsize(ruta) / 1e6
+
+        print(f"\n1 programa de {n} funciones con 40 locales y 50 globales ({tam:.1f} MB)")
+        for nombre, e in [("referencia", referencia), ("actual", exe)]:
+            if not e:
+                continue
+            mejores = {}
+            for _ in range(repeticiones):
+                for k, v in fases(e, ["-j", "1", ruta]).items():
+                    mejores[k] = min(v, mejores.get(k, v))
+            print(f"  {nombre:<11} tipos {mejores.get('tipos', 0):6.1f} ms"
+                  f"  codegen {mejores.get('codegen', 0):7.1f} ms")
+
+
+def bench_floats(n, referencia=None, repeticiones=5):
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "pc")
+        compilar_compilador(exe)
+        ruta = os.path.join(tmp, "floats.txt")
+        with open(ruta, "w") as fh:
+            fh.write(generar_floats(max(1, n // 50), n))
+
+        print(f"\n1 programa con {n} constantes float distintas")
+        for nombre, e in [("referencia", referencia), ("actual", exe)]:
+            if not e:
+                continue
+            mejor = None
+            for _ in range(repeticiones):
+                t = fases(e, ["-j", "1", ruta]).get("codegen", 0)
+                mejor = t if mejor is None else min(mejor, t)
+            print(f"  {nombre:<11} codegen {mejor:8.1f} ms")
+
+
+def bench_bucles(n, repeticiones=5):
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "pc")
+        compilar_compilador(exe)
+
+        print(f"\nBucles anidados {n} x {n}")
+        salidas = {}
+        for nombre, con_for in [("while", False), ("for", True)]:
+            fuente = os.path.join(tmp, f"{nombre}.txt")
+            binario = os.path.join(tmp, nombre)
+            with open(fuente, "w") as fh:
+                fh.write(generar_bucles(n, con_for))
+            subprocess.run([exe, "-q", fuente], stdout=subprocess.DEVNULL, check=True)
+            subprocess.run(["gcc", "-no-pie", "-o", binario, os.path.join(tmp, f"{nombre}.s")], check=True)
+            t, salidas[nombre] = ejecutar(binario, repeticiones)
+            print(f"  {nombre:<6} {t:7.3f} s")
+        print("  salida", "idéntica" if salidas["for"] == salidas["while"] else "DIFERENTE")
+
+
+def bench_vector(n, repeticiones=5):
+    modos = ["no", "sse2", "avx2"]
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "pc")
+        compilar_compilador(exe)
+
+        def construir(fuente, modo):
+            binario = os.path.join(tmp, f"{os.path.basename(fuente)}.{modo}")
+            subprocess.run([exe, "-q", "--simd", modo, fuente], stdout=subprocess.DEVNULL, check=True)
+            ensamblador = fuente[:-4] + ".s"
+            with open(ensamblador) as fh:
+                vectorizados = fh.read().count("\nvfor_")
+            subprocess.run(["gcc", "-no-pie", "-o", binario, ensamblador], check=True)
+            return binario, vectorizados
+
+        # Validación: la salida vectorizada debe ser idéntica a la escalar
+        rng = random.Random(43)
+        distintos, bucles = 0, {m: 0 for m in modos}
+        for k in range(n):
+            fuente = os.path.join(tmp, f"p{k}.txt")
+            with open(fuente, "w") as fh:
+                fh.write(generar_vectorial(rng))
+            salidas = {}
+            for modo in modos:
+                binario, vect = construir(fuente, modo)
+                bucles[modo] += vect
+                r = subprocess.run([binario], capture_output=True, text=True)
+                salidas[modo] = r.stdout + r.stderr
+            if len(set(salidas.values())) != 1:
+                distintos += 1
+                print(f"  p{k}: salida DIFERENTE")
+        print(f"\n{n} programas aleatorios: {distintos} con salida distinta a la escalar")
+        print("  bucles vectorizados:", ", ".join(f"{m} {bucles[m]}" for m in modos))
+
+        # Tiempo: axpy float, suma entera y máximo entero sobre 4096 elementos
+        fuente = os.path.join(tmp, "nucleos.txt")
+        with open(fuente, "w") as fh:
+            fh.write(generar_nucleos(20000))
+        print("\nNúcleos de 4096 elementos x 20000")
+        salidas = {}
+        for modo in modos:
+            binario, _ = construir(fuente, modo)
+            t, salidas[modo] = ejecutar(binario, repeticiones)
+            print(f"  {modo:<5} {t:7.3f} s")
+        print("  salida", "idéntica" if len(set(salidas.values())) == 1 else "DIFERENTE")
+
+
+def bench_arreglos(n, repeticiones=5):
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "pc")
+        compilar_compilador(exe)
+
+        print(f"\nSuma de 4096 elementos x {n * 20} y producto 64 x 64 x {n}")
+        salidas = {}
+        for nombre, constantes in [("variables", False), ("constantes", True)]:
+            fuente = os.path.join(tmp, f"{nombre}.txt")
+            binario = os.path.join(tmp, nombre)
+            with open(fuente, "w") as fh:
+                fh.write(generar_arreglos(n, constantes))
+            subprocess.run([exe, "-q", fuente], stdout=subprocess.DEVNULL, check=True)
+            ensamblador = os.path.join(tmp, f"{nombre}.s")
+            with open(ensamblador) as fh:
+                verificaciones = fh.read().count("ja .rango_")
+            subprocess.run(["gcc", "-no-pie", "-o", binario, ensamblador], check=True)
+            t, salidas[nombre] = ejecutar(binario, repeticiones)
+            print(f"  {nombre:<10} {t:7.3f} s   ({verificaciones} verificaciones de índice)")
+        print("  salida", "idéntica" if salidas["constantes"] == salidas["variables"] else "DIFERENTE")
+
+
+def bench_escritura(n, referencia=None, repeticiones=3):
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "pc")
+        compilar_compilador(exe)
+        fuente = os.path.join(tmp, "esc.txt")
+        with open(fuente, "w") as fh:
+            fh.write(generar_escritura(n))
+
+        total = 2 * n + n // 10
+        print(f"\n{total} números con writeln (salida a un archivo)")
+        salidas = {}
+        for nombre, e in [("referencia", referencia), ("actual", exe)]:
+            if not e:
+                continue
+            binario = os.path.join(tmp, nombre)
+            subprocess.run([e, "-q", fuente], stdout=subprocess.DEVNULL, check=True)
+            subprocess.run(["gcc", "-no-pie", "-o", binario, os.path.join(tmp, "esc.s")], check=True)
+            salida = os.path.join(tmp, nombre + ".out")
+            mejor = None
+            for _ in range(repeticiones):
+                with open(salida, "w") as fh:
+                    t0 = time.perf_counter()
+                    subprocess.run([binario], stdout=fh)
+                    t = time.perf_counter() - t0
+                mejor = t if mejor is None else min(mejor, t)
+            with open(salida, "rb") as fh:
+                salidas[nombre] = fh.read()
+            print(f"  {nombre:<11} {mejor:7.3f} s   {mejor * 1e9 / total:6.1f} ns/número"
+                  f"   {len(salidas[nombre]) / 1e6:6.1f} MB")
+        if len(salidas) == 2:
+            print("  salida", "idéntica" if len(set(salidas.values())) == 1 else "DIFERENTE")
+
+
+def bench_lectura(n, repeticiones=3):
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "pc")
+        compilar_compilador(exe)
+        fuente = os.path.join(tmp, "lee.txt")
+        with open(fuente, "w") as fh:
+            fh.write(generar_lectura(n))
+        subprocess.run([exe, "-q", fuente], stdout=subprocess.DEVNULL, check=True)
+        subprocess.run(["gcc", "-no-pie", "-o", os.path.join(tmp, "readln"), os.path.join(tmp, "lee.s")], check=True)
+        with open(os.path.join(tmp, "lee.c"), "w") as fh:
+            fh.write(LECTURA_C)
+        subprocess.run(["gcc", "-O2", "-o", os.path.join(tmp, "scanf"), os.path.join(tmp, "lee.c")], check=True)
+
+        rng = random.Random(1)
+        datos = os.path.join(tmp, "datos.txt")
+        with open(datos, "w") as fh:
+            fh.write(f"{n}\n")
+            for _ in range(n):
+                fh.write(f"{rng.randint(-10**6, 10**6)} {rng.randint(-10**12, 10**12)} "
+                         f"{rng.uniform(-1000, 1000):.3f}\n")
+        tam = os.path.getsize(datos)
+
+        print(f"\n{3 * n} números en {n} líneas ({tam / 1e6:.1f} MB por stdin)")
+        salidas = {}
+        for nombre in ["scanf", "readln"]:
+            mejor = None
+            for _ in range(repeticiones):
+                with open(datos, "rb") as fh:
+                    t0 = time.perf_counter()
+                    salidas[nombre] = subprocess.run([os.path.join(tmp, nombre)], stdin=fh,
+                                                     capture_output=True).stdout
+                    t = time.perf_counter() - t0
+                mejor = t if mejor is None else min(mejor, t)
+            print(f"  {nombre:<7} {mejor:7.3f} s   {tam / 1e6 / mejor:7.1f} MB/s"
+                  f"   {mejor * 1e9 / (3 * n):6.1f} ns/número")
+        print("  salida", "idéntica" if salidas["scanf"] == salidas["readln"] else "DIFERENTE")
+
+
+def bench_referencias(n, repeticiones=5):
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "pc")
+        compilar_compilador(exe)
+        print(f"\nSuma y cantidad de dígitos de 1..{n}")
+        salidas = {}
+        for nombre, con_var in [("dos funciones", False), ("procedure var", True)]:
+            fuente = os.path.join(tmp, "ref.txt")
+            with open(fuente, "w") as fh:
+                fh.write(generar_referencias(n, con_var))
+            binario = os.path.join(tmp, "var" if con_var else "valor")
+            subprocess.run([exe, "-q", fuente], stdout=subprocess.DEVNULL, check=True)
+            subprocess.run(["gcc", "-no-pie", "-o", binario, os.path.join(tmp, "ref.s")], check=True)
+            t, salidas[nombre] = ejecutar(binario, repeticiones)
+            print(f"  {nombre:<14} {t:7.3f} s   {t * 1e9 / n:6.1f} ns/número")
+        print("  salida", "idéntica" if len(set(salidas.values())) == 1 else "DIFERENTE")
+
+
+def bench_dobles(n, repeticiones=5):
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "pc")
+        compilar_compilador(exe)
+        print(f"\npi con {n} pasos (regla del punto medio)")
+        for tipo in ["float", "double"]:
+            fuente = os.path.join(tmp, "pi.txt")
+            with open(fuente, "w") as fh:
+                fh.write(generar_dobles(n, tipo))
+            binario = os.path.join(tmp, tipo)
+            subprocess.run([exe, "-q", fuente], stdout=subprocess.DEVNULL, check=True)
+            subprocess.run(["gcc", "-no-pie", "-o", binario, os.path.join(tmp, "pi.s")], check=True)
+            t, salida = ejecutar(binario, repeticiones)
+            valor = float(salida.split()[0])
+            print(f"  {tipo:<7} {t:7.3f} s   {t * 1e9 / n:6.2f} ns/paso"
+                  f"   {valor:.6f} (error {abs(valor - math.pi):.1e})")
+
+
+def bench_desenrollar(n, repeticiones=5):
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "pc")
+        compilar_compilador(exe)
+        fuente = os.path.join(tmp, "des.txt")
+        with open(fuente, "w") as fh:
+            fh.write(generar_desenrollado(n))
+
+        # Tiempo del proceso sin bucles, para descontarlo
+        vacio = os.path.join(tmp, "vacio.txt")
+        with open(vacio, "w") as fh:
+            fh.write(generar_desenrollado(0))
+        subprocess.run([exe, "-q", vacio], stdout=subprocess.DEVNULL, check=True)
+        subprocess.run(["gcc", "-no-pie", "-o", os.path.join(tmp, "vacio"), os.path.join(tmp, "vacio.s")], check=True)
+        base, _ = ejecutar(os.path.join(tmp, "vacio"), repeticiones)
+
+        mhz = mhz_cpu()
+        print(f"\nDos while de {n} vueltas" + (f" (ciclos a {mhz:.0f} MHz)" if mhz else ""))
+        salidas = {}
+        for factor in [1, 2, 4, 8]:
+            binario = os.path.join(tmp, f"des{factor}")
+            subprocess.run([exe, "-q", "--desenrollar", str(factor), fuente], stdout=subprocess.DEVNULL, check=True)
+            subprocess.run(["gcc", "-no-pie", "-o", binario, os.path.join(tmp, "des.s")], check=True)
+            t, salidas[factor] = ejecutar(binario, repeticiones)
+            ns = max(t - base, 0) * 1e9 / (2 * n)
+            ciclos = f"  {ns * mhz / 1000:5.2f} ciclos/vuelta" if mhz else ""
+            print(f"  x{factor:<2} {t:7.3f} s  {ns:6.3f} ns/vuelta{ciclos}")
+        print("  salida", "idéntica" if len(set(salidas.values())) == 1 else "DIFERENTE")
+
+
+if __name__ == "__main__":
+    modo = sys.argv[1] if len(sys.argv) > 1 else "batch"
+    if modo == "batch":
+        bench_batch(int(sys.argv[2]) if len(sys.argv) > 2 else 500)
+    elif modo == "funcs":
+        bench_funcs(int(sys.argv[2]) if len(sys.argv) > 2 else 5000)
+    elif modo == "cache":
+        bench_cache(int(sys.argv[2]) if len(sys.argv) > 2 else 5000)
+    elif modo == "servidor":
+        bench_servidor(int(sys.argv[2]) if len(sys.argv) > 2 else 500)
+    elif modo == "streaming":
+        bench_streaming(int(sys.argv[2]) if len(sys.argv) > 2 else 20000)
+    elif modo == "tuberia":
+        bench_tuberia(int(sys.argv[2]) if len(sys.argv) > 2 else 20000)
+    elif modo == "lexer":
+        bench_lexer(int(sys.argv[2]) if len(sys.argv) > 2 else 50000)
+    elif modo == "ast":
+        bench_ast(int(sys.argv[2]) if len(sys.argv) > 2 else 20000)
+    elif modo == "profundas":
+        bench_profundas(int(sys.argv[2]) if len(sys.argv) > 2 else 5000,
+                        sys.argv[3] if len(sys.argv) > 3 else None)
+    elif modo == "simbolos":
+        bench_simbolos(int(sys.argv[2]) if len(sys.argv) > 2 else 20000,
+                       sys.argv[3] if len(sys.argv) > 3 else None)
+    elif modo == "floats":
+        bench_floats(int(sys.argv[2]) if len(sys.argv) > 2 else 50000,
+                     sys.argv[3] if len(sys.argv) > 3 else None)
+    elif modo == "bucles":
+        bench_bucles(int(sys.argv[2]) if len(sys.argv) > 2 else 20000)
+    elif modo == "vector":
+        bench_vector(int(sys.argv[2]) if len(sys.argv) > 2 else 50)
+    elif modo == "arreglos":
+        bench_arreglos(int(sys.argv[2]) if len(sys.argv) > 2 else 200)
+    elif modo == "escritura":
+        bench_escritura(int(sys.argv[2]) if len(sys.argv) > 2 else 10000000,
+                        sys.argv[3] if len(sys.argv) > 3 else None)
+    elif modo == "lectura":
+        bench_lectura(int(sys.argv[2]) if len(sys.argv) > 2 else 5000000)
+    elif modo == "referencias":
+        bench_referencias(int(sys.argv[2]) if len(sys.argv) > 2 else 20000000)
+    elif modo == "dobles":
+        bench_dobles(int(sys.argv[2]) if len(sys.argv) > 2 else 100000000)
+    elif modo == "desenrollar":
+        bench_desenrollar(int(sys.argv[2]) if len(sys.argv) > 2 else 200000000)
+    elif modo == "compartir":
+        bench_compartir(int(sys.argv[2]) if len(sys.argv) > 2 else 20000)
+    elif modo == "jobs":
+        bench_jobs(int(sys.argv[2]) if len(sys.argv) > 2 else 3000)
+    else:
+        print("Modo desconocido:", modo)
+        exit(1)
@@ -0,0 +1,208 @@
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <unordered_map>
+#include "cache.h"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+// Versión del formato y del generador: cambiarla invalida toda la caché
+static const char* VERSION_CACHE = "pc-cache 6";
+
+// FNV-1a de 64 bits
+static uint64_t mezclar(uint64_t h, const string& s) {
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    h ^= 0xff;                // separador
+    h *= 1099511628211ULL;
+    return h;
+}
+
+CacheFunciones::CacheFunciones(const string& d) : dir(d) {
+    error_code ec;
+    fs::create_directories(dir, ec);
+}
+
+string CacheFunciones::ruta(uint64_t clave) const {
+    char buf[24];
+    snprintf(buf, sizeof buf, "%016llx.fn", (unsigned long long)clave);
+    return (fs::path(dir) / buf).string();
+}
+
+// =============================
+// Claves
+// =============================
+static string resolverAlias(const unordered_map<string, string>& tdefs, string t) {
+    for (int i = 0; i < 16; ++i) {
+        auto it = tdefs.find(t);
+        if (it == tdefs.end()) break;
+        t = it->second;
+    }
+    return t;
+}
+
+void CacheFunciones::aplicar(Program* p, const string& opciones,
+                             vector<uint64_t>& claves, int& aciertos, int& fallos) {
+    // Globales y firmas (con su posición, para respetar la visibilidad)
+    unordered_map<string, string> globales;
+    for (auto* vd : p->vdlist) {
+        if (!vd) continue;
+        string t = resolverAlias(p->tdefs, vd->type);
+        if (vd->arreglo) t += "[" + to_string(vd->lo) + ".." + to_string(vd->hi) + "]";
+        for (auto& v : vd->vars) globales[v] = t;
+    }
+
+    vector<FunDec*> funs(p->fdlist.begin(), p->fdlist.end());
+    unordered_map<string, vector<pair<size_t, string>>> firmas;
+    for (size_t i = 0; i < funs.size(); ++i) {
+        if (!funs[i]) continue;
+        string f = resolverAlias(p->tdefs, funs[i]->tipo) + "(";
+        for (size_t k = 0; k < funs[i]->Ptipos.size(); ++k)
+            f += (funs[i]->porReferencia(k) ? "var " : "") +
+                 resolverAlias(p->tdefs, funs[i]->Ptipos[k]) + ",";
+        firmas[funs[i]->nombre].push_back({i, f + ")"});
+    }
+
+    claves.assign(funs.size(), 0);
+    for (size_t i = 0; i < funs.size(); ++i) {
+        FunDec* fd = funs[i];
+        if (!fd) continue;
+
+        uint64_t h = 1469598103934665603ULL;
+        h = mezclar(h, VERSION_CACHE);
+        h = mezclar(h, opciones);
+        h = mezclar(h, to_string(fd->hashTokens));
+
+        for (const string& id : fd->idsUsados) {
+            h = mezclar(h, id);
+
+            auto g = globales.find(id);
+            h = mezclar(h, g != globales.end() ? "g:" + g->second : "-");
+
+            auto a = p->tdefs.find(id);
+            h = mezclar(h, a != p->tdefs.end() ? "t:" + resolverAlias(p->tdefs, id) : "-");
+
+            // firma visible desde esta función (la última declarada hasta i)
+            string firma = "-";
+            auto f = firmas.find(id);
+            if (f != firmas.end()) {
+                for (auto& e : f->second)
+                    if (e.first <= i) firma = "f:" + e.second;
+            }
+            h = mezclar(h, firma);
+        }
+        claves[i] = h;
+
+        CodigoFuncion* c = new CodigoFuncion();
+        if (leer(h, *c)) {
+            c->deCache = true;
+            delete fd->codigo;
+            fd->codigo = c;
+            aciertos++;
+        } else {
+            delete c;
+            fallos++;
+        }
+    }
+}
+
+// =============================
+// Lectura / escritura
+// =============================
+bool CacheFunciones::leer(uint64_t clave, CodigoFuncion& c) const {
+    if (dir.empty()) {
+        lock_guard<mutex> lk(m);
+        auto it = memoria.find(clave);
+        if (it == memoria.end()) return false;
+        c.texto  = it->second.texto;
+        c.floats  = it->second.floats;
+        c.doubles = it->second.doubles;
+        c.usaEscritura = it->second.usaEscritura;
+        c.usaLectura   = it->second.usaLectura;
+        return true;
+    }
+
+    ifstream in(ruta(clave), ios::binary);
+    if (!in.is_open()) return false;
+
+    string cabecera;
+    if (!getline(in, cabecera) || cabecera != VERSION_CACHE) return false;
+
+    // Runtime que usa: escritura y lectura (0/1)
+    if (!(in >> c.usaEscritura >> c.usaLectura)) return false;
+
+    size_t nf = 0;
+    if (!(in >> nf)) return false;
+    c.floats.resize(nf);
+    for (size_t i = 0; i < nf; ++i) {
+        unsigned long bits;
+        if (!(in >> hex >> bits) || bits > 0xffffffffUL) return false;
+        c.floats[i] = (uint32_t)bits;
+    }
+    size_t nd = 0;
+    if (!(in >> dec >> nd)) return false;
+    c.doubles.resize(nd);
+    for (size_t i = 0; i < nd; ++i) {
+        unsigned long long bits;
+        if (!(in >> hex >> bits)) return false;
+        c.doubles[i] = bits;
+    }
+
+    size_t len = 0;
+    if (!(in >> dec >> len)) return false;
+    in.get();   // '\n'
+    c.texto.resize(len);
+    if (len > 0 && !in.read(&c.texto[0], len)) return false;
+    return true;
+}
+
+void CacheFunciones::escribir(uint64_t clave, const CodigoFuncion& c) const {
+    if (dir.empty()) {
+        lock_guard<mutex> lk(m);
+        if (memoria.size() >= MAX_EN_MEMORIA) memoria.clear();
+        CodigoFuncion& e = memoria[clave];
+        e.texto  = c.texto;
+        e.floats  = c.floats;
+        e.doubles = c.doubles;
+        e.usaEscritura = c.usaEscritura;
+        e.usaLectura   = c.usaLectura;
+        return;
+    }
+
+    // Se escribe en un temporal y se renombra: otros hilos/procesos nunca
+    // leen una entrada a medias.
+    string destino = ruta(clave);
+    ostringstream tmp;
+    tmp << destino << ".tmp" << hash<thread::id>()(this_thread::get_id());
+
+    {
+        ofstream out(tmp.str(), ios::binary);
+        if (!out.is_open()) return;
+        out << VERSION_CACHE << "\n" << c.usaEscritura << " " << c.usaLectura << "\n";
+        out << c.floats.size() << "\n";
+        for (uint32_t bits : c.floats) out << hex << bits << dec << "\n";
+        out << c.doubles.size() << "\n";
+        for (uint64_t bits : c.doubles) out << hex << bits << dec << "\n";
+        out << c.texto.size() << "\n";
+        out.write(c.texto.data(), c.texto.size());
+    }
+
+    error_code ec;
+    fs::rename(tmp.str(), destino, ec);
+    if (ec) fs::remove(tmp.str(), ec);
+}
+
+void CacheFunciones::guardar(Program* p, const vector<uint64_t>& claves) {
+    size_t i = 0;
+    for (auto* fd : p->fdlist) {
+        if (fd && fd->codigo && !fd->codigo->deCache && i < claves.size())
+            escribir(claves[i], *fd->codigo);
+        ++i;
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include "ast.h"
+
+using namespace std;
+
+// --------------------------------------
+// Caché incremental de código por función
+// --------------------------------------
+// La clave de cada FunDec combina el hash de sus tokens con todo lo que su
+// código generado puede depender fuera de ella: para cada identificador que
+// aparece en la función, su tipo si es global, su destino si es un alias y la
+// firma visible si es una función. Cambiar el cuerpo de otra función no
+// invalida la entrada; cambiar una firma o global usada, sí.
+//
+// Cada entrada es un archivo <dir>/<clave>.fn con el texto ensamblador de la
+// función y las constantes float y double que usa (la sección de datos y los
+// pools se vuelven a generar en cada compilación). Sin directorio, las
+// entradas se guardan en memoria (modo servidor).
+class CacheFunciones {
+public:
+    explicit CacheFunciones(const string& dir);
+    CacheFunciones() {}   // en memoria
+
+    // Calcula la clave de cada función de p y carga en FunDec::codigo (con
+    // deCache = true) las que ya están en la caché.
+    void aplicar(Program* p, const string& opciones,
+                 vector<uint64_t>& claves, int& aciertos, int& fallos);
+
+    // Escribe las funciones generadas en esta compilación
+    void guardar(Program* p, const vector<uint64_t>& claves);
+
+private:
+    string dir;
+
+    // Modo en memoria: protegido por mutex (varios hilos del servidor)
+    static const size_t MAX_EN_MEMORIA = 200000;
+    mutable mutex m;
+    mutable unordered_map<uint64_t, CodigoFuncion> memoria;
+
+    string ruta(uint64_t clave) const;
+    bool   leer(uint64_t clave, CodigoFuncion& c) const;
+    void   escribir(uint64_t clave, const CodigoFuncion& c) const;
+};
+
+#endif // CACHE_H
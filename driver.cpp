@@ -0,0 +1,583 @@
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include <chrono>
+#include <memory>
+#include <set>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "driver.h"
+#include "scanner.h"
+#include "parser.h"
+#include "ast.h"
+#include "threadpool.h"
+#include "tuberia.h"
+#include "lexparalelo.h"
+#include "astbin.h"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+// Declaración de las funciones definidas en ast.cpp
+void optimizeAST(Program* prog, ostream* log, int desenrollado);
+void optimizeFunDec(FunDec* f, int desenrollado);
+
+static double msDesde(chrono::steady_clock::time_point t0) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+string claveOpciones(const OpcionesCompilacion& o) {
+    return string(nombreSimd(o.simd)) + "/u" + to_string(o.desenrollar);
+}
+
+string opcionesPeticion(const OpcionesCompilacion& o) {
+    return claveOpciones(o) + (o.compartirExp ? "/e" : "");
+}
+
+bool leerOpcionesPeticion(const string& texto, OpcionesCompilacion& o) {
+    vector<string> partes;
+    size_t ini = 0;
+    while (true) {
+        size_t fin = texto.find('/', ini);
+        partes.push_back(texto.substr(ini, fin == string::npos ? string::npos : fin - ini));
+        if (fin == string::npos) break;
+        ini = fin + 1;
+    }
+    if (partes.size() < 2 || partes.size() > 3) return false;
+
+    if (partes[0] == "sse2")      o.simd = SIMD_SSE2;
+    else if (partes[0] == "avx2") o.simd = SIMD_AVX2;
+    else if (partes[0] == "no")   o.simd = SIMD_NINGUNA;
+    else return false;
+
+    const string& u = partes[1];
+    if (u.size() < 2 || u.size() > 3 || u[0] != 'u' ||
+        !all_of(u.begin() + 1, u.end(), [](char c) { return c >= '0' && c <= '9'; }))
+        return false;
+    o.desenrollar = stoi(u.substr(1));
+    if (o.desenrollar < 1 || o.desenrollar > 16) return false;
+
+    if (partes.size() == 3 && partes[2] != "e") return false;
+    o.compartirExp = partes.size() == 3;
+    return true;
+}
+
+string nombreSalida(const string& entrada) {
+    size_t dotPos = entrada.find_last_of('.');
+    string baseName = (dotPos == string::npos) ? entrada : entrada.substr(0, dotPos);
+    return baseName + ".s";
+}
+
+// Con errores de tipos (ya escritos en avisos) la unidad falla igual que
+// con errores de sintaxis: sin .s
+static void comprobarTipos(const TypeCheckVisitor& typer) {
+    int n = typer.errores;
+    if (n > 0) throw runtime_error(to_string(n) + (n == 1 ? " error de tipos" : " errores de tipos"));
+}
+
+// "archivo:línea:columna: error: mensaje" por diagnóstico
+static vector<string> formatearDiagnosticos(const string& archivo, const char* texto, size_t len,
+                                            const vector<Diagnostico>& diags) {
+    vector<int> pos;
+    for (auto& d : diags) pos.push_back(d.pos);
+    vector<pair<int, int>> lc = lineasColumnas(texto, len, pos);
+
+    vector<string> res;
+    for (size_t i = 0; i < diags.size(); ++i) {
+        res.push_back(archivo + ":" + to_string(lc[i].first) + ":" + to_string(lc[i].second) +
+                      ": error: " + diags[i].mensaje);
+    }
+    return res;
+}
+
+// =============================
+// Expansión de argumentos
+// =============================
+static bool esFuente(const fs::path& p) {
+    string ext = p.extension().string();
+    return ext == ".txt" || ext == ".pas";
+}
+
+// 'abiertas': rutas canónicas de las listas que se están expandiendo (una
+// lista que se incluye a sí misma, directa o indirectamente, es un ciclo)
+static vector<string> expandir(const vector<string>& args, vector<string>& errores,
+                               set<string>& abiertas) {
+    vector<string> archivos;
+
+    for (const string& a : args) {
+        // @lista: archivo de respuesta con una ruta por línea
+        if (!a.empty() && a[0] == '@') {
+            ifstream lista(a.substr(1));
+            if (!lista.is_open()) {
+                errores.push_back("No se pudo abrir la lista: " + a.substr(1));
+                continue;
+            }
+            error_code ec;
+            string canonica = fs::canonical(a.substr(1), ec).string();
+            if (ec) canonica = a.substr(1);
+            if (!abiertas.insert(canonica).second) {
+                errores.push_back("Lista incluida en sí misma: " + a.substr(1));
+                continue;
+            }
+            vector<string> sub;
+            string linea;
+            while (getline(lista, linea)) {
+                size_t hash = linea.find('#');
+                if (hash != string::npos) linea.erase(hash);
+                while (!linea.empty() && isspace((unsigned char)linea.back()))  linea.pop_back();
+                size_t ini = 0;
+                while (ini < linea.size() && isspace((unsigned char)linea[ini])) ini++;
+                if (ini < linea.size()) sub.push_back(linea.substr(ini));
+            }
+            vector<string> exp = expandir(sub, errores, abiertas);
+            archivos.insert(archivos.end(), exp.begin(), exp.end());
+            abiertas.erase(canonica);
+            continue;
+        }
+
+        error_code ec;
+        if (fs::is_directory(a, ec)) {
+            // Directorio: todos sus fuentes, en orden alfabético
+            vector<string> dir;
+            for (auto& ent : fs::directory_iterator(a, ec)) {
+                if (ent.is_regular_file() && esFuente(ent.path()))
+                    dir.push_back(ent.path().string());
+            }
+            sort(dir.begin(), dir.end());
+            archivos.insert(archivos.end(), dir.begin(), dir.end());
+            continue;
+        }
+
+        archivos.push_back(a);
+    }
+
+    return archivos;
+}
+
+vector<string> expandirEntradas(const vector<string>& args, vector<string>& errores) {
+    set<string> abiertas;
+    return expandir(args, errores, abiertas);
+}
+
+// =============================
+// Compilación de una unidad
+// =============================
+bool Compilador::leerArchivo(const string& ruta) {
+    ifstream infile(ruta, ios::binary);
+    if (!infile.is_open()) return false;
+
+    infile.seekg(0, ios::end);
+    streamoff tam = infile.tellg();
+    infile.seekg(0, ios::beg);
+
+    // assign() reutiliza la capacidad ya reservada por unidades anteriores
+    fuente.assign(tam > 0 ? (size_t)tam : 0, '\0');
+    if (tam > 0) infile.read(&fuente[0], tam);
+    return true;
+}
+
+static bool esAST(const string& ruta) {
+    return fs::path(ruta).extension() == ".ast";
+}
+
+ResultadoCompilacion Compilador::compilar(const string& ruta) {
+    if (esAST(ruta)) return compilarAST(ruta);
+    if (opciones.streaming) return compilarStreaming(ruta);
+
+    if (!leerArchivo(ruta)) {
+        ResultadoCompilacion r;
+        r.entrada = ruta;
+        r.salida  = nombreSalida(ruta);
+        r.mensaje = "No se pudo abrir el archivo: " + ruta;
+        return r;
+    }
+
+    ResultadoCompilacion r = compilarFuente(ruta, fuente);
+    if (!r.ok) return r;
+
+    ofstream outfile(r.salida, ios::binary);
+    if (!outfile.is_open()) {
+        r.ok = false;
+        r.mensaje = "Error al crear el archivo de salida: " + r.salida;
+        return r;
+    }
+    const string& texto = asmBuf.str();
+    outfile.write(texto.data(), texto.size());
+    outfile.close();
+    return r;
+}
+
+// Origen de tokens del parser: léxico paralelo por trozos, scanner en otro
+// hilo o el Scanner de siempre, según las opciones y el tamaño del texto
+FuenteTokens* Compilador::abrirTokens(const char* texto, size_t len, ResultadoCompilacion& r) {
+    if (opciones.lexParalelo && len >= UMBRAL_LEX_PARALELO) {
+        auto t0 = chrono::steady_clock::now();
+        int n = codigo.hilos ? codigo.hilos->tamano() : 1;
+        size_t trozo = max<size_t>(64 * 1024, len / (4 * n));
+        vector<TokenCompacto> tokens;
+        tokenizarParalelo(texto, len, codigo.hilos, tokens, trozo);
+        r.tLex = msDesde(t0);
+        return new TokensEnMemoria(texto, std::move(tokens));
+    }
+    if (opciones.scannerHilo && TuberiaTokens::conviene(len))
+        return new TuberiaTokens(texto, len);
+    return new Scanner(texto, len);
+}
+
+ResultadoCompilacion Compilador::compilarFuente(const string& nombre, const string& texto) {
+    ResultadoCompilacion r;
+    r.entrada = nombre;
+    r.salida  = nombreSalida(nombre);
+
+    typer.reiniciar();
+    codigo.reiniciar();
+    for (ostringstream* b : {&asmBuf, &bitacora, &avisos}) {
+        b->str("");
+        b->clear();
+    }
+    ostream* log = opciones.verbose ? &bitacora : nullptr;
+    CacheFunciones* cache = opciones.cache;
+
+    Program* program = nullptr;
+    try {
+        auto t0 = chrono::steady_clock::now();
+
+        // Crear instancias de Scanner y Parser
+        unique_ptr<FuenteTokens> tokens(abrirTokens(texto.data(), texto.size(), r));
+        Parser parser(tokens.get(), log);
+        parser.hashFunciones = (cache != nullptr);
+        parser.expresiones.activa = opciones.compartirExp;
+
+        // Parsear y generar AST
+        program = parser.parseProgram();
+        r.tParse = msDesde(t0);
+        if (!program) {
+            r.mensaje = "Parser falló: AST nulo";
+            return r;
+        }
+        if (log && opciones.compartirExp) {
+            *log << "Expresiones compartidas: " << parser.expresiones.creados << " nodos, "
+                 << parser.expresiones.reutilizados << " usos reutilizados\n";
+        }
+
+        if (log) {
+            *log << "\n=== DEBUG AST ===\n";
+            *log << "Funciones en el AST: " << program->fdlist.size() << endl;
+            for (auto* f : program->fdlist) {
+                *log << " - " << f->nombre
+                    << " (" << f->Ptipos.size() << " tipos, "
+                    << f->Pnombres.size() << " nombres, cuerpo "
+                    << (f->cuerpo ? "OK" : "NULL") << ")\n";
+            }
+            *log << "=================\n";
+        }
+
+        // Funciones sin cambios: se toman de la caché
+        vector<uint64_t> claves;
+        if (cache) cache->aplicar(program, claveOpciones(opciones), claves,
+                                  r.cacheAciertos, r.cacheFallos);
+
+        //Analizador de tipos
+        t0 = chrono::steady_clock::now();
+        typer.analizar(program);
+        r.tTipos = msDesde(t0);
+        comprobarTipos(typer);
+
+        // AST ya analizado, para recompilar sin volver a parsear
+        if (opciones.emitirAST) {
+            string bin;
+            escribirASTBinario(program, bin);
+            string ruta = nombreAST(nombre);
+            ofstream f(ruta, ios::binary);
+            f.write(bin.data(), bin.size());
+            if (!f) throw runtime_error("Error al escribir " + ruta);
+        }
+
+        codigo.capturarFunciones = (cache != nullptr);
+        codigo.simd = opciones.simd;
+        optimizarYGenerar(program, r, log);
+
+        if (cache) cache->guardar(program, claves);
+    } catch (const ErroresSintaxis& ex) {
+        delete program;
+        r.mensaje  = ex.what();
+        r.diagnosticos = formatearDiagnosticos(nombre, texto.data(), texto.size(), ex.diagnosticos);
+        r.bitacora = bitacora.str();
+        r.avisos   = avisos.str();
+        return r;
+    } catch (const exception& ex) {
+        delete program;
+        r.mensaje  = ex.what();
+        r.bitacora = bitacora.str();
+        r.avisos   = avisos.str();
+        return r;
+    }
+    delete program;
+    r.bitacora = bitacora.str();
+    r.avisos   = avisos.str();
+
+    r.ok = true;
+    return r;
+}
+
+// Optimización y generación de código de un programa ya analizado
+void Compilador::optimizarYGenerar(Program* program, ResultadoCompilacion& r, ostream* log) {
+    //Aplicar optimizaciones
+    auto t0 = chrono::steady_clock::now();
+    optimizeAST(program, log, opciones.desenrollar);
+    r.tOpt = msDesde(t0);
+
+    //Generar código ensamblador
+    if (log)
+        *log << "Generando codigo ensamblador en " << r.salida << endl;
+    t0 = chrono::steady_clock::now();
+    codigo.generar(program);
+    r.tGen = msDesde(t0);
+}
+
+// =============================
+// Archivos mapeados en memoria
+// =============================
+namespace {
+
+// Archivo de solo lectura mapeado en memoria (sin copia al heap)
+class ArchivoMapeado {
+public:
+    const char* datos = "";
+    size_t      tam = 0;
+
+    bool abrir(const string& ruta) {
+        fd = ::open(ruta.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) return false;
+        tam = (size_t)st.st_size;
+        if (tam == 0) return true;
+        void* p = mmap(nullptr, tam, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) return false;
+        madvise(p, tam, MADV_SEQUENTIAL);
+        mapa  = p;
+        datos = static_cast<const char*>(p);
+        return true;
+    }
+
+    ~ArchivoMapeado() {
+        if (mapa) munmap(mapa, tam);
+        if (fd >= 0) ::close(fd);
+    }
+
+private:
+    int   fd = -1;
+    void* mapa = nullptr;
+};
+
+} // namespace
+
+// =============================
+// Compilación desde un AST binario
+// =============================
+// El .ast se mapea y se decodifica directamente; no hay scanner, parser ni
+// análisis de tipos (el AST ya trae tipos y conversiones).
+ResultadoCompilacion Compilador::compilarAST(const string& ruta) {
+    ResultadoCompilacion r;
+    r.entrada = ruta;
+    r.salida  = nombreSalida(ruta);
+
+    typer.reiniciar();
+    codigo.reiniciar();
+    for (ostringstream* b : {&asmBuf, &bitacora, &avisos}) {
+        b->str("");
+        b->clear();
+    }
+    ostream* log = opciones.verbose ? &bitacora : nullptr;
+
+    Program* program = nullptr;
+    try {
+        auto t0 = chrono::steady_clock::now();
+        {
+            ArchivoMapeado archivo;
+            if (!archivo.abrir(ruta)) throw runtime_error("No se pudo abrir el archivo: " + ruta);
+            program = leerASTBinario(archivo.datos, archivo.tam);
+        }
+        r.tParse = msDesde(t0);
+        if (log) *log << "AST cargado: " << program->fdlist.size() << " funciones\n";
+
+        codigo.capturarFunciones = false;
+        codigo.simd = opciones.simd;
+        optimizarYGenerar(program, r, log);
+
+        ofstream outfile(r.salida, ios::binary);
+        if (!outfile.is_open()) throw runtime_error("Error al crear el archivo de salida: " + r.salida);
+        const string& texto = asmBuf.str();
+        outfile.write(texto.data(), texto.size());
+    } catch (const exception& ex) {
+        delete program;
+        r.mensaje  = ex.what();
+        r.bitacora = bitacora.str();
+        r.avisos   = avisos.str();
+        return r;
+    }
+    delete program;
+    r.bitacora = bitacora.str();
+    r.avisos   = avisos.str();
+
+    r.ok = true;
+    return r;
+}
+
+// =============================
+// Compilación en streaming
+// =============================
+ResultadoCompilacion Compilador::compilarStreaming(const string& ruta) {
+    ResultadoCompilacion r;
+    r.entrada = ruta;
+    r.salida  = nombreSalida(ruta);
+
+    ArchivoMapeado archivo;
+    if (!archivo.abrir(ruta)) {
+        r.mensaje = "No se pudo abrir el archivo: " + ruta;
+        return r;
+    }
+
+    ofstream outfile(r.salida, ios::binary);
+    if (!outfile.is_open()) {
+        r.mensaje = "Error al crear el archivo de salida: " + r.salida;
+        return r;
+    }
+
+    typer.reiniciar();
+    for (ostringstream* b : {&bitacora, &avisos}) {
+        b->str("");
+        b->clear();
+    }
+    ostream* log = opciones.verbose ? &bitacora : nullptr;
+
+    GenCodeVisitor gen(outfile);
+    gen.avisos = &avisos;
+    gen.simd   = opciones.simd;
+
+    Program* program = nullptr;
+    try {
+        auto t0 = chrono::steady_clock::now();
+        unique_ptr<FuenteTokens> tokens(abrirTokens(archivo.datos, archivo.tam, r));
+        Parser parser(tokens.get(), log);
+        parser.expresiones.activa = opciones.compartirExp;
+
+        // Cabecera: alias y globales (necesarios antes de cualquier función)
+        program = parser.parseCabecera();
+        r.tParse += msDesde(t0);
+
+        typer.registrarGlobales(program);
+        gen.generarInicio(program);
+
+        if (log) *log << "\n=== DEBUG AST (streaming) ===\n";
+
+        // Una función a la vez: la visibilidad de firmas ya es posicional,
+        // así que basta con lo parseado hasta ahora.
+        int indice = 0;
+        while (true) {
+            t0 = chrono::steady_clock::now();
+            unique_ptr<FunDec> f(parser.parseSiguienteFuncion());
+            r.tParse += msDesde(t0);
+            if (!f) break;
+
+            // Con errores de sintaxis solo se sigue parseando (para
+            // informarlos todos); no se genera nada más
+            if (!parser.errores().empty()) continue;
+
+            if (log) {
+                *log << " - " << f->nombre
+                    << " (" << f->Ptipos.size() << " tipos, "
+                    << f->Pnombres.size() << " nombres, cuerpo "
+                    << (f->cuerpo ? "OK" : "NULL") << ")\n";
+            }
+
+            t0 = chrono::steady_clock::now();
+            typer.analizarFuncion(f.get(), indice++);
+            r.tTipos += msDesde(t0);
+
+            t0 = chrono::steady_clock::now();
+            optimizeFunDec(f.get(), opciones.desenrollar);
+            r.tOpt += msDesde(t0);
+
+            t0 = chrono::steady_clock::now();
+            gen.generarFuncion(f.get());
+            r.tGen += msDesde(t0);
+        }
+        if (!parser.errores().empty()) throw ErroresSintaxis(parser.errores());
+        comprobarTipos(typer);
+        if (log) {
+            *log << "Parser exitoso" << endl;
+            *log << "Optimizaciones aplicadas correctamente." << endl;
+        }
+
+        gen.generarFin();
+        outfile.close();
+        if (!outfile) throw runtime_error("Error al escribir " + r.salida);
+    } catch (const ErroresSintaxis& ex) {
+        delete program;
+        outfile.close();
+        remove(r.salida.c_str());
+        r.mensaje  = ex.what();
+        r.diagnosticos = formatearDiagnosticos(ruta, archivo.datos, archivo.tam, ex.diagnosticos);
+        r.bitacora = bitacora.str();
+        r.avisos   = avisos.str();
+        return r;
+    } catch (const exception& ex) {
+        delete program;
+        outfile.close();
+        remove(r.salida.c_str());   // sin .s a medias
+        r.mensaje  = ex.what();
+        r.bitacora = bitacora.str();
+        r.avisos   = avisos.str();
+        return r;
+    }
+    delete program;
+    r.bitacora = bitacora.str();
+    r.avisos   = avisos.str();
+
+    r.ok = true;
+    return r;
+}
+
+// =============================
+// Compilación de varias unidades
+// =============================
+vector<ResultadoCompilacion> compilarTodos(const vector<string>& archivos,
+                                           int hilos, const OpcionesCompilacion& opciones) {
+    vector<ResultadoCompilacion> resultados(archivos.size());
+    if (hilos < 1) hilos = 1;
+
+    // Un solo archivo: el paralelismo se aplica por función
+    if (archivos.size() == 1 && hilos > 1 && !opciones.streaming) {
+        ThreadPool pool(hilos);
+        Compilador c;
+        c.opciones = opciones;
+        c.usarHilos(&pool);
+        resultados[0] = c.compilar(archivos[0]);
+        return resultados;
+    }
+
+    if ((size_t)hilos > archivos.size()) hilos = (int)archivos.size();
+
+    // Un Compilador por hilo: no comparten ningún estado mutable
+    vector<Compilador> compiladores(hilos);
+    for (auto& c : compiladores) c.opciones = opciones;
+
+    if (hilos == 1) {
+        for (size_t i = 0; i < archivos.size(); ++i)
+            resultados[i] = compiladores[0].compilar(archivos[i]);
+        return resultados;
+    }
+
+    ThreadPool pool(hilos);
+    paraCada(&pool, archivos.size(), [&](size_t i, int hilo) {
+        resultados[i] = compiladores[hilo].compilar(archivos[i]);
+    });
+    return resultados;
+}
@@ -0,0 +1,144 @@
+#ifndef DRIVER_H
+#define DRIVER_H
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include "visitor.h"
+#include "cache.h"
+
+class FuenteTokens;
+
+using namespace std;
+
+// ========================
+//  Resultado por archivo
+// ========================
+struct ResultadoCompilacion {
+    string entrada;      // archivo fuente
+    string salida;       // archivo .s generado
+    bool   ok = false;
+    string mensaje;      // descripción del error si ok == false
+    vector<string> diagnosticos;   // errores de sintaxis (archivo:línea:col: ...)
+    string bitacora;     // mensajes de progreso de esta unidad
+    string avisos;       // advertencias de esta unidad
+
+    // Tiempo por fase (ms)
+    double tParse = 0, tTipos = 0, tOpt = 0, tGen = 0;
+    double tLex = 0;     // solo con el léxico por trozos (incluido en tParse)
+
+    // Caché incremental: funciones reutilizadas / regeneradas
+    int cacheAciertos = 0, cacheFallos = 0;
+};
+
+// ========================
+//  Opciones por unidad
+// ========================
+struct OpcionesCompilacion {
+    bool verbose = true;       // volcado de depuración del AST
+
+    // Caché incremental de funciones (opcional, compartible entre hilos)
+    CacheFunciones* cache = nullptr;
+
+    // Compilar función a función: el archivo se mapea en memoria y cada
+    // función se analiza, optimiza, escribe en el .s y se libera antes de
+    // parsear la siguiente. La memoria queda acotada por la función más
+    // grande, no por el programa. Ignora la caché y los hilos por unidad.
+    bool streaming = false;
+
+    // Scanner en un hilo propio que alimenta al parser por un anillo de
+    // tokens (solo en archivos grandes y con más de un núcleo)
+    bool scannerHilo = false;
+
+    // Léxico en paralelo por trozos con los hilos de la unidad (archivos
+    // grandes); el parser consume después la lista de tokens
+    bool lexParalelo = false;
+
+    // Guardar el programa ya analizado como <base>.ast (ver astbin.h); al
+    // compilar un .ast se omiten el scanner, el parser y el análisis de tipos
+    bool emitirAST = false;
+
+    // Hash-consing: las subexpresiones sin efectos iguales de una función
+    // comparten un solo nodo (menos memoria en fuentes repetitivas)
+    bool compartirExp = false;
+
+    // Extensión vectorial para los for vectorizables (ver visitor.h)
+    ExtensionSimd simd = SIMD_SSE2;
+
+    // Factor de desenrollado de los while con variable de inducción (1 no
+    // desenrolla; ver ast.cpp)
+    int desenrollar = 4;
+};
+
+// Opciones que cambian el código generado (parte de la clave de la caché),
+// p. ej. "sse2/u4"
+string claveOpciones(const OpcionesCompilacion& o);
+
+// Opciones de una petición al servidor: claveOpciones más "/e" con
+// compartirExp. leerOpcionesPeticion hace lo inverso sobre 'o' (false si el
+// texto no es válido)
+string opcionesPeticion(const OpcionesCompilacion& o);
+bool   leerOpcionesPeticion(const string& texto, OpcionesCompilacion& o);
+
+// Tamaño mínimo de la fuente para usar el léxico por trozos
+const size_t UMBRAL_LEX_PARALELO = 256 * 1024;
+
+// ========================
+//  Compilador reutilizable
+// ========================
+// Compila varias unidades en el mismo proceso. El buffer de lectura, el
+// buffer de ensamblador y las tablas de símbolos de los visitors se
+// reutilizan entre unidades (se limpian, pero conservan su memoria).
+// Todo el estado de una compilación vive aquí: con un Compilador por hilo
+// se pueden compilar unidades en paralelo.
+class Compilador {
+private:
+    string           fuente;   // contenido del archivo actual
+    ostringstream    asmBuf;   // ensamblador de la unidad actual
+    ostringstream    bitacora; // progreso de la unidad actual
+    ostringstream    avisos;   // advertencias de la unidad actual
+    TypeCheckVisitor typer;
+    GenCodeVisitor   codigo;
+
+    bool leerArchivo(const string& ruta);
+    ResultadoCompilacion compilarStreaming(const string& ruta);
+    ResultadoCompilacion compilarAST(const string& ruta);
+    void optimizarYGenerar(Program* program, ResultadoCompilacion& r, ostream* log);
+    FuenteTokens* abrirTokens(const char* texto, size_t len, ResultadoCompilacion& r);
+
+public:
+    OpcionesCompilacion opciones;
+
+    // Pool opcional para paralelizar dentro de la unidad (por función)
+    void usarHilos(ThreadPool* pool) {
+        typer.hilos  = pool;
+        codigo.hilos = pool;
+    }
+
+    Compilador() : codigo(asmBuf) {
+        typer.avisos  = &avisos;
+        codigo.avisos = &avisos;
+    }
+
+    // Lee 'ruta' (fuente o .ast) y escribe el .s junto a ella
+    ResultadoCompilacion compilar(const string& ruta);
+
+    // Compila un texto ya en memoria; el ensamblador queda en ensamblador()
+    ResultadoCompilacion compilarFuente(const string& nombre, const string& texto);
+    string ensamblador() const { return asmBuf.str(); }
+};
+
+// Compila todas las unidades con 'hilos' hilos (un Compilador por hilo).
+// Con un solo archivo, los hilos se usan dentro de la unidad.
+// Los resultados se devuelven en el mismo orden que 'archivos'.
+vector<ResultadoCompilacion> compilarTodos(const vector<string>& archivos,
+                                           int hilos, const OpcionesCompilacion& opciones);
+
+// Expande la lista de argumentos: archivos, directorios (todos sus .txt/.pas)
+// y listas "@archivo" (una ruta por línea, '#' inicia comentario).
+vector<string> expandirEntradas(const vector<string>& args, vector<string>& errores);
+
+// Nombre del .s junto al archivo fuente
+string nombreSalida(const string& entrada);
+
+#endif // DRIVER_H
@@ -0,0 +1,97 @@
+#include <cstring>
+#include "lexparalelo.h"
+#include "threadpool.h"
+
+using namespace std;
+
+namespace {
+
+struct Trozo {
+    size_t ini, fin;
+
+    // Variante 0: el trozo empieza fuera de un comentario.
+    // Variante 1: empieza dentro (se salta hasta el primer '}').
+    vector<TokenCompacto> tokens[2];
+    bool hecho[2]         = {false, false};
+    bool terminaDentro[2] = {false, false};
+};
+
+void escanearTrozo(const char* texto, Trozo& t, int dentro) {
+    size_t ini = t.ini;
+    if (dentro) {
+        const void* cierre = memchr(texto + t.ini, '}', t.fin - t.ini);
+        if (!cierre) {
+            // Todo el trozo es comentario
+            t.terminaDentro[1] = true;
+            t.hecho[1] = true;
+            return;
+        }
+        ini = (const char*)cierre - texto + 1;
+    }
+
+    Scanner sc(texto, ini, t.fin);
+    vector<TokenCompacto>& v = t.tokens[dentro];
+    v.reserve((t.fin - ini) / 4);
+    while (true) {
+        TokenCompacto tok = sc.nextCompacto();
+        if (tok.type == Token::END) break;
+        v.push_back(tok);
+    }
+    t.terminaDentro[dentro] = sc.comentarioAbierto();
+    t.hecho[dentro] = true;
+}
+
+} // namespace
+
+void tokenizarParalelo(const char* texto, size_t len, ThreadPool* pool,
+                       vector<TokenCompacto>& tokens, size_t tamTrozo) {
+    // Cortes: el primer espacio en blanco a partir de cada múltiplo de tamTrozo
+    vector<Trozo> trozos;
+    size_t ini = 0;
+    while (ini < len) {
+        size_t fin = ini + tamTrozo;
+        while (fin < len && !is_white_space(texto[fin])) fin++;
+        if (fin > len) fin = len;
+        trozos.push_back(Trozo());
+        trozos.back().ini = ini;
+        trozos.back().fin = fin;
+        ini = fin;
+    }
+
+    // Fase 1 (paralela): todos los trozos suponiendo que empiezan fuera
+    paraCada(pool, trozos.size(), [&](size_t i, int) {
+        escanearTrozo(texto, trozos[i], 0);
+    });
+
+    // Fase 2 (paralela): la variante "dentro" de los trozos cuyo anterior
+    // termina dentro de un comentario según la fase 1
+    vector<size_t> pendientes;
+    for (size_t i = 1; i < trozos.size(); ++i) {
+        if (trozos[i - 1].terminaDentro[0]) pendientes.push_back(i);
+    }
+    paraCada(pool, pendientes.size(), [&](size_t k, int) {
+        escanearTrozo(texto, trozos[pendientes[k]], 1);
+    });
+
+    // Costura (secuencial): se elige la variante según el estado real; si
+    // hace falta una que no se calculó (un comentario que cruza varios
+    // cortes), se escanea aquí.
+    size_t total = 0;
+    vector<int> elegida(trozos.size());
+    int dentro = 0;
+    for (size_t i = 0; i < trozos.size(); ++i) {
+        if (!trozos[i].hecho[dentro]) escanearTrozo(texto, trozos[i], dentro);
+        elegida[i] = dentro;
+        total += trozos[i].tokens[dentro].size();
+        dentro = trozos[i].terminaDentro[dentro] ? 1 : 0;
+    }
+
+    tokens.clear();
+    tokens.reserve(total + 1);
+    for (size_t i = 0; i < trozos.size(); ++i) {
+        vector<TokenCompacto>& v = trozos[i].tokens[elegida[i]];
+        tokens.insert(tokens.end(), v.begin(), v.end());
+        vector<TokenCompacto>().swap(v);
+    }
+    tokens.push_back({Token::END, (int)len, 0});
+}
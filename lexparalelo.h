@@ -0,0 +1,44 @@
+#ifndef LEXPARALELO_H
+#define LEXPARALELO_H
+
+#include <vector>
+#include <cstddef>
+#include "scanner.h"
+
+using namespace std;
+
+class ThreadPool;
+
+// --------------------------------------
+// Léxico en paralelo por trozos
+// --------------------------------------
+// El texto se corta en trozos que empiezan en un espacio en blanco: fuera de
+// un comentario, ningún token cruza un espacio, así que cada trozo se puede
+// escanear por separado. El único estado que pasa de un trozo al siguiente
+// es "dentro de un comentario { ... }". Cada trozo se escanea en paralelo
+// suponiendo que empieza fuera; los que resultan empezar dentro se vuelven a
+// escanear desde su primer '}' y luego se cosen en orden. El resultado es
+// exactamente la secuencia de Scanner::nextCompacto() hasta END (incluido).
+void tokenizarParalelo(const char* texto, size_t len, ThreadPool* pool,
+                       vector<TokenCompacto>& tokens,
+                       size_t tamTrozo = 1 << 20);
+
+// Tokens ya calculados servidos al parser uno a uno
+class TokensEnMemoria : public FuenteTokens {
+public:
+    TokensEnMemoria(const char* t, vector<TokenCompacto>&& v)
+        : texto(t), tokens(std::move(v)) {}
+
+    Token* nextToken() override {
+        const TokenCompacto& t = tokens[pos];
+        if (pos + 1 < tokens.size()) pos++;   // el último (END) se repite
+        return new Token(t.type, texto, t.first, t.len);
+    }
+
+private:
+    const char*           texto;
+    vector<TokenCompacto> tokens;
+    size_t                pos = 0;
+};
+
+#endif // LEXPARALELO_H
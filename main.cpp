@@ -1,86 +1,220 @@
 #include <iostream>
-#include <fstream>
 #include <string>
-#include "scanner.h"
-#include "parser.h"
-#include "ast.h"
-#include "visitor.h"
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include "driver.h"
+#include "threadpool.h"
+#include "server.h"
 
 using namespace std;
 
-// Declaración de la función definida en ast.cpp
-void optimizeAST(Program* prog);
+static void uso(const char* prog) {
+    cout << "Uso: " << prog << " [-q] [-j N] [--tiempos] [--cache DIR] [--streaming] [--scanner-hilo] [--lexer-paralelo] [--emitir-ast] [--compartir-exp] [--simd X] [--desenrollar N] <archivo|directorio|@lista>...\n";
+    cout << "  -q         no mostrar el volcado de depuración por archivo\n";
+    cout << "  -j N       compilar con N hilos (por defecto: todos los núcleos)\n";
+    cout << "  --tiempos  mostrar el tiempo de cada fase por archivo\n";
+    cout << "  --cache D  reutilizar el código de funciones sin cambios (caché en D)\n";
+    cout << "  --streaming  compilar función a función con memoria acotada (sin caché)\n";
+    cout << "  --scanner-hilo  léxico en un hilo aparte en archivos grandes (>= 256 KB)\n";
+    cout << "  --lexer-paralelo  léxico por trozos con los -j hilos en archivos grandes\n";
+    cout << "  --emitir-ast  guardar el AST analizado en <archivo>.ast (sin caché)\n";
+    cout << "             un .ast como entrada se compila sin parsear de nuevo\n";
+    cout << "  --compartir-exp  un solo nodo por subexpresión repetida en cada función\n";
+    cout << "  --simd X   vectorizar bucles for con X = sse2 (por defecto), avx2 o no\n";
+    cout << "  --desenrollar N  copias por vuelta al desenrollar while (4 por defecto; 1 no desenrolla)\n";
+    cout << "  --servidor S  compilar como servidor residente en el socket Unix S\n";
+    cout << "  --cliente S   enviar los archivos al servidor de S ('-' = entrada estándar)\n";
+    cout << "                con --simd, --desenrollar y --compartir-exp\n";
+    cout << "  --detener S   detener el servidor de S\n";
+    cout << "  directorio compila todos sus archivos .txt / .pas\n";
+    cout << "  @lista     archivo con una ruta por línea\n";
+}
 
 int main(int argc, const char* argv[]) {
-    if (argc != 2) {
-        cout << "Número incorrecto de argumentos.\n";
-        cout << "Uso: " << argv[0] << " <archivo_de_entrada>" << endl;
-        return 1;
+    bool quiet = false;
+    bool tiempos = false;
+    bool streaming = false;
+    bool scannerHilo = false;
+    bool lexParalelo = false;
+    bool emitirAST = false;
+    bool compartirExp = false;
+    ExtensionSimd simd = SIMD_SSE2;
+    int  desenrollar = 4;
+    int  hilos = 0;   // 0 = automático
+    string dirCache;
+    string sockServidor, sockCliente, sockDetener;
+    vector<string> args;
+    vector<string> banderas;   // opciones dadas (para avisar de las que se ignoran)
+
+    for (int i = 1; i < argc; ++i) {
+        string a = argv[i];
+        if (a.size() > 1 && a[0] == '-') banderas.push_back(a.rfind("-j", 0) == 0 ? "-j" : a);
+        if (a == "-q") quiet = true;
+        else if (a == "--tiempos") tiempos = true;
+        else if (a == "--streaming") streaming = true;
+        else if (a == "--scanner-hilo") scannerHilo = true;
+        else if (a == "--lexer-paralelo") lexParalelo = true;
+        else if (a == "--emitir-ast") emitirAST = true;
+        else if (a == "--compartir-exp") compartirExp = true;
+        else if (a == "--servidor" || a == "--cliente" || a == "--detener") {
+            if (i + 1 >= argc) {
+                cerr << "[ERROR] " << a << " requiere la ruta de un socket\n";
+                return 1;
+            }
+            string& destino = (a == "--servidor") ? sockServidor
+                            : (a == "--cliente")  ? sockCliente : sockDetener;
+            destino = argv[++i];
+        }
+        else if (a == "--simd") {
+            string x = i + 1 < argc ? argv[++i] : "";
+            if (x == "sse2")      simd = SIMD_SSE2;
+            else if (x == "avx2") simd = SIMD_AVX2;
+            else if (x == "no")   simd = SIMD_NINGUNA;
+            else {
+                cerr << "[ERROR] --simd requiere sse2, avx2 o no\n";
+                return 1;
+            }
+        }
+        else if (a == "--desenrollar") {
+            string n = i + 1 < argc ? argv[++i] : "";
+            try { desenrollar = stoi(n); } catch (...) { desenrollar = 0; }
+            if (desenrollar < 1 || desenrollar > 16) {
+                cerr << "[ERROR] --desenrollar requiere un número entre 1 y 16\n";
+                return 1;
+            }
+        }
+        else if (a == "--cache") {
+            if (i + 1 >= argc) {
+                cerr << "[ERROR] --cache requiere un directorio\n";
+                return 1;
+            }
+            dirCache = argv[++i];
+        }
+        else if (a == "-j" || a.rfind("-j", 0) == 0) {
+            string n = (a == "-j") ? (i + 1 < argc ? argv[++i] : "") : a.substr(2);
+            try { hilos = stoi(n); } catch (...) { hilos = -1; }
+            if (hilos < 1) {
+                cerr << "[ERROR] -j requiere un número de hilos positivo\n";
+                return 1;
+            }
+        }
+        else if (a == "-h" || a == "--help") { uso(argv[0]); return 0; }
+        else args.push_back(a);
     }
 
-    // Abrir archivo de entrada
-    ifstream infile(argv[1]);
-    if (!infile.is_open()) {
-        cout << "No se pudo abrir el archivo: " << argv[1] << endl;
+    // El servidor toma las opciones de código de cada petición y el cliente
+    // solo envía esas: el resto no tiene efecto en esos modos
+    auto avisarIgnoradas = [&](const string& modo, const vector<string>& validas) {
+        for (auto& b : banderas)
+            if (find(validas.begin(), validas.end(), b) == validas.end())
+                cerr << "[AVISO] " << b << " se ignora con " << modo << "\n";
+    };
+
+    if (!sockDetener.empty())  return detenerServidor(sockDetener);
+    if (!sockServidor.empty()) {
+        avisarIgnoradas("--servidor", {"--servidor", "-j", "-q"});
+        return ejecutarServidor(sockServidor, hilos ? hilos : ThreadPool::hilosDisponibles());
+    }
+
+    if (args.empty()) {
+        cout << "Número incorrecto de argumentos.\n";
+        uso(argv[0]);
         return 1;
     }
 
-    // Leer contenido completo del archivo
-    string input, line;
-    while (getline(infile, line)) {
-        input += line + '\n';
+    if (!sockCliente.empty()) {
+        avisarIgnoradas("--cliente", {"--cliente", "-q", "--simd", "--desenrollar", "--compartir-exp"});
+        OpcionesCompilacion opciones;
+        opciones.simd         = simd;
+        opciones.desenrollar  = desenrollar;
+        opciones.compartirExp = compartirExp;
+        if (args.size() == 1 && args[0] == "-")
+            return ejecutarCliente(sockCliente, args, true, opciones);
+        vector<string> errores;
+        vector<string> archivos = expandirEntradas(args, errores);
+        for (auto& e : errores) cerr << "[ERROR] " << e << "\n";
+        return ejecutarCliente(sockCliente, archivos, quiet, opciones) || !errores.empty();
     }
-    infile.close();
 
-    // Crear instancias de Scanner y Parser
-    Scanner scanner1(input.c_str());
-    Parser parser(&scanner1);
+    vector<string> errores;
+    vector<string> archivos = expandirEntradas(args, errores);
+    for (auto& e : errores) cerr << "[ERROR] " << e << "\n";
 
-    // Parsear y generar AST
-    Program* program = parser.parseProgram();
-    if (!program) {
-        cerr << "[ERROR] Parser falló: AST nulo.\n";
-        return 2;
+    if (archivos.empty()) {
+        cerr << "[ERROR] No hay archivos que compilar.\n";
+        return 1;
     }
 
-    // Determinar nombre del archivo de salida (.s)
-    string inputFile(argv[1]);
-    size_t dotPos = inputFile.find_last_of('.');
-    string baseName = (dotPos == string::npos) ? inputFile : inputFile.substr(0, dotPos);
-    string outputFilename = baseName + ".s";
+    if (hilos == 0) hilos = ThreadPool::hilosDisponibles();
 
-    ofstream outfile(outputFilename);
-    if (!outfile.is_open()) {
-        cerr << "Error al crear el archivo de salida: " << outputFilename << endl;
-        return 1;
+    if (streaming && emitirAST) cerr << "[AVISO] --emitir-ast se ignora con --streaming\n";
+
+    unique_ptr<CacheFunciones> cache;
+    if (!dirCache.empty()) {
+        if (streaming) cerr << "[AVISO] --cache se ignora con --streaming\n";
+        else if (emitirAST) cerr << "[AVISO] --cache se ignora con --emitir-ast\n";
+        else cache.reset(new CacheFunciones(dirCache));
     }
 
-    cout << "\n=== DEBUG AST ===\n";
-    cout << "Funciones en el AST: " << program->fdlist.size() << endl;
-    for (auto* f : program->fdlist) {
-        cout << " - " << f->nombre
-            << " (" << f->Ptipos.size() << " tipos, "
-            << f->Pnombres.size() << " nombres, cuerpo "
-            << (f->cuerpo ? "OK" : "NULL") << ")\n";
+    // Un compilador por hilo: cada uno reutiliza sus buffers y tablas
+    OpcionesCompilacion opciones;
+    opciones.verbose     = !quiet;
+    opciones.cache       = cache.get();
+    opciones.streaming   = streaming;
+    opciones.scannerHilo = scannerHilo;
+    opciones.lexParalelo = lexParalelo;
+    opciones.emitirAST   = emitirAST;
+    opciones.compartirExp = compartirExp;
+    opciones.simd         = simd;
+    opciones.desenrollar  = desenrollar;
+    vector<ResultadoCompilacion> resultados = compilarTodos(archivos, hilos, opciones);
+
+    // Mensajes por archivo, en el orden de entrada
+    for (auto& r : resultados) {
+        if (!r.avisos.empty()) cerr << r.avisos;
+        for (auto& d : r.diagnosticos) cerr << d << "\n";
+        if (quiet) continue;
+        cout << r.bitacora;
+        if (r.ok) cout << "Compilación y optimización completadas con éxito." << endl;
+        else      cerr << "[ERROR] " << r.entrada << ": " << r.mensaje << endl;
     }
-    cout << "=================\n";
 
-    //Analizador de tipos
-    TypeCheckVisitor typer;
-    typer.analizar(program);
+    if (tiempos) {
+        cout << "\n=== TIEMPOS (ms) ===\n";
+        for (auto& r : resultados) {
+            cout << " " << r.entrada << ": parse " << r.tParse
+                 << ", tipos " << r.tTipos << ", opt " << r.tOpt
+                 << ", codegen " << r.tGen;
+            if (r.tLex > 0) cout << ", lexer " << r.tLex;
+            cout << "\n";
+        }
+    }
 
-    //Aplicar optimizaciones
-    optimizeAST(program);
+    if (cache) {
+        int aciertos = 0, fallos = 0;
+        for (auto& r : resultados) {
+            aciertos += r.cacheAciertos;
+            fallos   += r.cacheFallos;
+        }
+        cout << "Caché: " << aciertos << " funciones reutilizadas, "
+             << fallos << " regeneradas" << endl;
+    }
 
-    //Generar código ensamblador
-    cout << "Generando codigo ensamblador en " << outputFilename << endl;
-    GenCodeVisitor codigo(outfile);
-    codigo.tipoGlobal = typer.tipoGlobal;
-    codigo.tipoLocal  = typer.tipoLocal;
-    codigo.generar(program);
+    int fallidos = 0;
+    for (auto& r : resultados) if (!r.ok) fallidos++;
 
-    outfile.close();
-    cout << "Compilación y optimización completadas con éxito." << endl;
+    // Resumen por archivo (solo si hay varios o alguno falló)
+    if (resultados.size() > 1 || fallidos > 0) {
+        cout << "\n=== RESUMEN ===\n";
+        for (auto& r : resultados) {
+            if (r.ok) cout << " [OK]    " << r.entrada << " -> " << r.salida << "\n";
+            else      cout << " [FALLO] " << r.entrada << ": " << r.mensaje << "\n";
+        }
+        cout << resultados.size() << " archivos, "
+             << (resultados.size() - fallidos) << " correctos, "
+             << fallidos << " con error" << endl;
+    }
 
-    return 0;
+    return (fallidos == 0 && errores.empty()) ? 0 : 1;
 }
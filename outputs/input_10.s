@@ -1,8 +1,6 @@
 .data
-print_fmt: .string "%ld \n"
-printf_fmt_float: .string "%f \n"
-y: .float 0.0
 x: .quad 0
+y: .float 0.0
 .text
 .globl main
 main:
@@ -10,22 +8,227 @@ main:
  movq %rsp, %rbp
  movq $9999999999, %rax
  movq %rax, x(%rip)
- movss ._CF0(%rip), %xmm0
+ movss ._CF4048f5c3(%rip), %xmm0
  movss %xmm0, y(%rip)
  movq x(%rip), %rax
- movq %rax, %rsi
- leaq print_fmt(%rip), %rdi
- movl $0, %eax
- call printf@PLT
+ movq %rax, %rdi
+ call write_i64
  movss y(%rip), %xmm0
- cvtss2sd %xmm0, %xmm0
- leaq printf_fmt_float(%rip), %rdi
- movl $1, %eax
- call printf@PLT
+ call write_f32
 .end_main:
  leave
  ret
 
+# Runtime de escritura (ver runtime.h)
+.bss
+.p2align 6
+.Lesc_buf: .zero 1048576
+.data
+.p2align 3
+.Lesc_pos: .quad .Lesc_buf
+.section .rodata
+.p2align 3
+.Lesc_millon: .double 1000000.0
+.Lesc_limite: .double 9.0e12
+.Lesc_limite_d: .double 3.0e7
+.Lesc_casi_medio: .double 0.49609375
+.Lesc_fmt_f: .string "%f \n"
+.Lesc_pot10: .quad 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000, 10000000000, 100000000000, 1000000000000, 10000000000000, 100000000000000, 1000000000000000, 10000000000000000, 100000000000000000, 1000000000000000000, 10000000000000000000
+.Lesc_pares: .ascii "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899"
+.section .fini_array,"aw"
+.p2align 3
+.quad write_flush
+.text
+
+# Vacía el buffer con write(1, ...); reintenta si la escritura es parcial o
+# se interrumpe (EINTR) y descarta el resto ante cualquier otro error
+write_flush:
+ leaq .Lesc_buf(%rip), %rsi
+ movq .Lesc_pos(%rip), %rdx
+ subq %rsi, %rdx
+1:
+ testq %rdx, %rdx
+ jle 2f
+ movl $1, %eax
+ movl $1, %edi
+ syscall
+ cmpq $-4, %rax
+ je 1b
+ testq %rax, %rax
+ jle 2f
+ addq %rax, %rsi
+ subq %rax, %rdx
+ jmp 1b
+2:
+ leaq .Lesc_buf(%rip), %rax
+ movq %rax, .Lesc_pos(%rip)
+ ret
+
+# %rdi = posición en el buffer con al menos 320 bytes libres (vacía el
+# buffer si hace falta); conserva %rax y %xmm0. Lo más largo que se escribe
+# es un double con "%f \n": signo, 309 dígitos enteros, '.', 6 decimales,
+# " \n" y el 0 final de snprintf, 320 bytes.
+.Lesc_espacio:
+ movq .Lesc_pos(%rip), %rdi
+ leaq .Lesc_buf+1048576-320(%rip), %rcx
+ cmpq %rcx, %rdi
+ jbe 1f
+ pushq %rax
+ call write_flush
+ popq %rax
+ movq .Lesc_pos(%rip), %rdi
+1:
+ ret
+
+# Dígitos decimales de %rax (sin signo) en (%rdi); deja %rdi tras el
+# último. La longitud sale de log2 (bsr) * log10(2) corregido con una tabla
+# de potencias de 10; los dígitos se escriben de atrás hacia adelante, de a
+# dos por división entre 100 (multiplicación por el inverso)
+.Lesc_dec:
+ cmpq $10, %rax
+ jae 1f
+ addl $48, %eax
+ movb %al, (%rdi)
+ addq $1, %rdi
+ ret
+1:
+ bsrq %rax, %rcx
+ addl $1, %ecx
+ imull $1233, %ecx, %ecx
+ shrl $12, %ecx
+ leaq .Lesc_pot10(%rip), %r8
+ cmpq (%r8,%rcx,8), %rax
+ sbbq $-1, %rcx
+ addq %rcx, %rdi
+ movq %rdi, %r9
+ movabsq $0x28F5C28F5C28F5C3, %r10
+ leaq .Lesc_pares(%rip), %r11
+2:
+ cmpq $100, %rax
+ jb 3f
+ movq %rax, %rcx
+ shrq $2, %rax
+ mulq %r10
+ shrq $2, %rdx
+ imulq $100, %rdx, %rax
+ subq %rax, %rcx
+ movzwl (%r11,%rcx,2), %ecx
+ movw %cx, -2(%r9)
+ subq $2, %r9
+ movq %rdx, %rax
+ jmp 2b
+3:
+ cmpq $10, %rax
+ jb 4f
+ movzwl (%r11,%rax,2), %ecx
+ movw %cx, -2(%r9)
+ ret
+4:
+ addl $48, %eax
+ movb %al, -1(%r9)
+ ret
+
+write_i32:
+ movslq %edi, %rax
+ jmp .Lesc_entero
+write_u32:
+ movl %edi, %eax
+ call .Lesc_espacio
+ jmp .Lesc_digitos
+write_i64:
+ movq %rdi, %rax
+.Lesc_entero:
+ call .Lesc_espacio
+ testq %rax, %rax
+ jns .Lesc_digitos
+ movb $45, (%rdi)
+ addq $1, %rdi
+ negq %rax
+.Lesc_digitos:
+ call .Lesc_dec
+ movw $0x0a20, (%rdi)
+ addq $2, %rdi
+ movq %rdi, .Lesc_pos(%rip)
+ ret
+
+# Como printf("%f"): |x| * 10^6 es exacto en double para cualquier float
+# (24 bits de mantisa por 20 de 10^6), así que redondear ese producto al
+# entero (al par, como printf) da los 6 decimales exactos. Infinito, NaN y
+# |x| >= 9e12 (el producto no cabe en 63 bits) van por snprintf.
+write_f32:
+ cvtss2sd %xmm0, %xmm0
+ call .Lesc_espacio
+ movq %xmm0, %rax
+ btrq $63, %rax
+ movq %rax, %xmm1
+ ucomisd .Lesc_limite(%rip), %xmm1
+ jp .Lesc_f_lento
+ jae .Lesc_f_lento
+ movmskpd %xmm0, %eax
+ testl $1, %eax
+ jz 1f
+ movb $45, (%rdi)
+ addq $1, %rdi
+1:
+ mulsd .Lesc_millon(%rip), %xmm1
+ cvtsd2si %xmm1, %rax
+ jmp .Lesc_f_digitos
+
+# En double el producto |x| * 10^6 se redondea; con |x| < 3e7 queda por
+# debajo de 2^45 y el error es a lo sumo 2^-9, así que su redondeo al
+# entero coincide con el del valor exacto salvo que la parte fraccionaria
+# quede a menos de 2^-8 de 0.5. Ese caso y |x| >= 3e7 van por snprintf.
+write_f64:
+ call .Lesc_espacio
+ movq %xmm0, %rax
+ btrq $63, %rax
+ movq %rax, %xmm1
+ ucomisd .Lesc_limite_d(%rip), %xmm1
+ jp .Lesc_f_lento
+ jae .Lesc_f_lento
+ mulsd .Lesc_millon(%rip), %xmm1
+ cvtsd2si %xmm1, %rax
+ cvtsi2sdq %rax, %xmm2
+ subsd %xmm2, %xmm1
+ movq %xmm1, %rdx
+ btrq $63, %rdx
+ movq %rdx, %xmm1
+ ucomisd .Lesc_casi_medio(%rip), %xmm1
+ jae .Lesc_f_lento
+ movmskpd %xmm0, %ecx
+ testl $1, %ecx
+ jz .Lesc_f_digitos
+ movb $45, (%rdi)
+ addq $1, %rdi
+.Lesc_f_digitos:
+ xorl %edx, %edx
+ movl $1000000, %ecx
+ divq %rcx
+ movq %rdx, %rsi
+ call .Lesc_dec
+ leaq 1000000(%rsi), %rax
+ movq %rdi, %rsi
+ call .Lesc_dec
+ movb $46, (%rsi)
+ movw $0x0a20, (%rdi)
+ addq $2, %rdi
+ movq %rdi, .Lesc_pos(%rip)
+ ret
+.Lesc_f_lento:
+ pushq %rbx
+ movq %rdi, %rbx
+ movl $320, %esi
+ leaq .Lesc_fmt_f(%rip), %rdx
+ movl $1, %eax
+ call snprintf@PLT
+ cltq
+ addq %rax, %rbx
+ movq %rbx, .Lesc_pos(%rip)
+ popq %rbx
+ ret
+
 # Constantes de punto flotante (float 32 bits)
-._CF0: .float 3.14
+.section .rodata
+.p2align 2
+._CF4048f5c3: .long 0x4048f5c3
 .section .note.GNU-stack,"",@progbits
@@ -0,0 +1,1807 @@
+.data
+i: .long 0
+s: .long 0
+.bss
+.p2align 3
+v: .zero 400
+.p2align 3
+m: .zero 128
+.p2align 3
+f: .zero 20
+.text
+.globl suma
+suma:
+ pushq %r12
+ pushq %r13
+ pushq %rbp
+ movq %rsp, %rbp
+ movq %rdi, -8(%rbp)
+ subq $544, %rsp
+ movl $0, %eax
+ pushq %rax
+ movl $63, %eax
+ popq %rcx
+ movslq %eax, %rax
+ movslq %ecx, %rcx
+ subq %rcx, %rax
+ addq $1, %rax
+ jle endfor_suma_0
+ movl %ecx, %r12d
+ movq %rax, %r13
+for_suma_0:
+ movl %r12d, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl %r12d, %eax
+ pushq %rax
+ movl %r12d, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movslq %eax, %rax
+ popq %rcx
+ movq %rax, -520(%rbp,%rcx,8)
+ incl %r12d
+ decq %r13
+ jnz for_suma_0
+ decl %r12d
+ movl %r12d, -524(%rbp)
+endfor_suma_0:
+ movq $0, %rax
+ movq %rax, -532(%rbp)
+ movl $0, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ pushq %rax
+ movl $1, %eax
+ movl %eax, %ecx
+ popq %rax
+ subl %ecx, %eax
+ popq %rcx
+ movslq %eax, %rax
+ movslq %ecx, %rcx
+ subq %rcx, %rax
+ addq $1, %rax
+ jle endfor_suma_1
+ movl %ecx, %r12d
+ movq %rax, %r13
+for_suma_1:
+ movq -532(%rbp), %rax
+ pushq %rax
+ movl %r12d, %eax
+ movslq %eax, %rax
+ cmpq $63, %rax
+ ja .rango_suma
+ movq -520(%rbp,%rax,8), %rax
+ movq %rax, %rcx
+ popq %rax
+ addq %rcx, %rax
+ movq %rax, -532(%rbp)
+ incl %r12d
+ decq %r13
+ jnz for_suma_1
+ decl %r12d
+ movl %r12d, -524(%rbp)
+endfor_suma_1:
+ movq -532(%rbp), %rax
+.end_suma:
+ leave
+ popq %r13
+ popq %r12
+ ret
+.rango_suma:
+ andq $-16, %rsp
+ movq stderr@GOTPCREL(%rip), %rdi
+ movq (%rdi), %rdi
+ leaq .rango_msg_suma(%rip), %rsi
+ movl $0, %eax
+ call fprintf@PLT
+ movl $1, %edi
+ call exit@PLT
+ .pushsection .rodata
+.rango_msg_suma: .string "Error: indice fuera de rango en suma\n"
+ .popsection
+.globl matmul
+matmul:
+ pushq %r12
+ pushq %r13
+ pushq %r14
+ pushq %r15
+ pushq %rbp
+ movq %rsp, %rbp
+ movq %rdi, -8(%rbp)
+ subq $816, %rsp
+ movl $0, %eax
+ pushq %rax
+ movl $7, %eax
+ popq %rcx
+ movslq %eax, %rax
+ movslq %ecx, %rcx
+ subq %rcx, %rax
+ addq $1, %rax
+ jle endfor_matmul_0
+ movl %ecx, %r12d
+ movq %rax, %r13
+for_matmul_0:
+ movl %r12d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $0, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl %r12d, %eax
+ pushq %rax
+ movl $0, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ popq %rcx
+ movl %eax, -264(%rbp,%rcx,4)
+ movl %r12d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $0, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl %r12d, %eax
+ pushq %rax
+ movl $0, %eax
+ movl %eax, %ecx
+ popq %rax
+ subl %ecx, %eax
+ popq %rcx
+ movl %eax, -520(%rbp,%rcx,4)
+ movl %r12d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $1, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl %r12d, %eax
+ pushq %rax
+ movl $1, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ popq %rcx
+ movl %eax, -264(%rbp,%rcx,4)
+ movl %r12d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $1, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl %r12d, %eax
+ pushq %rax
+ movl $1, %eax
+ movl %eax, %ecx
+ popq %rax
+ subl %ecx, %eax
+ popq %rcx
+ movl %eax, -520(%rbp,%rcx,4)
+ movl %r12d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $2, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl %r12d, %eax
+ pushq %rax
+ movl $2, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ popq %rcx
+ movl %eax, -264(%rbp,%rcx,4)
+ movl %r12d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $2, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl %r12d, %eax
+ pushq %rax
+ movl $2, %eax
+ movl %eax, %ecx
+ popq %rax
+ subl %ecx, %eax
+ popq %rcx
+ movl %eax, -520(%rbp,%rcx,4)
+ movl %r12d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $3, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl %r12d, %eax
+ pushq %rax
+ movl $3, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ popq %rcx
+ movl %eax, -264(%rbp,%rcx,4)
+ movl %r12d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $3, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl %r12d, %eax
+ pushq %rax
+ movl $3, %eax
+ movl %eax, %ecx
+ popq %rax
+ subl %ecx, %eax
+ popq %rcx
+ movl %eax, -520(%rbp,%rcx,4)
+ movl %r12d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $4, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl %r12d, %eax
+ pushq %rax
+ movl $4, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ popq %rcx
+ movl %eax, -264(%rbp,%rcx,4)
+ movl %r12d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $4, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl %r12d, %eax
+ pushq %rax
+ movl $4, %eax
+ movl %eax, %ecx
+ popq %rax
+ subl %ecx, %eax
+ popq %rcx
+ movl %eax, -520(%rbp,%rcx,4)
+ movl %r12d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $5, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl %r12d, %eax
+ pushq %rax
+ movl $5, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ popq %rcx
+ movl %eax, -264(%rbp,%rcx,4)
+ movl %r12d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $5, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl %r12d, %eax
+ pushq %rax
+ movl $5, %eax
+ movl %eax, %ecx
+ popq %rax
+ subl %ecx, %eax
+ popq %rcx
+ movl %eax, -520(%rbp,%rcx,4)
+ movl %r12d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $6, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl %r12d, %eax
+ pushq %rax
+ movl $6, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ popq %rcx
+ movl %eax, -264(%rbp,%rcx,4)
+ movl %r12d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $6, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl %r12d, %eax
+ pushq %rax
+ movl $6, %eax
+ movl %eax, %ecx
+ popq %rax
+ subl %ecx, %eax
+ popq %rcx
+ movl %eax, -520(%rbp,%rcx,4)
+ movl %r12d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $7, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl %r12d, %eax
+ pushq %rax
+ movl $7, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ popq %rcx
+ movl %eax, -264(%rbp,%rcx,4)
+ movl %r12d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $7, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl %r12d, %eax
+ pushq %rax
+ movl $7, %eax
+ movl %eax, %ecx
+ popq %rax
+ subl %ecx, %eax
+ popq %rcx
+ movl %eax, -520(%rbp,%rcx,4)
+ movl $7, %eax
+ movl %eax, -784(%rbp)
+ incl %r12d
+ decq %r13
+ jnz for_matmul_0
+ decl %r12d
+ movl %r12d, -780(%rbp)
+endfor_matmul_0:
+ movl $0, %eax
+ pushq %rax
+ movl $7, %eax
+ popq %rcx
+ movslq %eax, %rax
+ movslq %ecx, %rcx
+ subq %rcx, %rax
+ addq $1, %rax
+ jle endfor_matmul_1
+ movl %ecx, %r14d
+ movq %rax, %r15
+for_matmul_1:
+ movl $0, %eax
+ pushq %rax
+ movl $7, %eax
+ popq %rcx
+ movslq %eax, %rax
+ movslq %ecx, %rcx
+ subq %rcx, %rax
+ addq $1, %rax
+ jle endfor_matmul_2
+ movl %ecx, %r12d
+ movq %rax, %r13
+for_matmul_2:
+ movl $0, %eax
+ movl %eax, -792(%rbp)
+ movl -792(%rbp), %eax
+ pushq %rax
+ movl %r14d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $0, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ movl -264(%rbp,%rax,4), %eax
+ pushq %rax
+ movl $0, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl %r12d, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ movl -520(%rbp,%rax,4), %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movl %eax, -792(%rbp)
+ movl -792(%rbp), %eax
+ pushq %rax
+ movl %r14d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $1, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ movl -264(%rbp,%rax,4), %eax
+ pushq %rax
+ movl $1, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl %r12d, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ movl -520(%rbp,%rax,4), %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movl %eax, -792(%rbp)
+ movl -792(%rbp), %eax
+ pushq %rax
+ movl %r14d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $2, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ movl -264(%rbp,%rax,4), %eax
+ pushq %rax
+ movl $2, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl %r12d, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ movl -520(%rbp,%rax,4), %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movl %eax, -792(%rbp)
+ movl -792(%rbp), %eax
+ pushq %rax
+ movl %r14d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $3, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ movl -264(%rbp,%rax,4), %eax
+ pushq %rax
+ movl $3, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl %r12d, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ movl -520(%rbp,%rax,4), %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movl %eax, -792(%rbp)
+ movl -792(%rbp), %eax
+ pushq %rax
+ movl %r14d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $4, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ movl -264(%rbp,%rax,4), %eax
+ pushq %rax
+ movl $4, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl %r12d, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ movl -520(%rbp,%rax,4), %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movl %eax, -792(%rbp)
+ movl -792(%rbp), %eax
+ pushq %rax
+ movl %r14d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $5, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ movl -264(%rbp,%rax,4), %eax
+ pushq %rax
+ movl $5, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl %r12d, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ movl -520(%rbp,%rax,4), %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movl %eax, -792(%rbp)
+ movl -792(%rbp), %eax
+ pushq %rax
+ movl %r14d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $6, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ movl -264(%rbp,%rax,4), %eax
+ pushq %rax
+ movl $6, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl %r12d, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ movl -520(%rbp,%rax,4), %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movl %eax, -792(%rbp)
+ movl -792(%rbp), %eax
+ pushq %rax
+ movl %r14d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $7, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ movl -264(%rbp,%rax,4), %eax
+ pushq %rax
+ movl $7, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl %r12d, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ movl -520(%rbp,%rax,4), %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movl %eax, -792(%rbp)
+ movl $7, %eax
+ movl %eax, -788(%rbp)
+ movl %r14d, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl %r12d, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl -792(%rbp), %eax
+ popq %rcx
+ movl %eax, -776(%rbp,%rcx,4)
+ incl %r12d
+ decq %r13
+ jnz for_matmul_2
+ decl %r12d
+ movl %r12d, -784(%rbp)
+endfor_matmul_2:
+ incl %r14d
+ decq %r15
+ jnz for_matmul_1
+ decl %r14d
+ movl %r14d, -780(%rbp)
+endfor_matmul_1:
+ movq $0, %rax
+ movq %rax, -800(%rbp)
+ movl $0, %eax
+ pushq %rax
+ movl $63, %eax
+ popq %rcx
+ movslq %eax, %rax
+ movslq %ecx, %rcx
+ subq %rcx, %rax
+ addq $1, %rax
+ jle endfor_matmul_3
+ movl %ecx, %r12d
+ movq %rax, %r13
+for_matmul_3:
+ movq -800(%rbp), %rax
+ pushq %rax
+ movl %r12d, %eax
+ movslq %eax, %rax
+ movl -776(%rbp,%rax,4), %eax
+ movslq %eax, %rax
+ movq %rax, %rcx
+ popq %rax
+ addq %rcx, %rax
+ movq %rax, -800(%rbp)
+ incl %r12d
+ decq %r13
+ jnz for_matmul_3
+ decl %r12d
+ movl %r12d, -780(%rbp)
+endfor_matmul_3:
+ movq -800(%rbp), %rax
+.end_matmul:
+ leave
+ popq %r15
+ popq %r14
+ popq %r13
+ popq %r12
+ ret
+.globl neg
+neg:
+ pushq %rbp
+ movq %rsp, %rbp
+ movq %rdi, -8(%rbp)
+ subq $48, %rsp
+ movl $-3, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl $-3, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ popq %rcx
+ movl %eax, -28(%rbp,%rcx,4)
+ movl $-2, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl $-2, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ popq %rcx
+ movl %eax, -28(%rbp,%rcx,4)
+ movl $-1, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl $-1, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ popq %rcx
+ movl %eax, -28(%rbp,%rcx,4)
+ movl $0, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl $0, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ popq %rcx
+ movl %eax, -28(%rbp,%rcx,4)
+ movl $1, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl $1, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ popq %rcx
+ movl %eax, -28(%rbp,%rcx,4)
+ movl $2, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl $2, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ popq %rcx
+ movl %eax, -28(%rbp,%rcx,4)
+ movl $3, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl $3, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ popq %rcx
+ movl %eax, -28(%rbp,%rcx,4)
+ movl $3, %eax
+ movl %eax, -44(%rbp)
+ movl $-3, %eax
+ movslq %eax, %rax
+ movl -28(%rbp,%rax,4), %eax
+ pushq %rax
+ movl $3, %eax
+ movslq %eax, %rax
+ movl -28(%rbp,%rax,4), %eax
+ pushq %rax
+ movl $2, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movl %eax, -48(%rbp)
+ movl -8(%rbp), %eax
+ movl %eax, -44(%rbp)
+ movl -48(%rbp), %eax
+ pushq %rax
+ movl -44(%rbp), %eax
+ pushq %rax
+ movl $5, %eax
+ movl %eax, %ecx
+ popq %rax
+ subl %ecx, %eax
+ movslq %eax, %rax
+ subq $-3, %rax
+ cmpq $6, %rax
+ ja .rango_neg
+ movl -40(%rbp,%rax,4), %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movl %eax, -48(%rbp)
+ movl -48(%rbp), %eax
+.end_neg:
+ leave
+ ret
+.rango_neg:
+ andq $-16, %rsp
+ movq stderr@GOTPCREL(%rip), %rdi
+ movq (%rdi), %rdi
+ leaq .rango_msg_neg(%rip), %rsi
+ movl $0, %eax
+ call fprintf@PLT
+ movl $1, %edi
+ call exit@PLT
+ .pushsection .rodata
+.rango_msg_neg: .string "Error: indice fuera de rango en neg\n"
+ .popsection
+.globl main
+main:
+ pushq %r12
+ pushq %r13
+ pushq %rbp
+ movq %rsp, %rbp
+ subq $96, %rsp
+ movl $7, %eax
+ movq %rax, -16(%rbp)
+ movq -16(%rbp), %rdi
+ call neg
+ movl %eax, %edi
+ call write_i32
+ movl $1, %eax
+ pushq %rax
+ movl $100, %eax
+ popq %rcx
+ movslq %eax, %rax
+ movslq %ecx, %rcx
+ subq %rcx, %rax
+ addq $1, %rax
+ jle endfor_main_0
+ movl %ecx, i(%rip)
+ movq %rax, -8(%rbp)
+for_main_0:
+ movl i(%rip), %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $99, %rax
+ ja .rango_main
+ pushq %rax
+ movl i(%rip), %eax
+ popq %rcx
+ leaq v(%rip), %rdx
+ movl %eax, (%rdx,%rcx,4)
+ incl i(%rip)
+ decq -8(%rbp)
+ jnz for_main_0
+ decl i(%rip)
+endfor_main_0:
+ movl $0, %eax
+ movl %eax, s(%rip)
+ movl $1, %eax
+ pushq %rax
+ movl $100, %eax
+ popq %rcx
+ movslq %eax, %rax
+ movslq %ecx, %rcx
+ subq %rcx, %rax
+ addq $1, %rax
+ jle endfor_main_1
+ movl %ecx, i(%rip)
+ movq %rax, -8(%rbp)
+ cmpq $4, %rax
+ jl for_main_1
+ leaq -1(%rcx), %rdx
+ cmpq $99, %rdx
+ ja for_main_1
+ leaq -2(%rcx,%rax), %rdx
+ cmpq $99, %rdx
+ ja for_main_1
+ pxor %xmm8, %xmm8
+ leaq v(%rip), %r8
+ movslq i(%rip), %rcx
+ movq -8(%rbp), %rsi
+ shrq $2, %rsi
+vfor_main_2:
+ movdqu -4(%r8,%rcx,4), %xmm0
+ paddd %xmm0, %xmm8
+ addq $4, %rcx
+ decq %rsi
+ jnz vfor_main_2
+ pshufd $0x4e, %xmm8, %xmm0
+ paddd %xmm0, %xmm8
+ pshufd $0xb1, %xmm8, %xmm0
+ paddd %xmm0, %xmm8
+ movd %xmm8, %eax
+ addl %eax, s(%rip)
+ movl %ecx, i(%rip)
+ andq $3, -8(%rbp)
+ jz salfor_main_1
+for_main_1:
+ movl s(%rip), %eax
+ pushq %rax
+ movl i(%rip), %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $99, %rax
+ ja .rango_main
+ leaq v(%rip), %rdx
+ movl (%rdx,%rax,4), %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movl %eax, s(%rip)
+ incl i(%rip)
+ decq -8(%rbp)
+ jnz for_main_1
+salfor_main_1:
+ decl i(%rip)
+endfor_main_1:
+ movl s(%rip), %eax
+ movl %eax, %edi
+ call write_i32
+ movl $0, %eax
+ movl %eax, i(%rip)
+ movl $0, %eax
+ movslq %eax, %rax
+ cmpq $15, %rax
+ ja .rango_main
+ pushq %rax
+ movl $0, %eax
+ pushq %rax
+ movl $0, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movslq %eax, %rax
+ popq %rcx
+ leaq m(%rip), %rdx
+ movq %rax, (%rdx,%rcx,8)
+ movl $1, %eax
+ movl %eax, i(%rip)
+ movl $1, %eax
+ movslq %eax, %rax
+ cmpq $15, %rax
+ ja .rango_main
+ pushq %rax
+ movl $1, %eax
+ pushq %rax
+ movl $1, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movslq %eax, %rax
+ popq %rcx
+ leaq m(%rip), %rdx
+ movq %rax, (%rdx,%rcx,8)
+ movl $2, %eax
+ movl %eax, i(%rip)
+ movl $2, %eax
+ movslq %eax, %rax
+ cmpq $15, %rax
+ ja .rango_main
+ pushq %rax
+ movl $2, %eax
+ pushq %rax
+ movl $2, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movslq %eax, %rax
+ popq %rcx
+ leaq m(%rip), %rdx
+ movq %rax, (%rdx,%rcx,8)
+ movl $3, %eax
+ movl %eax, i(%rip)
+ movl $3, %eax
+ movslq %eax, %rax
+ cmpq $15, %rax
+ ja .rango_main
+ pushq %rax
+ movl $3, %eax
+ pushq %rax
+ movl $3, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movslq %eax, %rax
+ popq %rcx
+ leaq m(%rip), %rdx
+ movq %rax, (%rdx,%rcx,8)
+ movl $4, %eax
+ movl %eax, i(%rip)
+ movl $4, %eax
+ movslq %eax, %rax
+ cmpq $15, %rax
+ ja .rango_main
+ pushq %rax
+ movl $4, %eax
+ pushq %rax
+ movl $4, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movslq %eax, %rax
+ popq %rcx
+ leaq m(%rip), %rdx
+ movq %rax, (%rdx,%rcx,8)
+ movl $5, %eax
+ movl %eax, i(%rip)
+ movl $5, %eax
+ movslq %eax, %rax
+ cmpq $15, %rax
+ ja .rango_main
+ pushq %rax
+ movl $5, %eax
+ pushq %rax
+ movl $5, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movslq %eax, %rax
+ popq %rcx
+ leaq m(%rip), %rdx
+ movq %rax, (%rdx,%rcx,8)
+ movl $6, %eax
+ movl %eax, i(%rip)
+ movl $6, %eax
+ movslq %eax, %rax
+ cmpq $15, %rax
+ ja .rango_main
+ pushq %rax
+ movl $6, %eax
+ pushq %rax
+ movl $6, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movslq %eax, %rax
+ popq %rcx
+ leaq m(%rip), %rdx
+ movq %rax, (%rdx,%rcx,8)
+ movl $7, %eax
+ movl %eax, i(%rip)
+ movl $7, %eax
+ movslq %eax, %rax
+ cmpq $15, %rax
+ ja .rango_main
+ pushq %rax
+ movl $7, %eax
+ pushq %rax
+ movl $7, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movslq %eax, %rax
+ popq %rcx
+ leaq m(%rip), %rdx
+ movq %rax, (%rdx,%rcx,8)
+ movl $8, %eax
+ movl %eax, i(%rip)
+ movl $8, %eax
+ movslq %eax, %rax
+ cmpq $15, %rax
+ ja .rango_main
+ pushq %rax
+ movl $8, %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movslq %eax, %rax
+ popq %rcx
+ leaq m(%rip), %rdx
+ movq %rax, (%rdx,%rcx,8)
+ movl $9, %eax
+ movl %eax, i(%rip)
+ movl $9, %eax
+ movslq %eax, %rax
+ cmpq $15, %rax
+ ja .rango_main
+ pushq %rax
+ movl $9, %eax
+ pushq %rax
+ movl $9, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movslq %eax, %rax
+ popq %rcx
+ leaq m(%rip), %rdx
+ movq %rax, (%rdx,%rcx,8)
+ movl $10, %eax
+ movl %eax, i(%rip)
+ movl $10, %eax
+ movslq %eax, %rax
+ cmpq $15, %rax
+ ja .rango_main
+ pushq %rax
+ movl $10, %eax
+ pushq %rax
+ movl $10, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movslq %eax, %rax
+ popq %rcx
+ leaq m(%rip), %rdx
+ movq %rax, (%rdx,%rcx,8)
+ movl $11, %eax
+ movl %eax, i(%rip)
+ movl $11, %eax
+ movslq %eax, %rax
+ cmpq $15, %rax
+ ja .rango_main
+ pushq %rax
+ movl $11, %eax
+ pushq %rax
+ movl $11, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movslq %eax, %rax
+ popq %rcx
+ leaq m(%rip), %rdx
+ movq %rax, (%rdx,%rcx,8)
+ movl $12, %eax
+ movl %eax, i(%rip)
+ movl $12, %eax
+ movslq %eax, %rax
+ cmpq $15, %rax
+ ja .rango_main
+ pushq %rax
+ movl $12, %eax
+ pushq %rax
+ movl $12, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movslq %eax, %rax
+ popq %rcx
+ leaq m(%rip), %rdx
+ movq %rax, (%rdx,%rcx,8)
+ movl $13, %eax
+ movl %eax, i(%rip)
+ movl $13, %eax
+ movslq %eax, %rax
+ cmpq $15, %rax
+ ja .rango_main
+ pushq %rax
+ movl $13, %eax
+ pushq %rax
+ movl $13, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movslq %eax, %rax
+ popq %rcx
+ leaq m(%rip), %rdx
+ movq %rax, (%rdx,%rcx,8)
+ movl $14, %eax
+ movl %eax, i(%rip)
+ movl $14, %eax
+ movslq %eax, %rax
+ cmpq $15, %rax
+ ja .rango_main
+ pushq %rax
+ movl $14, %eax
+ pushq %rax
+ movl $14, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movslq %eax, %rax
+ popq %rcx
+ leaq m(%rip), %rdx
+ movq %rax, (%rdx,%rcx,8)
+ movl $15, %eax
+ movl %eax, i(%rip)
+ movl $15, %eax
+ movslq %eax, %rax
+ cmpq $15, %rax
+ ja .rango_main
+ pushq %rax
+ movl $15, %eax
+ pushq %rax
+ movl $15, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movslq %eax, %rax
+ popq %rcx
+ leaq m(%rip), %rdx
+ movq %rax, (%rdx,%rcx,8)
+ movl $15, %eax
+ movslq %eax, %rax
+ leaq m(%rip), %rdx
+ movq (%rdx,%rax,8), %rax
+ pushq %rax
+ movl $1, %eax
+ movslq %eax, %rax
+ leaq m(%rip), %rdx
+ movq (%rdx,%rax,8), %rax
+ movq %rax, %rcx
+ popq %rax
+ addq %rcx, %rax
+ movq %rax, %rdi
+ call write_i64
+ movl $-2, %eax
+ movl %eax, i(%rip)
+ movl $-2, %eax
+ movslq %eax, %rax
+ subq $-2, %rax
+ cmpq $4, %rax
+ ja .rango_main
+ pushq %rax
+ movl $-2, %eax
+ cvtsi2ssl %eax, %xmm0
+ movss %xmm0, -20(%rbp)
+ movss ._CF3fc00000(%rip), %xmm0
+ movss %xmm0, -24(%rbp)
+ movss -20(%rbp), %xmm1
+ movss -24(%rbp), %xmm0
+ mulss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ popq %rcx
+ leaq f(%rip), %rdx
+ movss %xmm0, (%rdx,%rcx,4)
+ movl $-1, %eax
+ movl %eax, i(%rip)
+ movl $-1, %eax
+ movslq %eax, %rax
+ subq $-2, %rax
+ cmpq $4, %rax
+ ja .rango_main
+ pushq %rax
+ movl $-1, %eax
+ cvtsi2ssl %eax, %xmm0
+ movss %xmm0, -28(%rbp)
+ movss ._CF3fc00000(%rip), %xmm0
+ movss %xmm0, -32(%rbp)
+ movss -28(%rbp), %xmm1
+ movss -32(%rbp), %xmm0
+ mulss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ popq %rcx
+ leaq f(%rip), %rdx
+ movss %xmm0, (%rdx,%rcx,4)
+ movl $0, %eax
+ movl %eax, i(%rip)
+ movl $0, %eax
+ movslq %eax, %rax
+ subq $-2, %rax
+ cmpq $4, %rax
+ ja .rango_main
+ pushq %rax
+ movl $0, %eax
+ cvtsi2ssl %eax, %xmm0
+ movss %xmm0, -36(%rbp)
+ movss ._CF3fc00000(%rip), %xmm0
+ movss %xmm0, -40(%rbp)
+ movss -36(%rbp), %xmm1
+ movss -40(%rbp), %xmm0
+ mulss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ popq %rcx
+ leaq f(%rip), %rdx
+ movss %xmm0, (%rdx,%rcx,4)
+ movl $1, %eax
+ movl %eax, i(%rip)
+ movl $1, %eax
+ movslq %eax, %rax
+ subq $-2, %rax
+ cmpq $4, %rax
+ ja .rango_main
+ pushq %rax
+ movl $1, %eax
+ cvtsi2ssl %eax, %xmm0
+ movss %xmm0, -44(%rbp)
+ movss ._CF3fc00000(%rip), %xmm0
+ movss %xmm0, -48(%rbp)
+ movss -44(%rbp), %xmm1
+ movss -48(%rbp), %xmm0
+ mulss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ popq %rcx
+ leaq f(%rip), %rdx
+ movss %xmm0, (%rdx,%rcx,4)
+ movl $2, %eax
+ movl %eax, i(%rip)
+ movl $2, %eax
+ movslq %eax, %rax
+ subq $-2, %rax
+ cmpq $4, %rax
+ ja .rango_main
+ pushq %rax
+ movl $2, %eax
+ cvtsi2ssl %eax, %xmm0
+ movss %xmm0, -52(%rbp)
+ movss ._CF3fc00000(%rip), %xmm0
+ movss %xmm0, -56(%rbp)
+ movss -52(%rbp), %xmm1
+ movss -56(%rbp), %xmm0
+ mulss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ popq %rcx
+ leaq f(%rip), %rdx
+ movss %xmm0, (%rdx,%rcx,4)
+ movl $2, %eax
+ movslq %eax, %rax
+ leaq f(%rip), %rdx
+ movss 8(%rdx,%rax,4), %xmm0
+ movss %xmm0, -60(%rbp)
+ movl $-2, %eax
+ movslq %eax, %rax
+ leaq f(%rip), %rdx
+ movss 8(%rdx,%rax,4), %xmm0
+ movss %xmm0, -64(%rbp)
+ movss -60(%rbp), %xmm1
+ movss -64(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -68(%rbp)
+ movl $1, %eax
+ movslq %eax, %rax
+ leaq f(%rip), %rdx
+ movss 8(%rdx,%rax,4), %xmm0
+ movss %xmm0, -72(%rbp)
+ movss -68(%rbp), %xmm1
+ movss -72(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ call write_f32
+ movl $64, %eax
+ movq %rax, -80(%rbp)
+ movq -80(%rbp), %rdi
+ call suma
+ movq %rax, %rdi
+ call write_i64
+ movl $1, %eax
+ movq %rax, -88(%rbp)
+ movq -88(%rbp), %rdi
+ call matmul
+ movq %rax, %rdi
+ call write_i64
+ movl $3, %eax
+ movl %eax, i(%rip)
+ movl i(%rip), %eax
+ pushq %rax
+ movl $30, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $99, %rax
+ ja .rango_main
+ leaq v(%rip), %rdx
+ movl (%rdx,%rax,4), %eax
+ movl %eax, %edi
+ call write_i32
+ movl $65, %eax
+ movq %rax, -96(%rbp)
+ movq -96(%rbp), %rdi
+ call suma
+ movq %rax, %rdi
+ call write_i64
+.end_main:
+ leave
+ popq %r13
+ popq %r12
+ ret
+.rango_main:
+ andq $-16, %rsp
+ movq stderr@GOTPCREL(%rip), %rdi
+ movq (%rdi), %rdi
+ leaq .rango_msg_main(%rip), %rsi
+ movl $0, %eax
+ call fprintf@PLT
+ movl $1, %edi
+ call exit@PLT
+ .pushsection .rodata
+.rango_msg_main: .string "Error: indice fuera de rango en main\n"
+ .popsection
+
+# Runtime de escritura (ver runtime.h)
+.bss
+.p2align 6
+.Lesc_buf: .zero 1048576
+.data
+.p2align 3
+.Lesc_pos: .quad .Lesc_buf
+.section .rodata
+.p2align 3
+.Lesc_millon: .double 1000000.0
+.Lesc_limite: .double 9.0e12
+.Lesc_limite_d: .double 3.0e7
+.Lesc_casi_medio: .double 0.49609375
+.Lesc_fmt_f: .string "%f \n"
+.Lesc_pot10: .quad 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000, 10000000000, 100000000000, 1000000000000, 10000000000000, 100000000000000, 1000000000000000, 10000000000000000, 100000000000000000, 1000000000000000000, 10000000000000000000
+.Lesc_pares: .ascii "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899"
+.section .fini_array,"aw"
+.p2align 3
+.quad write_flush
+.text
+
+# Vacía el buffer con write(1, ...); reintenta si la escritura es parcial o
+# se interrumpe (EINTR) y descarta el resto ante cualquier otro error
+write_flush:
+ leaq .Lesc_buf(%rip), %rsi
+ movq .Lesc_pos(%rip), %rdx
+ subq %rsi, %rdx
+1:
+ testq %rdx, %rdx
+ jle 2f
+ movl $1, %eax
+ movl $1, %edi
+ syscall
+ cmpq $-4, %rax
+ je 1b
+ testq %rax, %rax
+ jle 2f
+ addq %rax, %rsi
+ subq %rax, %rdx
+ jmp 1b
+2:
+ leaq .Lesc_buf(%rip), %rax
+ movq %rax, .Lesc_pos(%rip)
+ ret
+
+# %rdi = posición en el buffer con al menos 320 bytes libres (vacía el
+# buffer si hace falta); conserva %rax y %xmm0. Lo más largo que se escribe
+# es un double con "%f \n": signo, 309 dígitos enteros, '.', 6 decimales,
+# " \n" y el 0 final de snprintf, 320 bytes.
+.Lesc_espacio:
+ movq .Lesc_pos(%rip), %rdi
+ leaq .Lesc_buf+1048576-320(%rip), %rcx
+ cmpq %rcx, %rdi
+ jbe 1f
+ pushq %rax
+ call write_flush
+ popq %rax
+ movq .Lesc_pos(%rip), %rdi
+1:
+ ret
+
+# Dígitos decimales de %rax (sin signo) en (%rdi); deja %rdi tras el
+# último. La longitud sale de log2 (bsr) * log10(2) corregido con una tabla
+# de potencias de 10; los dígitos se escriben de atrás hacia adelante, de a
+# dos por división entre 100 (multiplicación por el inverso)
+.Lesc_dec:
+ cmpq $10, %rax
+ jae 1f
+ addl $48, %eax
+ movb %al, (%rdi)
+ addq $1, %rdi
+ ret
+1:
+ bsrq %rax, %rcx
+ addl $1, %ecx
+ imull $1233, %ecx, %ecx
+ shrl $12, %ecx
+ leaq .Lesc_pot10(%rip), %r8
+ cmpq (%r8,%rcx,8), %rax
+ sbbq $-1, %rcx
+ addq %rcx, %rdi
+ movq %rdi, %r9
+ movabsq $0x28F5C28F5C28F5C3, %r10
+ leaq .Lesc_pares(%rip), %r11
+2:
+ cmpq $100, %rax
+ jb 3f
+ movq %rax, %rcx
+ shrq $2, %rax
+ mulq %r10
+ shrq $2, %rdx
+ imulq $100, %rdx, %rax
+ subq %rax, %rcx
+ movzwl (%r11,%rcx,2), %ecx
+ movw %cx, -2(%r9)
+ subq $2, %r9
+ movq %rdx, %rax
+ jmp 2b
+3:
+ cmpq $10, %rax
+ jb 4f
+ movzwl (%r11,%rax,2), %ecx
+ movw %cx, -2(%r9)
+ ret
+4:
+ addl $48, %eax
+ movb %al, -1(%r9)
+ ret
+
+write_i32:
+ movslq %edi, %rax
+ jmp .Lesc_entero
+write_u32:
+ movl %edi, %eax
+ call .Lesc_espacio
+ jmp .Lesc_digitos
+write_i64:
+ movq %rdi, %rax
+.Lesc_entero:
+ call .Lesc_espacio
+ testq %rax, %rax
+ jns .Lesc_digitos
+ movb $45, (%rdi)
+ addq $1, %rdi
+ negq %rax
+.Lesc_digitos:
+ call .Lesc_dec
+ movw $0x0a20, (%rdi)
+ addq $2, %rdi
+ movq %rdi, .Lesc_pos(%rip)
+ ret
+
+# Como printf("%f"): |x| * 10^6 es exacto en double para cualquier float
+# (24 bits de mantisa por 20 de 10^6), así que redondear ese producto al
+# entero (al par, como printf) da los 6 decimales exactos. Infinito, NaN y
+# |x| >= 9e12 (el producto no cabe en 63 bits) van por snprintf.
+write_f32:
+ cvtss2sd %xmm0, %xmm0
+ call .Lesc_espacio
+ movq %xmm0, %rax
+ btrq $63, %rax
+ movq %rax, %xmm1
+ ucomisd .Lesc_limite(%rip), %xmm1
+ jp .Lesc_f_lento
+ jae .Lesc_f_lento
+ movmskpd %xmm0, %eax
+ testl $1, %eax
+ jz 1f
+ movb $45, (%rdi)
+ addq $1, %rdi
+1:
+ mulsd .Lesc_millon(%rip), %xmm1
+ cvtsd2si %xmm1, %rax
+ jmp .Lesc_f_digitos
+
+# En double el producto |x| * 10^6 se redondea; con |x| < 3e7 queda por
+# debajo de 2^45 y el error es a lo sumo 2^-9, así que su redondeo al
+# entero coincide con el del valor exacto salvo que la parte fraccionaria
+# quede a menos de 2^-8 de 0.5. Ese caso y |x| >= 3e7 van por snprintf.
+write_f64:
+ call .Lesc_espacio
+ movq %xmm0, %rax
+ btrq $63, %rax
+ movq %rax, %xmm1
+ ucomisd .Lesc_limite_d(%rip), %xmm1
+ jp .Lesc_f_lento
+ jae .Lesc_f_lento
+ mulsd .Lesc_millon(%rip), %xmm1
+ cvtsd2si %xmm1, %rax
+ cvtsi2sdq %rax, %xmm2
+ subsd %xmm2, %xmm1
+ movq %xmm1, %rdx
+ btrq $63, %rdx
+ movq %rdx, %xmm1
+ ucomisd .Lesc_casi_medio(%rip), %xmm1
+ jae .Lesc_f_lento
+ movmskpd %xmm0, %ecx
+ testl $1, %ecx
+ jz .Lesc_f_digitos
+ movb $45, (%rdi)
+ addq $1, %rdi
+.Lesc_f_digitos:
+ xorl %edx, %edx
+ movl $1000000, %ecx
+ divq %rcx
+ movq %rdx, %rsi
+ call .Lesc_dec
+ leaq 1000000(%rsi), %rax
+ movq %rdi, %rsi
+ call .Lesc_dec
+ movb $46, (%rsi)
+ movw $0x0a20, (%rdi)
+ addq $2, %rdi
+ movq %rdi, .Lesc_pos(%rip)
+ ret
+.Lesc_f_lento:
+ pushq %rbx
+ movq %rdi, %rbx
+ movl $320, %esi
+ leaq .Lesc_fmt_f(%rip), %rdx
+ movl $1, %eax
+ call snprintf@PLT
+ cltq
+ addq %rax, %rbx
+ movq %rbx, .Lesc_pos(%rip)
+ popq %rbx
+ ret
+
+# Constantes de punto flotante (float 32 bits)
+.section .rodata
+.p2align 2
+._CF3fc00000: .long 0x3fc00000
+.section .note.GNU-stack,"",@progbits
@@ -0,0 +1,1000 @@
+.data
+gs: .long 0
+.bss
+.p2align 3
+ga: .zero 412
+.p2align 3
+gb: .zero 412
+.p2align 3
+gi: .zero 400
+.text
+.globl elem
+elem:
+ pushq %r12
+ pushq %r13
+ pushq %rbp
+ movq %rsp, %rbp
+ movq %rdi, -8(%rbp)
+ movss %xmm0, -16(%rbp)
+ subq $1280, %rsp
+ movl $0, %eax
+ pushq %rax
+ movl $99, %eax
+ popq %rcx
+ movslq %eax, %rax
+ movslq %ecx, %rcx
+ subq %rcx, %rax
+ addq $1, %rax
+ jle endfor_elem_0
+ movl %ecx, %r12d
+ movq %rax, %r13
+for_elem_0:
+ movl %r12d, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl %r12d, %eax
+ cvtsi2ssl %eax, %xmm0
+ movss %xmm0, -1236(%rbp)
+ movss ._CF3f000000(%rip), %xmm0
+ movss %xmm0, -1240(%rbp)
+ movss -1236(%rbp), %xmm1
+ movss -1240(%rbp), %xmm0
+ mulss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ popq %rcx
+ movss %xmm0, -416(%rbp,%rcx,4)
+ movl %r12d, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl $100, %eax
+ pushq %rax
+ movl %r12d, %eax
+ movl %eax, %ecx
+ popq %rax
+ subl %ecx, %eax
+ cvtsi2ssl %eax, %xmm0
+ popq %rcx
+ movss %xmm0, -816(%rbp,%rcx,4)
+ movl %r12d, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl $1, %eax
+ cvtsi2ssl %eax, %xmm0
+ popq %rcx
+ movss %xmm0, -1216(%rbp,%rcx,4)
+ incl %r12d
+ decq %r13
+ jnz for_elem_0
+ decl %r12d
+ movl %r12d, -1220(%rbp)
+endfor_elem_0:
+ movl $0, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ pushq %rax
+ movl $1, %eax
+ movl %eax, %ecx
+ popq %rax
+ subl %ecx, %eax
+ popq %rcx
+ movslq %eax, %rax
+ movslq %ecx, %rcx
+ subq %rcx, %rax
+ addq $1, %rax
+ jle endfor_elem_1
+ movl %ecx, %r12d
+ movq %rax, %r13
+ cmpq $4, %rax
+ jl for_elem_1
+ leaq 0(%rcx), %rdx
+ cmpq $99, %rdx
+ ja for_elem_1
+ leaq -1(%rcx,%rax), %rdx
+ cmpq $99, %rdx
+ ja for_elem_1
+ leaq 0(%rcx), %rdx
+ cmpq $99, %rdx
+ ja for_elem_1
+ leaq -1(%rcx,%rax), %rdx
+ cmpq $99, %rdx
+ ja for_elem_1
+ leaq 0(%rcx), %rdx
+ cmpq $99, %rdx
+ ja for_elem_1
+ leaq -1(%rcx,%rax), %rdx
+ cmpq $99, %rdx
+ ja for_elem_1
+ movss -16(%rbp), %xmm0
+ movaps %xmm0, %xmm8
+ shufps $0, %xmm8, %xmm8
+ movslq %r12d, %rcx
+ movq %r13, %rsi
+ shrq $2, %rsi
+vfor_elem_2:
+ movups -416(%rbp,%rcx,4), %xmm0
+ movups -816(%rbp,%rcx,4), %xmm1
+ mulps %xmm1, %xmm0
+ movaps %xmm8, %xmm1
+ movups -816(%rbp,%rcx,4), %xmm2
+ divps %xmm2, %xmm1
+ addps %xmm1, %xmm0
+ movups -416(%rbp,%rcx,4), %xmm1
+ subps %xmm1, %xmm0
+ movups %xmm0, -1216(%rbp,%rcx,4)
+ addq $4, %rcx
+ decq %rsi
+ jnz vfor_elem_2
+ movl %ecx, %r12d
+ andq $3, %r13
+ jz salfor_elem_1
+for_elem_1:
+ movl %r12d, %eax
+ movslq %eax, %rax
+ cmpq $99, %rax
+ ja .rango_elem
+ pushq %rax
+ movl %r12d, %eax
+ movslq %eax, %rax
+ cmpq $99, %rax
+ ja .rango_elem
+ movss -416(%rbp,%rax,4), %xmm0
+ movss %xmm0, -1244(%rbp)
+ movl %r12d, %eax
+ movslq %eax, %rax
+ cmpq $99, %rax
+ ja .rango_elem
+ movss -816(%rbp,%rax,4), %xmm0
+ movss %xmm0, -1248(%rbp)
+ movss -1244(%rbp), %xmm1
+ movss -1248(%rbp), %xmm0
+ mulss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -1252(%rbp)
+ movss -16(%rbp), %xmm0
+ movss %xmm0, -1256(%rbp)
+ movl %r12d, %eax
+ movslq %eax, %rax
+ cmpq $99, %rax
+ ja .rango_elem
+ movss -816(%rbp,%rax,4), %xmm0
+ movss %xmm0, -1260(%rbp)
+ movss -1256(%rbp), %xmm1
+ movss -1260(%rbp), %xmm0
+ divss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -1264(%rbp)
+ movss -1252(%rbp), %xmm1
+ movss -1264(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -1268(%rbp)
+ movl %r12d, %eax
+ movslq %eax, %rax
+ cmpq $99, %rax
+ ja .rango_elem
+ movss -416(%rbp,%rax,4), %xmm0
+ movss %xmm0, -1272(%rbp)
+ movss -1268(%rbp), %xmm1
+ movss -1272(%rbp), %xmm0
+ subss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ popq %rcx
+ movss %xmm0, -1216(%rbp,%rcx,4)
+ incl %r12d
+ decq %r13
+ jnz for_elem_1
+salfor_elem_1:
+ decl %r12d
+ movl %r12d, -1220(%rbp)
+endfor_elem_1:
+ movl $0, %eax
+ cvtsi2ssl %eax, %xmm0
+ movss %xmm0, -1224(%rbp)
+ movl $0, %eax
+ pushq %rax
+ movl $99, %eax
+ popq %rcx
+ movslq %eax, %rax
+ movslq %ecx, %rcx
+ subq %rcx, %rax
+ addq $1, %rax
+ jle endfor_elem_3
+ movl %ecx, %r12d
+ movq %rax, %r13
+for_elem_3:
+ movss -1224(%rbp), %xmm0
+ movss %xmm0, -1276(%rbp)
+ movl %r12d, %eax
+ movslq %eax, %rax
+ movss -1216(%rbp,%rax,4), %xmm0
+ movss %xmm0, -1280(%rbp)
+ movss -1276(%rbp), %xmm1
+ movss -1280(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -1224(%rbp)
+ incl %r12d
+ decq %r13
+ jnz for_elem_3
+ decl %r12d
+ movl %r12d, -1220(%rbp)
+endfor_elem_3:
+ movss -1224(%rbp), %xmm0
+.end_elem:
+ leave
+ popq %r13
+ popq %r12
+ ret
+.rango_elem:
+ andq $-16, %rsp
+ movq stderr@GOTPCREL(%rip), %rdi
+ movq (%rdi), %rdi
+ leaq .rango_msg_elem(%rip), %rsi
+ movl $0, %eax
+ call fprintf@PLT
+ movl $1, %edi
+ call exit@PLT
+ .pushsection .rodata
+.rango_msg_elem: .string "Error: indice fuera de rango en elem\n"
+ .popsection
+.globl red
+red:
+ pushq %r12
+ pushq %r13
+ pushq %rbp
+ movq %rsp, %rbp
+ movq %rdi, -8(%rbp)
+ subq $432, %rsp
+ movl $0, %eax
+ pushq %rax
+ movl $99, %eax
+ popq %rcx
+ movslq %eax, %rax
+ movslq %ecx, %rcx
+ subq %rcx, %rax
+ addq $1, %rax
+ jle endfor_red_0
+ movl %ecx, %r12d
+ movq %rax, %r13
+for_red_0:
+ movl %r12d, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl %r12d, %eax
+ pushq %rax
+ movl $37, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl $101, %eax
+ movl %eax, %ecx
+ popq %rax
+ cltd
+ idivl %ecx
+ movl %edx, %eax
+ pushq %rax
+ movl $50, %eax
+ movl %eax, %ecx
+ popq %rax
+ subl %ecx, %eax
+ popq %rcx
+ movl %eax, -408(%rbp,%rcx,4)
+ incl %r12d
+ decq %r13
+ jnz for_red_0
+ decl %r12d
+ movl %r12d, -412(%rbp)
+endfor_red_0:
+ movl $7, %eax
+ movl %eax, -416(%rbp)
+ movl $1000, %eax
+ movl %eax, -420(%rbp)
+ movl $-1000, %eax
+ movl %eax, -424(%rbp)
+ movl $0, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ pushq %rax
+ movl $1, %eax
+ movl %eax, %ecx
+ popq %rax
+ subl %ecx, %eax
+ popq %rcx
+ movslq %eax, %rax
+ movslq %ecx, %rcx
+ subq %rcx, %rax
+ addq $1, %rax
+ jle endfor_red_1
+ movl %ecx, %r12d
+ movq %rax, %r13
+for_red_1:
+ movl -416(%rbp), %eax
+ pushq %rax
+ movl %r12d, %eax
+ movslq %eax, %rax
+ cmpq $99, %rax
+ ja .rango_red
+ movl -408(%rbp,%rax,4), %eax
+ pushq %rax
+ movl $3, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movl %eax, -416(%rbp)
+ movl %r12d, %eax
+ movslq %eax, %rax
+ cmpq $99, %rax
+ ja .rango_red
+ movl -408(%rbp,%rax,4), %eax
+ pushq %rax
+ movl -420(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ cmpl %ecx, %eax
+ movl $0, %eax
+ setl %al
+ movzbq %al, %rax
+ cmpq $0, %rax
+ je else_red_2
+ movl %r12d, %eax
+ movslq %eax, %rax
+ cmpq $99, %rax
+ ja .rango_red
+ movl -408(%rbp,%rax,4), %eax
+ movl %eax, -420(%rbp)
+ jmp endif_red_2
+else_red_2:
+endif_red_2:
+ movl -424(%rbp), %eax
+ pushq %rax
+ movl %r12d, %eax
+ movslq %eax, %rax
+ cmpq $99, %rax
+ ja .rango_red
+ movl -408(%rbp,%rax,4), %eax
+ pushq %rax
+ movl $1, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ cmpl %ecx, %eax
+ movl $0, %eax
+ setl %al
+ movzbq %al, %rax
+ cmpq $0, %rax
+ je else_red_3
+ movl %r12d, %eax
+ movslq %eax, %rax
+ cmpq $99, %rax
+ ja .rango_red
+ movl -408(%rbp,%rax,4), %eax
+ pushq %rax
+ movl $1, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movl %eax, -424(%rbp)
+ jmp endif_red_3
+else_red_3:
+endif_red_3:
+ incl %r12d
+ decq %r13
+ jnz for_red_1
+ decl %r12d
+ movl %r12d, -412(%rbp)
+endfor_red_1:
+ movl -416(%rbp), %eax
+ pushq %rax
+ movl $1000000, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ pushq %rax
+ movl -420(%rbp), %eax
+ pushq %rax
+ movl $1000, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl -424(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+.end_red:
+ leave
+ popq %r13
+ popq %r12
+ ret
+.rango_red:
+ andq $-16, %rsp
+ movq stderr@GOTPCREL(%rip), %rdi
+ movq (%rdi), %rdi
+ leaq .rango_msg_red(%rip), %rsi
+ movl $0, %eax
+ call fprintf@PLT
+ movl $1, %edi
+ call exit@PLT
+ .pushsection .rodata
+.rango_msg_red: .string "Error: indice fuera de rango en red\n"
+ .popsection
+.globl fmin
+fmin:
+ pushq %r12
+ pushq %r13
+ pushq %rbp
+ movq %rsp, %rbp
+ movq %rdi, -8(%rbp)
+ subq $48, %rsp
+ movl $1000, %eax
+ cvtsi2ssl %eax, %xmm0
+ movss %xmm0, -16(%rbp)
+ movl $2, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ popq %rcx
+ movslq %eax, %rax
+ movslq %ecx, %rcx
+ subq %rcx, %rax
+ addq $1, %rax
+ jle endfor_fmin_0
+ movl %ecx, %r12d
+ movq %rax, %r13
+for_fmin_0:
+ movl %r12d, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $102, %rax
+ ja .rango_fmin
+ leaq ga(%rip), %rdx
+ movss (%rdx,%rax,4), %xmm0
+ movss %xmm0, -28(%rbp)
+ movl %r12d, %eax
+ pushq %rax
+ movl $1, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $102, %rax
+ ja .rango_fmin
+ leaq gb(%rip), %rdx
+ movss (%rdx,%rax,4), %xmm0
+ movss %xmm0, -32(%rbp)
+ movss -28(%rbp), %xmm1
+ movss -32(%rbp), %xmm0
+ mulss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ subq $8, %rsp
+ movss %xmm0, (%rsp)
+ movss -16(%rbp), %xmm0
+ movss (%rsp), %xmm1
+ addq $8, %rsp
+ ucomiss %xmm1, %xmm0
+ movl $0, %eax
+ seta %al
+ movzbq %al, %rax
+ cmpq $0, %rax
+ je else_fmin_1
+ movl %r12d, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $102, %rax
+ ja .rango_fmin
+ leaq ga(%rip), %rdx
+ movss (%rdx,%rax,4), %xmm0
+ movss %xmm0, -36(%rbp)
+ movl %r12d, %eax
+ pushq %rax
+ movl $1, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $102, %rax
+ ja .rango_fmin
+ leaq gb(%rip), %rdx
+ movss (%rdx,%rax,4), %xmm0
+ movss %xmm0, -40(%rbp)
+ movss -36(%rbp), %xmm1
+ movss -40(%rbp), %xmm0
+ mulss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -16(%rbp)
+ jmp endif_fmin_1
+else_fmin_1:
+endif_fmin_1:
+ incl %r12d
+ decq %r13
+ jnz for_fmin_0
+ decl %r12d
+ movl %r12d, -12(%rbp)
+endfor_fmin_0:
+ movss -16(%rbp), %xmm0
+.end_fmin:
+ leave
+ popq %r13
+ popq %r12
+ ret
+.rango_fmin:
+ andq $-16, %rsp
+ movq stderr@GOTPCREL(%rip), %rdi
+ movq (%rdi), %rdi
+ leaq .rango_msg_fmin(%rip), %rsi
+ movl $0, %eax
+ call fprintf@PLT
+ movl $1, %edi
+ call exit@PLT
+ .pushsection .rodata
+.rango_msg_fmin: .string "Error: indice fuera de rango en fmin\n"
+ .popsection
+.globl main
+main:
+ pushq %r12
+ pushq %r13
+ pushq %rbp
+ movq %rsp, %rbp
+ subq $96, %rsp
+ movl $99, %eax
+ movq %rax, -16(%rbp)
+ movss ._CF40200000(%rip), %xmm0
+ movss %xmm0, -24(%rbp)
+ movq -16(%rbp), %rdi
+ movss -24(%rbp), %xmm0
+ call elem
+ call write_f32
+ movl $37, %eax
+ movq %rax, -32(%rbp)
+ movss ._CF3e800000(%rip), %xmm0
+ movss %xmm0, -40(%rbp)
+ movq -32(%rbp), %rdi
+ movss -40(%rbp), %xmm0
+ call elem
+ call write_f32
+ movl $100, %eax
+ movq %rax, -48(%rbp)
+ movq -48(%rbp), %rdi
+ call red
+ movl %eax, %edi
+ call write_i32
+ movl $13, %eax
+ movq %rax, -56(%rbp)
+ movq -56(%rbp), %rdi
+ call red
+ movl %eax, %edi
+ call write_i32
+ movl $3, %eax
+ movq %rax, -64(%rbp)
+ movq -64(%rbp), %rdi
+ call red
+ movl %eax, %edi
+ call write_i32
+ movl $1, %eax
+ pushq %rax
+ movl $103, %eax
+ popq %rcx
+ movslq %eax, %rax
+ movslq %ecx, %rcx
+ subq %rcx, %rax
+ addq $1, %rax
+ jle endfor_main_0
+ movl %ecx, gs(%rip)
+ movq %rax, -8(%rbp)
+for_main_0:
+ movl gs(%rip), %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $102, %rax
+ ja .rango_main
+ pushq %rax
+ movl gs(%rip), %eax
+ pushq %rax
+ movl $50, %eax
+ movl %eax, %ecx
+ popq %rax
+ subl %ecx, %eax
+ cvtsi2ssl %eax, %xmm0
+ popq %rcx
+ leaq ga(%rip), %rdx
+ movss %xmm0, (%rdx,%rcx,4)
+ movl gs(%rip), %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $102, %rax
+ ja .rango_main
+ pushq %rax
+ movl gs(%rip), %eax
+ cvtsi2ssl %eax, %xmm0
+ movss %xmm0, -68(%rbp)
+ movss ._CF3e800000(%rip), %xmm0
+ movss %xmm0, -72(%rbp)
+ movss -68(%rbp), %xmm1
+ movss -72(%rbp), %xmm0
+ mulss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ popq %rcx
+ leaq gb(%rip), %rdx
+ movss %xmm0, (%rdx,%rcx,4)
+ incl gs(%rip)
+ decq -8(%rbp)
+ jnz for_main_0
+ decl gs(%rip)
+endfor_main_0:
+ movl $1, %eax
+ pushq %rax
+ movl $100, %eax
+ popq %rcx
+ movslq %eax, %rax
+ movslq %ecx, %rcx
+ subq %rcx, %rax
+ addq $1, %rax
+ jle endfor_main_1
+ movl %ecx, gs(%rip)
+ movq %rax, -8(%rbp)
+ cmpq $4, %rax
+ jl for_main_1
+ leaq -1(%rcx), %rdx
+ cmpq $102, %rdx
+ ja for_main_1
+ leaq -2(%rcx,%rax), %rdx
+ cmpq $102, %rdx
+ ja for_main_1
+ leaq 2(%rcx), %rdx
+ cmpq $102, %rdx
+ ja for_main_1
+ leaq 1(%rcx,%rax), %rdx
+ cmpq $102, %rdx
+ ja for_main_1
+ movl $2, %eax
+ cvtsi2ssl %eax, %xmm0
+ movaps %xmm0, %xmm8
+ shufps $0, %xmm8, %xmm8
+ leaq ga(%rip), %r8
+ leaq gb(%rip), %r9
+ movslq gs(%rip), %rcx
+ movq -8(%rbp), %rsi
+ shrq $2, %rsi
+vfor_main_2:
+ movups -4(%r8,%rcx,4), %xmm0
+ movups 8(%r9,%rcx,4), %xmm1
+ mulps %xmm8, %xmm1
+ addps %xmm1, %xmm0
+ movups %xmm0, -4(%r8,%rcx,4)
+ addq $4, %rcx
+ decq %rsi
+ jnz vfor_main_2
+ movl %ecx, gs(%rip)
+ andq $3, -8(%rbp)
+ jz salfor_main_1
+for_main_1:
+ movl gs(%rip), %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $102, %rax
+ ja .rango_main
+ pushq %rax
+ movl gs(%rip), %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $102, %rax
+ ja .rango_main
+ leaq ga(%rip), %rdx
+ movss (%rdx,%rax,4), %xmm0
+ movss %xmm0, -76(%rbp)
+ movl gs(%rip), %eax
+ pushq %rax
+ movl $3, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $102, %rax
+ ja .rango_main
+ leaq gb(%rip), %rdx
+ movss (%rdx,%rax,4), %xmm0
+ movss %xmm0, -80(%rbp)
+ movl $2, %eax
+ cvtsi2ssl %eax, %xmm0
+ movss %xmm0, -84(%rbp)
+ movss -80(%rbp), %xmm1
+ movss -84(%rbp), %xmm0
+ mulss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -88(%rbp)
+ movss -76(%rbp), %xmm1
+ movss -88(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ popq %rcx
+ leaq ga(%rip), %rdx
+ movss %xmm0, (%rdx,%rcx,4)
+ incl gs(%rip)
+ decq -8(%rbp)
+ jnz for_main_1
+salfor_main_1:
+ decl gs(%rip)
+endfor_main_1:
+ movl $101, %eax
+ movq %rax, -96(%rbp)
+ movq -96(%rbp), %rdi
+ call fmin
+ call write_f32
+ movl $0, %eax
+ pushq %rax
+ movl $99, %eax
+ popq %rcx
+ movslq %eax, %rax
+ movslq %ecx, %rcx
+ subq %rcx, %rax
+ addq $1, %rax
+ jle endfor_main_3
+ movl %ecx, gs(%rip)
+ movq %rax, -8(%rbp)
+for_main_3:
+ movl gs(%rip), %eax
+ movslq %eax, %rax
+ cmpq $99, %rax
+ ja .rango_main
+ pushq %rax
+ movl gs(%rip), %eax
+ popq %rcx
+ leaq gi(%rip), %rdx
+ movl %eax, (%rdx,%rcx,4)
+ incl gs(%rip)
+ decq -8(%rbp)
+ jnz for_main_3
+ decl gs(%rip)
+endfor_main_3:
+ movl gs(%rip), %eax
+ movl %eax, %edi
+ call write_i32
+.end_main:
+ leave
+ popq %r13
+ popq %r12
+ ret
+.rango_main:
+ andq $-16, %rsp
+ movq stderr@GOTPCREL(%rip), %rdi
+ movq (%rdi), %rdi
+ leaq .rango_msg_main(%rip), %rsi
+ movl $0, %eax
+ call fprintf@PLT
+ movl $1, %edi
+ call exit@PLT
+ .pushsection .rodata
+.rango_msg_main: .string "Error: indice fuera de rango en main\n"
+ .popsection
+
+# Runtime de escritura (ver runtime.h)
+.bss
+.p2align 6
+.Lesc_buf: .zero 1048576
+.data
+.p2align 3
+.Lesc_pos: .quad .Lesc_buf
+.section .rodata
+.p2align 3
+.Lesc_millon: .double 1000000.0
+.Lesc_limite: .double 9.0e12
+.Lesc_limite_d: .double 3.0e7
+.Lesc_casi_medio: .double 0.49609375
+.Lesc_fmt_f: .string "%f \n"
+.Lesc_pot10: .quad 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000, 10000000000, 100000000000, 1000000000000, 10000000000000, 100000000000000, 1000000000000000, 10000000000000000, 100000000000000000, 1000000000000000000, 10000000000000000000
+.Lesc_pares: .ascii "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899"
+.section .fini_array,"aw"
+.p2align 3
+.quad write_flush
+.text
+
+# Vacía el buffer con write(1, ...); reintenta si la escritura es parcial o
+# se interrumpe (EINTR) y descarta el resto ante cualquier otro error
+write_flush:
+ leaq .Lesc_buf(%rip), %rsi
+ movq .Lesc_pos(%rip), %rdx
+ subq %rsi, %rdx
+1:
+ testq %rdx, %rdx
+ jle 2f
+ movl $1, %eax
+ movl $1, %edi
+ syscall
+ cmpq $-4, %rax
+ je 1b
+ testq %rax, %rax
+ jle 2f
+ addq %rax, %rsi
+ subq %rax, %rdx
+ jmp 1b
+2:
+ leaq .Lesc_buf(%rip), %rax
+ movq %rax, .Lesc_pos(%rip)
+ ret
+
+# %rdi = posición en el buffer con al menos 320 bytes libres (vacía el
+# buffer si hace falta); conserva %rax y %xmm0. Lo más largo que se escribe
+# es un double con "%f \n": signo, 309 dígitos enteros, '.', 6 decimales,
+# " \n" y el 0 final de snprintf, 320 bytes.
+.Lesc_espacio:
+ movq .Lesc_pos(%rip), %rdi
+ leaq .Lesc_buf+1048576-320(%rip), %rcx
+ cmpq %rcx, %rdi
+ jbe 1f
+ pushq %rax
+ call write_flush
+ popq %rax
+ movq .Lesc_pos(%rip), %rdi
+1:
+ ret
+
+# Dígitos decimales de %rax (sin signo) en (%rdi); deja %rdi tras el
+# último. La longitud sale de log2 (bsr) * log10(2) corregido con una tabla
+# de potencias de 10; los dígitos se escriben de atrás hacia adelante, de a
+# dos por división entre 100 (multiplicación por el inverso)
+.Lesc_dec:
+ cmpq $10, %rax
+ jae 1f
+ addl $48, %eax
+ movb %al, (%rdi)
+ addq $1, %rdi
+ ret
+1:
+ bsrq %rax, %rcx
+ addl $1, %ecx
+ imull $1233, %ecx, %ecx
+ shrl $12, %ecx
+ leaq .Lesc_pot10(%rip), %r8
+ cmpq (%r8,%rcx,8), %rax
+ sbbq $-1, %rcx
+ addq %rcx, %rdi
+ movq %rdi, %r9
+ movabsq $0x28F5C28F5C28F5C3, %r10
+ leaq .Lesc_pares(%rip), %r11
+2:
+ cmpq $100, %rax
+ jb 3f
+ movq %rax, %rcx
+ shrq $2, %rax
+ mulq %r10
+ shrq $2, %rdx
+ imulq $100, %rdx, %rax
+ subq %rax, %rcx
+ movzwl (%r11,%rcx,2), %ecx
+ movw %cx, -2(%r9)
+ subq $2, %r9
+ movq %rdx, %rax
+ jmp 2b
+3:
+ cmpq $10, %rax
+ jb 4f
+ movzwl (%r11,%rax,2), %ecx
+ movw %cx, -2(%r9)
+ ret
+4:
+ addl $48, %eax
+ movb %al, -1(%r9)
+ ret
+
+write_i32:
+ movslq %edi, %rax
+ jmp .Lesc_entero
+write_u32:
+ movl %edi, %eax
+ call .Lesc_espacio
+ jmp .Lesc_digitos
+write_i64:
+ movq %rdi, %rax
+.Lesc_entero:
+ call .Lesc_espacio
+ testq %rax, %rax
+ jns .Lesc_digitos
+ movb $45, (%rdi)
+ addq $1, %rdi
+ negq %rax
+.Lesc_digitos:
+ call .Lesc_dec
+ movw $0x0a20, (%rdi)
+ addq $2, %rdi
+ movq %rdi, .Lesc_pos(%rip)
+ ret
+
+# Como printf("%f"): |x| * 10^6 es exacto en double para cualquier float
+# (24 bits de mantisa por 20 de 10^6), así que redondear ese producto al
+# entero (al par, como printf) da los 6 decimales exactos. Infinito, NaN y
+# |x| >= 9e12 (el producto no cabe en 63 bits) van por snprintf.
+write_f32:
+ cvtss2sd %xmm0, %xmm0
+ call .Lesc_espacio
+ movq %xmm0, %rax
+ btrq $63, %rax
+ movq %rax, %xmm1
+ ucomisd .Lesc_limite(%rip), %xmm1
+ jp .Lesc_f_lento
+ jae .Lesc_f_lento
+ movmskpd %xmm0, %eax
+ testl $1, %eax
+ jz 1f
+ movb $45, (%rdi)
+ addq $1, %rdi
+1:
+ mulsd .Lesc_millon(%rip), %xmm1
+ cvtsd2si %xmm1, %rax
+ jmp .Lesc_f_digitos
+
+# En double el producto |x| * 10^6 se redondea; con |x| < 3e7 queda por
+# debajo de 2^45 y el error es a lo sumo 2^-9, así que su redondeo al
+# entero coincide con el del valor exacto salvo que la parte fraccionaria
+# quede a menos de 2^-8 de 0.5. Ese caso y |x| >= 3e7 van por snprintf.
+write_f64:
+ call .Lesc_espacio
+ movq %xmm0, %rax
+ btrq $63, %rax
+ movq %rax, %xmm1
+ ucomisd .Lesc_limite_d(%rip), %xmm1
+ jp .Lesc_f_lento
+ jae .Lesc_f_lento
+ mulsd .Lesc_millon(%rip), %xmm1
+ cvtsd2si %xmm1, %rax
+ cvtsi2sdq %rax, %xmm2
+ subsd %xmm2, %xmm1
+ movq %xmm1, %rdx
+ btrq $63, %rdx
+ movq %rdx, %xmm1
+ ucomisd .Lesc_casi_medio(%rip), %xmm1
+ jae .Lesc_f_lento
+ movmskpd %xmm0, %ecx
+ testl $1, %ecx
+ jz .Lesc_f_digitos
+ movb $45, (%rdi)
+ addq $1, %rdi
+.Lesc_f_digitos:
+ xorl %edx, %edx
+ movl $1000000, %ecx
+ divq %rcx
+ movq %rdx, %rsi
+ call .Lesc_dec
+ leaq 1000000(%rsi), %rax
+ movq %rdi, %rsi
+ call .Lesc_dec
+ movb $46, (%rsi)
+ movw $0x0a20, (%rdi)
+ addq $2, %rdi
+ movq %rdi, .Lesc_pos(%rip)
+ ret
+.Lesc_f_lento:
+ pushq %rbx
+ movq %rdi, %rbx
+ movl $320, %esi
+ leaq .Lesc_fmt_f(%rip), %rdx
+ movl $1, %eax
+ call snprintf@PLT
+ cltq
+ addq %rax, %rbx
+ movq %rbx, .Lesc_pos(%rip)
+ popq %rbx
+ ret
+
+# Constantes de punto flotante (float 32 bits)
+.section .rodata
+.p2align 2
+._CF3f000000: .long 0x3f000000
+._CF40200000: .long 0x40200000
+._CF3e800000: .long 0x3e800000
+.section .note.GNU-stack,"",@progbits
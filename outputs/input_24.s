@@ -0,0 +1,695 @@
+.data
+g: .long 0
+q: .long 0
+r: .long 0
+total: .quad 0
+x: .float 0.0
+.bss
+.p2align 3
+a: .zero 20
+.text
+.globl divmod
+divmod:
+ pushq %rbp
+ movq %rsp, %rbp
+ movq %rdi, -8(%rbp)
+ movq %rsi, -16(%rbp)
+ movq %rdx, -24(%rbp)
+ movq %rcx, -32(%rbp)
+ subq $32, %rsp
+ movl -8(%rbp), %eax
+ pushq %rax
+ movl -16(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ cltd
+ idivl %ecx
+ movq -24(%rbp), %rdx
+ movl %eax, (%rdx)
+ movl -8(%rbp), %eax
+ pushq %rax
+ movq -24(%rbp), %rdx
+ movl (%rdx), %eax
+ pushq %rax
+ movl -16(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ subl %ecx, %eax
+ movq -32(%rbp), %rdx
+ movl %eax, (%rdx)
+ movl $0, %eax
+.end_divmod:
+ leave
+ ret
+.globl intercambiar
+intercambiar:
+ pushq %rbp
+ movq %rsp, %rbp
+ movq %rdi, -8(%rbp)
+ movq %rsi, -16(%rbp)
+ subq $32, %rsp
+ movq -8(%rbp), %rdx
+ movl (%rdx), %eax
+ movl %eax, -20(%rbp)
+ movq -16(%rbp), %rdx
+ movl (%rdx), %eax
+ movq -8(%rbp), %rdx
+ movl %eax, (%rdx)
+ movl -20(%rbp), %eax
+ movq -16(%rbp), %rdx
+ movl %eax, (%rdx)
+ movl $0, %eax
+.end_intercambiar:
+ leave
+ ret
+.globl acumular
+acumular:
+ pushq %rbp
+ movq %rsp, %rbp
+ movq %rdi, -8(%rbp)
+ movq %rsi, -16(%rbp)
+ subq $16, %rsp
+ movq -8(%rbp), %rdx
+ movq (%rdx), %rax
+ pushq %rax
+ movl -16(%rbp), %eax
+ movslq %eax, %rax
+ movq %rax, %rcx
+ popq %rax
+ addq %rcx, %rax
+ movq -8(%rbp), %rdx
+ movq %rax, (%rdx)
+ movl -16(%rbp), %eax
+.end_acumular:
+ leave
+ ret
+.globl escalar
+escalar:
+ pushq %rbp
+ movq %rsp, %rbp
+ movq %rdi, -8(%rbp)
+ movss %xmm0, -16(%rbp)
+ subq $32, %rsp
+ movq -8(%rbp), %rdx
+ movss (%rdx), %xmm0
+ movss %xmm0, -20(%rbp)
+ movss -16(%rbp), %xmm0
+ movss %xmm0, -24(%rbp)
+ movss -20(%rbp), %xmm1
+ movss -24(%rbp), %xmm0
+ mulss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movq -8(%rbp), %rdx
+ movss %xmm0, (%rdx)
+ movl $0, %eax
+.end_escalar:
+ leave
+ ret
+.globl incrementar
+incrementar:
+ pushq %rbp
+ movq %rsp, %rbp
+ movq %rdi, -8(%rbp)
+ subq $32, %rsp
+ movq -8(%rbp), %rdx
+ movl (%rdx), %eax
+ pushq %rax
+ movl $1, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movq -8(%rbp), %rdx
+ movl %eax, (%rdx)
+ movq -8(%rbp), %rax
+ movq %rax, -16(%rbp)
+ leaq g(%rip), %rax
+ movq %rax, -24(%rbp)
+ movq -16(%rbp), %rdi
+ movq -24(%rbp), %rsi
+ call intercambiar
+.end_incrementar:
+ leave
+ ret
+.globl doble
+doble:
+ pushq %rbp
+ movq %rsp, %rbp
+ movq %rdi, -8(%rbp)
+ subq $16, %rsp
+ movq -8(%rbp), %rdx
+ movl (%rdx), %eax
+ pushq %rax
+ movl $2, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+.end_doble:
+ leave
+ ret
+.globl dobles
+dobles:
+ pushq %r12
+ pushq %r13
+ pushq %rbp
+ movq %rsp, %rbp
+ movq %rdi, -8(%rbp)
+ subq $32, %rsp
+ movl $0, %eax
+ movl %eax, -16(%rbp)
+ movl $1, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ popq %rcx
+ movslq %eax, %rax
+ movslq %ecx, %rcx
+ subq %rcx, %rax
+ addq $1, %rax
+ jle endfor_dobles_0
+ movl %ecx, %r12d
+ movq %rax, %r13
+for_dobles_0:
+ movl -16(%rbp), %eax
+ pushq %rax
+ movl %r12d, -12(%rbp)
+ leaq -12(%rbp), %rax
+ movq %rax, -32(%rbp)
+ subq $8, %rsp
+ movq -32(%rbp), %rdi
+ call doble
+ addq $8, %rsp
+ movl -12(%rbp), %r12d
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movl %eax, -16(%rbp)
+ incl %r12d
+ decq %r13
+ jnz for_dobles_0
+ decl %r12d
+ movl %r12d, -12(%rbp)
+endfor_dobles_0:
+ movl -16(%rbp), %eax
+ pushq %rax
+ movl -12(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+.end_dobles:
+ leave
+ popq %r13
+ popq %r12
+ ret
+.globl sumaHasta
+sumaHasta:
+ pushq %r12
+ pushq %r13
+ pushq %rbp
+ movq %rsp, %rbp
+ movq %rdi, -8(%rbp)
+ subq $96, %rsp
+ movq $0, %rax
+ movq %rax, -28(%rbp)
+ movl $1, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ popq %rcx
+ movslq %eax, %rax
+ movslq %ecx, %rcx
+ subq %rcx, %rax
+ addq $1, %rax
+ jle endfor_sumaHasta_0
+ movl %ecx, %r12d
+ movq %rax, %r13
+for_sumaHasta_0:
+ leaq -28(%rbp), %rax
+ movq %rax, -44(%rbp)
+ movl %r12d, %eax
+ movq %rax, -52(%rbp)
+ movq -44(%rbp), %rdi
+ movq -52(%rbp), %rsi
+ call acumular
+ movl %eax, -16(%rbp)
+ movl %r12d, %eax
+ movq %rax, -60(%rbp)
+ movl $3, %eax
+ movq %rax, -68(%rbp)
+ leaq q(%rip), %rax
+ movq %rax, -76(%rbp)
+ leaq r(%rip), %rax
+ movq %rax, -84(%rbp)
+ movq -60(%rbp), %rdi
+ movq -68(%rbp), %rsi
+ movq -76(%rbp), %rdx
+ movq -84(%rbp), %rcx
+ call divmod
+ movl %eax, -20(%rbp)
+ movq -28(%rbp), %rax
+ pushq %rax
+ movl r(%rip), %eax
+ movslq %eax, %rax
+ movq %rax, %rcx
+ popq %rax
+ addq %rcx, %rax
+ movq %rax, -28(%rbp)
+ incl %r12d
+ decq %r13
+ jnz for_sumaHasta_0
+ decl %r12d
+ movl %r12d, -12(%rbp)
+endfor_sumaHasta_0:
+ movq -28(%rbp), %rax
+.end_sumaHasta:
+ leave
+ popq %r13
+ popq %r12
+ ret
+.globl main
+main:
+ pushq %rbp
+ movq %rsp, %rbp
+ subq $256, %rsp
+ movl $47, %eax
+ movq %rax, -8(%rbp)
+ movl $5, %eax
+ movq %rax, -16(%rbp)
+ leaq q(%rip), %rax
+ movq %rax, -24(%rbp)
+ leaq r(%rip), %rax
+ movq %rax, -32(%rbp)
+ movq -8(%rbp), %rdi
+ movq -16(%rbp), %rsi
+ movq -24(%rbp), %rdx
+ movq -32(%rbp), %rcx
+ call divmod
+ movl %eax, g(%rip)
+ movl q(%rip), %eax
+ movl %eax, %edi
+ call write_i32
+ movl r(%rip), %eax
+ movl %eax, %edi
+ call write_i32
+ movl $1, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl $10, %eax
+ popq %rcx
+ leaq a(%rip), %rdx
+ movl %eax, -4(%rdx,%rcx,4)
+ movl $2, %eax
+ movslq %eax, %rax
+ pushq %rax
+ movl $20, %eax
+ popq %rcx
+ leaq a(%rip), %rdx
+ movl %eax, -4(%rdx,%rcx,4)
+ movl $1, %eax
+ movslq %eax, %rax
+ leaq a(%rip), %rdx
+ leaq -4(%rdx,%rax,4), %rax
+ movq %rax, -40(%rbp)
+ movl $2, %eax
+ movslq %eax, %rax
+ leaq a(%rip), %rdx
+ leaq -4(%rdx,%rax,4), %rax
+ movq %rax, -48(%rbp)
+ movq -40(%rbp), %rdi
+ movq -48(%rbp), %rsi
+ call intercambiar
+ movl %eax, g(%rip)
+ movl $1, %eax
+ movslq %eax, %rax
+ leaq a(%rip), %rdx
+ movl -4(%rdx,%rax,4), %eax
+ movl %eax, %edi
+ call write_i32
+ movl $2, %eax
+ movslq %eax, %rax
+ leaq a(%rip), %rdx
+ movl -4(%rdx,%rax,4), %eax
+ movl %eax, %edi
+ call write_i32
+ movq $0, %rax
+ movq %rax, total(%rip)
+ movl $1, %eax
+ movl %eax, g(%rip)
+ leaq total(%rip), %rax
+ movq %rax, -56(%rbp)
+ movl $1, %eax
+ movq %rax, -64(%rbp)
+ movq -56(%rbp), %rdi
+ movq -64(%rbp), %rsi
+ call acumular
+ movl %eax, q(%rip)
+ movl $2, %eax
+ movl %eax, g(%rip)
+ leaq total(%rip), %rax
+ movq %rax, -72(%rbp)
+ movl $2, %eax
+ movq %rax, -80(%rbp)
+ movq -72(%rbp), %rdi
+ movq -80(%rbp), %rsi
+ call acumular
+ movl %eax, q(%rip)
+ movl $3, %eax
+ movl %eax, g(%rip)
+ leaq total(%rip), %rax
+ movq %rax, -88(%rbp)
+ movl $3, %eax
+ movq %rax, -96(%rbp)
+ movq -88(%rbp), %rdi
+ movq -96(%rbp), %rsi
+ call acumular
+ movl %eax, q(%rip)
+ movl $4, %eax
+ movl %eax, g(%rip)
+ leaq total(%rip), %rax
+ movq %rax, -104(%rbp)
+ movl $4, %eax
+ movq %rax, -112(%rbp)
+ movq -104(%rbp), %rdi
+ movq -112(%rbp), %rsi
+ call acumular
+ movl %eax, q(%rip)
+ movl $5, %eax
+ movl %eax, g(%rip)
+ leaq total(%rip), %rax
+ movq %rax, -120(%rbp)
+ movl $5, %eax
+ movq %rax, -128(%rbp)
+ movq -120(%rbp), %rdi
+ movq -128(%rbp), %rsi
+ call acumular
+ movl %eax, q(%rip)
+ movl $6, %eax
+ movl %eax, g(%rip)
+ leaq total(%rip), %rax
+ movq %rax, -136(%rbp)
+ movl $6, %eax
+ movq %rax, -144(%rbp)
+ movq -136(%rbp), %rdi
+ movq -144(%rbp), %rsi
+ call acumular
+ movl %eax, q(%rip)
+ movl $7, %eax
+ movl %eax, g(%rip)
+ leaq total(%rip), %rax
+ movq %rax, -152(%rbp)
+ movl $7, %eax
+ movq %rax, -160(%rbp)
+ movq -152(%rbp), %rdi
+ movq -160(%rbp), %rsi
+ call acumular
+ movl %eax, q(%rip)
+ movl $8, %eax
+ movl %eax, g(%rip)
+ leaq total(%rip), %rax
+ movq %rax, -168(%rbp)
+ movl $8, %eax
+ movq %rax, -176(%rbp)
+ movq -168(%rbp), %rdi
+ movq -176(%rbp), %rsi
+ call acumular
+ movl %eax, q(%rip)
+ movl $9, %eax
+ movl %eax, g(%rip)
+ leaq total(%rip), %rax
+ movq %rax, -184(%rbp)
+ movl $9, %eax
+ movq %rax, -192(%rbp)
+ movq -184(%rbp), %rdi
+ movq -192(%rbp), %rsi
+ call acumular
+ movl %eax, q(%rip)
+ movl $10, %eax
+ movl %eax, g(%rip)
+ leaq total(%rip), %rax
+ movq %rax, -200(%rbp)
+ movl $10, %eax
+ movq %rax, -208(%rbp)
+ movq -200(%rbp), %rdi
+ movq -208(%rbp), %rsi
+ call acumular
+ movl %eax, q(%rip)
+ movq total(%rip), %rax
+ movq %rax, %rdi
+ call write_i64
+ movss ._CF3fc00000(%rip), %xmm0
+ movss %xmm0, x(%rip)
+ leaq x(%rip), %rax
+ movq %rax, -216(%rbp)
+ movss ._CF40800000(%rip), %xmm0
+ movss %xmm0, -224(%rbp)
+ movq -216(%rbp), %rdi
+ movss -224(%rbp), %xmm0
+ call escalar
+ movl %eax, g(%rip)
+ movss x(%rip), %xmm0
+ call write_f32
+ movl $7, %eax
+ movl %eax, g(%rip)
+ movl $100, %eax
+ movl %eax, q(%rip)
+ leaq q(%rip), %rax
+ movq %rax, -232(%rbp)
+ movq -232(%rbp), %rdi
+ call incrementar
+ movl %eax, r(%rip)
+ movl q(%rip), %eax
+ movl %eax, %edi
+ call write_i32
+ movl g(%rip), %eax
+ movl %eax, %edi
+ call write_i32
+ movl $20, %eax
+ movq %rax, -240(%rbp)
+ movq -240(%rbp), %rdi
+ call sumaHasta
+ movq %rax, %rdi
+ call write_i64
+ movl $10, %eax
+ movq %rax, -248(%rbp)
+ movq -248(%rbp), %rdi
+ call dobles
+ movl %eax, %edi
+ call write_i32
+.end_main:
+ leave
+ ret
+
+# Runtime de escritura (ver runtime.h)
+.bss
+.p2align 6
+.Lesc_buf: .zero 1048576
+.data
+.p2align 3
+.Lesc_pos: .quad .Lesc_buf
+.section .rodata
+.p2align 3
+.Lesc_millon: .double 1000000.0
+.Lesc_limite: .double 9.0e12
+.Lesc_limite_d: .double 3.0e7
+.Lesc_casi_medio: .double 0.49609375
+.Lesc_fmt_f: .string "%f \n"
+.Lesc_pot10: .quad 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000, 10000000000, 100000000000, 1000000000000, 10000000000000, 100000000000000, 1000000000000000, 10000000000000000, 100000000000000000, 1000000000000000000, 10000000000000000000
+.Lesc_pares: .ascii "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899"
+.section .fini_array,"aw"
+.p2align 3
+.quad write_flush
+.text
+
+# Vacía el buffer con write(1, ...); reintenta si la escritura es parcial o
+# se interrumpe (EINTR) y descarta el resto ante cualquier otro error
+write_flush:
+ leaq .Lesc_buf(%rip), %rsi
+ movq .Lesc_pos(%rip), %rdx
+ subq %rsi, %rdx
+1:
+ testq %rdx, %rdx
+ jle 2f
+ movl $1, %eax
+ movl $1, %edi
+ syscall
+ cmpq $-4, %rax
+ je 1b
+ testq %rax, %rax
+ jle 2f
+ addq %rax, %rsi
+ subq %rax, %rdx
+ jmp 1b
+2:
+ leaq .Lesc_buf(%rip), %rax
+ movq %rax, .Lesc_pos(%rip)
+ ret
+
+# %rdi = posición en el buffer con al menos 320 bytes libres (vacía el
+# buffer si hace falta); conserva %rax y %xmm0. Lo más largo que se escribe
+# es un double con "%f \n": signo, 309 dígitos enteros, '.', 6 decimales,
+# " \n" y el 0 final de snprintf, 320 bytes.
+.Lesc_espacio:
+ movq .Lesc_pos(%rip), %rdi
+ leaq .Lesc_buf+1048576-320(%rip), %rcx
+ cmpq %rcx, %rdi
+ jbe 1f
+ pushq %rax
+ call write_flush
+ popq %rax
+ movq .Lesc_pos(%rip), %rdi
+1:
+ ret
+
+# Dígitos decimales de %rax (sin signo) en (%rdi); deja %rdi tras el
+# último. La longitud sale de log2 (bsr) * log10(2) corregido con una tabla
+# de potencias de 10; los dígitos se escriben de atrás hacia adelante, de a
+# dos por división entre 100 (multiplicación por el inverso)
+.Lesc_dec:
+ cmpq $10, %rax
+ jae 1f
+ addl $48, %eax
+ movb %al, (%rdi)
+ addq $1, %rdi
+ ret
+1:
+ bsrq %rax, %rcx
+ addl $1, %ecx
+ imull $1233, %ecx, %ecx
+ shrl $12, %ecx
+ leaq .Lesc_pot10(%rip), %r8
+ cmpq (%r8,%rcx,8), %rax
+ sbbq $-1, %rcx
+ addq %rcx, %rdi
+ movq %rdi, %r9
+ movabsq $0x28F5C28F5C28F5C3, %r10
+ leaq .Lesc_pares(%rip), %r11
+2:
+ cmpq $100, %rax
+ jb 3f
+ movq %rax, %rcx
+ shrq $2, %rax
+ mulq %r10
+ shrq $2, %rdx
+ imulq $100, %rdx, %rax
+ subq %rax, %rcx
+ movzwl (%r11,%rcx,2), %ecx
+ movw %cx, -2(%r9)
+ subq $2, %r9
+ movq %rdx, %rax
+ jmp 2b
+3:
+ cmpq $10, %rax
+ jb 4f
+ movzwl (%r11,%rax,2), %ecx
+ movw %cx, -2(%r9)
+ ret
+4:
+ addl $48, %eax
+ movb %al, -1(%r9)
+ ret
+
+write_i32:
+ movslq %edi, %rax
+ jmp .Lesc_entero
+write_u32:
+ movl %edi, %eax
+ call .Lesc_espacio
+ jmp .Lesc_digitos
+write_i64:
+ movq %rdi, %rax
+.Lesc_entero:
+ call .Lesc_espacio
+ testq %rax, %rax
+ jns .Lesc_digitos
+ movb $45, (%rdi)
+ addq $1, %rdi
+ negq %rax
+.Lesc_digitos:
+ call .Lesc_dec
+ movw $0x0a20, (%rdi)
+ addq $2, %rdi
+ movq %rdi, .Lesc_pos(%rip)
+ ret
+
+# Como printf("%f"): |x| * 10^6 es exacto en double para cualquier float
+# (24 bits de mantisa por 20 de 10^6), así que redondear ese producto al
+# entero (al par, como printf) da los 6 decimales exactos. Infinito, NaN y
+# |x| >= 9e12 (el producto no cabe en 63 bits) van por snprintf.
+write_f32:
+ cvtss2sd %xmm0, %xmm0
+ call .Lesc_espacio
+ movq %xmm0, %rax
+ btrq $63, %rax
+ movq %rax, %xmm1
+ ucomisd .Lesc_limite(%rip), %xmm1
+ jp .Lesc_f_lento
+ jae .Lesc_f_lento
+ movmskpd %xmm0, %eax
+ testl $1, %eax
+ jz 1f
+ movb $45, (%rdi)
+ addq $1, %rdi
+1:
+ mulsd .Lesc_millon(%rip), %xmm1
+ cvtsd2si %xmm1, %rax
+ jmp .Lesc_f_digitos
+
+# En double el producto |x| * 10^6 se redondea; con |x| < 3e7 queda por
+# debajo de 2^45 y el error es a lo sumo 2^-9, así que su redondeo al
+# entero coincide con el del valor exacto salvo que la parte fraccionaria
+# quede a menos de 2^-8 de 0.5. Ese caso y |x| >= 3e7 van por snprintf.
+write_f64:
+ call .Lesc_espacio
+ movq %xmm0, %rax
+ btrq $63, %rax
+ movq %rax, %xmm1
+ ucomisd .Lesc_limite_d(%rip), %xmm1
+ jp .Lesc_f_lento
+ jae .Lesc_f_lento
+ mulsd .Lesc_millon(%rip), %xmm1
+ cvtsd2si %xmm1, %rax
+ cvtsi2sdq %rax, %xmm2
+ subsd %xmm2, %xmm1
+ movq %xmm1, %rdx
+ btrq $63, %rdx
+ movq %rdx, %xmm1
+ ucomisd .Lesc_casi_medio(%rip), %xmm1
+ jae .Lesc_f_lento
+ movmskpd %xmm0, %ecx
+ testl $1, %ecx
+ jz .Lesc_f_digitos
+ movb $45, (%rdi)
+ addq $1, %rdi
+.Lesc_f_digitos:
+ xorl %edx, %edx
+ movl $1000000, %ecx
+ divq %rcx
+ movq %rdx, %rsi
+ call .Lesc_dec
+ leaq 1000000(%rsi), %rax
+ movq %rdi, %rsi
+ call .Lesc_dec
+ movb $46, (%rsi)
+ movw $0x0a20, (%rdi)
+ addq $2, %rdi
+ movq %rdi, .Lesc_pos(%rip)
+ ret
+.Lesc_f_lento:
+ pushq %rbx
+ movq %rdi, %rbx
+ movl $320, %esi
+ leaq .Lesc_fmt_f(%rip), %rdx
+ movl $1, %eax
+ call snprintf@PLT
+ cltq
+ addq %rax, %rbx
+ movq %rbx, .Lesc_pos(%rip)
+ popq %rbx
+ ret
+
+# Constantes de punto flotante (float 32 bits)
+.section .rodata
+.p2align 2
+._CF3fc00000: .long 0x3fc00000
+._CF40800000: .long 0x40800000
+.section .note.GNU-stack,"",@progbits
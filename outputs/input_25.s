@@ -0,0 +1,978 @@
+.data
+g: .long 0
+h: .quad 0
+z: .float 0.0
+.text
+.globl ancha
+ancha:
+ pushq %rbp
+ movq %rsp, %rbp
+ movq %rdi, -8(%rbp)
+ movq %rsi, -16(%rbp)
+ movq %rdx, -24(%rbp)
+ movq %rcx, -32(%rbp)
+ movq %r8, -40(%rbp)
+ movq %r9, -48(%rbp)
+ movss %xmm0, -56(%rbp)
+ movss %xmm1, -64(%rbp)
+ movss %xmm2, -72(%rbp)
+ movss %xmm3, -80(%rbp)
+ movss %xmm4, -88(%rbp)
+ movss %xmm5, -96(%rbp)
+ movss %xmm6, -104(%rbp)
+ movss %xmm7, -112(%rbp)
+ subq $272, %rsp
+ movl -8(%rbp), %eax
+ pushq %rax
+ movl -16(%rbp), %eax
+ pushq %rax
+ movl $2, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl -24(%rbp), %eax
+ pushq %rax
+ movl $3, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl -32(%rbp), %eax
+ pushq %rax
+ movl $4, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl -40(%rbp), %eax
+ pushq %rax
+ movl $5, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl -48(%rbp), %eax
+ pushq %rax
+ movl $6, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl 16(%rbp), %eax
+ pushq %rax
+ movl $7, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl 24(%rbp), %eax
+ pushq %rax
+ movl $8, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl 32(%rbp), %eax
+ pushq %rax
+ movl $9, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl 40(%rbp), %eax
+ pushq %rax
+ movl $10, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movq 72(%rbp), %rdx
+ movl %eax, (%rdx)
+ movss -56(%rbp), %xmm0
+ movss %xmm0, -120(%rbp)
+ movss -64(%rbp), %xmm0
+ movss %xmm0, -124(%rbp)
+ movss ._CF40000000(%rip), %xmm0
+ movss %xmm0, -128(%rbp)
+ movss -124(%rbp), %xmm1
+ movss -128(%rbp), %xmm0
+ mulss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -132(%rbp)
+ movss -120(%rbp), %xmm1
+ movss -132(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -136(%rbp)
+ movss -72(%rbp), %xmm0
+ movss %xmm0, -140(%rbp)
+ movss ._CF40400000(%rip), %xmm0
+ movss %xmm0, -144(%rbp)
+ movss -140(%rbp), %xmm1
+ movss -144(%rbp), %xmm0
+ mulss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -148(%rbp)
+ movss -136(%rbp), %xmm1
+ movss -148(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -152(%rbp)
+ movss -80(%rbp), %xmm0
+ movss %xmm0, -156(%rbp)
+ movss ._CF40800000(%rip), %xmm0
+ movss %xmm0, -160(%rbp)
+ movss -156(%rbp), %xmm1
+ movss -160(%rbp), %xmm0
+ mulss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -164(%rbp)
+ movss -152(%rbp), %xmm1
+ movss -164(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -168(%rbp)
+ movss -88(%rbp), %xmm0
+ movss %xmm0, -172(%rbp)
+ movss ._CF40a00000(%rip), %xmm0
+ movss %xmm0, -176(%rbp)
+ movss -172(%rbp), %xmm1
+ movss -176(%rbp), %xmm0
+ mulss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -180(%rbp)
+ movss -168(%rbp), %xmm1
+ movss -180(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -184(%rbp)
+ movss -96(%rbp), %xmm0
+ movss %xmm0, -188(%rbp)
+ movss ._CF40c00000(%rip), %xmm0
+ movss %xmm0, -192(%rbp)
+ movss -188(%rbp), %xmm1
+ movss -192(%rbp), %xmm0
+ mulss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -196(%rbp)
+ movss -184(%rbp), %xmm1
+ movss -196(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -200(%rbp)
+ movss -104(%rbp), %xmm0
+ movss %xmm0, -204(%rbp)
+ movss ._CF40e00000(%rip), %xmm0
+ movss %xmm0, -208(%rbp)
+ movss -204(%rbp), %xmm1
+ movss -208(%rbp), %xmm0
+ mulss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -212(%rbp)
+ movss -200(%rbp), %xmm1
+ movss -212(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -216(%rbp)
+ movss -112(%rbp), %xmm0
+ movss %xmm0, -220(%rbp)
+ movss ._CF41000000(%rip), %xmm0
+ movss %xmm0, -224(%rbp)
+ movss -220(%rbp), %xmm1
+ movss -224(%rbp), %xmm0
+ mulss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -228(%rbp)
+ movss -216(%rbp), %xmm1
+ movss -228(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -232(%rbp)
+ movss 48(%rbp), %xmm0
+ movss %xmm0, -236(%rbp)
+ movss ._CF41100000(%rip), %xmm0
+ movss %xmm0, -240(%rbp)
+ movss -236(%rbp), %xmm1
+ movss -240(%rbp), %xmm0
+ mulss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -244(%rbp)
+ movss -232(%rbp), %xmm1
+ movss -244(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -248(%rbp)
+ movss 56(%rbp), %xmm0
+ movss %xmm0, -252(%rbp)
+ movss ._CF41200000(%rip), %xmm0
+ movss %xmm0, -256(%rbp)
+ movss -252(%rbp), %xmm1
+ movss -256(%rbp), %xmm0
+ mulss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -260(%rbp)
+ movss -248(%rbp), %xmm1
+ movss -260(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -116(%rbp)
+ movss -116(%rbp), %xmm0
+ movq 80(%rbp), %rdx
+ movss %xmm0, (%rdx)
+ movq 64(%rbp), %rax
+ pushq %rax
+ movq 72(%rbp), %rdx
+ movl (%rdx), %eax
+ movslq %eax, %rax
+ movq %rax, %rcx
+ popq %rax
+ addq %rcx, %rax
+.end_ancha:
+ leave
+ ret
+.globl mezcla
+mezcla:
+ pushq %rbp
+ movq %rsp, %rbp
+ movss %xmm0, -8(%rbp)
+ movq %rdi, -16(%rbp)
+ movss %xmm1, -24(%rbp)
+ movq %rsi, -32(%rbp)
+ movss %xmm2, -40(%rbp)
+ movq %rdx, -48(%rbp)
+ movss %xmm3, -56(%rbp)
+ movq %rcx, -64(%rbp)
+ movss %xmm4, -72(%rbp)
+ movq %r8, -80(%rbp)
+ movss %xmm5, -88(%rbp)
+ movq %r9, -96(%rbp)
+ movss %xmm6, -104(%rbp)
+ movss %xmm7, -112(%rbp)
+ subq $256, %rsp
+ movss -8(%rbp), %xmm0
+ movss %xmm0, -116(%rbp)
+ movss -24(%rbp), %xmm0
+ movss %xmm0, -120(%rbp)
+ movss -116(%rbp), %xmm1
+ movss -120(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -124(%rbp)
+ movss -40(%rbp), %xmm0
+ movss %xmm0, -128(%rbp)
+ movss -124(%rbp), %xmm1
+ movss -128(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -132(%rbp)
+ movss -56(%rbp), %xmm0
+ movss %xmm0, -136(%rbp)
+ movss -132(%rbp), %xmm1
+ movss -136(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -140(%rbp)
+ movss -72(%rbp), %xmm0
+ movss %xmm0, -144(%rbp)
+ movss -140(%rbp), %xmm1
+ movss -144(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -148(%rbp)
+ movss -88(%rbp), %xmm0
+ movss %xmm0, -152(%rbp)
+ movss -148(%rbp), %xmm1
+ movss -152(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -156(%rbp)
+ movss -104(%rbp), %xmm0
+ movss %xmm0, -160(%rbp)
+ movss -156(%rbp), %xmm1
+ movss -160(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -164(%rbp)
+ movss -112(%rbp), %xmm0
+ movss %xmm0, -168(%rbp)
+ movss -164(%rbp), %xmm1
+ movss -168(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -172(%rbp)
+ movss 32(%rbp), %xmm0
+ movss %xmm0, -176(%rbp)
+ movss -172(%rbp), %xmm1
+ movss -176(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -180(%rbp)
+ movl -16(%rbp), %eax
+ cvtsi2ssl %eax, %xmm0
+ movss %xmm0, -184(%rbp)
+ movss -180(%rbp), %xmm1
+ movss -184(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -188(%rbp)
+ movl -32(%rbp), %eax
+ cvtsi2ssl %eax, %xmm0
+ movss %xmm0, -192(%rbp)
+ movss -188(%rbp), %xmm1
+ movss -192(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -196(%rbp)
+ movl -48(%rbp), %eax
+ cvtsi2ssl %eax, %xmm0
+ movss %xmm0, -200(%rbp)
+ movss -196(%rbp), %xmm1
+ movss -200(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -204(%rbp)
+ movl -64(%rbp), %eax
+ cvtsi2ssl %eax, %xmm0
+ movss %xmm0, -208(%rbp)
+ movss -204(%rbp), %xmm1
+ movss -208(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -212(%rbp)
+ movl -80(%rbp), %eax
+ cvtsi2ssl %eax, %xmm0
+ movss %xmm0, -216(%rbp)
+ movss -212(%rbp), %xmm1
+ movss -216(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -220(%rbp)
+ movl -96(%rbp), %eax
+ cvtsi2ssl %eax, %xmm0
+ movss %xmm0, -224(%rbp)
+ movss -220(%rbp), %xmm1
+ movss -224(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -228(%rbp)
+ movl 16(%rbp), %eax
+ cvtsi2ssl %eax, %xmm0
+ movss %xmm0, -232(%rbp)
+ movss -228(%rbp), %xmm1
+ movss -232(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -236(%rbp)
+ movl 24(%rbp), %eax
+ cvtsi2ssl %eax, %xmm0
+ movss %xmm0, -240(%rbp)
+ movss -236(%rbp), %xmm1
+ movss -240(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -244(%rbp)
+ movl 40(%rbp), %eax
+ cvtsi2ssl %eax, %xmm0
+ movss %xmm0, -248(%rbp)
+ movss -244(%rbp), %xmm1
+ movss -248(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+.end_mezcla:
+ leave
+ ret
+.globl suma7
+suma7:
+ pushq %rbp
+ movq %rsp, %rbp
+ movq %rdi, -8(%rbp)
+ movq %rsi, -16(%rbp)
+ movq %rdx, -24(%rbp)
+ movq %rcx, -32(%rbp)
+ movq %r8, -40(%rbp)
+ movq %r9, -48(%rbp)
+ subq $64, %rsp
+ movl $0, %eax
+ movl %eax, -56(%rbp)
+ movl -56(%rbp), %eax
+ pushq %rax
+ movl 16(%rbp), %eax
+ pushq %rax
+ movl $1, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movl %eax, -56(%rbp)
+ movl -56(%rbp), %eax
+ pushq %rax
+ movl 16(%rbp), %eax
+ pushq %rax
+ movl $2, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movl %eax, -56(%rbp)
+ movl -56(%rbp), %eax
+ pushq %rax
+ movl 16(%rbp), %eax
+ pushq %rax
+ movl $3, %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movl %eax, -56(%rbp)
+ movl $3, %eax
+ movl %eax, -52(%rbp)
+ movl -8(%rbp), %eax
+ pushq %rax
+ movl -16(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl -24(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl -32(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl -40(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl -48(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ pushq %rax
+ movl -56(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+.end_suma7:
+ leave
+ ret
+.globl main
+main:
+ pushq %rbp
+ movq %rsp, %rbp
+ subq $560, %rsp
+ movl $1, %eax
+ movq %rax, -8(%rbp)
+ movl $2, %eax
+ movq %rax, -16(%rbp)
+ movl $3, %eax
+ movq %rax, -24(%rbp)
+ movl $4, %eax
+ movq %rax, -32(%rbp)
+ movl $5, %eax
+ movq %rax, -40(%rbp)
+ movl $6, %eax
+ movq %rax, -48(%rbp)
+ movl $7, %eax
+ movq %rax, -56(%rbp)
+ movl $8, %eax
+ movq %rax, -64(%rbp)
+ movl $9, %eax
+ movq %rax, -72(%rbp)
+ movl $10, %eax
+ movq %rax, -80(%rbp)
+ movss ._CF3f800000(%rip), %xmm0
+ movss %xmm0, -88(%rbp)
+ movss ._CF40000000(%rip), %xmm0
+ movss %xmm0, -96(%rbp)
+ movss ._CF40400000(%rip), %xmm0
+ movss %xmm0, -104(%rbp)
+ movss ._CF40800000(%rip), %xmm0
+ movss %xmm0, -112(%rbp)
+ movss ._CF40a00000(%rip), %xmm0
+ movss %xmm0, -120(%rbp)
+ movss ._CF40c00000(%rip), %xmm0
+ movss %xmm0, -128(%rbp)
+ movss ._CF40e00000(%rip), %xmm0
+ movss %xmm0, -136(%rbp)
+ movss ._CF41000000(%rip), %xmm0
+ movss %xmm0, -144(%rbp)
+ movss ._CF41100000(%rip), %xmm0
+ movss %xmm0, -152(%rbp)
+ movss ._CF41200000(%rip), %xmm0
+ movss %xmm0, -160(%rbp)
+ movq $5000000000, %rax
+ movq %rax, -168(%rbp)
+ leaq g(%rip), %rax
+ movq %rax, -176(%rbp)
+ leaq z(%rip), %rax
+ movq %rax, -184(%rbp)
+ subq $8, %rsp
+ pushq -184(%rbp)
+ pushq -176(%rbp)
+ pushq -168(%rbp)
+ pushq -160(%rbp)
+ pushq -152(%rbp)
+ pushq -80(%rbp)
+ pushq -72(%rbp)
+ pushq -64(%rbp)
+ pushq -56(%rbp)
+ movq -8(%rbp), %rdi
+ movq -16(%rbp), %rsi
+ movq -24(%rbp), %rdx
+ movq -32(%rbp), %rcx
+ movq -40(%rbp), %r8
+ movq -48(%rbp), %r9
+ movss -88(%rbp), %xmm0
+ movss -96(%rbp), %xmm1
+ movss -104(%rbp), %xmm2
+ movss -112(%rbp), %xmm3
+ movss -120(%rbp), %xmm4
+ movss -128(%rbp), %xmm5
+ movss -136(%rbp), %xmm6
+ movss -144(%rbp), %xmm7
+ call ancha
+ addq $80, %rsp
+ movq %rax, h(%rip)
+ movq h(%rip), %rax
+ movq %rax, %rdi
+ call write_i64
+ movl g(%rip), %eax
+ movl %eax, %edi
+ call write_i32
+ movss z(%rip), %xmm0
+ call write_f32
+ movss ._CF3fc00000(%rip), %xmm0
+ movss %xmm0, -192(%rbp)
+ movl $2, %eax
+ movq %rax, -200(%rbp)
+ movss ._CF40600000(%rip), %xmm0
+ movss %xmm0, -208(%rbp)
+ movl $4, %eax
+ movq %rax, -216(%rbp)
+ movss ._CF40b00000(%rip), %xmm0
+ movss %xmm0, -224(%rbp)
+ movl $6, %eax
+ movq %rax, -232(%rbp)
+ movss ._CF40f00000(%rip), %xmm0
+ movss %xmm0, -240(%rbp)
+ movl $8, %eax
+ movq %rax, -248(%rbp)
+ movss ._CF41180000(%rip), %xmm0
+ movss %xmm0, -256(%rbp)
+ movl $10, %eax
+ movq %rax, -264(%rbp)
+ movss ._CF41380000(%rip), %xmm0
+ movss %xmm0, -272(%rbp)
+ movl $12, %eax
+ movq %rax, -280(%rbp)
+ movss ._CF41580000(%rip), %xmm0
+ movss %xmm0, -288(%rbp)
+ movl $14, %eax
+ movq %rax, -296(%rbp)
+ movss ._CF41780000(%rip), %xmm0
+ movss %xmm0, -304(%rbp)
+ movl $16, %eax
+ movq %rax, -312(%rbp)
+ movss ._CF418c0000(%rip), %xmm0
+ movss %xmm0, -320(%rbp)
+ movl $18, %eax
+ movq %rax, -328(%rbp)
+ pushq -328(%rbp)
+ pushq -320(%rbp)
+ pushq -312(%rbp)
+ pushq -296(%rbp)
+ movss -192(%rbp), %xmm0
+ movq -200(%rbp), %rdi
+ movss -208(%rbp), %xmm1
+ movq -216(%rbp), %rsi
+ movss -224(%rbp), %xmm2
+ movq -232(%rbp), %rdx
+ movss -240(%rbp), %xmm3
+ movq -248(%rbp), %rcx
+ movss -256(%rbp), %xmm4
+ movq -264(%rbp), %r8
+ movss -272(%rbp), %xmm5
+ movq -280(%rbp), %r9
+ movss -288(%rbp), %xmm6
+ movss -304(%rbp), %xmm7
+ call mezcla
+ addq $32, %rsp
+ call write_f32
+ movl $1, %eax
+ movq %rax, -336(%rbp)
+ movl $2, %eax
+ movq %rax, -344(%rbp)
+ movl $3, %eax
+ movq %rax, -352(%rbp)
+ movl $4, %eax
+ movq %rax, -360(%rbp)
+ movl $5, %eax
+ movq %rax, -368(%rbp)
+ movl $6, %eax
+ movq %rax, -376(%rbp)
+ movl $7, %eax
+ movq %rax, -384(%rbp)
+ subq $8, %rsp
+ pushq -384(%rbp)
+ movq -336(%rbp), %rdi
+ movq -344(%rbp), %rsi
+ movq -352(%rbp), %rdx
+ movq -360(%rbp), %rcx
+ movq -368(%rbp), %r8
+ movq -376(%rbp), %r9
+ call suma7
+ addq $16, %rsp
+ pushq %rax
+ movl $1, %eax
+ movq %rax, -392(%rbp)
+ movl $1, %eax
+ movq %rax, -400(%rbp)
+ movl $1, %eax
+ movq %rax, -408(%rbp)
+ movl $1, %eax
+ movq %rax, -416(%rbp)
+ movl $1, %eax
+ movq %rax, -424(%rbp)
+ movl $1, %eax
+ movq %rax, -432(%rbp)
+ movl $0, %eax
+ movq %rax, -440(%rbp)
+ movl $0, %eax
+ movq %rax, -448(%rbp)
+ movl $0, %eax
+ movq %rax, -456(%rbp)
+ movl $0, %eax
+ movq %rax, -464(%rbp)
+ movl $0, %eax
+ movq %rax, -472(%rbp)
+ movl $0, %eax
+ movq %rax, -480(%rbp)
+ movl $1, %eax
+ movq %rax, -488(%rbp)
+ pushq -488(%rbp)
+ movq -440(%rbp), %rdi
+ movq -448(%rbp), %rsi
+ movq -456(%rbp), %rdx
+ movq -464(%rbp), %rcx
+ movq -472(%rbp), %r8
+ movq -480(%rbp), %r9
+ call suma7
+ addq $8, %rsp
+ movq %rax, -496(%rbp)
+ pushq -496(%rbp)
+ movq -392(%rbp), %rdi
+ movq -400(%rbp), %rsi
+ movq -408(%rbp), %rdx
+ movq -416(%rbp), %rcx
+ movq -424(%rbp), %r8
+ movq -432(%rbp), %r9
+ call suma7
+ addq $8, %rsp
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movl %eax, %edi
+ call write_i32
+ movl $1, %eax
+ pushq %rax
+ movl $1, %eax
+ movq %rax, -504(%rbp)
+ movl $2, %eax
+ movq %rax, -512(%rbp)
+ movl $3, %eax
+ movq %rax, -520(%rbp)
+ movl $4, %eax
+ movq %rax, -528(%rbp)
+ movl $5, %eax
+ movq %rax, -536(%rbp)
+ movl $6, %eax
+ movq %rax, -544(%rbp)
+ movl $7, %eax
+ movq %rax, -552(%rbp)
+ pushq -552(%rbp)
+ movq -504(%rbp), %rdi
+ movq -512(%rbp), %rsi
+ movq -520(%rbp), %rdx
+ movq -528(%rbp), %rcx
+ movq -536(%rbp), %r8
+ movq -544(%rbp), %r9
+ call suma7
+ addq $8, %rsp
+ movl %eax, %ecx
+ popq %rax
+ addl %ecx, %eax
+ movl %eax, %edi
+ call write_i32
+.end_main:
+ leave
+ ret
+
+# Runtime de escritura (ver runtime.h)
+.bss
+.p2align 6
+.Lesc_buf: .zero 1048576
+.data
+.p2align 3
+.Lesc_pos: .quad .Lesc_buf
+.section .rodata
+.p2align 3
+.Lesc_millon: .double 1000000.0
+.Lesc_limite: .double 9.0e12
+.Lesc_limite_d: .double 3.0e7
+.Lesc_casi_medio: .double 0.49609375
+.Lesc_fmt_f: .string "%f \n"
+.Lesc_pot10: .quad 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000, 10000000000, 100000000000, 1000000000000, 10000000000000, 100000000000000, 1000000000000000, 10000000000000000, 100000000000000000, 1000000000000000000, 10000000000000000000
+.Lesc_pares: .ascii "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899"
+.section .fini_array,"aw"
+.p2align 3
+.quad write_flush
+.text
+
+# Vacía el buffer con write(1, ...); reintenta si la escritura es parcial o
+# se interrumpe (EINTR) y descarta el resto ante cualquier otro error
+write_flush:
+ leaq .Lesc_buf(%rip), %rsi
+ movq .Lesc_pos(%rip), %rdx
+ subq %rsi, %rdx
+1:
+ testq %rdx, %rdx
+ jle 2f
+ movl $1, %eax
+ movl $1, %edi
+ syscall
+ cmpq $-4, %rax
+ je 1b
+ testq %rax, %rax
+ jle 2f
+ addq %rax, %rsi
+ subq %rax, %rdx
+ jmp 1b
+2:
+ leaq .Lesc_buf(%rip), %rax
+ movq %rax, .Lesc_pos(%rip)
+ ret
+
+# %rdi = posición en el buffer con al menos 320 bytes libres (vacía el
+# buffer si hace falta); conserva %rax y %xmm0. Lo más largo que se escribe
+# es un double con "%f \n": signo, 309 dígitos enteros, '.', 6 decimales,
+# " \n" y el 0 final de snprintf, 320 bytes.
+.Lesc_espacio:
+ movq .Lesc_pos(%rip), %rdi
+ leaq .Lesc_buf+1048576-320(%rip), %rcx
+ cmpq %rcx, %rdi
+ jbe 1f
+ pushq %rax
+ call write_flush
+ popq %rax
+ movq .Lesc_pos(%rip), %rdi
+1:
+ ret
+
+# Dígitos decimales de %rax (sin signo) en (%rdi); deja %rdi tras el
+# último. La longitud sale de log2 (bsr) * log10(2) corregido con una tabla
+# de potencias de 10; los dígitos se escriben de atrás hacia adelante, de a
+# dos por división entre 100 (multiplicación por el inverso)
+.Lesc_dec:
+ cmpq $10, %rax
+ jae 1f
+ addl $48, %eax
+ movb %al, (%rdi)
+ addq $1, %rdi
+ ret
+1:
+ bsrq %rax, %rcx
+ addl $1, %ecx
+ imull $1233, %ecx, %ecx
+ shrl $12, %ecx
+ leaq .Lesc_pot10(%rip), %r8
+ cmpq (%r8,%rcx,8), %rax
+ sbbq $-1, %rcx
+ addq %rcx, %rdi
+ movq %rdi, %r9
+ movabsq $0x28F5C28F5C28F5C3, %r10
+ leaq .Lesc_pares(%rip), %r11
+2:
+ cmpq $100, %rax
+ jb 3f
+ movq %rax, %rcx
+ shrq $2, %rax
+ mulq %r10
+ shrq $2, %rdx
+ imulq $100, %rdx, %rax
+ subq %rax, %rcx
+ movzwl (%r11,%rcx,2), %ecx
+ movw %cx, -2(%r9)
+ subq $2, %r9
+ movq %rdx, %rax
+ jmp 2b
+3:
+ cmpq $10, %rax
+ jb 4f
+ movzwl (%r11,%rax,2), %ecx
+ movw %cx, -2(%r9)
+ ret
+4:
+ addl $48, %eax
+ movb %al, -1(%r9)
+ ret
+
+write_i32:
+ movslq %edi, %rax
+ jmp .Lesc_entero
+write_u32:
+ movl %edi, %eax
+ call .Lesc_espacio
+ jmp .Lesc_digitos
+write_i64:
+ movq %rdi, %rax
+.Lesc_entero:
+ call .Lesc_espacio
+ testq %rax, %rax
+ jns .Lesc_digitos
+ movb $45, (%rdi)
+ addq $1, %rdi
+ negq %rax
+.Lesc_digitos:
+ call .Lesc_dec
+ movw $0x0a20, (%rdi)
+ addq $2, %rdi
+ movq %rdi, .Lesc_pos(%rip)
+ ret
+
+# Como printf("%f"): |x| * 10^6 es exacto en double para cualquier float
+# (24 bits de mantisa por 20 de 10^6), así que redondear ese producto al
+# entero (al par, como printf) da los 6 decimales exactos. Infinito, NaN y
+# |x| >= 9e12 (el producto no cabe en 63 bits) van por snprintf.
+write_f32:
+ cvtss2sd %xmm0, %xmm0
+ call .Lesc_espacio
+ movq %xmm0, %rax
+ btrq $63, %rax
+ movq %rax, %xmm1
+ ucomisd .Lesc_limite(%rip), %xmm1
+ jp .Lesc_f_lento
+ jae .Lesc_f_lento
+ movmskpd %xmm0, %eax
+ testl $1, %eax
+ jz 1f
+ movb $45, (%rdi)
+ addq $1, %rdi
+1:
+ mulsd .Lesc_millon(%rip), %xmm1
+ cvtsd2si %xmm1, %rax
+ jmp .Lesc_f_digitos
+
+# En double el producto |x| * 10^6 se redondea; con |x| < 3e7 queda por
+# debajo de 2^45 y el error es a lo sumo 2^-9, así que su redondeo al
+# entero coincide con el del valor exacto salvo que la parte fraccionaria
+# quede a menos de 2^-8 de 0.5. Ese caso y |x| >= 3e7 van por snprintf.
+write_f64:
+ call .Lesc_espacio
+ movq %xmm0, %rax
+ btrq $63, %rax
+ movq %rax, %xmm1
+ ucomisd .Lesc_limite_d(%rip), %xmm1
+ jp .Lesc_f_lento
+ jae .Lesc_f_lento
+ mulsd .Lesc_millon(%rip), %xmm1
+ cvtsd2si %xmm1, %rax
+ cvtsi2sdq %rax, %xmm2
+ subsd %xmm2, %xmm1
+ movq %xmm1, %rdx
+ btrq $63, %rdx
+ movq %rdx, %xmm1
+ ucomisd .Lesc_casi_medio(%rip), %xmm1
+ jae .Lesc_f_lento
+ movmskpd %xmm0, %ecx
+ testl $1, %ecx
+ jz .Lesc_f_digitos
+ movb $45, (%rdi)
+ addq $1, %rdi
+.Lesc_f_digitos:
+ xorl %edx, %edx
+ movl $1000000, %ecx
+ divq %rcx
+ movq %rdx, %rsi
+ call .Lesc_dec
+ leaq 1000000(%rsi), %rax
+ movq %rdi, %rsi
+ call .Lesc_dec
+ movb $46, (%rsi)
+ movw $0x0a20, (%rdi)
+ addq $2, %rdi
+ movq %rdi, .Lesc_pos(%rip)
+ ret
+.Lesc_f_lento:
+ pushq %rbx
+ movq %rdi, %rbx
+ movl $320, %esi
+ leaq .Lesc_fmt_f(%rip), %rdx
+ movl $1, %eax
+ call snprintf@PLT
+ cltq
+ addq %rax, %rbx
+ movq %rbx, .Lesc_pos(%rip)
+ popq %rbx
+ ret
+
+# Constantes de punto flotante (float 32 bits)
+.section .rodata
+.p2align 2
+._CF40000000: .long 0x40000000
+._CF40400000: .long 0x40400000
+._CF40800000: .long 0x40800000
+._CF40a00000: .long 0x40a00000
+._CF40c00000: .long 0x40c00000
+._CF40e00000: .long 0x40e00000
+._CF41000000: .long 0x41000000
+._CF41100000: .long 0x41100000
+._CF41200000: .long 0x41200000
+._CF3f800000: .long 0x3f800000
+._CF3fc00000: .long 0x3fc00000
+._CF40600000: .long 0x40600000
+._CF40b00000: .long 0x40b00000
+._CF40f00000: .long 0x40f00000
+._CF41180000: .long 0x41180000
+._CF41380000: .long 0x41380000
+._CF41580000: .long 0x41580000
+._CF41780000: .long 0x41780000
+._CF418c0000: .long 0x418c0000
+.section .note.GNU-stack,"",@progbits
@@ -0,0 +1,995 @@
+.data
+gd: .quad 0
+gf: .float 0.0
+i: .long 0
+n: .quad 0
+.bss
+.p2align 3
+ga: .zero 80
+.text
+.globl armonica
+armonica:
+ pushq %r12
+ pushq %r13
+ pushq %rbp
+ movq %rsp, %rbp
+ movq %rdi, -8(%rbp)
+ subq $64, %rsp
+ xorpd %xmm0, %xmm0
+ movsd %xmm0, -20(%rbp)
+ movl $1, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ popq %rcx
+ movslq %eax, %rax
+ movslq %ecx, %rcx
+ subq %rcx, %rax
+ addq $1, %rax
+ jle endfor_armonica_0
+ movl %ecx, %r12d
+ movq %rax, %r13
+for_armonica_0:
+ movsd -20(%rbp), %xmm0
+ movsd %xmm0, -36(%rbp)
+ movsd ._CD3ff0000000000000(%rip), %xmm0
+ movsd %xmm0, -44(%rbp)
+ movl %r12d, %eax
+ cvtsi2sdl %eax, %xmm0
+ movsd %xmm0, -52(%rbp)
+ movsd -44(%rbp), %xmm1
+ movsd -52(%rbp), %xmm0
+ divsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, -60(%rbp)
+ movsd -36(%rbp), %xmm1
+ movsd -60(%rbp), %xmm0
+ addsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, -20(%rbp)
+ incl %r12d
+ decq %r13
+ jnz for_armonica_0
+ decl %r12d
+ movl %r12d, -12(%rbp)
+endfor_armonica_0:
+ movsd -20(%rbp), %xmm0
+.end_armonica:
+ leave
+ popq %r13
+ popq %r12
+ ret
+.globl armonicaf
+armonicaf:
+ pushq %r12
+ pushq %r13
+ pushq %rbp
+ movq %rsp, %rbp
+ movq %rdi, -8(%rbp)
+ subq $48, %rsp
+ movl $0, %eax
+ cvtsi2ssl %eax, %xmm0
+ movss %xmm0, -16(%rbp)
+ movl $1, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ popq %rcx
+ movslq %eax, %rax
+ movslq %ecx, %rcx
+ subq %rcx, %rax
+ addq $1, %rax
+ jle endfor_armonicaf_0
+ movl %ecx, %r12d
+ movq %rax, %r13
+for_armonicaf_0:
+ movss -16(%rbp), %xmm0
+ movss %xmm0, -28(%rbp)
+ movss ._CF3f800000(%rip), %xmm0
+ movss %xmm0, -32(%rbp)
+ movl %r12d, %eax
+ cvtsi2ssl %eax, %xmm0
+ movss %xmm0, -36(%rbp)
+ movss -32(%rbp), %xmm1
+ movss -36(%rbp), %xmm0
+ divss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -40(%rbp)
+ movss -28(%rbp), %xmm1
+ movss -40(%rbp), %xmm0
+ addss %xmm0, %xmm1
+ movss %xmm1, %xmm0
+ movss %xmm0, -16(%rbp)
+ incl %r12d
+ decq %r13
+ jnz for_armonicaf_0
+ decl %r12d
+ movl %r12d, -12(%rbp)
+endfor_armonicaf_0:
+ movss -16(%rbp), %xmm0
+.end_armonicaf:
+ leave
+ popq %r13
+ popq %r12
+ ret
+.globl mezcla
+mezcla:
+ pushq %rbp
+ movq %rsp, %rbp
+ movsd %xmm0, -8(%rbp)
+ movss %xmm1, -16(%rbp)
+ movq %rdi, -24(%rbp)
+ movsd %xmm2, -32(%rbp)
+ movsd %xmm3, -40(%rbp)
+ movsd %xmm4, -48(%rbp)
+ movsd %xmm5, -56(%rbp)
+ movsd %xmm6, -64(%rbp)
+ movsd %xmm7, -72(%rbp)
+ movq %rsi, -80(%rbp)
+ subq $256, %rsp
+ movq -80(%rbp), %rdx
+ movsd (%rdx), %xmm0
+ movsd %xmm0, -88(%rbp)
+ movsd ._CD4000000000000000(%rip), %xmm0
+ movsd %xmm0, -96(%rbp)
+ movsd -88(%rbp), %xmm1
+ movsd -96(%rbp), %xmm0
+ mulsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movq -80(%rbp), %rdx
+ movsd %xmm0, (%rdx)
+ movsd -8(%rbp), %xmm0
+ movsd %xmm0, -104(%rbp)
+ movss -16(%rbp), %xmm0
+ cvtss2sd %xmm0, %xmm0
+ movsd %xmm0, -112(%rbp)
+ movsd -104(%rbp), %xmm1
+ movsd -112(%rbp), %xmm0
+ addsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, -120(%rbp)
+ movl -24(%rbp), %eax
+ cvtsi2sdl %eax, %xmm0
+ movsd %xmm0, -128(%rbp)
+ movsd -120(%rbp), %xmm1
+ movsd -128(%rbp), %xmm0
+ addsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, -136(%rbp)
+ movsd -32(%rbp), %xmm0
+ movsd %xmm0, -144(%rbp)
+ movsd -136(%rbp), %xmm1
+ movsd -144(%rbp), %xmm0
+ addsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, -152(%rbp)
+ movsd -40(%rbp), %xmm0
+ movsd %xmm0, -160(%rbp)
+ movsd -152(%rbp), %xmm1
+ movsd -160(%rbp), %xmm0
+ addsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, -168(%rbp)
+ movsd -48(%rbp), %xmm0
+ movsd %xmm0, -176(%rbp)
+ movsd -168(%rbp), %xmm1
+ movsd -176(%rbp), %xmm0
+ addsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, -184(%rbp)
+ movsd -56(%rbp), %xmm0
+ movsd %xmm0, -192(%rbp)
+ movsd -184(%rbp), %xmm1
+ movsd -192(%rbp), %xmm0
+ addsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, -200(%rbp)
+ movsd -64(%rbp), %xmm0
+ movsd %xmm0, -208(%rbp)
+ movsd -200(%rbp), %xmm1
+ movsd -208(%rbp), %xmm0
+ addsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, -216(%rbp)
+ movsd -72(%rbp), %xmm0
+ movsd %xmm0, -224(%rbp)
+ movsd -216(%rbp), %xmm1
+ movsd -224(%rbp), %xmm0
+ addsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, -232(%rbp)
+ movsd 16(%rbp), %xmm0
+ movsd %xmm0, -240(%rbp)
+ movsd -232(%rbp), %xmm1
+ movsd -240(%rbp), %xmm0
+ addsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, -248(%rbp)
+ movsd 24(%rbp), %xmm0
+ movsd %xmm0, -256(%rbp)
+ movsd -248(%rbp), %xmm1
+ movsd -256(%rbp), %xmm0
+ addsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+.end_mezcla:
+ leave
+ ret
+.globl escala
+escala:
+ pushq %rbp
+ movq %rsp, %rbp
+ movsd %xmm0, -8(%rbp)
+ subq $32, %rsp
+ movsd -8(%rbp), %xmm0
+ movsd %xmm0, -16(%rbp)
+ movsd ._CD41cdcd6500000000(%rip), %xmm0
+ movsd %xmm0, -24(%rbp)
+ movsd -16(%rbp), %xmm1
+ movsd -24(%rbp), %xmm0
+ mulsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ cvttsd2si %xmm0, %rax
+.end_escala:
+ leave
+ ret
+.globl main
+main:
+ pushq %rbp
+ movq %rsp, %rbp
+ subq $512, %rsp
+ movsd ._CD3fd3333333333334(%rip), %xmm0
+ movsd %xmm0, gd(%rip)
+ movsd gd(%rip), %xmm0
+ call write_f64
+ movl $1000000, %eax
+ movq %rax, -8(%rbp)
+ movq -8(%rbp), %rdi
+ call armonica
+ call write_f64
+ movl $1000000, %eax
+ movq %rax, -16(%rbp)
+ movq -16(%rbp), %rdi
+ call armonicaf
+ call write_f32
+ movsd gd(%rip), %xmm0
+ cvtsd2ss %xmm0, %xmm0
+ movss %xmm0, gf(%rip)
+ movss gf(%rip), %xmm0
+ call write_f32
+ movss gf(%rip), %xmm0
+ cvtss2sd %xmm0, %xmm0
+ movsd %xmm0, -24(%rbp)
+ movsd ._CD3fd3333333333333(%rip), %xmm0
+ movsd %xmm0, -32(%rbp)
+ movsd -24(%rbp), %xmm1
+ movsd -32(%rbp), %xmm0
+ subsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, -40(%rbp)
+ movsd ._CD41cdcd6500000000(%rip), %xmm0
+ movsd %xmm0, -48(%rbp)
+ movsd -40(%rbp), %xmm1
+ movsd -48(%rbp), %xmm0
+ mulsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ call write_f64
+ movsd ._CD3ff8000000000000(%rip), %xmm0
+ movsd %xmm0, gd(%rip)
+ movsd ._CD3fd0000000000000(%rip), %xmm0
+ movsd %xmm0, -56(%rbp)
+ movss ._CF3f000000(%rip), %xmm0
+ movss %xmm0, -64(%rbp)
+ movl $3, %eax
+ movq %rax, -72(%rbp)
+ movsd ._CD3ff0000000000000(%rip), %xmm0
+ movsd %xmm0, -80(%rbp)
+ movsd ._CD4000000000000000(%rip), %xmm0
+ movsd %xmm0, -88(%rbp)
+ movsd ._CD4008000000000000(%rip), %xmm0
+ movsd %xmm0, -96(%rbp)
+ movsd ._CD4010000000000000(%rip), %xmm0
+ movsd %xmm0, -104(%rbp)
+ movsd ._CD4014000000000000(%rip), %xmm0
+ movsd %xmm0, -112(%rbp)
+ movsd ._CD4018000000000000(%rip), %xmm0
+ movsd %xmm0, -120(%rbp)
+ movsd ._CD401c000000000000(%rip), %xmm0
+ movsd %xmm0, -128(%rbp)
+ movsd ._CD4020000000000000(%rip), %xmm0
+ movsd %xmm0, -136(%rbp)
+ leaq gd(%rip), %rax
+ movq %rax, -144(%rbp)
+ pushq -136(%rbp)
+ pushq -128(%rbp)
+ movsd -56(%rbp), %xmm0
+ movss -64(%rbp), %xmm1
+ movq -72(%rbp), %rdi
+ movsd -80(%rbp), %xmm2
+ movsd -88(%rbp), %xmm3
+ movsd -96(%rbp), %xmm4
+ movsd -104(%rbp), %xmm5
+ movsd -112(%rbp), %xmm6
+ movsd -120(%rbp), %xmm7
+ movq -144(%rbp), %rsi
+ call mezcla
+ addq $16, %rsp
+ call write_f64
+ movsd gd(%rip), %xmm0
+ call write_f64
+ movl $1, %eax
+ movl %eax, i(%rip)
+ movl $1, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $9, %rax
+ ja .rango_main
+ pushq %rax
+ movl $1, %eax
+ cvtsi2sdl %eax, %xmm0
+ movsd %xmm0, -152(%rbp)
+ movsd ._CD4008000000000000(%rip), %xmm0
+ movsd %xmm0, -160(%rbp)
+ movsd -152(%rbp), %xmm1
+ movsd -160(%rbp), %xmm0
+ divsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ popq %rcx
+ leaq ga(%rip), %rdx
+ movsd %xmm0, (%rdx,%rcx,8)
+ movl $2, %eax
+ movl %eax, i(%rip)
+ movl $2, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $9, %rax
+ ja .rango_main
+ pushq %rax
+ movl $2, %eax
+ cvtsi2sdl %eax, %xmm0
+ movsd %xmm0, -168(%rbp)
+ movsd ._CD4008000000000000(%rip), %xmm0
+ movsd %xmm0, -176(%rbp)
+ movsd -168(%rbp), %xmm1
+ movsd -176(%rbp), %xmm0
+ divsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ popq %rcx
+ leaq ga(%rip), %rdx
+ movsd %xmm0, (%rdx,%rcx,8)
+ movl $3, %eax
+ movl %eax, i(%rip)
+ movl $3, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $9, %rax
+ ja .rango_main
+ pushq %rax
+ movl $3, %eax
+ cvtsi2sdl %eax, %xmm0
+ movsd %xmm0, -184(%rbp)
+ movsd ._CD4008000000000000(%rip), %xmm0
+ movsd %xmm0, -192(%rbp)
+ movsd -184(%rbp), %xmm1
+ movsd -192(%rbp), %xmm0
+ divsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ popq %rcx
+ leaq ga(%rip), %rdx
+ movsd %xmm0, (%rdx,%rcx,8)
+ movl $4, %eax
+ movl %eax, i(%rip)
+ movl $4, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $9, %rax
+ ja .rango_main
+ pushq %rax
+ movl $4, %eax
+ cvtsi2sdl %eax, %xmm0
+ movsd %xmm0, -200(%rbp)
+ movsd ._CD4008000000000000(%rip), %xmm0
+ movsd %xmm0, -208(%rbp)
+ movsd -200(%rbp), %xmm1
+ movsd -208(%rbp), %xmm0
+ divsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ popq %rcx
+ leaq ga(%rip), %rdx
+ movsd %xmm0, (%rdx,%rcx,8)
+ movl $5, %eax
+ movl %eax, i(%rip)
+ movl $5, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $9, %rax
+ ja .rango_main
+ pushq %rax
+ movl $5, %eax
+ cvtsi2sdl %eax, %xmm0
+ movsd %xmm0, -216(%rbp)
+ movsd ._CD4008000000000000(%rip), %xmm0
+ movsd %xmm0, -224(%rbp)
+ movsd -216(%rbp), %xmm1
+ movsd -224(%rbp), %xmm0
+ divsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ popq %rcx
+ leaq ga(%rip), %rdx
+ movsd %xmm0, (%rdx,%rcx,8)
+ movl $6, %eax
+ movl %eax, i(%rip)
+ movl $6, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $9, %rax
+ ja .rango_main
+ pushq %rax
+ movl $6, %eax
+ cvtsi2sdl %eax, %xmm0
+ movsd %xmm0, -232(%rbp)
+ movsd ._CD4008000000000000(%rip), %xmm0
+ movsd %xmm0, -240(%rbp)
+ movsd -232(%rbp), %xmm1
+ movsd -240(%rbp), %xmm0
+ divsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ popq %rcx
+ leaq ga(%rip), %rdx
+ movsd %xmm0, (%rdx,%rcx,8)
+ movl $7, %eax
+ movl %eax, i(%rip)
+ movl $7, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $9, %rax
+ ja .rango_main
+ pushq %rax
+ movl $7, %eax
+ cvtsi2sdl %eax, %xmm0
+ movsd %xmm0, -248(%rbp)
+ movsd ._CD4008000000000000(%rip), %xmm0
+ movsd %xmm0, -256(%rbp)
+ movsd -248(%rbp), %xmm1
+ movsd -256(%rbp), %xmm0
+ divsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ popq %rcx
+ leaq ga(%rip), %rdx
+ movsd %xmm0, (%rdx,%rcx,8)
+ movl $8, %eax
+ movl %eax, i(%rip)
+ movl $8, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $9, %rax
+ ja .rango_main
+ pushq %rax
+ movl $8, %eax
+ cvtsi2sdl %eax, %xmm0
+ movsd %xmm0, -264(%rbp)
+ movsd ._CD4008000000000000(%rip), %xmm0
+ movsd %xmm0, -272(%rbp)
+ movsd -264(%rbp), %xmm1
+ movsd -272(%rbp), %xmm0
+ divsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ popq %rcx
+ leaq ga(%rip), %rdx
+ movsd %xmm0, (%rdx,%rcx,8)
+ movl $9, %eax
+ movl %eax, i(%rip)
+ movl $9, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $9, %rax
+ ja .rango_main
+ pushq %rax
+ movl $9, %eax
+ cvtsi2sdl %eax, %xmm0
+ movsd %xmm0, -280(%rbp)
+ movsd ._CD4008000000000000(%rip), %xmm0
+ movsd %xmm0, -288(%rbp)
+ movsd -280(%rbp), %xmm1
+ movsd -288(%rbp), %xmm0
+ divsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ popq %rcx
+ leaq ga(%rip), %rdx
+ movsd %xmm0, (%rdx,%rcx,8)
+ movl $10, %eax
+ movl %eax, i(%rip)
+ movl $10, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $9, %rax
+ ja .rango_main
+ pushq %rax
+ movl $10, %eax
+ cvtsi2sdl %eax, %xmm0
+ movsd %xmm0, -296(%rbp)
+ movsd ._CD4008000000000000(%rip), %xmm0
+ movsd %xmm0, -304(%rbp)
+ movsd -296(%rbp), %xmm1
+ movsd -304(%rbp), %xmm0
+ divsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ popq %rcx
+ leaq ga(%rip), %rdx
+ movsd %xmm0, (%rdx,%rcx,8)
+ xorpd %xmm0, %xmm0
+ movsd %xmm0, gd(%rip)
+ movl $1, %eax
+ movl %eax, i(%rip)
+ movsd gd(%rip), %xmm0
+ movsd %xmm0, -312(%rbp)
+ movl $1, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $9, %rax
+ ja .rango_main
+ leaq ga(%rip), %rdx
+ movsd (%rdx,%rax,8), %xmm0
+ movsd %xmm0, -320(%rbp)
+ movsd -312(%rbp), %xmm1
+ movsd -320(%rbp), %xmm0
+ addsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, gd(%rip)
+ movl $2, %eax
+ movl %eax, i(%rip)
+ movsd gd(%rip), %xmm0
+ movsd %xmm0, -328(%rbp)
+ movl $2, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $9, %rax
+ ja .rango_main
+ leaq ga(%rip), %rdx
+ movsd (%rdx,%rax,8), %xmm0
+ movsd %xmm0, -336(%rbp)
+ movsd -328(%rbp), %xmm1
+ movsd -336(%rbp), %xmm0
+ addsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, gd(%rip)
+ movl $3, %eax
+ movl %eax, i(%rip)
+ movsd gd(%rip), %xmm0
+ movsd %xmm0, -344(%rbp)
+ movl $3, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $9, %rax
+ ja .rango_main
+ leaq ga(%rip), %rdx
+ movsd (%rdx,%rax,8), %xmm0
+ movsd %xmm0, -352(%rbp)
+ movsd -344(%rbp), %xmm1
+ movsd -352(%rbp), %xmm0
+ addsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, gd(%rip)
+ movl $4, %eax
+ movl %eax, i(%rip)
+ movsd gd(%rip), %xmm0
+ movsd %xmm0, -360(%rbp)
+ movl $4, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $9, %rax
+ ja .rango_main
+ leaq ga(%rip), %rdx
+ movsd (%rdx,%rax,8), %xmm0
+ movsd %xmm0, -368(%rbp)
+ movsd -360(%rbp), %xmm1
+ movsd -368(%rbp), %xmm0
+ addsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, gd(%rip)
+ movl $5, %eax
+ movl %eax, i(%rip)
+ movsd gd(%rip), %xmm0
+ movsd %xmm0, -376(%rbp)
+ movl $5, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $9, %rax
+ ja .rango_main
+ leaq ga(%rip), %rdx
+ movsd (%rdx,%rax,8), %xmm0
+ movsd %xmm0, -384(%rbp)
+ movsd -376(%rbp), %xmm1
+ movsd -384(%rbp), %xmm0
+ addsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, gd(%rip)
+ movl $6, %eax
+ movl %eax, i(%rip)
+ movsd gd(%rip), %xmm0
+ movsd %xmm0, -392(%rbp)
+ movl $6, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $9, %rax
+ ja .rango_main
+ leaq ga(%rip), %rdx
+ movsd (%rdx,%rax,8), %xmm0
+ movsd %xmm0, -400(%rbp)
+ movsd -392(%rbp), %xmm1
+ movsd -400(%rbp), %xmm0
+ addsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, gd(%rip)
+ movl $7, %eax
+ movl %eax, i(%rip)
+ movsd gd(%rip), %xmm0
+ movsd %xmm0, -408(%rbp)
+ movl $7, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $9, %rax
+ ja .rango_main
+ leaq ga(%rip), %rdx
+ movsd (%rdx,%rax,8), %xmm0
+ movsd %xmm0, -416(%rbp)
+ movsd -408(%rbp), %xmm1
+ movsd -416(%rbp), %xmm0
+ addsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, gd(%rip)
+ movl $8, %eax
+ movl %eax, i(%rip)
+ movsd gd(%rip), %xmm0
+ movsd %xmm0, -424(%rbp)
+ movl $8, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $9, %rax
+ ja .rango_main
+ leaq ga(%rip), %rdx
+ movsd (%rdx,%rax,8), %xmm0
+ movsd %xmm0, -432(%rbp)
+ movsd -424(%rbp), %xmm1
+ movsd -432(%rbp), %xmm0
+ addsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, gd(%rip)
+ movl $9, %eax
+ movl %eax, i(%rip)
+ movsd gd(%rip), %xmm0
+ movsd %xmm0, -440(%rbp)
+ movl $9, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $9, %rax
+ ja .rango_main
+ leaq ga(%rip), %rdx
+ movsd (%rdx,%rax,8), %xmm0
+ movsd %xmm0, -448(%rbp)
+ movsd -440(%rbp), %xmm1
+ movsd -448(%rbp), %xmm0
+ addsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, gd(%rip)
+ movl $10, %eax
+ movl %eax, i(%rip)
+ movsd gd(%rip), %xmm0
+ movsd %xmm0, -456(%rbp)
+ movl $10, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $9, %rax
+ ja .rango_main
+ leaq ga(%rip), %rdx
+ movsd (%rdx,%rax,8), %xmm0
+ movsd %xmm0, -464(%rbp)
+ movsd -456(%rbp), %xmm1
+ movsd -464(%rbp), %xmm0
+ addsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, gd(%rip)
+ movsd gd(%rip), %xmm0
+ call write_f64
+ movsd ._CD400921fb54442d18(%rip), %xmm0
+ movsd %xmm0, -472(%rbp)
+ movsd -472(%rbp), %xmm0
+ call escala
+ movq %rax, n(%rip)
+ movq n(%rip), %rax
+ movq %rax, %rdi
+ call write_i64
+ movsd gd(%rip), %xmm0
+ subq $8, %rsp
+ movsd %xmm0, (%rsp)
+ movsd ._CD403255554fbdad75(%rip), %xmm0
+ movsd (%rsp), %xmm1
+ addq $8, %rsp
+ ucomisd %xmm0, %xmm1
+ movl $0, %eax
+ seta %al
+ movzbq %al, %rax
+ cmpq $0, %rax
+ je else_main_0
+ movl $1, %eax
+ movl %eax, %edi
+ call write_i32
+ jmp endif_main_0
+else_main_0:
+ movl $0, %eax
+ movl %eax, %edi
+ call write_i32
+endif_main_0:
+ movsd gd(%rip), %xmm0
+ cvttsd2si %xmm0, %rax
+ movl %eax, %edi
+ call write_i32
+ movsd ._CD419d6f34547e6b75(%rip), %xmm0
+ call write_f64
+ movss ._CF4ceb79a3(%rip), %xmm0
+ call write_f32
+ movsd gd(%rip), %xmm0
+ movsd %xmm0, -480(%rbp)
+ xorpd %xmm0, %xmm0
+ movsd %xmm0, -488(%rbp)
+ movsd -480(%rbp), %xmm1
+ movsd -488(%rbp), %xmm0
+ mulsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ movsd %xmm0, -496(%rbp)
+ movsd ._CD3ea0c6f7a0b5ed8d(%rip), %xmm0
+ movsd %xmm0, -504(%rbp)
+ movsd -496(%rbp), %xmm1
+ movsd -504(%rbp), %xmm0
+ subsd %xmm0, %xmm1
+ movsd %xmm1, %xmm0
+ call write_f64
+.end_main:
+ leave
+ ret
+.rango_main:
+ andq $-16, %rsp
+ movq stderr@GOTPCREL(%rip), %rdi
+ movq (%rdi), %rdi
+ leaq .rango_msg_main(%rip), %rsi
+ movl $0, %eax
+ call fprintf@PLT
+ movl $1, %edi
+ call exit@PLT
+ .pushsection .rodata
+.rango_msg_main: .string "Error: indice fuera de rango en main\n"
+ .popsection
+
+# Runtime de escritura (ver runtime.h)
+.bss
+.p2align 6
+.Lesc_buf: .zero 1048576
+.data
+.p2align 3
+.Lesc_pos: .quad .Lesc_buf
+.section .rodata
+.p2align 3
+.Lesc_millon: .double 1000000.0
+.Lesc_limite: .double 9.0e12
+.Lesc_limite_d: .double 3.0e7
+.Lesc_casi_medio: .double 0.49609375
+.Lesc_fmt_f: .string "%f \n"
+.Lesc_pot10: .quad 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000, 10000000000, 100000000000, 1000000000000, 10000000000000, 100000000000000, 1000000000000000, 10000000000000000, 100000000000000000, 1000000000000000000, 10000000000000000000
+.Lesc_pares: .ascii "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899"
+.section .fini_array,"aw"
+.p2align 3
+.quad write_flush
+.text
+
+# Vacía el buffer con write(1, ...); reintenta si la escritura es parcial o
+# se interrumpe (EINTR) y descarta el resto ante cualquier otro error
+write_flush:
+ leaq .Lesc_buf(%rip), %rsi
+ movq .Lesc_pos(%rip), %rdx
+ subq %rsi, %rdx
+1:
+ testq %rdx, %rdx
+ jle 2f
+ movl $1, %eax
+ movl $1, %edi
+ syscall
+ cmpq $-4, %rax
+ je 1b
+ testq %rax, %rax
+ jle 2f
+ addq %rax, %rsi
+ subq %rax, %rdx
+ jmp 1b
+2:
+ leaq .Lesc_buf(%rip), %rax
+ movq %rax, .Lesc_pos(%rip)
+ ret
+
+# %rdi = posición en el buffer con al menos 320 bytes libres (vacía el
+# buffer si hace falta); conserva %rax y %xmm0. Lo más largo que se escribe
+# es un double con "%f \n": signo, 309 dígitos enteros, '.', 6 decimales,
+# " \n" y el 0 final de snprintf, 320 bytes.
+.Lesc_espacio:
+ movq .Lesc_pos(%rip), %rdi
+ leaq .Lesc_buf+1048576-320(%rip), %rcx
+ cmpq %rcx, %rdi
+ jbe 1f
+ pushq %rax
+ call write_flush
+ popq %rax
+ movq .Lesc_pos(%rip), %rdi
+1:
+ ret
+
+# Dígitos decimales de %rax (sin signo) en (%rdi); deja %rdi tras el
+# último. La longitud sale de log2 (bsr) * log10(2) corregido con una tabla
+# de potencias de 10; los dígitos se escriben de atrás hacia adelante, de a
+# dos por división entre 100 (multiplicación por el inverso)
+.Lesc_dec:
+ cmpq $10, %rax
+ jae 1f
+ addl $48, %eax
+ movb %al, (%rdi)
+ addq $1, %rdi
+ ret
+1:
+ bsrq %rax, %rcx
+ addl $1, %ecx
+ imull $1233, %ecx, %ecx
+ shrl $12, %ecx
+ leaq .Lesc_pot10(%rip), %r8
+ cmpq (%r8,%rcx,8), %rax
+ sbbq $-1, %rcx
+ addq %rcx, %rdi
+ movq %rdi, %r9
+ movabsq $0x28F5C28F5C28F5C3, %r10
+ leaq .Lesc_pares(%rip), %r11
+2:
+ cmpq $100, %rax
+ jb 3f
+ movq %rax, %rcx
+ shrq $2, %rax
+ mulq %r10
+ shrq $2, %rdx
+ imulq $100, %rdx, %rax
+ subq %rax, %rcx
+ movzwl (%r11,%rcx,2), %ecx
+ movw %cx, -2(%r9)
+ subq $2, %r9
+ movq %rdx, %rax
+ jmp 2b
+3:
+ cmpq $10, %rax
+ jb 4f
+ movzwl (%r11,%rax,2), %ecx
+ movw %cx, -2(%r9)
+ ret
+4:
+ addl $48, %eax
+ movb %al, -1(%r9)
+ ret
+
+write_i32:
+ movslq %edi, %rax
+ jmp .Lesc_entero
+write_u32:
+ movl %edi, %eax
+ call .Lesc_espacio
+ jmp .Lesc_digitos
+write_i64:
+ movq %rdi, %rax
+.Lesc_entero:
+ call .Lesc_espacio
+ testq %rax, %rax
+ jns .Lesc_digitos
+ movb $45, (%rdi)
+ addq $1, %rdi
+ negq %rax
+.Lesc_digitos:
+ call .Lesc_dec
+ movw $0x0a20, (%rdi)
+ addq $2, %rdi
+ movq %rdi, .Lesc_pos(%rip)
+ ret
+
+# Como printf("%f"): |x| * 10^6 es exacto en double para cualquier float
+# (24 bits de mantisa por 20 de 10^6), así que redondear ese producto al
+# entero (al par, como printf) da los 6 decimales exactos. Infinito, NaN y
+# |x| >= 9e12 (el producto no cabe en 63 bits) van por snprintf.
+write_f32:
+ cvtss2sd %xmm0, %xmm0
+ call .Lesc_espacio
+ movq %xmm0, %rax
+ btrq $63, %rax
+ movq %rax, %xmm1
+ ucomisd .Lesc_limite(%rip), %xmm1
+ jp .Lesc_f_lento
+ jae .Lesc_f_lento
+ movmskpd %xmm0, %eax
+ testl $1, %eax
+ jz 1f
+ movb $45, (%rdi)
+ addq $1, %rdi
+1:
+ mulsd .Lesc_millon(%rip), %xmm1
+ cvtsd2si %xmm1, %rax
+ jmp .Lesc_f_digitos
+
+# En double el producto |x| * 10^6 se redondea; con |x| < 3e7 queda por
+# debajo de 2^45 y el error es a lo sumo 2^-9, así que su redondeo al
+# entero coincide con el del valor exacto salvo que la parte fraccionaria
+# quede a menos de 2^-8 de 0.5. Ese caso y |x| >= 3e7 van por snprintf.
+write_f64:
+ call .Lesc_espacio
+ movq %xmm0, %rax
+ btrq $63, %rax
+ movq %rax, %xmm1
+ ucomisd .Lesc_limite_d(%rip), %xmm1
+ jp .Lesc_f_lento
+ jae .Lesc_f_lento
+ mulsd .Lesc_millon(%rip), %xmm1
+ cvtsd2si %xmm1, %rax
+ cvtsi2sdq %rax, %xmm2
+ subsd %xmm2, %xmm1
+ movq %xmm1, %rdx
+ btrq $63, %rdx
+ movq %rdx, %xmm1
+ ucomisd .Lesc_casi_medio(%rip), %xmm1
+ jae .Lesc_f_lento
+ movmskpd %xmm0, %ecx
+ testl $1, %ecx
+ jz .Lesc_f_digitos
+ movb $45, (%rdi)
+ addq $1, %rdi
+.Lesc_f_digitos:
+ xorl %edx, %edx
+ movl $1000000, %ecx
+ divq %rcx
+ movq %rdx, %rsi
+ call .Lesc_dec
+ leaq 1000000(%rsi), %rax
+ movq %rdi, %rsi
+ call .Lesc_dec
+ movb $46, (%rsi)
+ movw $0x0a20, (%rdi)
+ addq $2, %rdi
+ movq %rdi, .Lesc_pos(%rip)
+ ret
+.Lesc_f_lento:
+ pushq %rbx
+ movq %rdi, %rbx
+ movl $320, %esi
+ leaq .Lesc_fmt_f(%rip), %rdx
+ movl $1, %eax
+ call snprintf@PLT
+ cltq
+ addq %rax, %rbx
+ movq %rbx, .Lesc_pos(%rip)
+ popq %rbx
+ ret
+
+# Constantes de punto flotante (float 32 bits)
+.section .rodata
+.p2align 2
+._CF3f800000: .long 0x3f800000
+._CF3f000000: .long 0x3f000000
+._CF4ceb79a3: .long 0x4ceb79a3
+
+# Constantes de punto flotante (double 64 bits)
+.section .rodata
+.p2align 3
+._CD3ff0000000000000: .quad 0x3ff0000000000000
+._CD4000000000000000: .quad 0x4000000000000000
+._CD41cdcd6500000000: .quad 0x41cdcd6500000000
+._CD3fd3333333333334: .quad 0x3fd3333333333334
+._CD3fd3333333333333: .quad 0x3fd3333333333333
+._CD3ff8000000000000: .quad 0x3ff8000000000000
+._CD3fd0000000000000: .quad 0x3fd0000000000000
+._CD4008000000000000: .quad 0x4008000000000000
+._CD4010000000000000: .quad 0x4010000000000000
+._CD4014000000000000: .quad 0x4014000000000000
+._CD4018000000000000: .quad 0x4018000000000000
+._CD401c000000000000: .quad 0x401c000000000000
+._CD4020000000000000: .quad 0x4020000000000000
+._CD400921fb54442d18: .quad 0x400921fb54442d18
+._CD403255554fbdad75: .quad 0x403255554fbdad75
+._CD419d6f34547e6b75: .quad 0x419d6f34547e6b75
+._CD3ea0c6f7a0b5ed8d: .quad 0x3ea0c6f7a0b5ed8d
+.section .note.GNU-stack,"",@progbits
@@ -0,0 +1,481 @@
+.data
+total: .quad 0
+i: .long 0
+.bss
+.p2align 3
+v: .zero 20
+.text
+.globl acumular
+acumular:
+ pushq %rbp
+ movq %rsp, %rbp
+ movq %rdi, -8(%rbp)
+ subq $16, %rsp
+ movq total(%rip), %rax
+ pushq %rax
+ movl -8(%rbp), %eax
+ movslq %eax, %rax
+ movq %rax, %rcx
+ popq %rax
+ addq %rcx, %rax
+ movq %rax, total(%rip)
+.end_acumular:
+ leave
+ ret
+.globl reiniciar
+reiniciar:
+ pushq %rbp
+ movq %rsp, %rbp
+ movq $0, %rax
+ movq %rax, total(%rip)
+.end_reiniciar:
+ leave
+ ret
+.globl intercambiar
+intercambiar:
+ pushq %rbp
+ movq %rsp, %rbp
+ movq %rdi, -8(%rbp)
+ movq %rsi, -16(%rbp)
+ subq $32, %rsp
+ movq -8(%rbp), %rdx
+ movl (%rdx), %eax
+ movl %eax, -20(%rbp)
+ movq -16(%rbp), %rdx
+ movl (%rdx), %eax
+ movq -8(%rbp), %rdx
+ movl %eax, (%rdx)
+ movl -20(%rbp), %eax
+ movq -16(%rbp), %rdx
+ movl %eax, (%rdx)
+.end_intercambiar:
+ leave
+ ret
+.globl mostrar
+mostrar:
+ pushq %rbp
+ movq %rsp, %rbp
+ subq $16, %rsp
+ movl $1, %eax
+ movslq %eax, %rax
+ leaq v(%rip), %rdx
+ movl -4(%rdx,%rax,4), %eax
+ movl %eax, %edi
+ call write_i32
+ movl $2, %eax
+ movslq %eax, %rax
+ leaq v(%rip), %rdx
+ movl -4(%rdx,%rax,4), %eax
+ movl %eax, %edi
+ call write_i32
+ movl $3, %eax
+ movslq %eax, %rax
+ leaq v(%rip), %rdx
+ movl -4(%rdx,%rax,4), %eax
+ movl %eax, %edi
+ call write_i32
+ movl $4, %eax
+ movslq %eax, %rax
+ leaq v(%rip), %rdx
+ movl -4(%rdx,%rax,4), %eax
+ movl %eax, %edi
+ call write_i32
+ movl $5, %eax
+ movslq %eax, %rax
+ leaq v(%rip), %rdx
+ movl -4(%rdx,%rax,4), %eax
+ movl %eax, %edi
+ call write_i32
+ movl $5, %eax
+ movl %eax, -4(%rbp)
+.end_mostrar:
+ leave
+ ret
+.globl doble
+doble:
+ pushq %rbp
+ movq %rsp, %rbp
+ movq %rdi, -8(%rbp)
+ subq $16, %rsp
+ movl -8(%rbp), %eax
+ movq %rax, -16(%rbp)
+ movq -16(%rbp), %rdi
+ call acumular
+ movl $2, %eax
+ pushq %rax
+ movl -8(%rbp), %eax
+ movl %eax, %ecx
+ popq %rax
+ imull %ecx, %eax
+.end_doble:
+ leave
+ ret
+.globl main
+main:
+ pushq %rbp
+ movq %rsp, %rbp
+ subq $80, %rsp
+ call reiniciar
+ movl $1, %eax
+ movl %eax, i(%rip)
+ movl $1, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $4, %rax
+ ja .rango_main
+ pushq %rax
+ movl $6, %eax
+ pushq %rax
+ movl $1, %eax
+ movl %eax, %ecx
+ popq %rax
+ subl %ecx, %eax
+ popq %rcx
+ leaq v(%rip), %rdx
+ movl %eax, (%rdx,%rcx,4)
+ movl $1, %eax
+ movq %rax, -8(%rbp)
+ movq -8(%rbp), %rdi
+ call acumular
+ movl $2, %eax
+ movl %eax, i(%rip)
+ movl $2, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $4, %rax
+ ja .rango_main
+ pushq %rax
+ movl $6, %eax
+ pushq %rax
+ movl $2, %eax
+ movl %eax, %ecx
+ popq %rax
+ subl %ecx, %eax
+ popq %rcx
+ leaq v(%rip), %rdx
+ movl %eax, (%rdx,%rcx,4)
+ movl $2, %eax
+ movq %rax, -16(%rbp)
+ movq -16(%rbp), %rdi
+ call acumular
+ movl $3, %eax
+ movl %eax, i(%rip)
+ movl $3, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $4, %rax
+ ja .rango_main
+ pushq %rax
+ movl $6, %eax
+ pushq %rax
+ movl $3, %eax
+ movl %eax, %ecx
+ popq %rax
+ subl %ecx, %eax
+ popq %rcx
+ leaq v(%rip), %rdx
+ movl %eax, (%rdx,%rcx,4)
+ movl $3, %eax
+ movq %rax, -24(%rbp)
+ movq -24(%rbp), %rdi
+ call acumular
+ movl $4, %eax
+ movl %eax, i(%rip)
+ movl $4, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $4, %rax
+ ja .rango_main
+ pushq %rax
+ movl $6, %eax
+ pushq %rax
+ movl $4, %eax
+ movl %eax, %ecx
+ popq %rax
+ subl %ecx, %eax
+ popq %rcx
+ leaq v(%rip), %rdx
+ movl %eax, (%rdx,%rcx,4)
+ movl $4, %eax
+ movq %rax, -32(%rbp)
+ movq -32(%rbp), %rdi
+ call acumular
+ movl $5, %eax
+ movl %eax, i(%rip)
+ movl $5, %eax
+ movslq %eax, %rax
+ subq $1, %rax
+ cmpq $4, %rax
+ ja .rango_main
+ pushq %rax
+ movl $6, %eax
+ pushq %rax
+ movl $5, %eax
+ movl %eax, %ecx
+ popq %rax
+ subl %ecx, %eax
+ popq %rcx
+ leaq v(%rip), %rdx
+ movl %eax, (%rdx,%rcx,4)
+ movl $5, %eax
+ movq %rax, -40(%rbp)
+ movq -40(%rbp), %rdi
+ call acumular
+ movq total(%rip), %rax
+ movq %rax, %rdi
+ call write_i64
+ movl $1, %eax
+ movslq %eax, %rax
+ leaq v(%rip), %rdx
+ leaq -4(%rdx,%rax,4), %rax
+ movq %rax, -48(%rbp)
+ movl $5, %eax
+ movslq %eax, %rax
+ leaq v(%rip), %rdx
+ leaq -4(%rdx,%rax,4), %rax
+ movq %rax, -56(%rbp)
+ movq -48(%rbp), %rdi
+ movq -56(%rbp), %rsi
+ call intercambiar
+ call mostrar
+ call mostrar
+ movl $100, %eax
+ movq %rax, -64(%rbp)
+ movq -64(%rbp), %rdi
+ call doble
+ movq total(%rip), %rax
+ movq %rax, %rdi
+ call write_i64
+ movl $7, %eax
+ movq %rax, -72(%rbp)
+ movq -72(%rbp), %rdi
+ call doble
+ movl %eax, %edi
+ call write_i32
+ movq total(%rip), %rax
+ movq %rax, %rdi
+ call write_i64
+.end_main:
+ leave
+ ret
+.rango_main:
+ andq $-16, %rsp
+ movq stderr@GOTPCREL(%rip), %rdi
+ movq (%rdi), %rdi
+ leaq .rango_msg_main(%rip), %rsi
+ movl $0, %eax
+ call fprintf@PLT
+ movl $1, %edi
+ call exit@PLT
+ .pushsection .rodata
+.rango_msg_main: .string "Error: indice fuera de rango en main\n"
+ .popsection
+
+# Runtime de escritura (ver runtime.h)
+.bss
+.p2align 6
+.Lesc_buf: .zero 1048576
+.data
+.p2align 3
+.Lesc_pos: .quad .Lesc_buf
+.section .rodata
+.p2align 3
+.Lesc_millon: .double 1000000.0
+.Lesc_limite: .double 9.0e12
+.Lesc_limite_d: .double 3.0e7
+.Lesc_casi_medio: .double 0.49609375
+.Lesc_fmt_f: .string "%f \n"
+.Lesc_pot10: .quad 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000, 10000000000, 100000000000, 1000000000000, 10000000000000, 100000000000000, 1000000000000000, 10000000000000000, 100000000000000000, 1000000000000000000, 10000000000000000000
+.Lesc_pares: .ascii "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899"
+.section .fini_array,"aw"
+.p2align 3
+.quad write_flush
+.text
+
+# Vacía el buffer con write(1, ...); reintenta si la escritura es parcial o
+# se interrumpe (EINTR) y descarta el resto ante cualquier otro error
+write_flush:
+ leaq .Lesc_buf(%rip), %rsi
+ movq .Lesc_pos(%rip), %rdx
+ subq %rsi, %rdx
+1:
+ testq %rdx, %rdx
+ jle 2f
+ movl $1, %eax
+ movl $1, %edi
+ syscall
+ cmpq $-4, %rax
+ je 1b
+ testq %rax, %rax
+ jle 2f
+ addq %rax, %rsi
+ subq %rax, %rdx
+ jmp 1b
+2:
+ leaq .Lesc_buf(%rip), %rax
+ movq %rax, .Lesc_pos(%rip)
+ ret
+
+# %rdi = posición en el buffer con al menos 320 bytes libres (vacía el
+# buffer si hace falta); conserva %rax y %xmm0. Lo más largo que se escribe
+# es un double con "%f \n": signo, 309 dígitos enteros, '.', 6 decimales,
+# " \n" y el 0 final de snprintf, 320 bytes.
+.Lesc_espacio:
+ movq .Lesc_pos(%rip), %rdi
+ leaq .Lesc_buf+1048576-320(%rip), %rcx
+ cmpq %rcx, %rdi
+ jbe 1f
+ pushq %rax
+ call write_flush
+ popq %rax
+ movq .Lesc_pos(%rip), %rdi
+1:
+ ret
+
+# Dígitos decimales de %rax (sin signo) en (%rdi); deja %rdi tras el
+# último. La longitud sale de log2 (bsr) * log10(2) corregido con una tabla
+# de potencias de 10; los dígitos se escriben de atrás hacia adelante, de a
+# dos por división entre 100 (multiplicación por el inverso)
+.Lesc_dec:
+ cmpq $10, %rax
+ jae 1f
+ addl $48, %eax
+ movb %al, (%rdi)
+ addq $1, %rdi
+ ret
+1:
+ bsrq %rax, %rcx
+ addl $1, %ecx
+ imull $1233, %ecx, %ecx
+ shrl $12, %ecx
+ leaq .Lesc_pot10(%rip), %r8
+ cmpq (%r8,%rcx,8), %rax
+ sbbq $-1, %rcx
+ addq %rcx, %rdi
+ movq %rdi, %r9
+ movabsq $0x28F5C28F5C28F5C3, %r10
+ leaq .Lesc_pares(%rip), %r11
+2:
+ cmpq $100, %rax
+ jb 3f
+ movq %rax, %rcx
+ shrq $2, %rax
+ mulq %r10
+ shrq $2, %rdx
+ imulq $100, %rdx, %rax
+ subq %rax, %rcx
+ movzwl (%r11,%rcx,2), %ecx
+ movw %cx, -2(%r9)
+ subq $2, %r9
+ movq %rdx, %rax
+ jmp 2b
+3:
+ cmpq $10, %rax
+ jb 4f
+ movzwl (%r11,%rax,2), %ecx
+ movw %cx, -2(%r9)
+ ret
+4:
+ addl $48, %eax
+ movb %al, -1(%r9)
+ ret
+
+write_i32:
+ movslq %edi, %rax
+ jmp .Lesc_entero
+write_u32:
+ movl %edi, %eax
+ call .Lesc_espacio
+ jmp .Lesc_digitos
+write_i64:
+ movq %rdi, %rax
+.Lesc_entero:
+ call .Lesc_espacio
+ testq %rax, %rax
+ jns .Lesc_digitos
+ movb $45, (%rdi)
+ addq $1, %rdi
+ negq %rax
+.Lesc_digitos:
+ call .Lesc_dec
+ movw $0x0a20, (%rdi)
+ addq $2, %rdi
+ movq %rdi, .Lesc_pos(%rip)
+ ret
+
+# Como printf("%f"): |x| * 10^6 es exacto en double para cualquier float
+# (24 bits de mantisa por 20 de 10^6), así que redondear ese producto al
+# entero (al par, como printf) da los 6 decimales exactos. Infinito, NaN y
+# |x| >= 9e12 (el producto no cabe en 63 bits) van por snprintf.
+write_f32:
+ cvtss2sd %xmm0, %xmm0
+ call .Lesc_espacio
+ movq %xmm0, %rax
+ btrq $63, %rax
+ movq %rax, %xmm1
+ ucomisd .Lesc_limite(%rip), %xmm1
+ jp .Lesc_f_lento
+ jae .Lesc_f_lento
+ movmskpd %xmm0, %eax
+ testl $1, %eax
+ jz 1f
+ movb $45, (%rdi)
+ addq $1, %rdi
+1:
+ mulsd .Lesc_millon(%rip), %xmm1
+ cvtsd2si %xmm1, %rax
+ jmp .Lesc_f_digitos
+
+# En double el producto |x| * 10^6 se redondea; con |x| < 3e7 queda por
+# debajo de 2^45 y el error es a lo sumo 2^-9, así que su redondeo al
+# entero coincide con el del valor exacto salvo que la parte fraccionaria
+# quede a menos de 2^-8 de 0.5. Ese caso y |x| >= 3e7 van por snprintf.
+write_f64:
+ call .Lesc_espacio
+ movq %xmm0, %rax
+ btrq $63, %rax
+ movq %rax, %xmm1
+ ucomisd .Lesc_limite_d(%rip), %xmm1
+ jp .Lesc_f_lento
+ jae .Lesc_f_lento
+ mulsd .Lesc_millon(%rip), %xmm1
+ cvtsd2si %xmm1, %rax
+ cvtsi2sdq %rax, %xmm2
+ subsd %xmm2, %xmm1
+ movq %xmm1, %rdx
+ btrq $63, %rdx
+ movq %rdx, %xmm1
+ ucomisd .Lesc_casi_medio(%rip), %xmm1
+ jae .Lesc_f_lento
+ movmskpd %xmm0, %ecx
+ testl $1, %ecx
+ jz .Lesc_f_digitos
+ movb $45, (%rdi)
+ addq $1, %rdi
+.Lesc_f_digitos:
+ xorl %edx, %edx
+ movl $1000000, %ecx
+ divq %rcx
+ movq %rdx, %rsi
+ call .Lesc_dec
+ leaq 1000000(%rsi), %rax
+ movq %rdi, %rsi
+ call .Lesc_dec
+ movb $46, (%rsi)
+ movw $0x0a20, (%rdi)
+ addq $2, %rdi
+ movq %rdi, .Lesc_pos(%rip)
+ ret
+.Lesc_f_lento:
+ pushq %rbx
+ movq %rdi, %rbx
+ movl $320, %esi
+ leaq .Lesc_fmt_f(%rip), %rdx
+ movl $1, %eax
+ call snprintf@PLT
+ cltq
+ addq %rax, %rbx
+ movq %rbx, .Lesc_pos(%rip)
+ popq %rbx
+ ret
+.section .note.GNU-stack,"",@progbits
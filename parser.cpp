@@ -1,5 +1,8 @@
 #include <iostream>
 #include <stdexcept>
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
 #include "token.h"
 #include "scanner.h"
 #include "ast.h"
@@ -7,21 +10,84 @@
 
 using namespace std;
 
-// =============================
-// Utilidad local
-// =============================
-static inline void expectOrThrow(bool ok, const char* msg) {
-    if (!ok) throw runtime_error(msg);
-}
+// Nodos a medio construir: si un ErrorSintaxis corta el parseo se liberan al
+// salir del ámbito; release() al engancharlos en su padre. Exp::liberar no
+// toca las expresiones compartidas (son de la TablaExpresiones).
+struct LiberarExp {
+    void operator()(Exp* e) const { Exp::liberar(e); }
+};
+typedef unique_ptr<Exp, LiberarExp> ExpPropia;
 
 // =============================
 // Constructor y utilidades
 // =============================
-Parser::Parser(Scanner* sc) : scanner(sc) {
+Parser::Parser(FuenteTokens* sc, ostream* lg) : scanner(sc), log(lg) {
     previous = nullptr;
     current  = scanner->nextToken();
-    if (current->type == Token::ERR) {
-        throw runtime_error("Error léxico");
+    try {
+        while (current->type == Token::ERR) {
+            registrar(current->pos, "Error léxico: carácter inválido '" + current->text + "'");
+            delete current;
+            current = scanner->nextToken();
+        }
+    } catch (...) {
+        delete current;   // sin constructor completo no hay destructor
+        throw;
+    }
+}
+
+ErroresSintaxis::ErroresSintaxis(const vector<Diagnostico>& d)
+    : runtime_error(to_string(d.size()) +
+                    (d.size() == 1 ? " error de sintaxis" : " errores de sintaxis")),
+      diagnosticos(d) {}
+
+// =============================
+// Errores y recuperación
+// =============================
+void Parser::errorSintaxis(const string& msg) {
+    throw ErrorSintaxis(current->pos, msg);
+}
+
+void Parser::expectOrThrow(bool ok, const char* msg) {
+    if (!ok) errorSintaxis(msg);
+}
+
+// Para tokens que se pueden dar por insertados (';', 'begin', 'end', '.'):
+// se registra el error y se sigue como si estuvieran
+void Parser::esperar(bool ok, const char* msg) {
+    if (!ok) registrar(current->pos, msg);
+}
+
+void Parser::registrar(int pos, const string& msg) {
+    // Errores en cascada: uno por posición y ninguno nuevo al final del
+    // archivo si ya se informó algo
+    if (!diagnosticos.empty() && (diagnosticos.back().pos == pos || isAtEnd())) return;
+    diagnosticos.push_back({pos, msg});
+    if (diagnosticos.size() >= MAX_DIAGNOSTICOS) throw ErroresSintaxis(diagnosticos);
+}
+
+// Modo pánico: descarta tokens hasta un punto seguro para seguir parseando.
+//  - sentencias/declaraciones: tras un ';' o antes de 'end', 'function' o
+//    'procedure';
+//    los bloques begin ... end que se saltan se cuentan para no cortar en
+//    un ';' o 'end' interior.
+//  - cabecera de función: antes de 'var', 'begin', 'function' o 'procedure'.
+void Parser::sincronizar(bool cabecera) {
+    int nivel = 0;
+    while (!isAtEnd()) {
+        if (checkSubprograma()) return;
+        if (cabecera) {
+            if (check(Token::VAR) || check(Token::BEGIN_KW)) return;
+        } else if (check(Token::BEGIN_KW)) {
+            nivel++;
+        } else if (check(Token::END_KW)) {
+            if (nivel == 0) return;
+            nivel--;
+        } else if (check(Token::SEMICOL) && nivel == 0) {
+            advance();
+            return;
+        }
+        advance();
     }
 }
 
@@ -38,15 +104,50 @@ bool Parser::check(Token::Type ttype) {
     return current->type == ttype;
 }
 
+// FNV-1a de 64 bits
+static inline uint64_t mezclar(uint64_t h, const void* datos, size_t n) {
+    const unsigned char* p = static_cast<const unsigned char*>(datos);
+    for (size_t i = 0; i < n; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+void Parser::iniciarHash() {
+    if (!hashFunciones) return;
+    hashing    = true;
+    hashActual = 1469598103934665603ULL;
+    idsActual.clear();
+}
+
+void Parser::terminarHash(FunDec* fd) {
+    if (!hashing) return;
+    hashing = false;
+    fd->hashTokens = hashActual;
+    fd->idsUsados.assign(idsActual.begin(), idsActual.end());
+    sort(fd->idsUsados.begin(), fd->idsUsados.end());
+}
+
 bool Parser::advance() {
     if (!isAtEnd()) {
         Token* tmp = current;
+        if (hashing) {
+            unsigned char t = (unsigned char)tmp->type;
+            hashActual = mezclar(hashActual, &t, 1);
+            hashActual = mezclar(hashActual, tmp->text.data(), tmp->text.size());
+            hashActual = mezclar(hashActual, "", 1);
+            if (tmp->type == Token::ID) idsActual.insert(tmp->text);
+        }
         if (previous) delete previous;
         current  = scanner->nextToken();
         previous = tmp;
+        consumidos++;
 
-        if (check(Token::ERR)) {
-            throw runtime_error("Error léxico");
+        while (current->type == Token::ERR) {
+            registrar(current->pos, "Error léxico: carácter inválido '" + current->text + "'");
+            delete current;
+            current = scanner->nextToken();
         }
         return true;
     }
@@ -58,48 +159,99 @@ bool Parser::isAtEnd() {
 }
 
 Program* Parser::parseProgram() {
-    Program* p = new Program();
+    Program* p = parseCabecera();
 
-    if (match(Token::PROGRAM)) {
-        expectOrThrow(match(Token::ID), "Se esperaba nombre del programa tras 'program'");
-        expectOrThrow(match(Token::SEMICOL), "Se esperaba ';' tras cabecera de 'program'");
+    // ====== Funciones y bloque principal (como función 'main') ======
+    try {
+        while (FunDec* f = parseSiguienteFuncion()) {
+            p->fdlist.push_back(f);
+        }
+    } catch (...) {
+        delete p;
+        throw;
     }
 
-    while (check(Token::TYPEKW)) {
-        expectOrThrow(match(Token::TYPEKW), "Se esperaba 'type'");
+    if (!diagnosticos.empty()) {
+        delete p;
+        throw ErroresSintaxis(diagnosticos);
+    }
 
-        while (check(Token::ID)) {
-            TypeAlias* ta = parseTypeAlias();
-            p->tdefs[ta->alias] = ta->target;
-            delete ta;
-            expectOrThrow(match(Token::SEMICOL), "Se esperaba ';' tras definición 'type'");
+    if (log) *log << "Parser exitoso" << endl;
+    return p;
+}
+
+Program* Parser::parseCabecera() {
+    Program* p = new Program();
+    terminado = false;
+
+    try {
+        if (match(Token::PROGRAM)) {
+            expectOrThrow(match(Token::ID), "Se esperaba nombre del programa tras 'program'");
+            expectOrThrow(match(Token::SEMICOL), "Se esperaba ';' tras cabecera de 'program'");
         }
+
+        while (check(Token::TYPEKW)) {
+            expectOrThrow(match(Token::TYPEKW), "Se esperaba 'type'");
+
+            while (check(Token::ID)) {
+                try {
+                    TypeAlias* ta = parseTypeAlias();
+                    p->tdefs[ta->alias] = ta->target;
+                    delete ta;
+                    esperar(match(Token::SEMICOL), "Se esperaba ';' tras definición 'type'");
+                } catch (const ErrorSintaxis& e) {
+                    registrar(e.pos, e.what());
+                    sincronizar(false);
+                }
+            }
+        }
+        while (check(Token::VAR)) {
+            parseVarBlock(p->vdlist, false);
+        }
+    } catch (...) {
+        delete p;
+        throw;
     }
-    while (check(Token::VAR)) {
-        parseVarBlock(p->vdlist);
-    }
+    return p;
+}
 
-    // ====== Declaraciones de funciones ======
-    while (check(Token::FUNCTION)) {
-        FunDec* f = parseFunDec();
-        p->fdlist.push_back(f);
+FunDec* Parser::parseSiguienteFuncion() {
+    while (!terminado) {
+        // Tras un error que se comió el resto del archivo no hay 'main'
+        if (isAtEnd() && !diagnosticos.empty()) break;
+
+        long antes = consumidos;
+        try {
+            // ====== Declaraciones de funciones y procedimientos ======
+            if (checkSubprograma()) return parseFunDec();
+            return parseMain();
+        } catch (const ErrorSintaxis& e) {
+            registrar(e.pos, e.what());
+            sincronizar(false);
+            if (consumidos == antes && !isAtEnd()) advance();
+        }
     }
+    return nullptr;
+}
 
+FunDec* Parser::parseMain() {
     // ====== Bloque principal begin ... end. ======
+    iniciarHash();
+    expresiones.iniciarAmbito();
     Body* mainBody = parseBody();  // consume BEGIN_KW ... END_KW
 
     // Punto final del programa
-    expectOrThrow(match(Token::DOT), "Se esperaba '.' al final del programa Pascal");
+    esperar(match(Token::DOT), "Se esperaba '.' al final del programa Pascal");
 
     // Convertimos el bloque principal en una función 'main'
     FunDec* mainFun = new FunDec();
     mainFun->nombre = "main";
     mainFun->tipo   = "integer";
     mainFun->cuerpo = mainBody;
-    p->fdlist.push_back(mainFun);
-
-    cout << "Parser exitoso" << endl;
-    return p;
+    terminarHash(mainFun);
+    expresiones.entregar(mainFun);
+    terminado = true;
+    return mainFun;
 }
 
 TypeAlias* Parser::parseTypeAlias() {
@@ -112,44 +264,45 @@ TypeAlias* Parser::parseTypeAlias() {
     string target;
     if (match(Token::INTEGER))       target = "integer";
     else if (match(Token::FLOAT))    target = "float";
+    else if (match(Token::DOUBLE))   target = "double";
     else if (match(Token::LONGINT))  target = "longint";
     else if (match(Token::UNSIGNED)) target = "unsigned";
     else if (match(Token::ID))       target = previous->text;
-    else throw runtime_error("Tipo destino inválido en 'type alias = ...'");
+    else errorSintaxis("Tipo destino inválido en 'type alias = ...'");
 
     return new TypeAlias(alias, target);
 }
 
-void Parser::parseVarBlock(std::list<VarDec*>& outList) {
+void Parser::parseVarBlock(std::list<VarDec*>& outList, bool local) {
     expectOrThrow(match(Token::VAR), "Se esperaba 'var'");
 
     while (check(Token::ID)) {
         VarDec* vd = new VarDec();
-
-        expectOrThrow(match(Token::ID), "Se esperaba identificador en declaración 'var'");
-        vd->vars.push_back(previous->text);
-
-        while (match(Token::COMMA)) {
-            expectOrThrow(match(Token::ID), "Se esperaba identificador en lista de variables");
+        try {
+            expectOrThrow(match(Token::ID), "Se esperaba identificador en declaración 'var'");
             vd->vars.push_back(previous->text);
-        }
 
-        expectOrThrow(match(Token::COLON), "Se esperaba ':' en declaración 'var'");
+            while (match(Token::COMMA)) {
+                expectOrThrow(match(Token::ID), "Se esperaba identificador en lista de variables");
+                vd->vars.push_back(previous->text);
+            }
 
-        if (match(Token::INTEGER))           vd->type = "integer";
-        else if (match(Token::FLOAT))        vd->type = "float";
-        else if (match(Token::LONGINT))      vd->type = "longint";
-        else if (match(Token::UNSIGNED))     vd->type = "unsigned";
-        else if (match(Token::ID))           vd->type = previous->text;
-        else throw runtime_error("Tipo inválido en declaración Pascal");
+            expectOrThrow(match(Token::COLON), "Se esperaba ':' en declaración 'var'");
+            parseTipoVar(vd, local);
+        } catch (const ErrorSintaxis& e) {
+            delete vd;
+            registrar(e.pos, e.what());
+            sincronizar(false);
+            continue;
+        }
 
         outList.push_back(vd);
-        expectOrThrow(match(Token::SEMICOL), "Se esperaba ';' tras declaración 'var'");
+        esperar(match(Token::SEMICOL), "Se esperaba ';' tras declaración 'var'");
     }
 }
 
 VarDec* Parser::parseVarDec() {
-    VarDec* vd = new VarDec();
+    unique_ptr<VarDec> vd(new VarDec());
     expectOrThrow(match(Token::VAR), "Se esperaba 'var'");
 
     expectOrThrow(match(Token::ID), "Se esperaba identificador en declaración 'var'");
@@ -161,99 +314,229 @@ VarDec* Parser::parseVarDec() {
     }
 
     expectOrThrow(match(Token::COLON), "Se esperaba ':' en declaración 'var'");
+    parseTipoVar(vd.get(), true);
+
+    return vd.release();
+}
+
+// Bytes máximos de un arreglo: los globales van en .bss; los locales, en la
+// pila (que suele ser de 8 MiB en total)
+static const long long MAX_ARREGLO_GLOBAL = 1LL << 30;
+static const long long MAX_ARREGLO_LOCAL  = 4LL << 20;
+// Los límites, hi - lo y -lo * escala van como inmediatos o desplazamientos
+// de 32 bits con signo en el código generado
+static const long long MAX_INMEDIATO = 0x7fffffffLL;
+
+// Límite de un rango: entero literal, opcionalmente negativo; false si no
+// cabe en 32 bits con signo
+static bool limiteRango(bool negativo, const string& texto, long long& v) {
+    try {
+        v = stoll(texto);
+    } catch (const out_of_range&) {
+        return false;
+    }
+    if (v > MAX_INMEDIATO) return false;
+    if (negativo) v = -v;
+    return true;
+}
+
+// Bytes de un elemento según el nombre del tipo; un alias se cuenta como el
+// más grande (8)
+static long long tamElemento(const string& tipo) {
+    return tipo == "integer" || tipo == "float" || tipo == "unsigned" ? 4 : 8;
+}
+
+void Parser::parseTipoVar(VarDec* vd, bool local) {
+    if (match(Token::ARRAY)) {
+        expectOrThrow(match(Token::LBRACKET), "Se esperaba '[' después de 'array'");
+        bool neg = match(Token::MINUS);
+        expectOrThrow(match(Token::NUM), "Se esperaba un entero como límite inferior del arreglo");
+        if (!limiteRango(neg, previous->text, vd->lo))
+            errorSintaxis("Límite inferior del arreglo fuera de rango");
+        expectOrThrow(match(Token::DOTDOT), "Se esperaba '..' en el rango del arreglo");
+        neg = match(Token::MINUS);
+        expectOrThrow(match(Token::NUM), "Se esperaba un entero como límite superior del arreglo");
+        if (!limiteRango(neg, previous->text, vd->hi))
+            errorSintaxis("Límite superior del arreglo fuera de rango");
+        expectOrThrow(match(Token::RBRACKET), "Se esperaba ']' al cerrar el rango del arreglo");
+        expectOrThrow(match(Token::OF), "Se esperaba 'of' en la declaración del arreglo");
+        if (vd->hi < vd->lo) errorSintaxis("Rango de arreglo vacío");
+        if (vd->hi - vd->lo > MAX_INMEDIATO) errorSintaxis("Rango de arreglo demasiado grande");
+        vd->arreglo = true;
+    }
 
     if (match(Token::INTEGER))           vd->type = "integer";
     else if (match(Token::FLOAT))        vd->type = "float";
+    else if (match(Token::DOUBLE))       vd->type = "double";
     else if (match(Token::LONGINT))      vd->type = "longint";
     else if (match(Token::UNSIGNED))     vd->type = "unsigned";
     else if (match(Token::ID))           vd->type = previous->text;
-    else throw runtime_error("Tipo inválido en declaración Pascal");
-
-    return vd;
+    else errorSintaxis("Tipo inválido en declaración Pascal");
+
+    if (vd->arreglo) {
+        long long escala = tamElemento(vd->type);
+        long long maximo = local ? MAX_ARREGLO_LOCAL : MAX_ARREGLO_GLOBAL;
+        if ((vd->hi - vd->lo + 1) * escala > maximo)
+            errorSintaxis(string("Arreglo demasiado grande (máximo ") +
+                          to_string(maximo >> 20) + " MiB " +
+                          (local ? "por arreglo local)" : "por arreglo global)"));
+        // -lo * escala se suma al desplazamiento del arreglo (en un local,
+        // además del offset en el frame)
+        if (llabs(vd->lo) * escala > MAX_INMEDIATO - maximo)
+            errorSintaxis("Límite inferior del arreglo demasiado lejos de 0");
+    }
 }
 
 Body* Parser::parseBody() {
     Body* b = new Body();
 
     while (check(Token::VAR)) {
-        parseVarBlock(b->declarations);
+        parseVarBlock(b->declarations, true);
     }
+    // Un bloque con variables propias puede ocultar nombres de fuera: sus
+    // expresiones no se comparten con las de antes ni las de después
+    bool ambito = !b->declarations.empty();
+    if (ambito) expresiones.iniciarAmbito();
 
     // begin ... end
-    expectOrThrow(match(Token::BEGIN_KW), "Se esperaba 'begin' para iniciar un bloque");
-
-    while (!check(Token::END_KW) && !isAtEnd()) {
-        Stm* s = parseStm();
-        b->StmList.push_back(s);
-        if (check(Token::SEMICOL)) match(Token::SEMICOL);
+    esperar(match(Token::BEGIN_KW), "Se esperaba 'begin' para iniciar un bloque");
+
+    while (!check(Token::END_KW) && !isAtEnd() && !checkSubprograma()) {
+        long antes = consumidos;
+        try {
+            Stm* s = parseStm();
+            b->StmList.push_back(s);
+            if (check(Token::SEMICOL)) match(Token::SEMICOL);
+        } catch (const ErrorSintaxis& e) {
+            registrar(e.pos, e.what());
+            sincronizar(false);
+            if (consumidos == antes && !check(Token::END_KW) && !checkSubprograma())
+                advance();
+        }
     }
 
-    expectOrThrow(match(Token::END_KW), "Se esperaba 'end' para cerrar el bloque");
+    esperar(match(Token::END_KW), "Se esperaba 'end' para cerrar el bloque");
+    if (ambito) expresiones.iniciarAmbito();
 
     return b;
 }
 
 FunDec* Parser::parseFunDec() {
     FunDec* fd = new FunDec();
-
-    expectOrThrow(match(Token::FUNCTION), "Se esperaba 'function'");
-
-    expectOrThrow(match(Token::ID), "Se esperaba nombre de función");
-    fd->nombre = previous->text;
-
-    expectOrThrow(match(Token::LPAREN), "Se esperaba '(' en parámetros de función");
-
-    if (!check(Token::RPAREN)) {
-        while (true) {
-            std::vector<std::string> paramNames;
-            expectOrThrow(match(Token::ID), "Se esperaba identificador de parámetro");
-            paramNames.push_back(previous->text);
-
-            while (match(Token::COMMA)) {
+    iniciarHash();
+    expresiones.iniciarAmbito();
+
+    // Un procedimiento no tiene tipo de retorno (FunDec::tipo vacío) y sus
+    // paréntesis son opcionales si no tiene parámetros
+    bool procedimiento = match(Token::PROCEDURE);
+    if (!procedimiento) expectOrThrow(match(Token::FUNCTION), "Se esperaba 'function' o 'procedure'");
+
+    // Cabecera: si falla, se salta hasta 'var' / 'begin' y se sigue con el
+    // cuerpo para encontrar también sus errores
+    bool cabeceraOk = true;
+    try {
+        expectOrThrow(match(Token::ID), "Se esperaba nombre de función");
+        fd->nombre = previous->text;
+
+        bool parentesis = match(Token::LPAREN);
+        if (!procedimiento) expectOrThrow(parentesis, "Se esperaba '(' en parámetros de función");
+
+        if (parentesis && !check(Token::RPAREN)) {
+            while (true) {
+                // var a, b: tipo  ->  por referencia
+                bool porReferencia = match(Token::VAR);
+                std::vector<std::string> paramNames;
                 expectOrThrow(match(Token::ID), "Se esperaba identificador de parámetro");
                 paramNames.push_back(previous->text);
-            }
 
-            expectOrThrow(match(Token::COLON), "Se esperaba ':' tras nombres de parámetros");
+                while (match(Token::COMMA)) {
+                    expectOrThrow(match(Token::ID), "Se esperaba identificador de parámetro");
+                    paramNames.push_back(previous->text);
+                }
 
-            std::string ptype;
-            if (match(Token::INTEGER))      ptype = "integer";
-            else if (match(Token::FLOAT))   ptype = "float";
-            else if (match(Token::LONGINT)) ptype = "longint";
-            else if (match(Token::UNSIGNED))ptype = "unsigned";
-            else if (match(Token::ID))      ptype = previous->text;
-            else throw runtime_error("Tipo de parámetro inválido en function");
+                expectOrThrow(match(Token::COLON), "Se esperaba ':' tras nombres de parámetros");
+
+                std::string ptype;
+                if (match(Token::INTEGER))      ptype = "integer";
+                else if (match(Token::FLOAT))   ptype = "float";
+                else if (match(Token::DOUBLE))  ptype = "double";
+                else if (match(Token::LONGINT)) ptype = "longint";
+                else if (match(Token::UNSIGNED))ptype = "unsigned";
+                else if (match(Token::ID))      ptype = previous->text;
+                else errorSintaxis("Tipo de parámetro inválido en function");
+
+                for (auto &pn : paramNames) {
+                    fd->Pnombres.push_back(pn);
+                    fd->Ptipos.push_back(ptype);
+                    fd->Pvar.push_back(porReferencia);
+                }
 
-            for (auto &pn : paramNames) {
-                fd->Pnombres.push_back(pn);
-                fd->Ptipos.push_back(ptype);
+                if (!match(Token::SEMICOL))
+                    break;
             }
-
-            if (!match(Token::SEMICOL))
-                break;
         }
-    }
-
-    expectOrThrow(match(Token::RPAREN), "Se esperaba ')' al cerrar parámetros");
 
-    expectOrThrow(match(Token::COLON), "Se esperaba ':' antes del tipo de retorno en function");
+        if (parentesis) expectOrThrow(match(Token::RPAREN), "Se esperaba ')' al cerrar parámetros");
+        if (procedimiento) procedimientos.insert(fd->nombre);
+        else               procedimientos.erase(fd->nombre);
 
-    if (match(Token::INTEGER))      fd->tipo = "integer";
-    else if (match(Token::FLOAT))   fd->tipo = "float";
-    else if (match(Token::LONGINT)) fd->tipo = "longint";
-    else if (match(Token::UNSIGNED))fd->tipo = "unsigned";
-    else if (match(Token::ID))      fd->tipo = previous->text;
-    else throw runtime_error("Tipo de retorno inválido en function");
+        if (procedimiento) {
+            if (check(Token::COLON)) errorSintaxis("Un procedimiento no tiene tipo de retorno");
+        } else {
+            expectOrThrow(match(Token::COLON), "Se esperaba ':' antes del tipo de retorno en function");
+
+            if (match(Token::INTEGER))      fd->tipo = "integer";
+            else if (match(Token::FLOAT))   fd->tipo = "float";
+            else if (match(Token::DOUBLE))  fd->tipo = "double";
+            else if (match(Token::LONGINT)) fd->tipo = "longint";
+            else if (match(Token::UNSIGNED))fd->tipo = "unsigned";
+            else if (match(Token::ID))      fd->tipo = previous->text;
+            else errorSintaxis("Tipo de retorno inválido en function");
+        }
+    } catch (const ErrorSintaxis& e) {
+        registrar(e.pos, e.what());
+        sincronizar(true);
+        cabeceraOk = false;
+    }
 
-    expectOrThrow(match(Token::SEMICOL), "Se esperaba ';' tras cabecera de function");
+    if (cabeceraOk)
+        esperar(match(Token::SEMICOL), procedimiento ? "Se esperaba ';' tras cabecera de procedure"
+                                                     : "Se esperaba ';' tras cabecera de function");
+    if (checkSubprograma()) {
+        terminarHash(fd);
+        expresiones.entregar(fd);
+        return fd;
+    }
 
     fd->cuerpo = parseBody();
 
-    expectOrThrow(match(Token::SEMICOL), "Se esperaba ';' tras 'end' de function");
+    esperar(match(Token::SEMICOL), procedimiento ? "Se esperaba ';' tras 'end' de procedure"
+                                                 : "Se esperaba ';' tras 'end' de function");
+    terminarHash(fd);
+    expresiones.entregar(fd);
 
     return fd;
 }
 
+// Argumentos de nombre(...) (ya consumido el '(') hasta el ')'. Los de
+// readln van por referencia; los de parámetros var los marca el análisis
+// de tipos con la firma visible.
+FcallExp* Parser::llamada(const std::string& nombre, const char* cierre) {
+    unique_ptr<FcallExp> fcall(new FcallExp());
+    fcall->nombre = nombre;
+    if (!check(Token::RPAREN)) {
+        fcall->argumentos.push_back(parseCE());
+        while (match(Token::COMMA)) {
+            fcall->argumentos.push_back(parseCE());
+        }
+    }
+    expectOrThrow(match(Token::RPAREN), cierre);
+
+    if (nombre == "readln")
+        fcall->referencia.assign(fcall->argumentos.size(), true);
+    return fcall.release();
+}
+
 static Body* makeSingleStmBody(Stm* s) {
     Body* b = new Body();
     if (s) b->StmList.push_back(s);
@@ -267,7 +550,6 @@ Stm* Parser::parseStm() {
     while (match(Token::SEMICOL));
 
     Stm* a = nullptr;
-    Exp* e = nullptr;
     string nombre;
 
     if (match(Token::ID)) {
@@ -275,97 +557,115 @@ Stm* Parser::parseStm() {
 
         if (check(Token::LPAREN)) {
             match(Token::LPAREN);
+            a = new ExpStm(llamada(nombre, "Se esperaba ')' al cerrar llamada de función/procedimiento"));
+        } else if (procedimientos.count(nombre) && !check(Token::ASSIGN) && !check(Token::LBRACKET)) {
+            // p;  (procedimiento sin argumentos)
             FcallExp* fcall = new FcallExp();
             fcall->nombre = nombre;
-
-            if (!check(Token::RPAREN)) {
-                fcall->argumentos.push_back(parseCE());
-                while (match(Token::COMMA)) {
-                    fcall->argumentos.push_back(parseCE());
-                }
-            }
-            expectOrThrow(match(Token::RPAREN), "Se esperaba ')' al cerrar llamada de función/procedimiento");
             a = new ExpStm(fcall);
         } else {
+            // a[i] := e
+            ExpPropia indice;
+            if (match(Token::LBRACKET)) {
+                indice.reset(parseCE());
+                expectOrThrow(match(Token::RBRACKET), "Se esperaba ']' después del índice");
+            }
             expectOrThrow(match(Token::ASSIGN), "Se esperaba ':=' en asignación");
-            e = parseCE();
-            a = new AssignStm(nombre, e);
+            AssignStm* as = new AssignStm(nombre, parseCE());
+            as->indice = indice.release();
+            a = as;
         }
     }
 
     // 2) writeln( CE );
     else if (match(Token::WRITELN)) {
         expectOrThrow(match(Token::LPAREN), "Se esperaba '(' en writeln");
-        e = parseCE();
+        ExpPropia e(parseCE());
         expectOrThrow(match(Token::RPAREN), "Se esperaba ')' en writeln");
-        a = new PrintStm(e);
+        a = new PrintStm(e.release());
     }
 
     // 3) readln( ... );
     else if (match(Token::READLN)) {
         expectOrThrow(match(Token::LPAREN), "Se esperaba '(' en readln");
-        FcallExp* fcall = new FcallExp();
-        fcall->nombre = "readln";
-
-        if (!check(Token::RPAREN)) {
-            fcall->argumentos.push_back(parseCE());
-            while (match(Token::COMMA)) {
-                fcall->argumentos.push_back(parseCE());
-            }
-        }
-        expectOrThrow(match(Token::RPAREN), "Se esperaba ')' en readln");
-        a = new ExpStm(fcall);
+        a = new ExpStm(llamada("readln", "Se esperaba ')' en readln"));
     }
 
     // 4) if CE then bloque | sentencia   [else bloque | sentencia]
     else if (match(Token::IF)) {
-        e = parseCE();
+        ExpPropia e(parseCE());
         expectOrThrow(match(Token::THEN), "Se esperaba 'then' después de la condición del if");
 
-        Body* tb = nullptr;
-        Body* fb = nullptr;
+        unique_ptr<Body> tb;
+        unique_ptr<Body> fb;
 
-        // THEN: o bien 'begin ... end' o una sola sentencia
-        if (check(Token::BEGIN_KW)) {
-            tb = parseBody();  // begin ... end
+        // THEN: o bien '[var ...] begin ... end' o una sola sentencia
+        if (check(Token::BEGIN_KW) || check(Token::VAR)) {
+            tb.reset(parseBody());  // begin ... end
         } else {
             Stm* sThen = parseStm();  // una sola sentencia
-            tb = makeSingleStmBody(sThen);
+            tb.reset(makeSingleStmBody(sThen));
         }
 
         // ELSE opcional: igual, bloque o sentencia simple
         if (match(Token::ELSE)) {
-            if (check(Token::BEGIN_KW)) {
-                fb = parseBody();   // else begin ... end
+            if (check(Token::BEGIN_KW) || check(Token::VAR)) {
+                fb.reset(parseBody());   // else begin ... end
             } else {
                 Stm* sElse = parseStm(); // else <sentencia>
-                fb = makeSingleStmBody(sElse);
+                fb.reset(makeSingleStmBody(sElse));
             }
         }
 
-        a = new IfStm(e, tb, fb);
+        a = new IfStm(e.release(), tb.release(), fb.release());
     }
 
     // 5) while CE do bloque | sentencia
     else if (match(Token::WHILE)) {
-        e = parseCE();
+        ExpPropia e(parseCE());
         expectOrThrow(match(Token::DO), "Se esperaba 'do' después de la condición del while");
 
         Body* bb = nullptr;
 
-        // DO: o 'begin ... end' o sentencia simple
-        if (check(Token::BEGIN_KW)) {
+        // DO: o '[var ...] begin ... end' o sentencia simple
+        if (check(Token::BEGIN_KW) || check(Token::VAR)) {
             bb = parseBody();  // while ... do begin ... end
         } else {
             Stm* sBody = parseStm(); // while ... do <sentencia>
             bb = makeSingleStmBody(sBody);
         }
 
-        a = new WhileStm(e, bb);
+        a = new WhileStm(e.release(), bb);
+    }
+
+    // 6) for id := CE to|downto CE do bloque | sentencia
+    else if (match(Token::FOR)) {
+        expectOrThrow(match(Token::ID), "Se esperaba la variable de control del for");
+        nombre = previous->text;
+        expectOrThrow(match(Token::ASSIGN), "Se esperaba ':=' en el for");
+        ExpPropia inicio(parseCE());
+
+        bool descendente = false;
+        if (match(Token::DOWNTO)) descendente = true;
+        else expectOrThrow(match(Token::TO), "Se esperaba 'to' o 'downto' en el for");
+
+        ExpPropia fin(parseCE());
+        expectOrThrow(match(Token::DO), "Se esperaba 'do' en el for");
+
+        // DO: o '[var ...] begin ... end' o sentencia simple
+        Body* bb = nullptr;
+        if (check(Token::BEGIN_KW) || check(Token::VAR)) {
+            bb = parseBody();
+        } else {
+            Stm* sBody = parseStm();
+            bb = makeSingleStmBody(sBody);
+        }
+
+        a = new ForStm(nombre, inicio.release(), fin.release(), descendente, bb);
     }
 
     else {
-        throw runtime_error("Error sintáctico en sentencia");
+        errorSintaxis("Error sintáctico en sentencia");
     }
 
     if (check(Token::SEMICOL)) match(Token::SEMICOL);
@@ -376,7 +676,7 @@ Stm* Parser::parseStm() {
 // Expresiones
 // =============================
 Exp* Parser::parseCE() {
-    Exp* l = parseBE();
+    ExpPropia l(parseBE());
     if (match(Token::LT) || match(Token::LE) || match(Token::GT) ||
         match(Token::GE) || match(Token::EQ) || match(Token::NEQ)) {
 
@@ -388,28 +688,28 @@ Exp* Parser::parseCE() {
             case Token::GE:  op = GE_OP;  break;
             case Token::EQ:  op = EQ_OP;  break;
             case Token::NEQ: op = NEQ_OP; break;
-            default: throw runtime_error("Operador relacional inesperado");
+            default: errorSintaxis("Operador relacional inesperado");
         }
-        Exp* r = parseBE();
-        l = new BinaryExp(l, r, op);
+        ExpPropia r(parseBE());
+        l.reset(expresiones.binaria(l.release(), r.release(), op));
     }
-    return l;
+    return l.release();
 }
 
 // BE: suma / resta
 Exp* Parser::parseBE() {
-    Exp* l = parseE();
+    ExpPropia l(parseE());
     while (match(Token::PLUS) || match(Token::MINUS)) {
         BinaryOp op = (previous->type == Token::PLUS) ? PLUS_OP : MINUS_OP;
-        Exp* r = parseE();
-        l = new BinaryExp(l, r, op);
+        ExpPropia r(parseE());
+        l.reset(expresiones.binaria(l.release(), r.release(), op));
     }
-    return l;
+    return l.release();
 }
 
 // E: multiplicativos (*, div, /, mod)
 Exp* Parser::parseE() {
-    Exp* l = parseT();
+    ExpPropia l(parseT());
     while (match(Token::MUL) || match(Token::DIV) || match(Token::REALDIV) || match(Token::MOD)) {
         BinaryOp op;
         switch (previous->type) {
@@ -419,12 +719,12 @@ Exp* Parser::parseE() {
                 op = DIV_OP;     break;
             case Token::MOD:     op = MOD_OP;  break;
             default:
-                throw runtime_error("Operador multiplicativo inesperado");
+                errorSintaxis("Operador multiplicativo inesperado");
         }
-        Exp* r = parseT();
-        l = new BinaryExp(l, r, op);
+        ExpPropia r(parseT());
+        l.reset(expresiones.binaria(l.release(), r.release(), op));
     }
-    return l;
+    return l.release();
 }
 
 // T: unarios +/- y delega a F
@@ -434,51 +734,49 @@ Exp* Parser::parseT() {
     }
     if (match(Token::MINUS)) {
         Exp* e = parseT();
-        return new BinaryExp(new NumberExp((long long)0), e, MINUS_OP);
+        return expresiones.binaria(expresiones.numero((long long)0), e, MINUS_OP);
     }
     return parseF();
 }
 
 // F: primarias + CASTS tipo(expr)
 Exp* Parser::parseF() {
-    Exp* e;
     string nom;
 
-    // ---- Casts explícitos estilo Pascal: float(expr), integer(expr), longint(expr), unsigned(expr) ----
-    if (match(Token::FLOAT) || match(Token::INTEGER) || match(Token::LONGINT) || match(Token::UNSIGNED)) {
+    // ---- Casts explícitos estilo Pascal: float(expr), double(expr), integer(expr), longint(expr), unsigned(expr) ----
+    if (match(Token::FLOAT) || match(Token::DOUBLE) || match(Token::INTEGER) || match(Token::LONGINT) || match(Token::UNSIGNED)) {
         Token::Type t = previous->type;
         expectOrThrow(match(Token::LPAREN), "Se esperaba '(' después del tipo en cast");
 
-        Exp* inner = parseCE();
+        ExpPropia inner(parseCE());
         expectOrThrow(match(Token::RPAREN), "Se esperaba ')' para cerrar el cast");
 
         Tipo dst;
         switch (t) {
             case Token::FLOAT:   dst = T_FLOAT;    break;
+            case Token::DOUBLE:  dst = T_DOUBLE;   break;
             case Token::INTEGER: dst = T_INT;      break;
             case Token::LONGINT: dst = T_LONG;     break;
             case Token::UNSIGNED:dst = T_UNSIGNED; break;
             default:             dst = T_INT;      break;
         }
 
-        CastExp* c = new CastExp(inner, dst);
-        c->tipoDato = dst;
-        return c;
+        return expresiones.cast(inner.release(), dst);
     }
 
     // ---- Números ----
     if (match(Token::NUM)) {
-        return new NumberExp((long long)stoll(previous->text));
+        return expresiones.numero((long long)stoll(previous->text));
     }
     else if (match(Token::FLOATNUM)) {
-        return new NumberExp(stod(previous->text));
+        return expresiones.numero(stod(previous->text));
     }
 
     // ---- (expr) ----
     else if (match(Token::LPAREN)) {
-        e = parseCE();
+        ExpPropia e(parseCE());
         expectOrThrow(match(Token::RPAREN), "Se esperaba ')' para cerrar la expresión");
-        return e;
+        return e.release();
     }
 
     // ---- id o llamada f(...) ----
@@ -486,20 +784,17 @@ Exp* Parser::parseF() {
         nom = previous->text;
         if (check(Token::LPAREN)) {
             match(Token::LPAREN);
-            FcallExp* fcall = new FcallExp();
-            fcall->nombre = nom;
-            if (!check(Token::RPAREN)) {
-                fcall->argumentos.push_back(parseCE());
-                while (match(Token::COMMA)) {
-                    fcall->argumentos.push_back(parseCE());
-                }
-            }
-            expectOrThrow(match(Token::RPAREN), "Se esperaba ')' al cerrar llamada de función");
-            return fcall;
+            return llamada(nom, "Se esperaba ')' al cerrar llamada de función");
+        } else if (match(Token::LBRACKET)) {
+            // Elemento de arreglo: nunca se comparte (su verificación de
+            // rango depende del lugar donde aparece)
+            ExpPropia indice(parseCE());
+            expectOrThrow(match(Token::RBRACKET), "Se esperaba ']' después del índice");
+            return new IndexExp(nom, indice.release());
         } else {
-            return new IdExp(nom);
+            return expresiones.id(nom);
         }
     }
 
-    throw runtime_error("Error sintáctico en expresión");
+    errorSintaxis("Error sintáctico en expresión");
 }
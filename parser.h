@@ -4,30 +4,106 @@
 #include "scanner.h"
 #include "ast.h"
 #include <list>
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+#include <unordered_set>
+
+// Diagnóstico de sintaxis: posición (offset en el texto) y mensaje
+struct Diagnostico {
+    int         pos;
+    std::string mensaje;
+};
+
+// Error en el punto actual del parseo; el parser lo registra y se recupera
+// en modo pánico
+class ErrorSintaxis : public std::runtime_error {
+public:
+    int pos;
+    ErrorSintaxis(int p, const std::string& msg) : std::runtime_error(msg), pos(p) {}
+};
+
+// Todos los diagnósticos de una pasada (se lanza al terminar de parsear)
+class ErroresSintaxis : public std::runtime_error {
+public:
+    std::vector<Diagnostico> diagnosticos;
+    explicit ErroresSintaxis(const std::vector<Diagnostico>& d);
+};
 
 class Parser {
 private:
-    Scanner* scanner;
+    FuenteTokens* scanner;   // Scanner, TuberiaTokens o TokensEnMemoria
     Token *current, *previous;
+    std::ostream* log;   // mensajes de progreso (nullptr = silencioso)
+
+    // Hash de los tokens consumidos dentro de la declaración actual
+    bool     hashing = false;
+    uint64_t hashActual = 0;
+    std::unordered_set<std::string> idsActual;
+
+    bool terminado = false;   // ya se consumió el bloque principal
+
+    FcallExp* llamada(const std::string& nombre, const char* cierre);
+
+    // Procedimientos declarados hasta ahí: 'p;' es una llamada sin argumentos
+    std::unordered_set<std::string> procedimientos;
+
+    // Recuperación de errores (modo pánico)
+    static const size_t MAX_DIAGNOSTICOS = 100;
+    std::vector<Diagnostico> diagnosticos;
+    long consumidos = 0;      // tokens consumidos (para garantizar avance)
+
+    [[noreturn]] void errorSintaxis(const std::string& msg);
+    void expectOrThrow(bool ok, const char* msg);
+    void esperar(bool ok, const char* msg);   // registra sin abortar
+    void registrar(int pos, const std::string& msg);
+    void sincronizar(bool cabecera);
+
+    void iniciarHash();
+    void terminarHash(FunDec* fd);
 
     bool match(Token::Type ttype);
     bool check(Token::Type ttype);
+    bool checkSubprograma() { return check(Token::FUNCTION) || check(Token::PROCEDURE); }
     bool advance();
     bool isAtEnd();
 
     // Bloque begin ... end
     Body* parseBody();
-    void parseVarBlock(std::list<VarDec*>& outList);
+    // 'local': variables en el frame de una función (límite de tamaño menor)
+    void parseVarBlock(std::list<VarDec*>& outList, bool local);
+    FunDec* parseMain();
 
 public:
-    Parser(Scanner* scanner);
+    Parser(FuenteTokens* scanner, std::ostream* log = &std::cout);
+    ~Parser() { delete previous; delete current; }
+    Parser(const Parser&) = delete;
+    Parser& operator=(const Parser&) = delete;
 
+    // Calcular FunDec::hashTokens / idsUsados (caché incremental)
+    bool hashFunciones = false;
+
+    // Fábrica de expresiones; con expresiones.activa se comparten las
+    // subexpresiones iguales de cada función (hash-consing)
+    TablaExpresiones expresiones;
+
+    // Lanza ErroresSintaxis con todos los diagnósticos si hubo alguno
     Program* parseProgram();
 
+    const std::vector<Diagnostico>& errores() const { return diagnosticos; }
+
+    // Parseo incremental (compilación en streaming): la cabecera (type/var
+    // globales) y después una función por llamada; el bloque principal se
+    // devuelve como la función 'main' y luego nullptr. No lanzan por errores
+    // de sintaxis: quedan en errores().
+    Program* parseCabecera();
+    FunDec*  parseSiguienteFuncion();
+
     // Declaraciones
     VarDec*    parseVarDec();     // (versión simple: var x,y: tipo;)
+    void       parseTipoVar(VarDec* vd, bool local);   // tipo | array[lo..hi] of tipo
     TypeAlias* parseTypeAlias();  // alias = tipo;
-    FunDec*    parseFunDec();     // function f(...): tipo; [var ...;] begin ... end;
+    FunDec*    parseFunDec();     // function f(...): tipo; / procedure p[(...)]; [var ...;] begin ... end;
 
     // Sentencias
     Stm* parseStm();
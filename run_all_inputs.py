@@ -3,7 +3,7 @@ import subprocess
 import shutil
 
 # Archivos C++
-programa = ["main.cpp", "scanner.cpp", "token.cpp", "parser.cpp", "ast.cpp", "visitor.cpp"]
+programa = ["main.cpp", "driver.cpp", "threadpool.cpp", "cache.cpp", "server.cpp", "tuberia.cpp", "lexparalelo.cpp", "astbin.cpp", "runtime.cpp", "scanner.cpp", "token.cpp", "parser.cpp", "ast.cpp", "visitor.cpp"]
 
 # Compilar
 compile = ["g++"] + programa
@@ -29,28 +29,30 @@ for f in os.listdir(output_dir):
     if f.endswith(".s"):
         os.remove(os.path.join(output_dir, f))
 
-# Ejecutar inputs
-for i in range(1, 19):
+# Ejecutar inputs (todos en un solo proceso)
+entradas = []
+for i in range(1, 29):
     filename = f"input{i}.txt"
     filepath = os.path.join(input_dir, filename)
-
     if os.path.isfile(filepath):
-        print(f"Ejecutando {filename}")
-        run_cmd = ["./a.out", filepath]
-        result = subprocess.run(run_cmd, capture_output=True, text=True)
-        if result.returncode != 0:
-            print(f" Error ejecutando {filename}:\n{result.stderr}")
-            continue
-
-        tokens_file = os.path.join(input_dir, f"input{i}.s")
-
-        if os.path.isfile(tokens_file):
-            dest_tokens = os.path.join(output_dir, f"input_{i}.s")
-            shutil.move(tokens_file, dest_tokens)
-            print(f"    Generado: {dest_tokens}")
-        else:
-            print(f"  No se generó archivo .s para {filename}")
+        entradas.append((i, filepath))
     else:
         print(f"{filename} no encontrado en {input_dir}")
 
+print("Ejecutando", len(entradas), "archivos")
+run_cmd = ["./a.out", "-q"] + [fp for _, fp in entradas]
+result = subprocess.run(run_cmd, capture_output=True, text=True)
+if result.returncode != 0:
+    print(f" Error ejecutando:\n{result.stdout}{result.stderr}")
+
+for i, filepath in entradas:
+    tokens_file = os.path.join(input_dir, f"input{i}.s")
+
+    if os.path.isfile(tokens_file):
+        dest_tokens = os.path.join(output_dir, f"input_{i}.s")
+        shutil.move(tokens_file, dest_tokens)
+        print(f"    Generado: {dest_tokens}")
+    else:
+        print(f"  No se generó archivo .s para input{i}.txt")
+
 print("\n Ejecución completada.")
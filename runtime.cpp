@@ -0,0 +1,530 @@
+#include "runtime.h"
+
+// Las etiquetas internas son .L (locales al archivo .s) para no chocar con
+// las funciones del programa.
+const char* const RUNTIME_ESCRITURA = R"(
+# Runtime de escritura (ver runtime.h)
+.bss
+.p2align 6
+.Lesc_buf: .zero 1048576
+.data
+.p2align 3
+.Lesc_pos: .quad .Lesc_buf
+.section .rodata
+.p2align 3
+.Lesc_millon: .double 1000000.0
+.Lesc_limite: .double 9.0e12
+.Lesc_limite_d: .double 3.0e7
+.Lesc_casi_medio: .double 0.49609375
+.Lesc_fmt_f: .string "%f \n"
+.Lesc_pot10: .quad 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000, 10000000000, 100000000000, 1000000000000, 10000000000000, 100000000000000, 1000000000000000, 10000000000000000, 100000000000000000, 1000000000000000000, 10000000000000000000
+.Lesc_pares: .ascii "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899"
+.section .fini_array,"aw"
+.p2align 3
+.quad write_flush
+.text
+
+# Vacía el buffer con write(1, ...); reintenta si la escritura es parcial o
+# se interrumpe (EINTR) y descarta el resto ante cualquier otro error
+write_flush:
+ leaq .Lesc_buf(%rip), %rsi
+ movq .Lesc_pos(%rip), %rdx
+ subq %rsi, %rdx
+1:
+ testq %rdx, %rdx
+ jle 2f
+ movl $1, %eax
+ movl $1, %edi
+ syscall
+ cmpq $-4, %rax
+ je 1b
+ testq %rax, %rax
+ jle 2f
+ addq %rax, %rsi
+ subq %rax, %rdx
+ jmp 1b
+2:
+ leaq .Lesc_buf(%rip), %rax
+ movq %rax, .Lesc_pos(%rip)
+ ret
+
+# %rdi = posición en el buffer con al menos 320 bytes libres (vacía el
+# buffer si hace falta); conserva %rax y %xmm0. Lo más largo que se escribe
+# es un double con "%f \n": signo, 309 dígitos enteros, '.', 6 decimales,
+# " \n" y el 0 final de snprintf, 320 bytes.
+.Lesc_espacio:
+ movq .Lesc_pos(%rip), %rdi
+ leaq .Lesc_buf+1048576-320(%rip), %rcx
+ cmpq %rcx, %rdi
+ jbe 1f
+ pushq %rax
+ call write_flush
+ popq %rax
+ movq .Lesc_pos(%rip), %rdi
+1:
+ ret
+
+# Dígitos decimales de %rax (sin signo) en (%rdi); deja %rdi tras el
+# último. La longitud sale de log2 (bsr) * log10(2) corregido con una tabla
+# de potencias de 10; los dígitos se escriben de atrás hacia adelante, de a
+# dos por división entre 100 (multiplicación por el inverso)
+.Lesc_dec:
+ cmpq $10, %rax
+ jae 1f
+ addl $48, %eax
+ movb %al, (%rdi)
+ addq $1, %rdi
+ ret
+1:
+ bsrq %rax, %rcx
+ addl $1, %ecx
+ imull $1233, %ecx, %ecx
+ shrl $12, %ecx
+ leaq .Lesc_pot10(%rip), %r8
+ cmpq (%r8,%rcx,8), %rax
+ sbbq $-1, %rcx
+ addq %rcx, %rdi
+ movq %rdi, %r9
+ movabsq $0x28F5C28F5C28F5C3, %r10
+ leaq .Lesc_pares(%rip), %r11
+2:
+ cmpq $100, %rax
+ jb 3f
+ movq %rax, %rcx
+ shrq $2, %rax
+ mulq %r10
+ shrq $2, %rdx
+ imulq $100, %rdx, %rax
+ subq %rax, %rcx
+ movzwl (%r11,%rcx,2), %ecx
+ movw %cx, -2(%r9)
+ subq $2, %r9
+ movq %rdx, %rax
+ jmp 2b
+3:
+ cmpq $10, %rax
+ jb 4f
+ movzwl (%r11,%rax,2), %ecx
+ movw %cx, -2(%r9)
+ ret
+4:
+ addl $48, %eax
+ movb %al, -1(%r9)
+ ret
+
+write_i32:
+ movslq %edi, %rax
+ jmp .Lesc_entero
+write_u32:
+ movl %edi, %eax
+ call .Lesc_espacio
+ jmp .Lesc_digitos
+write_i64:
+ movq %rdi, %rax
+.Lesc_entero:
+ call .Lesc_espacio
+ testq %rax, %rax
+ jns .Lesc_digitos
+ movb $45, (%rdi)
+ addq $1, %rdi
+ negq %rax
+.Lesc_digitos:
+ call .Lesc_dec
+ movw $0x0a20, (%rdi)
+ addq $2, %rdi
+ movq %rdi, .Lesc_pos(%rip)
+ ret
+
+# Como printf("%f"): |x| * 10^6 es exacto en double para cualquier float
+# (24 bits de mantisa por 20 de 10^6), así que redondear ese producto al
+# entero (al par, como printf) da los 6 decimales exactos. Infinito, NaN y
+# |x| >= 9e12 (el producto no cabe en 63 bits) van por snprintf.
+write_f32:
+ cvtss2sd %xmm0, %xmm0
+ call .Lesc_espacio
+ movq %xmm0, %rax
+ btrq $63, %rax
+ movq %rax, %xmm1
+ ucomisd .Lesc_limite(%rip), %xmm1
+ jp .Lesc_f_lento
+ jae .Lesc_f_lento
+ movmskpd %xmm0, %eax
+ testl $1, %eax
+ jz 1f
+ movb $45, (%rdi)
+ addq $1, %rdi
+1:
+ mulsd .Lesc_millon(%rip), %xmm1
+ cvtsd2si %xmm1, %rax
+ jmp .Lesc_f_digitos
+
+# En double el producto |x| * 10^6 se redondea; con |x| < 3e7 queda por
+# debajo de 2^45 y el error es a lo sumo 2^-9, así que su redondeo al
+# entero coincide con el del valor exacto salvo que la parte fraccionaria
+# quede a menos de 2^-8 de 0.5. Ese caso y |x| >= 3e7 van por snprintf.
+write_f64:
+ call .Lesc_espacio
+ movq %xmm0, %rax
+ btrq $63, %rax
+ movq %rax, %xmm1
+ ucomisd .Lesc_limite_d(%rip), %xmm1
+ jp .Lesc_f_lento
+ jae .Lesc_f_lento
+ mulsd .Lesc_millon(%rip), %xmm1
+ cvtsd2si %xmm1, %rax
+ cvtsi2sdq %rax, %xmm2
+ subsd %xmm2, %xmm1
+ movq %xmm1, %rdx
+ btrq $63, %rdx
+ movq %rdx, %xmm1
+ ucomisd .Lesc_casi_medio(%rip), %xmm1
+ jae .Lesc_f_lento
+ movmskpd %xmm0, %ecx
+ testl $1, %ecx
+ jz .Lesc_f_digitos
+ movb $45, (%rdi)
+ addq $1, %rdi
+.Lesc_f_digitos:
+ xorl %edx, %edx
+ movl $1000000, %ecx
+ divq %rcx
+ movq %rdx, %rsi
+ call .Lesc_dec
+ leaq 1000000(%rsi), %rax
+ movq %rdi, %rsi
+ call .Lesc_dec
+ movb $46, (%rsi)
+ movw $0x0a20, (%rdi)
+ addq $2, %rdi
+ movq %rdi, .Lesc_pos(%rip)
+ ret
+.Lesc_f_lento:
+ pushq %rbx
+ movq %rdi, %rbx
+ movl $320, %esi
+ leaq .Lesc_fmt_f(%rip), %rdx
+ movl $1, %eax
+ call snprintf@PLT
+ cltq
+ addq %rax, %rbx
+ movq %rbx, .Lesc_pos(%rip)
+ popq %rbx
+ ret
+)";
+
+// Lectura: bloques de 1 MiB con read(0, ...) y un centinela 0 tras el
+// último byte, para que los bucles de dígitos no comprueben el final en cada
+// carácter.
+const char* const RUNTIME_LECTURA = R"(
+# Runtime de lectura (ver runtime.h)
+.bss
+.p2align 6
+.Llee_buf: .zero 1048592
+.data
+.p2align 3
+.Llee_pos: .quad .Llee_buf
+.Llee_fin: .quad .Llee_buf
+.section .rodata
+.p2align 4
+.Llee_signo: .long 0x80000000, 0, 0, 0
+.Llee_signo64: .quad 0x8000000000000000, 0
+.Llee_pot10: .double 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+.text
+
+# Siguiente bloque de la entrada estándar. Antes vacía la salida pendiente,
+# para que un programa interactivo muestre lo escrito antes de esperar.
+# Deja %rsi = pos = inicio del buffer, el centinela en *fin y en %rax los
+# bytes leídos (0 al final o con error). Conserva %r8-%r10.
+.Llee_recargar:
+ call write_flush
+1:
+ xorl %eax, %eax
+ xorl %edi, %edi
+ leaq .Llee_buf(%rip), %rsi
+ movl $1048576, %edx
+ syscall
+ cmpq $-4, %rax
+ je 1b
+ testq %rax, %rax
+ jg 2f
+ xorl %eax, %eax
+2:
+ leaq (%rsi,%rax), %rdx
+ movb $0, (%rdx)
+ movq %rdx, .Llee_fin(%rip)
+ movq %rsi, .Llee_pos(%rip)
+ ret
+
+# Salta blancos (bytes <= ' '); deja %rsi en el primer carácter siguiente y
+# ese carácter en %ecx (0 al final de la entrada)
+.Llee_blancos:
+ movq .Llee_pos(%rip), %rsi
+1:
+ movzbl (%rsi), %ecx
+ cmpl $32, %ecx
+ ja 3f
+ cmpq .Llee_fin(%rip), %rsi
+ jae 2f
+ addq $1, %rsi
+ jmp 1b
+2:
+ call .Llee_recargar
+ testq %rax, %rax
+ jg 1b
+ xorl %ecx, %ecx
+3:
+ ret
+
+# Entero con signo opcional; int y unsigned se quedan con los 32 bits bajos
+read_i32:
+read_u32:
+read_i64:
+ call .Llee_blancos
+ xorl %r8d, %r8d
+ cmpl $45, %ecx
+ jne 1f
+ movl $1, %r8d
+ jmp 2f
+1:
+ cmpl $43, %ecx
+ jne 3f
+2:
+ addq $1, %rsi
+3:
+ xorl %eax, %eax
+4:
+ movzbl (%rsi), %ecx
+ subl $48, %ecx
+ cmpl $9, %ecx
+ ja 5f
+ leaq (%rax,%rax,4), %rax
+ leaq (%rcx,%rax,2), %rax
+ addq $1, %rsi
+ jmp 4b
+5:
+ cmpq .Llee_fin(%rip), %rsi
+ jb 6f
+ movq %rax, %r9
+ call .Llee_recargar
+ testq %rax, %rax
+ movq %r9, %rax
+ jg 4b
+6:
+ movq %rsi, .Llee_pos(%rip)
+ movq %rax, %rdx
+ negq %rdx
+ testl %r8d, %r8d
+ cmovne %rdx, %rax
+ ret
+
+# Float y double: el número ([0-9+-.eE]) se copia a la pila y se convierte
+# ahí. Con a lo sumo 19 dígitos, mantisa m <= 2^53 y exponente e en
+# [-22, 22], m y 10^e son exactos en double y m * 10^e (o m / 10^-e) sale
+# redondeado correctamente: es el resultado de read_f64. Pasarlo a float da
+# el mismo resultado que redondear el valor exacto, salvo que el double
+# caiga justo en el punto medio entre dos float. Ese caso y cualquier otro
+# van por strtof / strtod. -8(%rbp) dice cuál de las dos se pidió.
+read_f64:
+ pushq %rbp
+ movq %rsp, %rbp
+ pushq $1
+ jmp .Llee_real
+read_f32:
+ pushq %rbp
+ movq %rsp, %rbp
+ pushq $0
+.Llee_real:
+ subq $520, %rsp
+ andq $-16, %rsp
+ call .Llee_blancos
+ movq %rsp, %r9
+ leaq 511(%rsp), %r10
+1:
+ movzbl (%rsi), %ecx
+ leal -48(%rcx), %edx
+ cmpl $9, %edx
+ jbe 2f
+ cmpl $43, %ecx
+ je 2f
+ cmpl $45, %ecx
+ je 2f
+ cmpl $46, %ecx
+ je 2f
+ movl %ecx, %edx
+ orl $32, %edx
+ cmpl $101, %edx
+ je 2f
+ cmpq .Llee_fin(%rip), %rsi
+ jb 4f
+ call .Llee_recargar
+ testq %rax, %rax
+ jg 1b
+ jmp 4f
+2:
+ cmpq %r10, %r9
+ jae 3f
+ movb %cl, (%r9)
+ addq $1, %r9
+3:
+ addq $1, %rsi
+ jmp 1b
+4:
+ movb $0, (%r9)
+ movq %rsi, .Llee_pos(%rip)
+
+ # signo, mantisa (%rax), dígitos (%r9d) y exponente decimal (%r10d)
+ movq %rsp, %rsi
+ xorl %r8d, %r8d
+ movzbl (%rsi), %ecx
+ cmpl $45, %ecx
+ jne 5f
+ movl $1, %r8d
+ jmp 6f
+5:
+ cmpl $43, %ecx
+ jne 7f
+6:
+ addq $1, %rsi
+7:
+ xorl %eax, %eax
+ xorl %r9d, %r9d
+ xorl %r10d, %r10d
+8:
+ movzbl (%rsi), %ecx
+ subl $48, %ecx
+ cmpl $9, %ecx
+ ja 9f
+ leaq (%rax,%rax,4), %rax
+ leaq (%rcx,%rax,2), %rax
+ addl $1, %r9d
+ addq $1, %rsi
+ jmp 8b
+9:
+ cmpb $46, (%rsi)
+ jne 11f
+ addq $1, %rsi
+10:
+ movzbl (%rsi), %ecx
+ subl $48, %ecx
+ cmpl $9, %ecx
+ ja 11f
+ leaq (%rax,%rax,4), %rax
+ leaq (%rcx,%rax,2), %rax
+ addl $1, %r9d
+ subl $1, %r10d
+ addq $1, %rsi
+ jmp 10b
+11:
+ cmpl $19, %r9d
+ ja .Llee_lento
+ testl %r9d, %r9d
+ jz .Llee_lento
+ movzbl (%rsi), %ecx
+ orl $32, %ecx
+ cmpl $101, %ecx
+ jne 16f
+ addq $1, %rsi
+ xorl %r11d, %r11d
+ movzbl (%rsi), %ecx
+ cmpl $45, %ecx
+ jne 12f
+ movl $1, %r11d
+ jmp 13f
+12:
+ cmpl $43, %ecx
+ jne 14f
+13:
+ addq $1, %rsi
+14:
+ movq %rsi, %rdi
+ xorl %edx, %edx
+15:
+ movzbl (%rsi), %ecx
+ subl $48, %ecx
+ cmpl $9, %ecx
+ ja 17f
+ cmpl $100000, %edx
+ jae 18f
+ imull $10, %edx, %edx
+ addl %ecx, %edx
+18:
+ addq $1, %rsi
+ jmp 15b
+17:
+ cmpq %rdi, %rsi
+ je .Llee_lento
+ movl %edx, %ecx
+ negl %ecx
+ testl %r11d, %r11d
+ cmovne %ecx, %edx
+ addl %edx, %r10d
+16:
+ cmpb $0, (%rsi)
+ jne .Llee_lento
+ movabsq $9007199254740992, %rcx
+ cmpq %rcx, %rax
+ ja .Llee_lento
+ cvtsi2sdq %rax, %xmm0
+ leaq .Llee_pot10(%rip), %rcx
+ testl %r10d, %r10d
+ js 19f
+ cmpl $22, %r10d
+ jg .Llee_lento
+ mulsd (%rcx,%r10,8), %xmm0
+ jmp 20f
+19:
+ negl %r10d
+ cmpl $22, %r10d
+ jg .Llee_lento
+ divsd (%rcx,%r10,8), %xmm0
+20:
+ cmpl $0, -8(%rbp)
+ jne 22f
+ movq %xmm0, %rdx
+ andl $0x1FFFFFFF, %edx
+ cmpl $0x10000000, %edx
+ je .Llee_lento
+ cvtsd2ss %xmm0, %xmm0
+ testl %r8d, %r8d
+ jz 21f
+ xorps .Llee_signo(%rip), %xmm0
+21:
+ leave
+ ret
+22:
+ testl %r8d, %r8d
+ jz 21b
+ xorpd .Llee_signo64(%rip), %xmm0
+ leave
+ ret
+.Llee_lento:
+ movq %rsp, %rdi
+ xorl %esi, %esi
+ cmpl $0, -8(%rbp)
+ jne 23f
+ call strtof@PLT
+ leave
+ ret
+23:
+ call strtod@PLT
+ leave
+ ret
+
+# Fin de readln: descarta el resto de la línea (incluido el '\n')
+read_ln:
+ movq .Llee_pos(%rip), %rsi
+1:
+ cmpq .Llee_fin(%rip), %rsi
+ jae 2f
+ movzbl (%rsi), %ecx
+ addq $1, %rsi
+ cmpl $10, %ecx
+ jne 1b
+ movq %rsi, .Llee_pos(%rip)
+ ret
+2:
+ call .Llee_recargar
+ testq %rax, %rax
+ jg 1b
+ ret
+)";
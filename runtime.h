@@ -0,0 +1,40 @@
+#ifndef RUNTIME_H
+#define RUNTIME_H
+
+// --------------------------------------
+// Runtime de los programas generados
+// --------------------------------------
+// writeln no llama a printf: cada PrintStm llama a la rutina de su tipo, que
+// convierte el número a decimal directamente en un buffer de salida. El
+// buffer se vacía con la llamada al sistema write(2) cuando se llena y al
+// terminar el programa (desde .fini_array, así que también con exit()).
+//
+//   write_i32(%edi)   int / bool       write_u32(%edi)   unsigned
+//   write_i64(%rdi)   long             write_f32(%xmm0)  float, como "%f"
+//   write_f64(%xmm0)  double, ídem     write_flush()
+//
+// Todas escriben el número seguido de " \n" (el formato de siempre) y
+// respetan la convención de llamada de System V (solo tocan registros
+// volátiles). Es ensamblador en texto: GenCodeVisitor lo añade al final de
+// cada programa que escribe o lee, que sigue ensamblándose solo con
+// 'gcc -no-pie x.s'.
+extern const char* const RUNTIME_ESCRITURA;
+
+// readln(v1, ..., vn) llama por cada destino a la rutina de su tipo, que
+// devuelve el número leído (el código generado lo guarda como en una
+// asignación), y al final a read_ln. La entrada se lee en bloques grandes
+// con read(2) y los números se convierten a mano; los float y double que
+// la conversión rápida no garantiza exactos pasan por strtof / strtod.
+//
+//   read_i32 -> %eax    int / bool       read_u32 -> %eax    unsigned
+//   read_i64 -> %rax    long             read_f32 -> %xmm0   float
+//   read_f64 -> %xmm0   double           read_ln()           salta hasta
+//                                                            después del '\n'
+//
+// Los números van separados por blancos; al final de la entrada, o ante
+// algo que no es un número, devuelven 0. Antes de leer un bloque se vacía
+// la salida pendiente (lo escrito aparece antes de esperar la entrada), así
+// que un programa con readln lleva también RUNTIME_ESCRITURA.
+extern const char* const RUNTIME_LECTURA;
+
+#endif // RUNTIME_H
@@ -1,27 +1,38 @@
 #include <iostream>
 #include <cstring>
 #include <fstream>
+#include <algorithm>
 #include "token.h"
 #include "scanner.h"
 
 using namespace std;
 
-Scanner::Scanner(const char* s): input(s), first(0), current(0) { }
+Scanner::Scanner(const char* s): input(s), length((int)strlen(s)), first(0), current(0) { }
+
+Scanner::Scanner(const char* s, size_t len): input(s), length((int)len), first(0), current(0) { }
+
+Scanner::Scanner(const char* s, size_t ini, size_t fin)
+    : input(s), length((int)fin), first((int)ini), current((int)ini) { }
 
 bool is_white_space(char c) {
     return c==' ' || c=='\n' || c=='\r' || c=='\t';
 }
 
 Token* Scanner::nextToken() {
-    Token* token;
+    TokenCompacto t = nextCompacto();
+    return new Token(t.type, input, t.first, t.len);
+}
+
+TokenCompacto Scanner::nextCompacto() {
+    TokenCompacto token;
 
     // Saltar espacios en blanco
-    while (current < input.length() && is_white_space(input[current]))
+    while (current < length && is_white_space(input[current]))
         current++;
 
     // Fin de archivo
-    if (current >= input.length())
-        return new Token(Token::END);
+    if (current >= length)
+        return {Token::END, current, 0};
 
     char c = input[current];
     first = current;
@@ -31,12 +42,14 @@ Token* Scanner::nextToken() {
     // =======================
     if (c == '{') {
         current++;
-        while (current < input.length() && input[current] != '}')
+        while (current < length && input[current] != '}')
             current++;
 
-        if (current < input.length() && input[current] == '}')
+        if (current < length && input[current] == '}')
             current++;
-        return nextToken();
+        else
+            abierto = true;
+        return nextCompacto();
     }
 
     // =======================
@@ -44,21 +57,23 @@ Token* Scanner::nextToken() {
     // =======================
     if (isdigit(c)) {
         current++;
-        while (current < input.length() && isdigit(input[current]))
+        while (current < length && isdigit(input[current]))
             current++;
 
-        if (current < input.length() && input[current] == '.') {
+        // "1..10" es un rango, no el real "1."
+        if (current < length && input[current] == '.' &&
+            !(current + 1 < length && input[current + 1] == '.')) {
             current++;
             bool atleastone = false;
 
-            while (current < input.length() && isdigit(input[current])) {
+            while (current < length && isdigit(input[current])) {
                 current++;
                 atleastone = true;
             }
 
-            token = new Token(Token::FLOATNUM, input, first, current - first);
+            token = {Token::FLOATNUM, first, current - first};
         } else {
-            token = new Token(Token::NUM, input, first, current - first);
+            token = {Token::NUM, first, current - first};
         }
     }
 
@@ -67,50 +82,55 @@ Token* Scanner::nextToken() {
     // =======================
     else if (isalpha(c)) {
         current++;
-        while (current < input.length() && (isalnum(input[current]) || input[current]=='_'))
+        while (current < length && (isalnum(input[current]) || input[current]=='_'))
             current++;
 
-        string lexema = input.substr(first, current - first);
+        string lexema(input + first, current - first);
 
         // Palabras clave Pascal
-        if      (lexema=="program")   return new Token(Token::PROGRAM,  input, first, current-first);
-        else if (lexema=="begin")     return new Token(Token::BEGIN_KW, input, first, current-first);
-        else if (lexema=="end")       return new Token(Token::END_KW,   input, first, current-first);
-        else if (lexema=="var")       return new Token(Token::VAR,      input, first, current-first);
+        if      (lexema=="program")   return {Token::PROGRAM,   first, current-first};
+        else if (lexema=="begin")     return {Token::BEGIN_KW,  first, current-first};
+        else if (lexema=="end")       return {Token::END_KW,    first, current-first};
+        else if (lexema=="var")       return {Token::VAR,       first, current-first};
+
+        else if (lexema=="if")        return {Token::IF,        first, current-first};
+        else if (lexema=="then")      return {Token::THEN,      first, current-first};
+        else if (lexema=="else")      return {Token::ELSE,      first, current-first};
 
-        else if (lexema=="if")        return new Token(Token::IF,       input, first, current-first);
-        else if (lexema=="then")      return new Token(Token::THEN,     input, first, current-first);
-        else if (lexema=="else")      return new Token(Token::ELSE,     input, first, current-first);
+        else if (lexema=="while")     return {Token::WHILE,     first, current-first};
+        else if (lexema=="do")        return {Token::DO,        first, current-first};
 
-        else if (lexema=="while")     return new Token(Token::WHILE,    input, first, current-first);
-        else if (lexema=="do")        return new Token(Token::DO,       input, first, current-first);
+        else if (lexema=="for")       return {Token::FOR,       first, current-first};
+        else if (lexema=="to")        return {Token::TO,        first, current-first};
+        else if (lexema=="downto")    return {Token::DOWNTO,    first, current-first};
 
-        else if (lexema=="for")       return new Token(Token::FOR,      input, first, current-first);
-        else if (lexema=="to")        return new Token(Token::TO,       input, first, current-first);
-        else if (lexema=="downto")    return new Token(Token::DOWNTO,   input, first, current-first);
+        // Arreglos
+        else if (lexema=="array")     return {Token::ARRAY,     first, current-first};
+        else if (lexema=="of")        return {Token::OF,        first, current-first};
 
         // Funciones / procedimientos
-        else if (lexema=="function")  return new Token(Token::FUNCTION,  input, first, current-first);
-        else if (lexema=="procedure") return new Token(Token::PROCEDURE, input, first, current-first);
+        else if (lexema=="function")  return {Token::FUNCTION,  first, current-first};
+        else if (lexema=="procedure") return {Token::PROCEDURE, first, current-first};
 
         // I/O
-        else if (lexema=="writeln")   return new Token(Token::WRITELN, input, first, current-first);
-        else if (lexema=="readln")    return new Token(Token::READLN,  input, first, current-first);
+        else if (lexema=="writeln")   return {Token::WRITELN,   first, current-first};
+        else if (lexema=="readln")    return {Token::READLN,    first, current-first};
 
         // Tipos
-        else if (lexema=="integer")   return new Token(Token::INTEGER,  input, first, current-first);
-        else if (lexema=="longint")   return new Token(Token::LONGINT,  input, first, current-first);
-        else if (lexema=="real" || lexema=="float")
-                                      return new Token(Token::FLOAT,    input, first, current-first);
-        else if (lexema=="unsigned")  return new Token(Token::UNSIGNED, input, first, current-first);
-        else if (lexema=="type")      return new Token(Token::TYPEKW,   input, first, current-first);
+        else if (lexema=="integer")   return {Token::INTEGER,   first, current-first};
+        else if (lexema=="longint")   return {Token::LONGINT,   first, current-first};
+        else if (lexema=="float")     return {Token::FLOAT,     first, current-first};
+        else if (lexema=="real" || lexema=="double")
+                                      return {Token::DOUBLE,    first, current-first};
+        else if (lexema=="unsigned")  return {Token::UNSIGNED,  first, current-first};
+        else if (lexema=="type")      return {Token::TYPEKW,    first, current-first};
 
         // Operadores palabra
-        else if (lexema=="div")       return new Token(Token::DIV, input, first, current-first);
-        else if (lexema=="mod")       return new Token(Token::MOD, input, first, current-first);
+        else if (lexema=="div")       return {Token::DIV,       first, current-first};
+        else if (lexema=="mod")       return {Token::MOD,       first, current-first};
 
         // Identificador
-        else                          return new Token(Token::ID,  input, first, current-first);
+        else                          return {Token::ID,        first, current-first};
     }
 
     // =======================
@@ -118,81 +138,96 @@ Token* Scanner::nextToken() {
     // =======================
     else if (c=='+' || c=='-' || c=='*' || c=='(' || c==')' ||
              c==';' || c=='=' || c=='<' || c=='>' || c==',' ||
-             c==':' || c=='.' || c=='/' )
+             c==':' || c=='.' || c=='/' || c=='[' || c==']' )
     {
         switch (c) {
-            case '+': token = new Token(Token::PLUS,  c); current++; break;
-            case '-': token = new Token(Token::MINUS, c); current++; break;
-            case '*': token = new Token(Token::MUL,   c); current++; break;
+            case '+': token = {Token::PLUS, first, 1}; current++; break;
+            case '-': token = {Token::MINUS, first, 1}; current++; break;
+            case '*': token = {Token::MUL, first, 1}; current++; break;
 
             case '(':
-                token = new Token(Token::LPAREN, c);
+                token = {Token::LPAREN, first, 1};
                 current++;
                 break;
 
             case ')':
-                token = new Token(Token::RPAREN, c);
+                token = {Token::RPAREN, first, 1};
                 current++;
                 break;
 
             case ';':
-                token = new Token(Token::SEMICOL, c);
+                token = {Token::SEMICOL, first, 1};
                 current++;
                 break;
 
             case ',':
-                token = new Token(Token::COMMA, c);
+                token = {Token::COMMA, first, 1};
                 current++;
                 break;
 
-            case '.':
-                token = new Token(Token::DOT, c);
+            case '[':
+                token = {Token::LBRACKET, first, 1};
                 current++;
                 break;
 
+            case ']':
+                token = {Token::RBRACKET, first, 1};
+                current++;
+                break;
+
+            case '.':
+                if (current+1 < length && input[current+1] == '.') {
+                    token = {Token::DOTDOT, first, 2}; // '..'
+                    current += 2;
+                } else {
+                    token = {Token::DOT, first, 1};
+                    current++;
+                }
+                break;
+
             case ':':
-                if (current+1 < (int)input.length() && input[current+1] == '=') {
-                    token = new Token(Token::ASSIGN, input, first, 2); // ':='
+                if (current+1 < length && input[current+1] == '=') {
+                    token = {Token::ASSIGN, first, 2}; // ':='
                     current += 2;
                 } else {
-                    token = new Token(Token::COLON, c);
+                    token = {Token::COLON, first, 1};
                     current++;
                 }
                 break;
 
             case '=':
-                token = new Token(Token::EQ, c);
+                token = {Token::EQ, first, 1};
                 current++;
                 break;
 
             case '<':
-                if (current+1 < (int)input.length() && input[current+1]=='=') {
-                    token = new Token(Token::LE, input, first, 2);
+                if (current+1 < length && input[current+1]=='=') {
+                    token = {Token::LE, first, 2};
                     current += 2;
                 }
-                else if (current+1 < (int)input.length() && input[current+1]=='>') {
-                    token = new Token(Token::NEQ, input, first, 2);
+                else if (current+1 < length && input[current+1]=='>') {
+                    token = {Token::NEQ, first, 2};
                     current += 2;
                 }
                 else {
-                    token = new Token(Token::LT, c);
+                    token = {Token::LT, first, 1};
                     current++;
                 }
                 break;
 
             case '>':
-                if (current+1 < (int)input.length() && input[current+1]=='=') {
-                    token = new Token(Token::GE, input, first, 2);
+                if (current+1 < length && input[current+1]=='=') {
+                    token = {Token::GE, first, 2};
                     current += 2;
                 }
                 else {
-                    token = new Token(Token::GT, c);
+                    token = {Token::GT, first, 1};
                     current++;
                 }
                 break;
 
             case '/':
-                token = new Token(Token::REALDIV, c);
+                token = {Token::REALDIV, first, 1};
                 current++;
                 break;
         }
@@ -202,7 +237,7 @@ Token* Scanner::nextToken() {
     // CARÁCTER DESCONOCIDO
     // =======================
     else {
-        token = new Token(Token::ERR, c);
+        token = {Token::ERR, first, 1};
         current++;
     }
 
@@ -211,6 +246,24 @@ Token* Scanner::nextToken() {
 
 Scanner::~Scanner() { }
 
+vector<pair<int, int>> lineasColumnas(const char* texto, size_t len, const vector<int>& pos) {
+    vector<pair<int, int>> res;
+    res.reserve(pos.size());
+    size_t i = 0;
+    int linea = 1, inicioLinea = 0;
+    for (int p : pos) {
+        size_t fin = p < 0 ? 0 : min((size_t)p, len);
+        for (; i < fin; ++i) {
+            if (texto[i] == '\n') {
+                linea++;
+                inicioLinea = (int)i + 1;
+            }
+        }
+        res.push_back({linea, (int)fin - inicioLinea + 1});
+    }
+    return res;
+}
+
 int ejecutar_scanner(Scanner* scanner, const string& InputFile) {
     Token* tok;
 
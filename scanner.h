@@ -2,27 +2,61 @@
 #define SCANNER_H
 
 #include <string>
+#include <vector>
+#include <utility>
 #include "token.h"
 
 using namespace std;
 
-class Scanner {
+// Token compacto: tipo y posición del lexema en el texto fuente (sin copia)
+struct TokenCompacto {
+    Token::Type type;
+    int first;
+    int len;
+};
+
+// Origen de tokens del parser: el Scanner, un scanner en otro hilo o una
+// lista ya tokenizada
+class FuenteTokens {
+public:
+    virtual ~FuenteTokens() = default;
+    virtual Token* nextToken() = 0;
+};
+
+class Scanner : public FuenteTokens {
 private:
-    string input;   // Texto completo del archivo fuente
-    int first;      // Índice de inicio del lexema actual
-    int current;    // Índice de lectura actual
+    const char* input;    // Texto del archivo fuente (no se copia)
+    int length;           // Fin del texto (o del tramo) a escanear
+    int first;            // Índice de inicio del lexema actual
+    int current;          // Índice de lectura actual
+    bool abierto = false; // un comentario '{' llegó al final sin cerrarse
 
 public:
-    // Constructor: recibe el código fuente como C-string
+    // Constructor: recibe el código fuente como C-string. El texto debe
+    // seguir vivo mientras se use el scanner.
     Scanner(const char* in_s);
+    Scanner(const char* in_s, size_t len);
+
+    // Escanea solo el tramo [ini, fin) de un texto mayor
+    Scanner(const char* in_s, size_t ini, size_t fin);
 
     // Retorna el siguiente token
-    Token* nextToken();
+    Token* nextToken() override;
+    TokenCompacto nextCompacto();
+
+    // ¿Terminó el texto/tramo dentro de un comentario?
+    bool comentarioAbierto() const { return abierto; }
 
     // Destructor
     ~Scanner();
 };
 
+bool is_white_space(char c);
+
+// Línea y columna (desde 1) de cada posición de 'pos', que debe estar en
+// orden creciente. Solo se usa para diagnósticos: recorre el texto una vez.
+vector<pair<int, int>> lineasColumnas(const char* texto, size_t len, const vector<int>& pos);
+
 // Función auxiliar para probar el scanner y volcar los tokens a un archivo
 int ejecutar_scanner(Scanner* scanner, const string& InputFile);
 
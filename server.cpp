@@ -0,0 +1,471 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <cstring>
+#include <csignal>
+#include <unordered_map>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "server.h"
+#include "driver.h"
+#include "threadpool.h"
+
+using namespace std;
+
+// =============================
+// Conexión con lectura bufferizada
+// =============================
+class Conexion {
+    int    fd;
+    string buf;
+    size_t pos = 0;
+    bool   larga = false;   // la última línea superó MAX_LINEA
+
+    bool rellenar() {
+        if (pos > 0) {
+            buf.erase(0, pos);
+            pos = 0;
+        }
+        char tmp[65536];
+        ssize_t n = ::read(fd, tmp, sizeof tmp);
+        if (n <= 0) return false;
+        buf.append(tmp, n);
+        return true;
+    }
+
+public:
+    explicit Conexion(int f) : fd(f) {}
+    ~Conexion() { ::close(fd); }
+
+    int descriptor() const { return fd; }
+
+    // ¿Quedan bytes ya leídos del socket sin consumir? (peticiones
+    // encadenadas: poll() no avisaría de ellas)
+    bool pendiente() const { return pos < buf.size(); }
+
+    // Bytes de una línea de petición o de respuesta (una ruta de PATH_MAX
+    // con el verbo y las opciones cabe)
+    static const size_t MAX_LINEA = 8192;
+
+    // false si se cerró la conexión o la línea no termina en MAX_LINEA bytes
+    // (lineaLarga()); un cliente que nunca envía '\n' no hace crecer el buffer
+    bool leerLinea(string& linea) {
+        while (true) {
+            size_t nl = buf.find('\n', pos);
+            if (nl != string::npos && nl - pos <= MAX_LINEA) {
+                linea.assign(buf, pos, nl - pos);
+                pos = nl + 1;
+                return true;
+            }
+            if (buf.size() - pos > MAX_LINEA) {
+                larga = true;
+                return false;
+            }
+            if (!rellenar()) return false;
+        }
+    }
+
+    bool lineaLarga() const { return larga; }
+
+    bool leerBytes(size_t n, string& datos) {
+        while (buf.size() - pos < n) {
+            if (!rellenar()) return false;
+        }
+        datos.assign(buf, pos, n);
+        pos += n;
+        return true;
+    }
+
+    bool escribir(const string& s) {
+        size_t hecho = 0;
+        while (hecho < s.size()) {
+            ssize_t n = ::write(fd, s.data() + hecho, s.size() - hecho);
+            if (n <= 0) return false;
+            hecho += n;
+        }
+        return true;
+    }
+
+    bool responder(bool ok, const string& cuerpo) {
+        return escribir((ok ? "OK " : "ERROR ") + to_string(cuerpo.size()) + "\n") &&
+               escribir(cuerpo);
+    }
+};
+
+static int conectar(const string& ruta) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof addr);
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, ruta.c_str(), sizeof(addr.sun_path) - 1);
+    if (connect(fd, (sockaddr*)&addr, sizeof addr) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// =============================
+// Servidor
+// =============================
+namespace {
+
+// Resultado completo de un archivo ya compilado
+struct Memo {
+    bool   ok;
+    string cuerpo;   // ensamblador o diagnóstico
+};
+
+class Servidor {
+public:
+    Servidor(int hilos) : compiladores(hilos) {
+        for (auto& c : compiladores) {
+            c.opciones.verbose = false;
+            c.opciones.cache   = &cacheFunciones;
+        }
+    }
+
+    atomic<bool> apagando{false};
+    int          despertar = -1;   // extremo de escritura del pipe del bucle principal
+
+    // Atiende una sola petición; false si hay que cerrar la conexión
+    bool atender(Conexion& con, int hilo);
+
+    // Conexiones que terminaron su petición y vuelven al poll() principal
+    mutex             mDevueltas;
+    vector<Conexion*> devueltas;
+
+    void devolver(Conexion* con) {
+        {
+            lock_guard<mutex> lk(mDevueltas);
+            devueltas.push_back(con);
+        }
+        avisar();
+    }
+
+    void avisar() {
+        char c = 0;
+        (void)!::write(despertar, &c, 1);
+    }
+
+private:
+    static const size_t MAX_MEMOS  = 256;
+    static const size_t MAX_FUENTE = 256u << 20;   // bytes de una petición FUENTE
+
+    vector<Compilador> compiladores;   // uno por hilo del pool
+    CacheFunciones     cacheFunciones; // en memoria, compartida
+
+    // Resultados por archivo (ruta + mtime + tamaño) o por contenido
+    mutex                        mMemo;
+    unordered_map<string, Memo>  memos;
+    deque<string>                ordenMemos;
+
+    bool buscarMemo(const string& clave, Memo& m) {
+        lock_guard<mutex> lk(mMemo);
+        auto it = memos.find(clave);
+        if (it == memos.end()) return false;
+        m = it->second;
+        return true;
+    }
+
+    void guardarMemo(const string& clave, const Memo& m) {
+        lock_guard<mutex> lk(mMemo);
+        if (!memos.count(clave)) {
+            ordenMemos.push_back(clave);
+            if (ordenMemos.size() > MAX_MEMOS) {
+                memos.erase(ordenMemos.front());
+                ordenMemos.pop_front();
+            }
+        }
+        memos[clave] = m;
+    }
+
+    Memo compilar(int hilo, const OpcionesCompilacion& o, const string& nombre,
+                  const string& texto) {
+        Compilador& c = compiladores[hilo];
+        c.opciones.simd         = o.simd;
+        c.opciones.desenrollar  = o.desenrollar;
+        c.opciones.compartirExp = o.compartirExp;
+        ResultadoCompilacion r = c.compilarFuente(nombre, texto);
+        if (r.ok) return {true, c.ensamblador()};
+        string diag;
+        for (auto& d : r.diagnosticos) diag += d + "\n";
+        return {false, diag + r.entrada + ": " + r.mensaje + "\n" + r.avisos};
+    }
+};
+
+bool Servidor::atender(Conexion& con, int hilo) {
+    string linea;
+    if (!con.leerLinea(linea)) {
+        if (con.lineaLarga()) con.responder(false, "Línea de petición demasiado larga\n");
+        return false;
+    }
+
+    if (linea == "APAGAR") {
+        apagando = true;
+        con.responder(true, "");
+        avisar();   // despierta al poll() del bucle principal
+        return false;
+    }
+
+    // Opciones de la petición: primer campo tras el verbo
+    OpcionesCompilacion o;
+    string resto;
+    auto leerOpciones = [&](size_t inicio) {
+        size_t esp = linea.find(' ', inicio);
+        if (esp == string::npos || !leerOpcionesPeticion(linea.substr(inicio, esp - inicio), o))
+            return false;
+        resto = linea.substr(esp + 1);
+        return true;
+    };
+
+    if (linea.rfind("COMPILAR ", 0) == 0) {
+        if (!leerOpciones(9)) {
+            con.responder(false, "Petición COMPILAR mal formada\n");
+            return false;
+        }
+        string ruta = resto;
+        struct stat st;
+        if (stat(ruta.c_str(), &st) != 0)
+            return con.responder(false, "No se pudo abrir el archivo: " + ruta + "\n");
+        // Sin cambios desde la última vez: ni siquiera se vuelve a leer
+        string clave = "R" + opcionesPeticion(o) + "|" + ruta + "|" +
+                       to_string(st.st_mtim.tv_sec) + "." +
+                       to_string(st.st_mtim.tv_nsec) + "|" + to_string(st.st_size);
+        Memo m;
+        if (!buscarMemo(clave, m)) {
+            ifstream in(ruta, ios::binary);
+            stringstream ss;
+            ss << in.rdbuf();
+            m = compilar(hilo, o, ruta, ss.str());
+            guardarMemo(clave, m);
+        }
+        return con.responder(m.ok, m.cuerpo);
+    }
+
+    if (linea.rfind("FUENTE ", 0) == 0) {
+        istringstream cab(leerOpciones(7) ? resto : "");
+        string nombre;
+        size_t len = 0;
+        string texto;
+        if (!(cab >> nombre >> len) || len > MAX_FUENTE || !con.leerBytes(len, texto)) {
+            con.responder(false, "Petición FUENTE mal formada\n");
+            return false;
+        }
+        string clave = "F" + opcionesPeticion(o) + "|" + nombre + "|" +
+                       to_string(hash<string>()(texto)) +
+                       "|" + to_string(texto.size());
+        Memo m;
+        if (!buscarMemo(clave, m)) {
+            m = compilar(hilo, o, nombre, texto);
+            guardarMemo(clave, m);
+        }
+        return con.responder(m.ok, m.cuerpo);
+    }
+
+    return con.responder(false, "Petición desconocida: " + linea + "\n");
+}
+
+} // namespace
+
+// Segundos que una petición a medias puede tardar en llegar completa
+static const int TIEMPO_PETICION = 10;
+
+int ejecutarServidor(const string& ruta, int hilos) {
+    signal(SIGPIPE, SIG_IGN);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        cerr << "[ERROR] No se pudo crear el socket\n";
+        return 1;
+    }
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof addr);
+    addr.sun_family = AF_UNIX;
+    if (ruta.size() >= sizeof(addr.sun_path)) {
+        cerr << "[ERROR] Ruta de socket demasiado larga: " << ruta << "\n";
+        return 1;
+    }
+    strncpy(addr.sun_path, ruta.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(ruta.c_str());
+    if (bind(fd, (sockaddr*)&addr, sizeof addr) < 0 || listen(fd, 64) < 0) {
+        cerr << "[ERROR] No se pudo escuchar en " << ruta << ": " << strerror(errno) << "\n";
+        ::close(fd);
+        return 1;
+    }
+
+    // Pipe para despertar al poll(): conexiones devueltas y APAGAR
+    int tubo[2];
+    if (pipe(tubo) < 0) {
+        cerr << "[ERROR] No se pudo crear el pipe del servidor\n";
+        ::close(fd);
+        return 1;
+    }
+    for (int t : tubo) fcntl(t, F_SETFL, fcntl(t, F_GETFL) | O_NONBLOCK);
+
+    if (hilos < 1) hilos = 1;
+    Servidor servidor(hilos);
+    servidor.despertar = tubo[1];
+    ThreadPool pool(hilos);
+
+    // El bucle principal espera con poll() en el socket de escucha y en las
+    // conexiones ociosas; cada petición es una tarea del pool, que devuelve la
+    // conexión al terminar. Un cliente conectado sin enviar nada no ocupa
+    // ningún hilo.
+    vector<Conexion*> ociosas;
+    auto enviar = [&](Conexion* con) {
+        pool.enviar([&servidor, con](int hilo) {
+            if (servidor.atender(*con, hilo)) servidor.devolver(con);
+            else delete con;
+        });
+    };
+
+    cout << "Servidor escuchando en " << ruta << " (" << hilos << " hilos)" << endl;
+    vector<pollfd> pfds;
+    while (!servidor.apagando) {
+        pfds.assign({{fd, POLLIN, 0}, {tubo[0], POLLIN, 0}});
+        for (Conexion* c : ociosas) pfds.push_back({c->descriptor(), POLLIN, 0});
+        if (poll(pfds.data(), pfds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        // Conexiones con datos (o cerradas por el cliente): una petición al pool
+        vector<Conexion*> siguen;
+        for (size_t i = 0; i < ociosas.size(); ++i) {
+            if (pfds[i + 2].revents) enviar(ociosas[i]);
+            else siguen.push_back(ociosas[i]);
+        }
+        ociosas.swap(siguen);
+
+        if (pfds[1].revents & POLLIN) {
+            char tmp[64];
+            while (::read(tubo[0], tmp, sizeof tmp) > 0) {}
+            vector<Conexion*> vuelven;
+            {
+                lock_guard<mutex> lk(servidor.mDevueltas);
+                vuelven.swap(servidor.devueltas);
+            }
+            for (Conexion* c : vuelven) {
+                if (c->pendiente()) enviar(c);
+                else ociosas.push_back(c);
+            }
+        }
+
+        if (pfds[0].revents & POLLIN) {
+            int cli = accept(fd, nullptr, nullptr);
+            if (cli >= 0) {
+                // Un cliente que deja una petición a medias no retiene el hilo
+                timeval espera{TIEMPO_PETICION, 0};
+                setsockopt(cli, SOL_SOCKET, SO_RCVTIMEO, &espera, sizeof espera);
+                ociosas.push_back(new Conexion(cli));
+            }
+            else if (errno != EINTR && errno != EAGAIN) break;
+        }
+    }
+
+    // Apagado: las conexiones ociosas se cierran sin esperar a sus clientes;
+    // las peticiones en curso terminan (como mucho TIEMPO_PETICION si el
+    // cliente deja de enviar)
+    for (Conexion* c : ociosas) delete c;
+    pool.esperar();
+    for (Conexion* c : servidor.devueltas) delete c;
+    ::close(tubo[0]);
+    ::close(tubo[1]);
+
+    ::close(fd);
+    unlink(ruta.c_str());
+    cout << "Servidor detenido" << endl;
+    return 0;
+}
+
+// =============================
+// Cliente
+// =============================
+static bool leerRespuesta(Conexion& con, bool& ok, string& cuerpo) {
+    string linea;
+    if (!con.leerLinea(linea)) return false;
+    size_t esp = linea.find(' ');
+    if (esp == string::npos) return false;
+    string estado = linea.substr(0, esp);
+    if (estado != "OK" && estado != "ERROR") return false;
+    ok = (estado == "OK");
+    size_t len;
+    try { len = stoul(linea.substr(esp + 1)); } catch (...) { return false; }
+    return con.leerBytes(len, cuerpo);
+}
+
+int ejecutarCliente(const string& ruta, const vector<string>& archivos, bool quiet,
+                    const OpcionesCompilacion& opciones) {
+    int fd = conectar(ruta);
+    if (fd < 0) {
+        cerr << "[ERROR] No se pudo conectar con el servidor en " << ruta << "\n";
+        return 1;
+    }
+    Conexion con(fd);
+    int fallidos = 0;
+    string opc = opcionesPeticion(opciones);
+
+    for (const string& archivo : archivos) {
+        bool ok = false;
+        string cuerpo;
+
+        if (archivo == "-") {
+            stringstream ss;
+            ss << cin.rdbuf();
+            string texto = ss.str();
+            if (!con.escribir("FUENTE " + opc + " stdin " + to_string(texto.size()) + "\n") ||
+                !con.escribir(texto) || !leerRespuesta(con, ok, cuerpo)) {
+                cerr << "[ERROR] Conexión con el servidor perdida\n";
+                return 1;
+            }
+            if (ok) cout << cuerpo;
+            else { cerr << "[ERROR] " << cuerpo; fallidos++; }
+            continue;
+        }
+
+        // El servidor lee el archivo: se envía la ruta absoluta
+        char* abs = realpath(archivo.c_str(), nullptr);
+        string rutaAbs = abs ? abs : archivo;
+        free(abs);
+
+        if (!con.escribir("COMPILAR " + opc + " " + rutaAbs + "\n") || !leerRespuesta(con, ok, cuerpo)) {
+            cerr << "[ERROR] Conexión con el servidor perdida\n";
+            return 1;
+        }
+        if (!ok) {
+            cerr << "[ERROR] " << cuerpo;
+            fallidos++;
+            continue;
+        }
+        string salida = nombreSalida(archivo);
+        ofstream out(salida, ios::binary);
+        out.write(cuerpo.data(), cuerpo.size());
+        if (!quiet) cout << " [OK]    " << archivo << " -> " << salida << "\n";
+    }
+
+    return fallidos == 0 ? 0 : 1;
+}
+
+int detenerServidor(const string& ruta) {
+    int fd = conectar(ruta);
+    if (fd < 0) {
+        cerr << "[ERROR] No se pudo conectar con el servidor en " << ruta << "\n";
+        return 1;
+    }
+    Conexion con(fd);
+    bool ok;
+    string cuerpo;
+    con.escribir("APAGAR\n");
+    leerRespuesta(con, ok, cuerpo);
+    return 0;
+}
@@ -0,0 +1,40 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct OpcionesCompilacion;
+
+// --------------------------------------
+// Servidor de compilación residente
+// --------------------------------------
+// Escucha en un socket Unix y atiende peticiones de compilación manteniendo
+// el estado caliente entre ellas: un Compilador por hilo, caché en memoria
+// del código de cada función y de los resultados completos por archivo.
+//
+// Protocolo (una conexión puede enviar varias peticiones):
+//   COMPILAR <opc> <ruta>\n                 compila el archivo (el servidor lo lee)
+//   FUENTE <opc> <nombre> <len>\n<len bytes> compila el texto enviado (len <= 256 MB)
+//   APAGAR\n                                detiene el servidor
+// <opc> son las opciones de código de esa petición, p. ej. "avx2/u8/e"
+// (ver opcionesPeticion en driver.h); también separan los resultados
+// guardados. Una línea de petición no pasa de 8 KB.
+// Respuesta:
+//   OK <len>\n<ensamblador>   |   ERROR <len>\n<diagnóstico>
+// Cada petición es una tarea del pool: una conexión abierta sin peticiones
+// no ocupa ningún hilo, y APAGAR cierra las conexiones ociosas.
+int ejecutarServidor(const string& socket, int hilos);
+
+// Cliente: envía cada archivo al servidor con las opciones de código de
+// 'opciones' y escribe el .s junto a la fuente. "-" lee el programa de la
+// entrada estándar y escribe el ensamblador en la salida estándar.
+int ejecutarCliente(const string& socket, const vector<string>& archivos, bool quiet,
+                    const OpcionesCompilacion& opciones);
+
+// Pide al servidor que se detenga
+int detenerServidor(const string& socket);
+
+#endif // SERVER_H
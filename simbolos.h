@@ -0,0 +1,92 @@
+#ifndef SIMBOLOS_H
+#define SIMBOLOS_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+
+using namespace std;
+
+// --------------------------------------
+// Tabla de símbolos con ámbitos anidados
+// --------------------------------------
+// Cada nombre se interna una vez como un entero y la vinculación visible de
+// cada símbolo vive en un arreglo plano indexado por ese entero: buscar es un
+// hash del nombre más un acceso directo, sin recorrer ámbitos. Declarar en un
+// ámbito interior guarda la vinculación anterior en un registro de deshacer
+// y cerrar el ámbito la restaura, así que salir de una función o de un
+// bloque cuesta lo que se declaró en él, no el tamaño de la tabla. El nivel
+// 0 son los globales (nunca se cierra). Toda la memoria se conserva entre
+// funciones y unidades.
+template <class Info>
+class TablaSimbolos {
+public:
+    // Entero del nombre (lo interna si es nuevo)
+    int simbolo(const string& nombre) {
+        auto it = ids.find(nombre);
+        if (it != ids.end()) return it->second;
+        int s = (int)vinculos.size();
+        ids.emplace(nombre, s);
+        vinculos.push_back(Vinculo());
+        return s;
+    }
+
+    void declarar(const string& nombre, const Info& info) {
+        int s = simbolo(nombre);
+        Vinculo& v = vinculos[s];
+        // La primera declaración en un ámbito interior guarda la anterior
+        // (o "sin declarar"); redeclarar en el mismo ámbito solo reemplaza
+        if (nivel() > 0 && v.nivel != nivel()) deshacer.push_back({s, v});
+        v.info  = info;
+        v.nivel = nivel();
+    }
+
+    // Vinculación visible de 'nombre', o nullptr si no está declarado
+    const Info* buscar(const string& nombre) const {
+        auto it = ids.find(nombre);
+        if (it == ids.end()) return nullptr;
+        const Vinculo& v = vinculos[it->second];
+        return v.nivel >= 0 ? &v.info : nullptr;
+    }
+
+    // ¿La vinculación visible es global?
+    bool esGlobal(const string& nombre) const {
+        auto it = ids.find(nombre);
+        return it != ids.end() && vinculos[it->second].nivel == 0;
+    }
+
+    void abrir() { marcas.push_back(deshacer.size()); }
+
+    void cerrar() {
+        size_t marca = marcas.back();
+        marcas.pop_back();
+        while (deshacer.size() > marca) {
+            vinculos[deshacer.back().first] = deshacer.back().second;
+            deshacer.pop_back();
+        }
+    }
+
+    int nivel() const { return (int)marcas.size(); }
+
+    // Vacía la tabla (otra unidad); conserva la memoria reservada
+    void reiniciar() {
+        ids.clear();
+        vinculos.clear();
+        deshacer.clear();
+        marcas.clear();
+    }
+
+private:
+    struct Vinculo {
+        Info info{};
+        int  nivel = -1;   // -1: sin declarar
+    };
+
+    unordered_map<string, int>   ids;
+    vector<Vinculo>              vinculos;
+    vector<pair<int, Vinculo>>   deshacer;
+    vector<size_t>               marcas;
+};
+
+#endif // SIMBOLOS_H
@@ -0,0 +1,97 @@
+#include "threadpool.h"
+
+using namespace std;
+
+ThreadPool::ThreadPool(int hilos) : colas(hilos < 1 ? 1 : hilos) {
+    for (int i = 0; i < (int)colas.size(); ++i)
+        workers.emplace_back(&ThreadPool::bucle, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lk(mEstado);
+        detener = true;
+    }
+    hayTrabajo.notify_all();
+    for (auto& w : workers) w.join();
+}
+
+int ThreadPool::hilosDisponibles() {
+    unsigned n = thread::hardware_concurrency();
+    return n == 0 ? 1 : (int)n;
+}
+
+void ThreadPool::enviar(Tarea tarea) {
+    unsigned i = siguiente++ % colas.size();
+    pendientes++;
+    {
+        lock_guard<mutex> lk(colas[i].m);
+        colas[i].tareas.push_back(std::move(tarea));
+    }
+    {
+        // encoladas se publica bajo mEstado para no perder notificaciones
+        lock_guard<mutex> lk(mEstado);
+        encoladas++;
+    }
+    hayTrabajo.notify_one();
+}
+
+bool ThreadPool::obtener(int id, Tarea& t) {
+    // 1) cola propia, extremo trasero (LIFO: mejor localidad)
+    {
+        Cola& c = colas[id];
+        lock_guard<mutex> lk(c.m);
+        if (!c.tareas.empty()) {
+            t = std::move(c.tareas.back());
+            c.tareas.pop_back();
+            encoladas--;
+            return true;
+        }
+    }
+    // 2) robar del extremo delantero de las demás colas
+    int n = (int)colas.size();
+    for (int k = 1; k < n; ++k) {
+        Cola& c = colas[(id + k) % n];
+        lock_guard<mutex> lk(c.m);
+        if (!c.tareas.empty()) {
+            t = std::move(c.tareas.front());
+            c.tareas.pop_front();
+            encoladas--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::bucle(int id) {
+    while (true) {
+        Tarea t;
+        if (obtener(id, t)) {
+            t(id);
+            if (--pendientes == 0) {
+                lock_guard<mutex> lk(mEstado);
+                terminado.notify_all();
+            }
+            continue;
+        }
+
+        unique_lock<mutex> lk(mEstado);
+        hayTrabajo.wait(lk, [this] { return detener || encoladas > 0; });
+        if (detener && encoladas == 0) return;
+    }
+}
+
+void ThreadPool::esperar() {
+    unique_lock<mutex> lk(mEstado);
+    terminado.wait(lk, [this] { return pendientes == 0; });
+}
+
+void paraCada(ThreadPool* pool, size_t n, const function<void(size_t, int)>& f) {
+    if (!pool || pool->tamano() <= 1 || n <= 1) {
+        for (size_t i = 0; i < n; ++i) f(i, 0);
+        return;
+    }
+    for (size_t i = 0; i < n; ++i)
+        pool->enviar([i, &f](int hilo) { f(i, hilo); });
+    pool->esperar();
+}
@@ -0,0 +1,67 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+
+using namespace std;
+
+// --------------------------------------
+// Pool de hilos con robo de trabajo
+// --------------------------------------
+// Cada hilo tiene su propia cola: saca tareas de su extremo trasero y, cuando
+// se queda sin trabajo, roba del extremo delantero de la cola de otro hilo.
+// Las tareas reciben el índice del hilo que las ejecuta, para que puedan usar
+// estado propio por hilo (p.ej. un Compilador o un visitor por hilo).
+class ThreadPool {
+public:
+    using Tarea = function<void(int)>;
+
+    explicit ThreadPool(int hilos);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Encola una tarea (reparto round-robin entre las colas)
+    void enviar(Tarea tarea);
+
+    // Bloquea hasta que todas las tareas enviadas hayan terminado
+    void esperar();
+
+    int tamano() const { return (int)colas.size(); }
+
+    // Número de hilos por defecto: núcleos disponibles (mínimo 1)
+    static int hilosDisponibles();
+
+private:
+    struct Cola {
+        mutex       m;
+        deque<Tarea> tareas;
+    };
+
+    vector<Cola>   colas;
+    vector<thread> workers;
+
+    mutex              mEstado;
+    condition_variable hayTrabajo;
+    condition_variable terminado;
+    atomic<long>       pendientes{0};   // enviadas y aún no terminadas
+    atomic<long>       encoladas{0};    // en alguna cola, sin empezar
+    atomic<unsigned>   siguiente{0};
+    bool               detener = false;
+
+    bool obtener(int id, Tarea& t);
+    void bucle(int id);
+};
+
+// Ejecuta f(i, hilo) para i en [0, n) usando el pool; si pool es nulo o
+// tiene un solo hilo, se ejecuta en orden en el hilo actual.
+void paraCada(ThreadPool* pool, size_t n, const function<void(size_t, int)>& f);
+
+#endif // THREADPOOL_H
@@ -17,6 +17,7 @@ ostream& operator<<(ostream& outs, const Token& tok) {
         case Token::INTEGER:     outs << "TOKEN(INTEGER, \""   << tok.text << "\")"; break;
         case Token::LONGINT:     outs << "TOKEN(LONGINT, \""   << tok.text << "\")"; break;
         case Token::FLOAT:       outs << "TOKEN(FLOAT, \""     << tok.text << "\")"; break;
+        case Token::DOUBLE:      outs << "TOKEN(DOUBLE, \""    << tok.text << "\")"; break;
         case Token::UNSIGNED:    outs << "TOKEN(UNSIGNED, \""  << tok.text << "\")"; break;
         case Token::TYPEKW:      outs << "TOKEN(TYPE, \""      << tok.text << "\")"; break;
         case Token::IF:          outs << "TOKEN(IF, \""        << tok.text << "\")"; break;
@@ -29,6 +30,8 @@ ostream& operator<<(ostream& outs, const Token& tok) {
         case Token::DOWNTO:      outs << "TOKEN(DOWNTO, \""    << tok.text << "\")"; break;
         case Token::WRITELN:     outs << "TOKEN(WRITELN, \""   << tok.text << "\")"; break;
         case Token::READLN:      outs << "TOKEN(READLN, \""    << tok.text << "\")"; break;
+        case Token::ARRAY:       outs << "TOKEN(ARRAY, \""     << tok.text << "\")"; break;
+        case Token::OF:          outs << "TOKEN(OF, \""        << tok.text << "\")"; break;
 
         // Delimitadores
         case Token::SEMICOL:     outs << "TOKEN(SEMICOL, \""   << tok.text << "\")"; break;
@@ -37,6 +40,9 @@ ostream& operator<<(ostream& outs, const Token& tok) {
         case Token::DOT:         outs << "TOKEN(DOT, \""       << tok.text << "\")"; break;
         case Token::LPAREN:      outs << "TOKEN(LPAREN, \""    << tok.text << "\")"; break;
         case Token::RPAREN:      outs << "TOKEN(RPAREN, \""    << tok.text << "\")"; break;
+        case Token::LBRACKET:    outs << "TOKEN(LBRACKET, \""  << tok.text << "\")"; break;
+        case Token::RBRACKET:    outs << "TOKEN(RBRACKET, \""  << tok.text << "\")"; break;
+        case Token::DOTDOT:      outs << "TOKEN(DOTDOT, \""    << tok.text << "\")"; break;
 
         // Operadores
         case Token::ASSIGN:      outs << "TOKEN(ASSIGN, \""    << tok.text << "\")"; break;
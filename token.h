@@ -18,7 +18,8 @@ public:
         PROCEDURE,      // procedure
         INTEGER,        // integer
         LONGINT,        // longint
-        FLOAT,          // real / float
+        FLOAT,          // float
+        DOUBLE,         // real / double
         UNSIGNED,       // unsigned
         TYPEKW,         // type
         IF,             // if
@@ -31,6 +32,8 @@ public:
         DOWNTO,         // downto
         WRITELN,        // writeln
         READLN,         // readln
+        ARRAY,          // array
+        OF,             // of
 
         // ---- Delimitadores ----
         SEMICOL,        // ;
@@ -39,6 +42,9 @@ public:
         DOT,            // .
         LPAREN,         // (
         RPAREN,         // )
+        LBRACKET,       // [
+        RBRACKET,       // ]
+        DOTDOT,         // ..
 
         // ---- Operadores ----
         ASSIGN,         // :=
@@ -69,11 +75,12 @@ public:
 
     Type type;
     string text;
+    int pos = -1;   // posición del lexema en el texto (para diagnósticos)
 
     Token(Type t) : type(t), text("") {}
     Token(Type t, char c) : type(t), text(string(1,c)) {}
-    Token(Type t, const string& src, int first, int len)
-        : type(t), text(src.substr(first, len)) {}
+    Token(Type t, const char* src, int first, int len)
+        : type(t), text(src + first, len), pos(first) {}
 
     friend ostream& operator<<(ostream& outs, const Token& tok);
     friend ostream& operator<<(ostream& outs, const Token* tok);
@@ -0,0 +1,46 @@
+#include "tuberia.h"
+
+using namespace std;
+
+TuberiaTokens::TuberiaTokens(const char* t, size_t len) : texto(t) {
+    productor = thread(&TuberiaTokens::producir, this, len);
+}
+
+TuberiaTokens::~TuberiaTokens() {
+    // El parser puede abandonar antes del final (error de sintaxis): el
+    // productor deja de esperar hueco en el anillo y termina.
+    cancelado.store(true, memory_order_relaxed);
+    if (productor.joinable()) productor.join();
+}
+
+bool TuberiaTokens::conviene(size_t len) {
+    return len >= UMBRAL && thread::hardware_concurrency() > 1;
+}
+
+void TuberiaTokens::producir(size_t len) {
+    Scanner scanner(texto, len);
+    while (true) {
+        TokenCompacto t = scanner.nextCompacto();
+        while (!anillo.push(t)) {
+            if (cancelado.load(memory_order_relaxed)) return;
+            this_thread::yield();
+        }
+        // Un ERR no corta el texto: el parser lo registra y sigue pidiendo
+        // tokens, igual que con Scanner o TokensEnMemoria
+        if (t.type == Token::END) return;
+    }
+}
+
+Token* TuberiaTokens::nextToken() {
+    // Tras END el productor ya terminó: se repite el último token
+    if (terminado) return new Token(ultimo.type, texto, ultimo.first, ultimo.len);
+
+    TokenCompacto t;
+    while (!anillo.pop(t)) this_thread::yield();
+
+    if (t.type == Token::END) {
+        terminado = true;
+        ultimo    = t;
+    }
+    return new Token(t.type, texto, t.first, t.len);
+}
@@ -0,0 +1,90 @@
+#ifndef TUBERIA_H
+#define TUBERIA_H
+
+#include <atomic>
+#include <thread>
+#include <cstddef>
+#include "scanner.h"
+
+using namespace std;
+
+// --------------------------------------
+// Anillo SPSC sin bloqueos
+// --------------------------------------
+// Un productor y un consumidor, capacidad N (potencia de 2). Cada lado
+// guarda una copia del índice del otro y solo lo vuelve a leer (acquire)
+// cuando el anillo le parece lleno/vacío: en régimen estable no hay tráfico
+// de caché entre los dos hilos por cada elemento.
+template <class T, size_t N>
+class AnilloSPSC {
+    static_assert((N & (N - 1)) == 0, "N debe ser potencia de 2");
+
+public:
+    bool push(const T& v) {
+        size_t c = cola.load(memory_order_relaxed);
+        if (c - cabezaVista == N) {
+            cabezaVista = cabeza.load(memory_order_acquire);
+            if (c - cabezaVista == N) return false;   // lleno
+        }
+        datos[c & (N - 1)] = v;
+        cola.store(c + 1, memory_order_release);
+        return true;
+    }
+
+    bool pop(T& v) {
+        size_t h = cabeza.load(memory_order_relaxed);
+        if (h == colaVista) {
+            colaVista = cola.load(memory_order_acquire);
+            if (h == colaVista) return false;          // vacío
+        }
+        v = datos[h & (N - 1)];
+        cabeza.store(h + 1, memory_order_release);
+        return true;
+    }
+
+private:
+    // Lado del consumidor
+    alignas(64) atomic<size_t> cabeza{0};
+    size_t colaVista = 0;
+
+    // Lado del productor
+    alignas(64) atomic<size_t> cola{0};
+    size_t cabezaVista = 0;
+
+    alignas(64) T datos[N];
+};
+
+// --------------------------------------
+// Scanner en un hilo propio
+// --------------------------------------
+// El hilo productor recorre el texto con Scanner::nextCompacto() y publica
+// tokens compactos en el anillo; el parser los consume con nextToken() y
+// solo entonces se construye el Token (tipo + texto). El léxico se solapa
+// así con el parseo y la construcción del AST.
+class TuberiaTokens : public FuenteTokens {
+public:
+    TuberiaTokens(const char* texto, size_t len);
+    ~TuberiaTokens();
+
+    Token* nextToken() override;
+
+    // ¿Compensa un hilo aparte para un texto de 'len' bytes? (no con
+    // archivos pequeños ni con un solo núcleo)
+    static bool conviene(size_t len);
+
+private:
+    static const size_t CAPACIDAD = 1 << 14;
+    static const size_t UMBRAL    = 256 * 1024;   // bytes
+
+    const char* texto;
+    AnilloSPSC<TokenCompacto, CAPACIDAD> anillo;
+    atomic<bool> cancelado{false};
+    thread productor;
+
+    bool terminado = false;   // el consumidor ya recibió END
+    TokenCompacto ultimo;
+
+    void producir(size_t len);
+};
+
+#endif // TUBERIA_H
@@ -1,6 +1,15 @@
 #include <iostream>
+#include <sstream>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <algorithm>
+#include <unordered_set>
+#include <set>
 #include "visitor.h"
 #include "ast.h"
+#include "runtime.h"
+#include "threadpool.h"
 
 using namespace std;
 
@@ -12,8 +21,29 @@ static bool es64Entero(Tipo t) {
     return t == T_LONG;
 }
 static bool esFlotante(Tipo t) {
-    return t == T_FLOAT;   // SOLO float: 32 bits (SSE)
+    return t == T_FLOAT || t == T_DOUBLE;   // escalares SSE
 }
+// Sufijo de las instrucciones SSE escalares: double (64 bits) o float (32)
+static const char* sse(Tipo t) {
+    return t == T_DOUBLE ? "sd" : "ss";
+}
+// Bytes de un valor de tipo t en memoria
+static int tamTipo(Tipo t) {
+    return es64Entero(t) || t == T_DOUBLE ? 8 : 4;
+}
+
+// ==== registros de argumentos (System V) ====
+static const char* const REG_ARG_64[]    = {"%rdi", "%rsi", "%rdx", "%rcx", "%r8", "%r9"};
+static const char* const REG_ARG_FLOAT[] = {"%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                                            "%xmm4", "%xmm5", "%xmm6", "%xmm7"};
+static const int ARGS_ENTEROS = 6;
+static const int ARGS_FLOAT   = 8;
+
+// ==== registros callee-saved de los for ====
+// Pares (contador, vueltas restantes): el 0-1 para los for sin otro for
+// dentro, el 2-3 para los que solo tienen esos dentro
+static const char* const REG_FOR_64[] = {"%r12",  "%r13",  "%r14",  "%r15"};
+static const char* const REG_FOR_32[] = {"%r12d", "%r13d", "%r14d", "%r15d"};
 
 ///////////////////////////////////////////////////////////////////////////////
 //           MÉTODOS accept(...) DE LOS NODOS DEL AST
@@ -31,6 +61,10 @@ int IdExp::accept(Visitor* visitor) {
     return visitor->visit(this);
 }
 
+int IndexExp::accept(Visitor* visitor) {
+    return visitor->visit(this);
+}
+
 int PrintStm::accept(Visitor* visitor) {
     return visitor->visit(this);
 }
@@ -47,6 +81,10 @@ int WhileStm::accept(Visitor* visitor) {
     return visitor->visit(this);
 }
 
+int ForStm::accept(Visitor* visitor) {
+    return visitor->visit(this);
+}
+
 int Body::accept(Visitor* visitor) {
     return visitor->visit(this);
 }
@@ -76,62 +114,125 @@ int CastExp::accept(Visitor* visitor) {
 ///////////////////////////////////////////////////////////////////////////////
 
 int TypeCheckVisitor::visit(Program* p) {
+    registrarGlobales(p);
+
+    // Fase 1: firmas de todas las funciones
+    vector<FunDec*> funs(p->fdlist.begin(), p->fdlist.end());
+    for (size_t i = 0; i < funs.size(); ++i) {
+        if (funs[i]) registrarFirma(funs[i], (int)i);
+    }
+
+    // Fase 2: cuerpos (solo leen globales, alias y firmas)
+    if (hilos && hilos->tamano() > 1 && funs.size() > 1) {
+        analizarCuerposParalelo(funs);
+    } else {
+        for (size_t i = 0; i < funs.size(); ++i) {
+            indiceFuncion = (int)i;
+            if (funs[i]) visit(funs[i]);
+        }
+    }
+
+    return 0;
+}
+
+void TypeCheckVisitor::registrarGlobales(Program* p) {
     // Cargar alias de tipos (type alias = ...)
     aliasMap = p->tdefs;
 
     // Variables globales
     for (auto vd : p->vdlist) {
-        if (vd) vd->accept(this);
+        if (vd) visit(vd);
     }
+}
 
-    // Funciones
-    for (auto fd : p->fdlist) {
-        if (fd) fd->accept(this);
+void TypeCheckVisitor::registrarFirma(FunDec* fd, int indice) {
+    Tipo t = strToTipo(fd->tipo);
+    funRet[fd->nombre] = t;
+    Firma f{indice, t, {}, fd->Pvar, fd->esProcedimiento()};
+    for (auto& p : fd->Ptipos) f.parametros.push_back(strToTipo(p));
+    firmas[fd->nombre].push_back(std::move(f));
+
+    // Análisis incremental: una llamada anterior no pudo ver estos var
+    auto it = llamadasAdelantadas.find(fd->nombre);
+    if (it != llamadasAdelantadas.end() &&
+        find(fd->Pvar.begin(), fd->Pvar.end(), true) != fd->Pvar.end()) {
+        error() << "'" << fd->nombre << "' tiene parámetros var y se llama"
+                << " antes de su declaración (en '" << it->second << "').\n";
+        llamadasAdelantadas.erase(it);
     }
+}
 
-    return 0;
+void TypeCheckVisitor::analizarFuncion(FunDec* fd, int indice) {
+    if (!fd) return;
+    registrarFirma(fd, indice);
+    indiceFuncion = indice;
+    visit(fd);
+}
+
+void TypeCheckVisitor::analizarCuerposParalelo(const vector<FunDec*>& funs) {
+    // Un visitor por hilo con copia de las tablas de solo lectura; cada
+    // cuerpo tiene su propio tipoLocal y solo modifica sus propios nodos.
+    vector<unique_ptr<TypeCheckVisitor>> trabajadores(hilos->tamano());
+    for (auto& t : trabajadores) {
+        t.reset(new TypeCheckVisitor());
+        t->simbolos   = simbolos;
+        t->aliasMap   = aliasMap;
+        t->funRet     = funRet;
+        t->firmas     = firmas;
+    }
+
+    // Errores de cada función por separado, unidos en orden fuente
+    vector<string> avisosF(funs.size());
+    paraCada(hilos, funs.size(), [&](size_t i, int hilo) {
+        TypeCheckVisitor& t = *trabajadores[hilo];
+        ostringstream av;
+        t.avisos = &av;
+        t.indiceFuncion = (int)i;
+        if (funs[i]) t.visit(funs[i]);
+        avisosF[i] = av.str();
+    });
+    for (auto& a : avisosF) *avisos << a;
+    for (auto& t : trabajadores) errores += t->errores;
 }
 
 int TypeCheckVisitor::visit(VarDec* vd) {
     if (!vd) return 0;
 
-    Tipo tt = strToTipo(vd->type);
+    InfoVar info;
+    info.tipo    = strToTipo(vd->type);
+    info.arreglo = vd->arreglo;
+    info.lo      = vd->lo;
+    info.hi      = vd->hi;
 
-    if (!enFuncion) {
-        // variables globales
-        for (auto& v : vd->vars) {
-            tipoGlobal[v] = tt;
-        }
-    } else {
-        // variables locales
-        for (auto& v : vd->vars) {
-            tipoLocal[v] = tt;
-        }
+    // Globales (nivel 0) o del ámbito abierto (función / bloque)
+    for (auto& v : vd->vars) {
+        simbolos.declarar(v, info);
     }
     return 0;
 }
 
 int TypeCheckVisitor::visit(FunDec* fd) {
     if (!fd) return 0;
-
-    // tipo de retorno de la función
-    funRet[fd->nombre] = strToTipo(fd->tipo);
+    if (fd->codigo && fd->codigo->deCache) return 0;   // ya compilada
 
     enFuncion = true;
     funcionActual = fd->nombre;   // <--- IMPORTANTE
-    tipoLocal.clear();            // limpiar entorno local
+    simbolos.abrir();             // entorno local: parámetros
 
     // registrar parámetros en el entorno local
     for (size_t i = 0; i < fd->Pnombres.size(); ++i) {
         const string& pname = fd->Pnombres[i];
         const string& ptype = fd->Ptipos[i];
-        Tipo t = strToTipo(ptype);
-        tipoLocal[pname] = t;
+        InfoVar info;
+        info.tipo = strToTipo(ptype);
+        info.referencia = fd->porReferencia(i);
+        simbolos.declarar(pname, info);
     }
 
     if (fd->cuerpo) {
-        fd->cuerpo->accept(this);
+        visit(fd->cuerpo);
     }
+    simbolos.cerrar();
 
     enFuncion = false;
     funcionActual.clear();        // <--- limpiar nombre
@@ -141,13 +242,18 @@ int TypeCheckVisitor::visit(FunDec* fd) {
 int TypeCheckVisitor::visit(Body* b) {
     if (!b) return 0;
 
+    // Un cuerpo con declaraciones propias abre un ámbito
+    bool ambito = !b->declarations.empty();
+    if (ambito) simbolos.abrir();
+
     for (auto vd : b->declarations) {
-        if (vd) vd->accept(this);
+        if (vd) visit(vd);
     }
     for (auto s : b->StmList) {
-        if (s) s->accept(this);
+        if (s) visitar(this, s);
     }
 
+    if (ambito) simbolos.cerrar();
     return 0;
 }
 
@@ -158,13 +264,15 @@ int TypeCheckVisitor::visit(AssignStm* s) {
 
     // Caso especial: asignación al nombre de la función (estilo Pascal)
     if (enFuncion && !funcionActual.empty() && s->id == funcionActual) {
-        auto it = funRet.find(funcionActual);
-        if (it != funRet.end()) {
-            dst = it->second;  // tipo de retorno de la función
+        tipoRetorno(funcionActual, dst);  // tipo de retorno de la función
+        const Firma* propia = firma(funcionActual);
+        if (propia && propia->procedimiento) {
+            error() << "'" << funcionActual
+                    << "' es un procedimiento: no se le puede asignar un valor.\n";
         }
 
         // Analizar expresión y castear al tipo de retorno
-        s->e->accept(this);
+        visitar(this, s->e);
         s->e = insertarCast(s->e, dst);
 
         // NO registramos 's->id' como variable local
@@ -172,15 +280,21 @@ int TypeCheckVisitor::visit(AssignStm* s) {
     }
 
     // Asignación normal a variable local/global
-    if (tipoLocal.count(s->id))       dst = tipoLocal[s->id];
-    else if (tipoGlobal.count(s->id)) dst = tipoGlobal[s->id];
-    else {
-        // Si no está declarada, por defecto la tratamos como int
-        dst = T_INT;
+    const InfoVar* v = simbolos.buscar(s->id);
+    // Si no está declarada, por defecto la tratamos como int
+    dst = v ? v->tipo : T_INT;
+
+    // a[i] := e
+    if (s->indice) {
+        visitar(this, s->indice);
+        if (esFlotante(s->indice->tipoDato)) s->indice = insertarCast(s->indice, T_INT);
+        long long min, max;
+        s->verificar = !(v && v->arreglo && rango(s->indice, min, max) &&
+                         min >= v->lo && max <= v->hi);
     }
 
     // Analizamos la expresión y la casteamos al tipo destino
-    s->e->accept(this);
+    visitar(this, s->e);
     s->e = insertarCast(s->e, dst);
 
     return 0;
@@ -188,7 +302,7 @@ int TypeCheckVisitor::visit(AssignStm* s) {
 
 int TypeCheckVisitor::visit(PrintStm* s) {
     if (!s || !s->e) return 0;
-    s->e->accept(this);
+    visitar(this, s->e);
     return 0;
 }
 
@@ -196,25 +310,138 @@ int TypeCheckVisitor::visit(WhileStm* s) {
     if (!s) return 0;
 
     if (s->condition) {
-        s->condition->accept(this);
+        visitar(this, s->condition);
         // condición se fuerza a entero (0 / no 0)
         s->condition = insertarCast(s->condition, T_INT);
     }
 
-    if (s->b) s->b->accept(this);
+    if (s->b) visit(s->b);
 
     return 0;
 }
 
+void TypeCheckVisitor::marcarReferencias(Exp* e) {
+    if (!e) return;
+    switch (e->clase) {
+        case EXP_BINARIA: {
+            auto b = static_cast<BinaryExp*>(e);
+            marcarReferencias(b->left);
+            marcarReferencias(b->right);
+            break;
+        }
+        case EXP_CAST:   marcarReferencias(static_cast<CastExp*>(e)->expr); break;
+        case EXP_INDICE: marcarReferencias(static_cast<IndexExp*>(e)->indice); break;
+        case EXP_LLAMADA: {
+            auto f = static_cast<FcallExp*>(e);
+            if (!esLectura(f)) {
+                const Firma* s = firma(f->nombre);
+                f->referencia = s ? s->referencia : vector<bool>();
+            }
+            for (auto a : f->argumentos) marcarReferencias(a);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// ¿Alguna sentencia de b (o de sus bloques) asigna a la variable 'id'?
+// Pasarla por referencia a una llamada cuenta como asignación.
+bool TypeCheckVisitor::asigna(Body* b, const string& id) {
+    if (!b) return false;
+    auto entrega = [&](Exp* e) {
+        marcarReferencias(e);
+        return entregaVariable(e, id);
+    };
+    for (auto s : b->StmList) {
+        if (!s) continue;
+        switch (s->clase) {
+            case STM_ASIGNACION: {
+                auto a = static_cast<AssignStm*>(s);
+                if (a->id == id && !a->indice) return true;
+                if (entrega(a->e) || entrega(a->indice)) return true;
+                break;
+            }
+            case STM_IF: {
+                auto i = static_cast<IfStm*>(s);
+                if (entrega(i->condition)) return true;
+                if (asigna(i->then, id) || asigna(i->els, id)) return true;
+                break;
+            }
+            case STM_WHILE: {
+                auto w = static_cast<WhileStm*>(s);
+                if (entrega(w->condition) || asigna(w->b, id)) return true;
+                break;
+            }
+            case STM_FOR: {
+                auto f = static_cast<ForStm*>(s);
+                if (f->id == id || asigna(f->b, id)) return true;
+                if (entrega(f->inicio) || entrega(f->fin)) return true;
+                break;
+            }
+            case STM_PRINT:
+                if (entrega(static_cast<PrintStm*>(s)->e)) return true;
+                break;
+            case STM_RETURN:
+                if (entrega(static_cast<ReturnStm*>(s)->e)) return true;
+                break;
+            case STM_EXP:
+                if (entrega(static_cast<ExpStm*>(s)->e)) return true;
+                break;
+        }
+    }
+    return false;
+}
+
+int TypeCheckVisitor::visit(ForStm* s) {
+    if (!s) return 0;
+
+    // Los límites toman el tipo de la variable de control
+    const InfoVar* v = simbolos.buscar(s->id);
+    Tipo t = v ? v->tipo : T_INT;
+
+    if (s->inicio) {
+        visitar(this, s->inicio);
+        s->inicio = insertarCast(s->inicio, t);
+    }
+    if (s->fin) {
+        visitar(this, s->fin);
+        s->fin = insertarCast(s->fin, t);
+    }
+
+    // Si los límites tienen rango conocido, dentro del cuerpo el contador
+    // también: de inicio a fin. No vale para una global ni para un
+    // parámetro var (una función llamada puede cambiarlas) ni si el cuerpo
+    // la asigna.
+    long long minIni, maxIni, minFin, maxFin;
+    bool acotada = v && !v->arreglo && !v->referencia && !simbolos.esGlobal(s->id) &&
+                   s->inicio && s->fin &&
+                   rango(s->inicio, minIni, maxIni) && rango(s->fin, minFin, maxFin) &&
+                   !asigna(s->b, s->id);
+    if (acotada) {
+        InfoVar contador = *v;
+        contador.acotada = true;
+        contador.min = s->descendente ? minFin : minIni;
+        contador.max = s->descendente ? maxIni : maxFin;
+        simbolos.abrir();
+        simbolos.declarar(s->id, contador);
+    }
+
+    if (s->b) visit(s->b);
+
+    if (acotada) simbolos.cerrar();
+    return 0;
+}
+
 int TypeCheckVisitor::visit(IfStm* s) {
     if (!s) return 0;
 
     if (s->condition) {
-        s->condition->accept(this);
+        visitar(this, s->condition);
         s->condition = insertarCast(s->condition, T_INT);
     }
-    if (s->then) s->then->accept(this);
-    if (s->els)  s->els->accept(this);
+    if (s->then) visit(s->then);
+    if (s->els)  visit(s->els);
 
     return 0;
 }
@@ -223,7 +450,7 @@ int TypeCheckVisitor::visit(ReturnStm* r) {
     if (!r) return 0;
 
     if (r->e) {
-        r->e->accept(this);
+        visitar(this, r->e);
     }
 
     return 0;
@@ -243,27 +470,150 @@ int TypeCheckVisitor::visit(NumberExp* e) {
 int TypeCheckVisitor::visit(IdExp* e) {
     if (!e) return 0;
 
-    if (tipoLocal.count(e->value))        e->tipoDato = tipoLocal[e->value];
-    else if (tipoGlobal.count(e->value))  e->tipoDato = tipoGlobal[e->value];
-    else                                  e->tipoDato = T_INT; // por defecto
+    const InfoVar* v = simbolos.buscar(e->value);
+    e->tipoDato = v ? v->tipo : T_INT;   // por defecto, int
+
+    // 'x := p' con p un procedimiento sin argumentos
+    const Firma* s = v ? nullptr : firma(e->value);
+    if (s && s->procedimiento) {
+        error() << "'" << e->value << "' es un procedimiento y no devuelve"
+                << " un valor (en '" << funcionActual << "').\n";
+    }
+
+    return 0;
+}
+
+int TypeCheckVisitor::visit(IndexExp* e) {
+    if (!e || !e->indice) return 0;
+
+    const InfoVar* v = simbolos.buscar(e->nombre);
+    e->tipoDato = v ? v->tipo : T_INT;
+
+    visitar(this, e->indice);
+    if (esFlotante(e->indice->tipoDato)) e->indice = insertarCast(e->indice, T_INT);
 
+    // Sin verificación si el índice cae siempre dentro de los límites
+    long long min, max;
+    e->verificar = !(v && v->arreglo && rango(e->indice, min, max) &&
+                     min >= v->lo && max <= v->hi);
     return 0;
 }
 
+// Límite para la aritmética de intervalos: así +, - y * de dos cotas nunca
+// desbordan un long long ni un int de 32 bits en el código generado
+static const long long COTA_RANGO = 1LL << 30;
+
+bool TypeCheckVisitor::rango(Exp* e, long long& min, long long& max) const {
+    if (!e) return false;
+
+    switch (e->clase) {
+        case EXP_NUMERO: {
+            auto num = static_cast<NumberExp*>(e);
+            if (num->isFloat || esFlotante(num->tipoDato)) return false;
+            min = max = num->ivalue;
+            break;
+        }
+        case EXP_ID: {
+            const InfoVar* v = simbolos.buscar(static_cast<IdExp*>(e)->value);
+            if (!v || !v->acotada) return false;
+            min = v->min;
+            max = v->max;
+            break;
+        }
+        case EXP_CAST: {
+            auto c = static_cast<CastExp*>(e);
+            if (esFlotante(c->destino) || esFlotante(c->expr->tipoDato)) return false;
+            if (!rango(c->expr, min, max)) return false;
+            // a unsigned, un negativo cambia de valor
+            if (c->destino == T_UNSIGNED && min < 0) return false;
+            break;
+        }
+        case EXP_BINARIA: {
+            auto b = static_cast<BinaryExp*>(e);
+            long long lmin, lmax, rmin, rmax;
+            if (!rango(b->left, lmin, lmax) || !rango(b->right, rmin, rmax)) return false;
+            switch (b->op) {
+                case PLUS_OP:  min = lmin + rmin; max = lmax + rmax; break;
+                case MINUS_OP: min = lmin - rmax; max = lmax - rmin; break;
+                case MUL_OP: {
+                    long long p[4] = {lmin * rmin, lmin * rmax, lmax * rmin, lmax * rmax};
+                    min = *std::min_element(p, p + 4);
+                    max = *std::max_element(p, p + 4);
+                    break;
+                }
+                default:
+                    return false;
+            }
+            break;
+        }
+        default:
+            return false;
+    }
+    return min >= -COTA_RANGO && max <= COTA_RANGO;
+}
+
 int TypeCheckVisitor::visit(FcallExp* f) {
     if (!f) return 0;
 
     // analizar tipos de argumentos
     for (auto* arg : f->argumentos) {
-        if (arg) arg->accept(this);
+        if (arg) visitar(this, arg);
     }
 
     // tipo de retorno de la función
-    auto it = funRet.find(f->nombre);
-    if (it != funRet.end()) {
-        f->tipoDato = it->second;
-    } else {
-        f->tipoDato = T_INT;  // por defecto
+    Tipo t = T_INT;  // por defecto
+    const Firma* firmaF = firma(f->nombre);
+    if (firmaF) t = firmaF->retorno;
+    f->tipoDato = t;
+
+    // Parámetros var: los de la firma visible. Una función declarada más
+    // adelante recibe todo por valor; si esa declaración tiene var, error.
+    if (!esLectura(f)) f->referencia = firmaF ? firmaF->referencia : vector<bool>();
+    if (!firmaF && !esLectura(f)) {
+        bool conVar = false;
+        auto it = firmas.find(f->nombre);
+        if (it != firmas.end()) {
+            for (auto& s : it->second)
+                conVar = conVar || find(s.referencia.begin(), s.referencia.end(), true) != s.referencia.end();
+        }
+        if (conVar) {
+            error() << "'" << f->nombre << "' tiene parámetros var y se llama"
+                    << " antes de su declaración (en '" << funcionActual << "').\n";
+        } else if (!llamadasAdelantadas.count(f->nombre)) {
+            llamadasAdelantadas[f->nombre] = funcionActual;
+        }
+    }
+
+    if (firmaF && firmaF->procedimiento && f != sentencia) {
+        error() << "'" << f->nombre << "' es un procedimiento y no devuelve"
+                << " un valor (en '" << funcionActual << "').\n";
+    }
+
+    // Un argumento por valor se convierte al tipo del parámetro (así llega
+    // en la clase de registro que espera la función). Uno var tiene que ser
+    // una variable (o un elemento de arreglo) del mismo tipo: se pasa su
+    // dirección. Los de readln los revisa la generación (cada tipo tiene
+    // su rutina).
+    if (!firmaF || esLectura(f)) return 0;
+    for (size_t i = 0; i < f->argumentos.size() && i < firmaF->parametros.size(); ++i) {
+        if (!f->porReferencia(i)) {
+            f->argumentos[i] = insertarCast(f->argumentos[i], firmaF->parametros[i]);
+            continue;
+        }
+        Exp* a = f->argumentos[i];
+        const InfoVar* v = nullptr;
+        if (a && a->clase == EXP_ID && static_cast<IdExp*>(a)->value != funcionActual)
+            v = simbolos.buscar(static_cast<IdExp*>(a)->value);
+        else if (a && a->clase == EXP_INDICE)
+            v = simbolos.buscar(static_cast<IndexExp*>(a)->nombre);
+
+        if (!v || v->arreglo != (a->clase == EXP_INDICE)) {
+            error() << "el argumento " << i + 1 << " de '" << f->nombre
+                    << "' (en '" << funcionActual << "') es un parámetro var: debe ser una variable.\n";
+        } else if (v->tipo != firmaF->parametros[i]) {
+            error() << "el argumento " << i + 1 << " de '" << f->nombre
+                    << "' (en '" << funcionActual << "') no tiene el tipo del parámetro var.\n";
+        }
     }
 
     return 0;
@@ -272,8 +622,14 @@ int TypeCheckVisitor::visit(FcallExp* f) {
 int TypeCheckVisitor::visit(BinaryExp* e) {
     if (!e || !e->left || !e->right) return 0;
 
-    e->left->accept(this);
-    e->right->accept(this);
+    // Un nodo compartido ya analizado conserva su tipo y sus casts
+    if (e->compartido) {
+        if (e->tipado) return 0;
+        e->tipado = true;
+    }
+
+    visitar(this, e->left);
+    visitar(this, e->right);
 
     if (esRelOp(e->op)) {
         // unificar tipos para comparación
@@ -293,9 +649,83 @@ int TypeCheckVisitor::visit(BinaryExp* e) {
     return 0;
 }
 
+// ¿e es float solo por sus literales? Literales, enteros convertidos
+// implícitamente y operaciones entre ellos. Bajo un nodo compartido, lo
+// convertido tiene que ser compartido también (ver aDouble).
+static bool floatPorLiterales(Exp* e, bool compartido = false) {
+    if (e->tipoDato != T_FLOAT) return false;
+    compartido = compartido || e->compartido;
+    switch (e->clase) {
+        case EXP_NUMERO:
+            return true;
+        case EXP_CAST: {
+            auto c = static_cast<CastExp*>(e);
+            return c->implicito && !esFlotante(c->expr->tipoDato) &&
+                   (!compartido || c->expr->compartido);
+        }
+        case EXP_BINARIA: {
+            auto b = static_cast<BinaryExp*>(e);
+            return floatPorLiterales(b->left, compartido) &&
+                   floatPorLiterales(b->right, compartido);
+        }
+        default:
+            return false;
+    }
+}
+
+// Pasa a double una expresión que cumple floatPorLiterales. Un nodo
+// compartido puede usarse también como float en otro lugar: él y lo que
+// cuelga de él se copian (la parte entera se sigue compartiendo).
+static Exp* aDouble(Exp* e, bool copiar = false) {
+    copiar = copiar || e->compartido;
+    switch (e->clase) {
+        case EXP_CAST: {
+            auto c = static_cast<CastExp*>(e);
+            if (copiar) {
+                c = new CastExp(c->expr, T_DOUBLE);
+                c->implicito = true;
+            }
+            c->destino = T_DOUBLE;
+            e = c;
+            break;
+        }
+        case EXP_BINARIA: {
+            auto b = static_cast<BinaryExp*>(e);
+            Exp* l = aDouble(b->left, copiar);
+            Exp* r = aDouble(b->right, copiar);
+            if (copiar) {
+                b = new BinaryExp(l, r, b->op);
+            } else {
+                b->left  = l;
+                b->right = r;
+            }
+            e = b;
+            break;
+        }
+        default:
+            if (copiar) {
+                e = new NumberExp(*static_cast<NumberExp*>(e));
+                e->compartido = false;
+                e->tipado     = false;
+            }
+            break;
+    }
+    e->tipoDato = T_DOUBLE;
+    return e;
+}
+
 int TypeCheckVisitor::visit(CastExp* e) {
     if (!e || !e->expr) return 0;
-    e->expr->accept(this);
+    if (e->compartido) {
+        if (e->tipado) return 0;
+        e->tipado = true;
+    }
+    visitar(this, e->expr);
+    // double(0.1), double(i / 3.0): los literales pasan a double, sin
+    // redondear antes a float
+    if (e->destino == T_DOUBLE &&
+        (e->expr->clase == EXP_NUMERO || floatPorLiterales(e->expr)))
+        e->expr = insertarCast(e->expr, T_DOUBLE);
     e->tipoDato = e->destino;
     return 0;
 }
@@ -307,7 +737,10 @@ int TypeCheckVisitor::visit(TypeAlias* tdef) {
 }
 
 int TypeCheckVisitor::visit(ExpStm* s) {
-    if (s && s->e) s->e->accept(this);
+    if (!s || !s->e) return 0;
+    sentencia = s->e;
+    visitar(this, s->e);
+    sentencia = nullptr;
     return 0;
 }
 
@@ -316,15 +749,36 @@ int TypeCheckVisitor::visit(ExpStm* s) {
 Exp* TypeCheckVisitor::insertarCast(Exp* e, Tipo dst) {
     if (!e) return nullptr;
     if (e->tipoDato == dst) return e;
+    // (i - 0.5) * h con h double: la resta se hace en double, no en float
+    // y convertida después
+    if (dst == T_DOUBLE && floatPorLiterales(e)) return aDouble(e);
     if (dst == T_LONG) {
-        if (auto* num = dynamic_cast<NumberExp*>(e)) {
+        if (e->clase == EXP_NUMERO) {
+            auto* num = static_cast<NumberExp*>(e);
+            // Un literal compartido puede usarse también como int: se copia
+            if (num->compartido) {
+                num = new NumberExp(*num);
+                num->compartido = false;
+            }
             num->tipoDato = T_LONG;   // hará que GenCode use movq $literal, %rax
-            return e;
+            return num;
+        }
+    }
+    if (dst == T_DOUBLE && e->clase == EXP_NUMERO) {
+        // El literal pasa a double con el valor escrito en la fuente, sin
+        // redondearlo antes a float
+        auto* num = static_cast<NumberExp*>(e);
+        if (num->compartido) {
+            num = new NumberExp(*num);
+            num->compartido = false;
         }
+        num->tipoDato = T_DOUBLE;
+        return num;
     }
 
     auto* c = new CastExp(e, dst);
     c->tipoDato = dst;
+    c->implicito = true;
     return c;
 }
 
@@ -334,60 +788,109 @@ Exp* TypeCheckVisitor::insertarCast(Exp* e, Tipo dst) {
 
 int GenCodeVisitor::generar(Program* program) {
     if (!program) return 0;
-    return program->accept(this);
+    return visit(program);
 }
 
 int GenCodeVisitor::visit(Program* program) {
+    generarInicio(program);
+
+    // Código de cada función
+    if (capturarFunciones || (hilos && hilos->tamano() > 1 && program->fdlist.size() > 1))
+        generarFuncionesEnBuffers(program);
+    else
+        generarFunciones(program);
+
+    generarFin();
+    return 0;
+}
+
+void GenCodeVisitor::generarInicio(Program* program) {
     poolFloats.clear();
+    enPool.clear();
+    poolDoubles.clear();
+    enPoolDoubles.clear();
+    usaEscritura = false;
+    usaLectura   = false;
 
     // Sección de datos
     out << ".data\n";
-    out << "print_fmt: .string \"%ld \\n\"\n";
-    out << "printf_fmt_float: .string \"%f \\n\"\n";
 
     // alias de tipos (type alias = ...)
     aliasMap = program->tdefs;
 
-    // variables globales -> rellenan tipoGlobal + memoriaGlobal
+    // variables globales -> nivel 0 de la tabla de símbolos
     for (auto dec : program->vdlist) {
-        if (dec) dec->accept(this);
+        if (dec) visit(dec);
     }
 
-    // Definiciones reales en .data según tipo
-    for (auto &kv : tipoGlobal) {
-        const string &name = kv.first;
-        Tipo t = kv.second;
+    // Definiciones reales en .data según tipo, en orden de declaración; los
+    // arreglos van después, sin inicializar, en .bss
+    unordered_set<string> definidas;
+    vector<pair<string, long long>> arreglos;
+    for (auto dec : program->vdlist) {
+        if (!dec) continue;
+        for (const string& name : dec->vars) {
+            if (!definidas.insert(name).second) continue;
+            Tipo t = simbolos.buscar(name)->tipo;
+
+            if (dec->arreglo) {
+                arreglos.push_back({name, tamVariable(dec)});
+            } else if (t == T_FLOAT) {
+                // float 32 bits en memoria
+                out << name << ": .float 0.0\n";
+            } else if (tamTipo(t) == 8) {
+                // long / double 64 bits
+                out << name << ": .quad 0\n";
+            } else {
+                // int / unsigned / bool (32 bits)
+                out << name << ": .long 0\n";
+            }
+        }
+    }
 
-        if (esFlotante(t)) {
-            // float 32 bits en memoria
-            out << name << ": .float 0.0\n";
-        } else if (es64Entero(t)) {
-            // long 64 bits
-            out << name << ": .quad 0\n";
-        } else {
-            // int / unsigned / bool (32 bits)
-            out << name << ": .long 0\n";
+    if (!arreglos.empty()) {
+        out << ".bss\n";
+        for (auto& a : arreglos) {
+            out << ".p2align 3\n";
+            out << a.first << ": .zero " << a.second << "\n";
         }
     }
 
     // Sección de código
     out << ".text\n";
+}
 
-    // Código de cada función
-    for (auto dec : program->fdlist) {
-        if (dec) dec->accept(this);
-    }
+void GenCodeVisitor::generarFin() {
+    // Rutinas de writeln y readln, solo si se usan (read_* vacía la salida
+    // con write_flush antes de leer)
+    if (usaEscritura || usaLectura) out << RUNTIME_ESCRITURA;
+    if (usaLectura)                 out << RUNTIME_LECTURA;
 
-    // Pool de constantes de punto flotante (float 32 bits)
+    // Pool de constantes de punto flotante (float 32 bits): sólo lectura,
+    // alineadas a 4 y escritas en hexadecimal (el patrón exacto, sin pasar
+    // por una conversión decimal)
     if (!poolFloats.empty()) {
         out << "\n# Constantes de punto flotante (float 32 bits)\n";
-        for (size_t i = 0; i < poolFloats.size(); ++i) {
-            out << "._CF" << i << ": .float " << poolFloats[i] << "\n";
+        out << ".section .rodata\n";
+        out << ".p2align 2\n";
+        char hexa[16];
+        for (uint32_t bits : poolFloats) {
+            snprintf(hexa, sizeof hexa, "0x%08x", bits);
+            out << etiquetaFloat(bits) << ": .long " << hexa << "\n";
+        }
+    }
+    if (!poolDoubles.empty()) {
+        out << "\n# Constantes de punto flotante (double 64 bits)\n";
+        out << ".section .rodata\n";
+        out << ".p2align 3\n";
+        char hexa[24];
+        for (uint64_t bits : poolDoubles) {
+            snprintf(hexa, sizeof hexa, "0x%016llx", (unsigned long long)bits);
+            out << etiquetaDouble(bits) << ": .quad " << hexa << "\n";
         }
     }
 
     out << ".section .note.GNU-stack,\"\",@progbits\n";
-    return 0;
 }
 
 int GenCodeVisitor::visit(TypeAlias* tdef) {
@@ -396,36 +899,201 @@ int GenCodeVisitor::visit(TypeAlias* tdef) {
     return 0;
 }
 
-string GenCodeVisitor::addFloatConst(double v) {
-    for (size_t i = 0; i < poolFloats.size(); ++i) {
-        if (poolFloats[i] == v) {
-            return "._CF" + to_string(i);
+void GenCodeVisitor::generarFunciones(Program* program) {
+    for (auto dec : program->fdlist) {
+        if (dec) visit(dec);
+    }
+}
+
+// Cada hilo (del pool, o el actual si no hay pool) tiene su propio
+// GenCodeVisitor (copia de las tablas globales) que escribe en su buffer; el
+// texto y el pool de floats de cada función quedan en FunDec::codigo y se
+// unen después en orden fuente. Las funciones traídas de la caché no se
+// regeneran.
+void GenCodeVisitor::generarFuncionesEnBuffers(Program* program) {
+    vector<FunDec*> funs(program->fdlist.begin(), program->fdlist.end());
+    size_t n = funs.size();
+
+    struct Trabajador {
+        ostringstream  buf;
+        GenCodeVisitor gen;
+        Trabajador() : gen(buf) {}
+    };
+    vector<unique_ptr<Trabajador>> trabajadores(hilos ? hilos->tamano() : 1);
+    for (auto& t : trabajadores) {
+        t.reset(new Trabajador());
+        t->gen.simbolos      = simbolos;
+        t->gen.aliasMap      = aliasMap;
+        t->gen.simd          = simd;
+    }
+
+    vector<string> avisosF(n);
+
+    paraCada(hilos, n, [&](size_t i, int hilo) {
+        FunDec* fd = funs[i];
+        if (!fd || (fd->codigo && fd->codigo->deCache)) return;
+
+        Trabajador& t = *trabajadores[hilo];
+        ostringstream av;
+        t.gen.avisos = &av;
+        t.gen.poolFloats.clear();
+        t.gen.enPool.clear();
+        t.gen.poolDoubles.clear();
+        t.gen.enPoolDoubles.clear();
+        t.gen.usaEscritura = false;
+        t.gen.usaLectura   = false;
+        t.gen.visit(fd);
+
+        if (!fd->codigo) fd->codigo = new CodigoFuncion();
+        fd->codigo->texto = t.buf.str();
+        fd->codigo->floats.swap(t.gen.poolFloats);
+        fd->codigo->doubles.swap(t.gen.poolDoubles);
+        fd->codigo->usaEscritura = t.gen.usaEscritura;
+        fd->codigo->usaLectura   = t.gen.usaLectura;
+        avisosF[i] = av.str();
+        t.buf.str("");
+    });
+
+    // Unión determinista: texto y constantes en el orden de las funciones
+    for (size_t i = 0; i < n; ++i) {
+        if (!funs[i] || !funs[i]->codigo) continue;
+        out << funs[i]->codigo->texto;
+        *avisos << avisosF[i];
+        for (uint32_t bits : funs[i]->codigo->floats)  addFloatConst(bits);
+        for (uint64_t bits : funs[i]->codigo->doubles) addDoubleConst(bits);
+        usaEscritura |= funs[i]->codigo->usaEscritura;
+        usaLectura   |= funs[i]->codigo->usaLectura;
+
+        // Sin caché no hace falta conservar el texto
+        if (!capturarFunciones) {
+            delete funs[i]->codigo;
+            funs[i]->codigo = nullptr;
         }
     }
-    poolFloats.push_back(v);
-    return "._CF" + to_string(poolFloats.size() - 1);
+}
+
+static uint32_t bitsFloat(double v) {
+    float f = (float)v;
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof bits);
+    return bits;
+}
+
+static uint64_t bitsDouble(double v) {
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof bits);
+    return bits;
+}
+
+string GenCodeVisitor::etiquetaFloat(uint32_t bits) {
+    char buf[16];
+    snprintf(buf, sizeof buf, "._CF%08x", bits);
+    return buf;
+}
+
+string GenCodeVisitor::addFloatConst(uint32_t bits) {
+    if (enPool.insert(bits).second) poolFloats.push_back(bits);
+    return etiquetaFloat(bits);
+}
+
+string GenCodeVisitor::etiquetaDouble(uint64_t bits) {
+    char buf[24];
+    snprintf(buf, sizeof buf, "._CD%016llx", (unsigned long long)bits);
+    return buf;
+}
+
+string GenCodeVisitor::addDoubleConst(uint64_t bits) {
+    if (enPoolDoubles.insert(bits).second) poolDoubles.push_back(bits);
+    return etiquetaDouble(bits);
 }
 
 int GenCodeVisitor::visit(VarDec* vd) {
     if (!vd) return 0;
 
-    Tipo tt = mapStr(vd->type);
+    Variable v;
+    v.tipo    = mapStr(vd->type);
+    v.arreglo = vd->arreglo;
+    v.lo      = vd->lo;
+    v.hi      = vd->hi;
 
     for (auto& var : vd->vars) {
         if (!entornoFuncion) {
             // ---- variable global ----
-            memoriaGlobal[var] = true;
-            tipoGlobal[var]    = tt;
+            v.global = true;
+        } else if (vd->arreglo) {
+            // ---- arreglo local: elementos contiguos, alineado a 8 ----
+            offset = (offset - tamVariable(vd)) & ~7;
+            v.offset = offset;
         } else {
             // ---- variable local en función ----
             // long -> 8 bytes, todo lo demás (int, unsigned, float, bool) -> 4 bytes
-            int tam = es64Entero(tt) ? 8 : 4;
-
-            offset -= tam;
-            memoria[var]   = offset;
-            tipoLocal[var] = tt;
+            offset -= tamVariable(vd);
+            v.offset = offset;
         }
+        simbolos.declarar(var, v);
+    }
+    return 0;
+}
+
+// Bytes de cada variable de vd
+long long GenCodeVisitor::tamVariable(const VarDec* vd) const {
+    long long elemento = tamTipo(mapStr(vd->type));
+    if (!vd->arreglo) return elemento;
+    return elemento * (vd->hi - vd->lo + 1);
+}
+
+// Evalúa el índice de v[indice] y lo deja en %rax como entero de 64 bits.
+// Con 'verificar', además le resta lo y salta a la rutina de error de la
+// función si queda fuera de [0, hi - lo] (una sola comparación sin signo).
+void GenCodeVisitor::indiceEnRax(const Variable& v, Exp* indice, bool verificar) {
+    visitar(this, indice);
+    if (indice->tipoDato == T_INT || indice->tipoDato == T_BOOL)
+        out << " movslq %eax, %rax\n";
+
+    if (verificar) {
+        if (v.lo != 0) out << " subq $" << v.lo << ", %rax\n";
+        out << " cmpq $" << (v.hi - v.lo) << ", %rax\n";
+        out << " ja .rango_" << nombreFuncion << "\n";
+        saltaARango = true;
+    }
+}
+
+// Operando del elemento de v cuyo índice está en regIndice; 'verificado'
+// indica que ya se le restó lo (si no, se descuenta en el desplazamiento).
+// En un global deja la dirección base en %rdx.
+string GenCodeVisitor::elemento(const Variable& v, const string& nombre,
+                                const char* regIndice, bool verificado) {
+    int escala = tamTipo(v.tipo);
+    long long desp = verificado ? 0 : -v.lo * escala;
+
+    std::ostringstream op;
+    if (v.global) {
+        out << " leaq " << nombre << "(%rip), %rdx\n";
+        if (desp != 0) op << desp;
+        op << "(%rdx," << regIndice << "," << escala << ")";
+    } else {
+        op << (v.offset + desp) << "(%rbp," << regIndice << "," << escala << ")";
+    }
+    return op.str();
+}
+
+int GenCodeVisitor::visit(IndexExp* e) {
+    if (!e || !e->indice) return 0;
+
+    const Variable* var = simbolos.buscar(e->nombre);
+    if (!var || !var->arreglo) {
+        *avisos << "[GenCodeVisitor] Error: '" << e->nombre << "' no es un arreglo (en '"
+                << nombreFuncion << "').\n";
+        return 0;
     }
+    Variable v = *var;
+
+    indiceEnRax(v, e->indice, e->verificar);
+    string op = elemento(v, e->nombre, "%rax", e->verificar);
+
+    if (esFlotante(v.tipo))      out << " mov" << sse(v.tipo) << " " << op << ", %xmm0\n";
+    else if (es64Entero(v.tipo)) out << " movq "  << op << ", %rax\n";
+    else                         out << " movl "  << op << ", %eax\n";
     return 0;
 }
 
@@ -433,11 +1101,23 @@ int GenCodeVisitor::visit(VarDec* vd) {
 int GenCodeVisitor::visit(NumberExp* exp) {
     if (!exp) return 0;
 
-    if (exp->isFloat || exp->tipoDato == T_FLOAT) {
-        // Cargar constante float (32 bits) en %xmm0
-        std::string lbl = addFloatConst(exp->isFloat ? exp->fvalue
-                                                     : (double)exp->ivalue);
-        out << " movss " << lbl << "(%rip), %xmm0\n";
+    if (exp->tipoDato == T_DOUBLE) {
+        // Constante double (64 bits), con el valor exacto del literal
+        uint64_t bits = bitsDouble(exp->isFloat ? exp->fvalue
+                                                : (double)exp->ivalue);
+        if (bits == 0)
+            out << " xorpd %xmm0, %xmm0\n";
+        else
+            out << " movsd " << addDoubleConst(bits) << "(%rip), %xmm0\n";
+    } else if (exp->isFloat || exp->tipoDato == T_FLOAT) {
+        // Cargar constante float (32 bits) en %xmm0; +0.0 no necesita
+        // memoria
+        uint32_t bits = bitsFloat(exp->isFloat ? exp->fvalue
+                                               : (double)exp->ivalue);
+        if (bits == 0)
+            out << " xorps %xmm0, %xmm0\n";
+        else
+            out << " movss " << addFloatConst(bits) << "(%rip), %xmm0\n";
     } else {
         // enteros
         if (es64Entero(exp->tipoDato)) {
@@ -453,30 +1133,41 @@ int GenCodeVisitor::visit(NumberExp* exp) {
 int GenCodeVisitor::visit(IdExp* exp) {
     if (!exp) return 0;
 
-    bool esGlobalVar = memoriaGlobal.count(exp->value);
-    Tipo t = T_INT;
-
-    if (tipoLocal.count(exp->value))       t = tipoLocal[exp->value];
-    else if (tipoGlobal.count(exp->value)) t = tipoGlobal[exp->value];
+    const Variable* var = simbolos.buscar(exp->value);
+    bool esGlobalVar = var && var->global;
+    Tipo t   = var ? var->tipo : T_INT;
+    int  off = var ? var->offset : 0;
 
-    if (esFlotante(t)) {
-        // float 32 bits
+    if (var && var->registro >= 0) {
+        // contador de un for en registro
+        if (es64Entero(t))
+            out << " movq " << REG_FOR_64[var->registro] << ", %rax\n";
+        else
+            out << " movl " << REG_FOR_32[var->registro] << ", %eax\n";
+    } else if (var && var->referencia) {
+        // parámetro var: se lee a través de su dirección
+        out << " movq " << off << "(%rbp), %rdx\n";
+        if (esFlotante(t))      out << " mov" << sse(t) << " (%rdx), %xmm0\n";
+        else if (es64Entero(t)) out << " movq (%rdx), %rax\n";
+        else                    out << " movl (%rdx), %eax\n";
+    } else if (esFlotante(t)) {
+        // float 32 bits / double 64 bits
         if (esGlobalVar)
-            out << " movss " << exp->value << "(%rip), %xmm0\n";
+            out << " mov" << sse(t) << " " << exp->value << "(%rip), %xmm0\n";
         else
-            out << " movss " << memoria[exp->value] << "(%rbp), %xmm0\n";
+            out << " mov" << sse(t) << " " << off << "(%rbp), %xmm0\n";
     } else if (es64Entero(t)) {
         // long -> 64 bits
         if (esGlobalVar)
             out << " movq " << exp->value << "(%rip), %rax\n";
         else
-            out << " movq " << memoria[exp->value] << "(%rbp), %rax\n";
+            out << " movq " << off << "(%rbp), %rax\n";
     } else {
         // int / unsigned / bool -> 32 bits
         if (esGlobalVar)
             out << " movl " << exp->value << "(%rip), %eax\n";
         else
-            out << " movl " << memoria[exp->value] << "(%rbp), %eax\n";
+            out << " movl " << off << "(%rbp), %eax\n";
         // escribir en %eax pone en cero la parte alta de %rax
     }
 
@@ -486,67 +1177,86 @@ int GenCodeVisitor::visit(IdExp* exp) {
 int GenCodeVisitor::visit(BinaryExp* e) {
     if (!e || !e->left || !e->right) return 0;
 
-    // --------- CASO FLOAT (aritmético seguro en funciones) -------------
-    if (e->tipoDato == T_FLOAT && !TypeCheckVisitor::esRelOp(e->op)) {
+    // --------- CASO FLOAT / DOUBLE (aritmético seguro en funciones) -------------
+    if (esFlotante(e->tipoDato) && !TypeCheckVisitor::esRelOp(e->op)) {
+        const char* x = sse(e->tipoDato);   // ss (float) o sd (double)
 
-        // Evaluamos left → %xmm0
-        e->left->accept(this);
-        int temp1 = offset - 4;     // reservar local float (4 bytes)
-        out << " movss %xmm0, " << temp1 << "(%rbp)\n";
+        // Evaluamos left → %xmm0. El temporal se reserva antes de evaluar
+        // right, para que los temporales de right no lo pisen.
+        visitar(this, e->left);
+        offset -= tamTipo(e->tipoDato);   // reservar local (4 u 8 bytes)
+        int temp1 = offset;
+        out << " mov" << x << " %xmm0, " << temp1 << "(%rbp)\n";
 
         // Evaluamos right → %xmm0
-        e->right->accept(this);
-        int temp2 = temp1 - 4;      // otro local float
-        out << " movss %xmm0, " << temp2 << "(%rbp)\n";
+        visitar(this, e->right);
+        offset -= tamTipo(e->tipoDato);   // otro local
+        int temp2 = offset;
+        out << " mov" << x << " %xmm0, " << temp2 << "(%rbp)\n";
 
         // Recuperar valores
-        out << " movss " << temp1 << "(%rbp), %xmm1\n";
-        out << " movss " << temp2 << "(%rbp), %xmm0\n";
+        out << " mov" << x << " " << temp1 << "(%rbp), %xmm1\n";
+        out << " mov" << x << " " << temp2 << "(%rbp), %xmm0\n";
 
         // Operación
         switch (e->op) {
             case PLUS_OP:
-                out << " addss %xmm0, %xmm1\n";
-                out << " movss %xmm1, %xmm0\n";
+                out << " add" << x << " %xmm0, %xmm1\n";
+                out << " mov" << x << " %xmm1, %xmm0\n";
                 break;
             case MINUS_OP:
-                out << " subss %xmm0, %xmm1\n";
-                out << " movss %xmm1, %xmm0\n";
+                out << " sub" << x << " %xmm0, %xmm1\n";
+                out << " mov" << x << " %xmm1, %xmm0\n";
                 break;
             case MUL_OP:
-                out << " mulss %xmm0, %xmm1\n";
-                out << " movss %xmm1, %xmm0\n";
+                out << " mul" << x << " %xmm0, %xmm1\n";
+                out << " mov" << x << " %xmm1, %xmm0\n";
                 break;
             case DIV_OP:
-                out << " divss %xmm0, %xmm1\n";
-                out << " movss %xmm1, %xmm0\n";
+                out << " div" << x << " %xmm0, %xmm1\n";
+                out << " mov" << x << " %xmm1, %xmm0\n";
                 break;
         }
-
-        offset = temp2;   // registrar consumo de locals temporales
         return 0;
     }
 
-    // --------- COMPARACIONES CON FLOAT -------------
-    if (e->left->tipoDato == T_FLOAT || e->right->tipoDato == T_FLOAT) {
-        e->left->accept(this);
+    // --------- COMPARACIONES CON FLOAT / DOUBLE -------------
+    // (los dos lados ya tienen el mismo tipo: ver unificarBin)
+    if (esFlotante(e->left->tipoDato) || esFlotante(e->right->tipoDato)) {
+        const char* x = sse(e->left->tipoDato);
+        visitar(this, e->left);
         out << " subq $8, %rsp\n";
-        out << " movss %xmm0, (%rsp)\n";
+        out << " mov" << x << " %xmm0, (%rsp)\n";
+        apilados += 8;
 
-        e->right->accept(this);
-        out << " movss (%rsp), %xmm1\n";
+        visitar(this, e->right);
+        out << " mov" << x << " (%rsp), %xmm1\n";
         out << " addq $8, %rsp\n";
+        apilados -= 8;
 
-        out << " ucomiss %xmm0, %xmm1\n";
+        // Con un NaN (no ordenados) ucomis deja CF = ZF = PF = 1 y todas las
+        // comparaciones son falsas salvo <>: a < b se evalúa como b > a
+        // (seta exige CF = ZF = 0) y = / <> miran también PF
+        bool invertir = e->op == LT_OP || e->op == LE_OP;
+        if (invertir) out << " ucomi" << x << " %xmm1, %xmm0\n";
+        else          out << " ucomi" << x << " %xmm0, %xmm1\n";
 
         out << " movl $0, %eax\n";
         switch (e->op) {
-            case LT_OP:  out << " setb %al\n";  break;
-            case LE_OP:  out << " setbe %al\n"; break;
+            case LT_OP:
             case GT_OP:  out << " seta %al\n";  break;
+            case LE_OP:
             case GE_OP:  out << " setae %al\n"; break;
-            case EQ_OP:  out << " sete %al\n";  break;
-            case NEQ_OP: out << " setne %al\n"; break;
+            case EQ_OP:
+                out << " sete %al\n";
+                out << " setnp %cl\n";
+                out << " andb %cl, %al\n";
+                break;
+            case NEQ_OP:
+                out << " setne %al\n";
+                out << " setp %cl\n";
+                out << " orb %cl, %al\n";
+                break;
             default:     break;
         }
         out << " movzbq %al, %rax\n";   // resultado 0/1 en %rax
@@ -558,10 +1268,12 @@ int GenCodeVisitor::visit(BinaryExp* e) {
                    e->right->tipoDato == T_LONG);
 
     // Evaluar left
-    e->left->accept(this);
+    visitar(this, e->left);
     out << " pushq %rax\n";
+    apilados += 8;
     // Evaluar right
-    e->right->accept(this);
+    visitar(this, e->right);
+    apilados -= 8;   // el popq de cada caso
 
     if (esLong) {
         // ======= 64 BITS: long =======
@@ -672,59 +1384,140 @@ int GenCodeVisitor::visit(AssignStm* s) {
         // Evaluamos la expresión; deja el resultado en:
         // - %rax / %eax para enteros / long / unsigned
         // - %xmm0 para float
-        s->e->accept(this);
+        visitar(this, s->e);
         // No almacenamos en memoria: al hacer 'ret' ese será el valor de retorno.
         return 0;
     }
 
-    // Asignación normal a variable
-    s->e->accept(this);  // resultado en %rax o %xmm0
-
-    bool esGlobalVar = memoriaGlobal.count(s->id);
-    Tipo t = T_INT;
+    // Elemento de arreglo: índice (ya verificado) a la pila, valor, y store
+    if (s->indice) {
+        const Variable* var = simbolos.buscar(s->id);
+        if (!var || !var->arreglo) {
+            *avisos << "[GenCodeVisitor] Error: '" << s->id << "' no es un arreglo (en '"
+                    << nombreFuncion << "').\n";
+            return 0;
+        }
+        Variable v = *var;
+
+        indiceEnRax(v, s->indice, s->verificar);
+        out << " pushq %rax\n";
+        apilados += 8;
+        visitar(this, s->e);
+        out << " popq %rcx\n";
+        apilados -= 8;
+        guardarEn(v.tipo, elemento(v, s->id, "%rcx", s->verificar));
+        return 0;
+    }
 
-    if (tipoLocal.count(s->id))       t = tipoLocal[s->id];
-    else if (tipoGlobal.count(s->id)) t = tipoGlobal[s->id];
+    // Asignación normal a variable
+    visitar(this, s->e);  // resultado en %rax o %xmm0
+    guardarVariable(s->id);
+    return 0;
+}
 
-    if (esFlotante(t)) {
-        if (esGlobalVar)
-            out << " movss %xmm0, " << s->id << "(%rip)\n";
-        else
-            out << " movss %xmm0, " << memoria[s->id] << "(%rbp)\n";
+// Guarda el resultado (%xmm0, %rax o %eax según t) en el operando 'op'
+void GenCodeVisitor::guardarEn(Tipo t, const string& op) {
+    if (esFlotante(t))      out << " mov" << sse(t) << " %xmm0, " << op << "\n";
+    else if (es64Entero(t)) out << " movq %rax, "   << op << "\n";
+    else                    out << " movl %eax, "   << op << "\n";
+}
 
-    } else if (es64Entero(t)) {
-        if (esGlobalVar)
-            out << " movq %rax, " << s->id << "(%rip)\n";
-        else
-            out << " movq %rax, " << memoria[s->id] << "(%rbp)\n";
+// Guarda el resultado en la variable escalar 'id': su registro (contador de
+// un for), la dirección de un parámetro var, su etiqueta global o su lugar
+// en el frame
+void GenCodeVisitor::guardarVariable(const string& id) {
+    const Variable* var = simbolos.buscar(id);
+    Tipo t = var ? var->tipo : T_INT;
+
+    if (var && var->registro >= 0) {
+        guardarEn(t, es64Entero(t) ? REG_FOR_64[var->registro] : REG_FOR_32[var->registro]);
+    } else if (var && var->referencia) {
+        out << " movq " << var->offset << "(%rbp), %rdx\n";
+        guardarEn(t, "(%rdx)");
+    } else if (var && var->global)
+        guardarEn(t, id + "(%rip)");
+    else
+        guardarEn(t, std::to_string(var ? var->offset : 0) + "(%rbp)");
+}
 
-    } else {
-        if (esGlobalVar)
-            out << " movl %eax, " << s->id << "(%rip)\n";
-        else
-            out << " movl %eax, " << memoria[s->id] << "(%rbp)\n";
+// readln(v1, ..., vn): cada destino recibe lo que devuelve la rutina de
+// lectura de su tipo (ver runtime.h), guardado como en una asignación; al
+// final se descarta el resto de la línea
+void GenCodeVisitor::leer(FcallExp* f) {
+    for (Exp* a : f->argumentos) {
+        string nombre;
+        IndexExp* x = nullptr;
+        if (a && a->clase == EXP_ID) {
+            nombre = static_cast<IdExp*>(a)->value;
+        } else if (a && a->clase == EXP_INDICE) {
+            x = static_cast<IndexExp*>(a);
+            nombre = x->nombre;
+        }
+        const Variable* var = nombre.empty() ? nullptr : simbolos.buscar(nombre);
+        if (!var || var->arreglo != (x != nullptr)) {
+            *avisos << "[GenCodeVisitor] Error: readln en '" << nombreFuncion
+                    << "' solo admite variables y elementos de arreglo.\n";
+            continue;
+        }
+        Variable v = *var;
+
+        const char* rutina = v.tipo == T_DOUBLE     ? "read_f64"
+                           : v.tipo == T_FLOAT      ? "read_f32"
+                           : es64Entero(v.tipo)     ? "read_i64"
+                           : v.tipo == T_UNSIGNED   ? "read_u32"
+                           :                          "read_i32";
+        if (x) {
+            indiceEnRax(v, x->indice, x->verificar);
+            out << " pushq %rax\n";
+            apilados += 8;
+            llamar(rutina);
+            out << " popq %rcx\n";
+            apilados -= 8;
+            guardarEn(v.tipo, elemento(v, nombre, "%rcx", x->verificar));
+        } else {
+            llamar(rutina);
+            guardarVariable(nombre);
+        }
     }
+    llamar("read_ln");
+}
 
-    return 0;
+// call con %rsp alineado a 16 bytes (System V) aunque haya temporales
+// apilados en la expresión que se está evaluando
+void GenCodeVisitor::llamar(const string& destino) {
+    if (destino.rfind("write_", 0) == 0)     usaEscritura = true;
+    else if (destino.rfind("read_", 0) == 0) usaLectura   = true;
+    bool relleno = apilados % 16 != 0;
+    if (relleno) out << " subq $8, %rsp\n";
+    out << " call " << destino << "\n";
+    if (relleno) out << " addq $8, %rsp\n";
 }
 
 int GenCodeVisitor::visit(PrintStm* stm) {
     if (!stm || !stm->e) return 0;
 
-    stm->e->accept(this);
-
-    if (stm->e->tipoDato == T_FLOAT) {
-        // Tenemos float en %xmm0 -> convertir a double en %xmm0 para printf("%f")
-        out << " cvtss2sd %xmm0, %xmm0\n";
-        out << " leaq printf_fmt_float(%rip), %rdi\n";
-        out << " movl $1, %eax\n";
-        out << " call printf@PLT\n";
-    } else {
-        // int / long / unsigned -> valor en %rax
-        out << " movq %rax, %rsi\n";
-        out << " leaq print_fmt(%rip), %rdi\n";
-        out << " movl $0, %eax\n";
-        out << " call printf@PLT\n";
+    visitar(this, stm->e);
+
+    // La rutina del runtime según el tipo (ver runtime.h)
+    switch (stm->e->tipoDato) {
+        case T_FLOAT:
+            llamar("write_f32");          // valor en %xmm0
+            break;
+        case T_DOUBLE:
+            llamar("write_f64");
+            break;
+        case T_LONG:
+            out << " movq %rax, %rdi\n";
+            llamar("write_i64");
+            break;
+        case T_UNSIGNED:
+            out << " movl %eax, %edi\n";
+            llamar("write_u32");
+            break;
+        default:
+            out << " movl %eax, %edi\n";
+            llamar("write_i32");
+            break;
     }
     return 0;
 }
@@ -732,36 +1525,67 @@ int GenCodeVisitor::visit(PrintStm* stm) {
 int GenCodeVisitor::visit(CastExp* e) {
     if (!e || !e->expr) return 0;
 
-    e->expr->accept(this);
+    visitar(this, e->expr);
     Tipo src = e->expr->tipoDato;
     Tipo dst = e->destino;
 
     if (src == dst) return 0;
 
-    // entero/long/unsigned -> float
-    if (dst == T_FLOAT && (src == T_INT || src == T_LONG || src == T_UNSIGNED)) {
-        out << " cvtsi2ss %rax, %xmm0\n";
+    // entero/long/unsigned -> float / double
+    if (esFlotante(dst) && (src == T_INT || src == T_LONG || src == T_UNSIGNED)) {
+        // int es de 32 bits con signo; unsigned ya está extendido con ceros
+        if (src == T_INT) out << " cvtsi2" << sse(dst) << "l %eax, %xmm0\n";
+        else              out << " cvtsi2" << sse(dst) << " %rax, %xmm0\n";
+        return 0;
+    }
+
+    // float <-> double
+    if (src == T_FLOAT && dst == T_DOUBLE) {
+        out << " cvtss2sd %xmm0, %xmm0\n";
+        return 0;
+    }
+    if (src == T_DOUBLE && dst == T_FLOAT) {
+        out << " cvtsd2ss %xmm0, %xmm0\n";
         return 0;
     }
 
-    // float -> entero (int/long/unsigned)
-    if ((dst == T_INT || dst == T_LONG || dst == T_UNSIGNED) && src == T_FLOAT) {
-        out << " cvttss2si %xmm0, %rax\n";
+    // float / double -> entero (int/long/unsigned)
+    if ((dst == T_INT || dst == T_LONG || dst == T_UNSIGNED) && esFlotante(src)) {
+        out << " cvtt" << sse(src) << "2si %xmm0, %rax\n";
         return 0;
     }
 
-    // int <-> long no necesitan instrucción extra: ya están en %rax
+    // int -> long extiende el signo; lo demás ya está en %rax
+    if (src == T_INT && dst == T_LONG) out << " movslq %eax, %rax\n";
     return 0;
 }
 
+// Bloque anidado (el cuerpo de la función lo recorre visit(FunDec)). Si
+// declara variables, abre un ámbito y las ubica en la zona de bloques del
+// frame, que se libera al salir.
 int GenCodeVisitor::visit(Body* b) {
     if (!b) return 0;
 
-    for (auto dec : b->declarations) {
-        if (dec) dec->accept(this);
+    bool ambito = !b->declarations.empty();
+    int  inicioBloque = offsetBloque;
+    if (ambito) {
+        simbolos.abrir();
+        int temporales = offset;
+        offset = offsetBloque;
+        for (auto dec : b->declarations) {
+            if (dec) visit(dec);
+        }
+        offsetBloque = offset;
+        offset = temporales;
     }
+
     for (auto s : b->StmList) {
-        if (s) s->accept(this);
+        if (s) visitar(this, s);
+    }
+
+    if (ambito) {
+        simbolos.cerrar();
+        offsetBloque = inicioBloque;
     }
     return 0;
 }
@@ -771,17 +1595,17 @@ int GenCodeVisitor::visit(IfStm* stm) {
 
     int label = labelcont++;
 
-    stm->condition->accept(this);
+    visitar(this, stm->condition);
     out << " cmpq $0, %rax\n";
-    out << " je else_" << label << "\n";
+    out << " je else_" << nombreFuncion << "_" << label << "\n";
 
-    if (stm->then) stm->then->accept(this);
-    out << " jmp endif_" << label << "\n";
+    if (stm->then) visit(stm->then);
+    out << " jmp endif_" << nombreFuncion << "_" << label << "\n";
 
-    out << "else_" << label << ":\n";
-    if (stm->els) stm->els->accept(this);
+    out << "else_" << nombreFuncion << "_" << label << ":\n";
+    if (stm->els) visit(stm->els);
 
-    out << "endif_" << label << ":\n";
+    out << "endif_" << nombreFuncion << "_" << label << ":\n";
     return 0;
 }
 
@@ -790,22 +1614,607 @@ int GenCodeVisitor::visit(WhileStm* stm) {
 
     int label = labelcont++;
 
-    out << "while_" << label << ":\n";
-    stm->condition->accept(this);
+    out << "while_" << nombreFuncion << "_" << label << ":\n";
+    visitar(this, stm->condition);
     out << " cmpq $0, %rax\n";
-    out << " je endwhile_" << label << "\n";
+    out << " je endwhile_" << nombreFuncion << "_" << label << "\n";
 
     if (stm->b && !stm->b->StmList.empty())
-        stm->b->accept(this);
+        visit(stm->b);
 
-    out << " jmp while_" << label << "\n";
-    out << "endwhile_" << label << ":\n";
+    out << " jmp while_" << nombreFuncion << "_" << label << "\n";
+    out << "endwhile_" << nombreFuncion << "_" << label << ":\n";
+    return 0;
+}
+
+// =====================================================
+// Vectorización de for
+// =====================================================
+// Un for ascendente cuyo cuerpo es solo una lista de:
+//   a[i + c] := E                    (elemento a elemento)
+//   s := s + E1 + ... + En           (suma de enteros)
+//   if E < s then s := E             (mínimo; con '>' o 's < E', máximo)
+// con E hecha de elementos b[i + c'] del mismo tipo, + - * (y / en float) e
+// invariantes del lazo, se ejecuta de a W elementos (4 con SSE2, 8 con AVX2)
+// y las vueltas que sobran van al lazo escalar de siempre. Los elementos son
+// integer o float (4 bytes). Condiciones para que el resultado sea idéntico
+// al escalar:
+//   - un arreglo que se escribe solo se accede con el mismo desplazamiento c
+//     (sin dependencias entre vueltas; los arreglos no se solapan);
+//   - las variables reducidas no aparecen en ninguna otra parte del cuerpo;
+//   - la suma float no se vectoriza (reordenarla cambia el redondeo), ni
+//     el mínimo/máximo float: con empates entre -0.0 y +0.0 el if escalar
+//     se queda con el primero y minps/maxps, con el de su lane;
+//   - los invariantes no llaman funciones, no leen arreglos ni dividen
+//     enteros: se evalúan una sola vez, antes del lazo vectorial.
+// Los accesos con verificación de rango se comprueban una vez para el
+// primer y el último índice; si alguno queda fuera, todo el for va por el
+// lazo escalar, que aborta en la vuelta exacta.
+
+struct GenCodeVisitor::PlanVector {
+    enum Clase { ELEMENTO, SUMA, MINIMO, MAXIMO };
+
+    struct Sentencia {
+        Clase       clase;
+        Tipo        tipo;          // T_INT o T_FLOAT
+        string      destino;       // arreglo o variable reducida
+        long long   c = 0;         // ELEMENTO: desplazamiento del índice
+        Exp*        e = nullptr;
+        vector<Exp*> terminos;         // SUMA: se suman todos al acumulador
+        int         acumulador = -1;   // reducciones: %xmm8 + n
+    };
+
+    struct Acceso {
+        string    arreglo;
+        long long c;
+        bool      verificar;
+        bool      escritura;
+    };
+
+    string                    contador;
+    vector<Sentencia>         sentencias;
+    vector<Acceso>            accesos;
+    unordered_set<string>     reducidas;
+    vector<Exp*>              invariantes;     // en %xmm8 + n, antes que los acumuladores
+    unordered_map<Exp*, int>  regInvariante;
+    vector<string>            globales;        // arreglos globales, base en REG_BASE[n]
+    int                       registros = 0;   // %xmm8.. usados
+};
+
+// Bases de los arreglos globales dentro del lazo vectorial
+static const char* const REG_BASE[] = {"%r8", "%r9", "%r10", "%r11", "%rdi", "%rdx"};
+static const int         MAX_XMM    = 8;   // temporales %xmm0-7; fijos %xmm8-15
+
+const char* nombreSimd(ExtensionSimd s) {
+    switch (s) {
+        case SIMD_SSE2: return "sse2";
+        case SIMD_AVX2: return "avx2";
+        default:        return "no";
+    }
+}
+
+// i, i + c, c + i, i - c  ->  c
+static bool desplazamiento(Exp* e, const string& contador, long long& c) {
+    auto esContador = [&](Exp* x) {
+        return x->clase == EXP_ID && static_cast<IdExp*>(x)->value == contador;
+    };
+    auto constante = [](Exp* x, long long& v) {
+        if (x->clase != EXP_NUMERO || static_cast<NumberExp*>(x)->isFloat) return false;
+        v = static_cast<NumberExp*>(x)->ivalue;
+        return v > -(1LL << 20) && v < (1LL << 20);
+    };
+
+    if (esContador(e)) { c = 0; return true; }
+    if (e->clase != EXP_BINARIA) return false;
+    auto b = static_cast<BinaryExp*>(e);
+    if (b->op == PLUS_OP) {
+        if (esContador(b->left)  && constante(b->right, c)) return true;
+        if (esContador(b->right) && constante(b->left,  c)) return true;
+    } else if (b->op == MINUS_OP) {
+        if (esContador(b->left) && constante(b->right, c)) { c = -c; return true; }
+    }
+    return false;
+}
+
+// Misma forma y mismas hojas (sirve para 'if E < s then s := E')
+static bool iguales(Exp* a, Exp* b) {
+    if (a == b) return true;
+    if (!a || !b || a->clase != b->clase || a->tipoDato != b->tipoDato) return false;
+    switch (a->clase) {
+        case EXP_NUMERO: {
+            auto x = static_cast<NumberExp*>(a), y = static_cast<NumberExp*>(b);
+            return x->isFloat == y->isFloat &&
+                   (x->isFloat ? x->fvalue == y->fvalue : x->ivalue == y->ivalue);
+        }
+        case EXP_ID:
+            return static_cast<IdExp*>(a)->value == static_cast<IdExp*>(b)->value;
+        case EXP_BINARIA: {
+            auto x = static_cast<BinaryExp*>(a), y = static_cast<BinaryExp*>(b);
+            return x->op == y->op && iguales(x->left, y->left) && iguales(x->right, y->right);
+        }
+        case EXP_CAST: {
+            auto x = static_cast<CastExp*>(a), y = static_cast<CastExp*>(b);
+            return x->destino == y->destino && iguales(x->expr, y->expr);
+        }
+        case EXP_INDICE: {
+            auto x = static_cast<IndexExp*>(a), y = static_cast<IndexExp*>(b);
+            return x->nombre == y->nombre && iguales(x->indice, y->indice);
+        }
+        default:
+            return false;
+    }
+}
+
+// ¿e se puede evaluar una sola vez antes del lazo?
+bool GenCodeVisitor::invariante(Exp* e, PlanVector& p) {
+    switch (e->clase) {
+        case EXP_NUMERO:
+            return true;
+        case EXP_ID: {
+            const string& id = static_cast<IdExp*>(e)->value;
+            const Variable* v = simbolos.buscar(id);
+            return v && !v->arreglo && !v->referencia && id != p.contador && !p.reducidas.count(id);
+        }
+        case EXP_CAST:
+            return invariante(static_cast<CastExp*>(e)->expr, p);
+        case EXP_BINARIA: {
+            auto b = static_cast<BinaryExp*>(e);
+            if (b->op == POW_OP) return false;
+            if ((b->op == DIV_OP || b->op == MOD_OP) && !esFlotante(b->tipoDato)) return false;
+            return invariante(b->left, p) && invariante(b->right, p);
+        }
+        default:
+            return false;   // llamadas y elementos de arreglo
+    }
+}
+
+// ¿e se puede calcular de a W elementos de tipo t? 'altura': registros
+// temporales que necesita.
+bool GenCodeVisitor::planVectorial(Exp* e, Tipo t, PlanVector& p, int& altura) {
+    if (e->tipoDato != t) return false;
+    altura = 1;
+
+    if (invariante(e, p)) {
+        if (!p.regInvariante.count(e)) {
+            p.regInvariante[e] = (int)p.invariantes.size();
+            p.invariantes.push_back(e);
+        }
+        return true;
+    }
+
+    if (e->clase == EXP_INDICE) {
+        auto x = static_cast<IndexExp*>(e);
+        const Variable* v = simbolos.buscar(x->nombre);
+        long long c;
+        if (!v || !v->arreglo || v->tipo != t || !desplazamiento(x->indice, p.contador, c))
+            return false;
+        p.accesos.push_back({x->nombre, c, x->verificar, false});
+        return true;
+    }
+
+    if (e->clase != EXP_BINARIA) return false;
+    auto b = static_cast<BinaryExp*>(e);
+    switch (b->op) {
+        case PLUS_OP: case MINUS_OP: break;
+        case MUL_OP:  if (t == T_INT && simd != SIMD_AVX2) return false; break;  // pmulld: SSE4.1
+        case DIV_OP:  if (t != T_FLOAT) return false; break;
+        default:      return false;
+    }
+    int hl, hr;
+    if (!planVectorial(b->left, t, p, hl) || !planVectorial(b->right, t, p, hr)) return false;
+    altura = max(hl, hr + 1);
+    return true;
+}
+
+bool GenCodeVisitor::planificarVector(ForStm* stm, PlanVector& p) {
+    if (simd == SIMD_NINGUNA || stm->descendente || !stm->b) return false;
+    if (!stm->b->declarations.empty() || stm->b->StmList.empty()) return false;
+    p.contador = stm->id;
+
+    // Variable reducida: escalar entera o float fuera de registro (un
+    // parámetro var podría ser a la vez un invariante con otro nombre)
+    auto escalar = [&](const string& id, Tipo& t) {
+        const Variable* v = simbolos.buscar(id);
+        if (!v || v->arreglo || v->registro >= 0 || v->referencia || id == p.contador) return false;
+        t = v->tipo;
+        return t == T_INT || t == T_FLOAT;
+    };
+    auto esId = [](Exp* e, const string& id) {
+        return e->clase == EXP_ID && static_cast<IdExp*>(e)->value == id;
+    };
+
+    // 1) Forma de cada sentencia
+    for (auto s : stm->b->StmList) {
+        if (!s) return false;
+        PlanVector::Sentencia st;
+
+        if (s->clase == STM_ASIGNACION) {
+            auto a = static_cast<AssignStm*>(s);
+            if (a->indice) {
+                const Variable* v = simbolos.buscar(a->id);
+                if (!v || !v->arreglo || (v->tipo != T_INT && v->tipo != T_FLOAT)) return false;
+                if (!desplazamiento(a->indice, p.contador, st.c)) return false;
+                st.clase = PlanVector::ELEMENTO;
+                st.tipo  = v->tipo;
+                st.e     = a->e;
+                p.accesos.push_back({a->id, st.c, a->verificar, true});
+            } else {
+                // s := s + E1 + ... + En  /  s := E + s  (la suma entera es
+                // asociativa aun con desborde: los términos van por separado)
+                if (!escalar(a->id, st.tipo) || st.tipo != T_INT) return false;
+                Exp* x = a->e;
+                while (true) {
+                    if (x->clase != EXP_BINARIA) return false;
+                    auto b = static_cast<BinaryExp*>(x);
+                    if (b->op != PLUS_OP) return false;
+                    if (esId(b->left, a->id))  { st.terminos.push_back(b->right); break; }
+                    if (esId(b->right, a->id)) { st.terminos.push_back(b->left);  break; }
+                    st.terminos.push_back(b->right);
+                    x = b->left;
+                }
+                st.clase = PlanVector::SUMA;
+            }
+            st.destino = a->id;
+        } else if (s->clase == STM_IF) {
+            // if E < s then s := E  (mínimo)  /  if E > s then s := E  (máximo)
+            auto i = static_cast<IfStm*>(s);
+            if (i->els && !i->els->StmList.empty()) return false;
+            if (!i->then || !i->then->declarations.empty() || i->then->StmList.size() != 1) return false;
+            Stm* t = i->then->StmList.front();
+            if (!t || t->clase != STM_ASIGNACION) return false;
+            auto a = static_cast<AssignStm*>(t);
+            if (a->indice || i->condition->clase != EXP_BINARIA) return false;
+            auto c = static_cast<BinaryExp*>(i->condition);
+            if (c->op != LT_OP && c->op != GT_OP) return false;
+
+            bool menor = c->op == LT_OP;
+            Exp* e;
+            if      (esId(c->right, a->id)) e = c->left;
+            else if (esId(c->left, a->id))  { e = c->right; menor = !menor; }
+            else return false;
+            if (!iguales(e, a->e)) return false;
+
+            if (!escalar(a->id, st.tipo) || st.tipo != T_INT) return false;
+            if (simd != SIMD_AVX2) return false;   // pminsd: SSE4.1
+            st.clase   = menor ? PlanVector::MINIMO : PlanVector::MAXIMO;
+            st.destino = a->id;
+            st.e       = a->e;
+        } else {
+            return false;
+        }
+
+        if (st.clase != PlanVector::ELEMENTO && !p.reducidas.insert(st.destino).second)
+            return false;
+        p.sentencias.push_back(st);
+    }
+
+    // 2) Expresiones (ya con todas las variables reducidas conocidas)
+    for (auto& st : p.sentencias) {
+        int altura;
+        if (st.clase == PlanVector::SUMA) {
+            for (Exp* t : st.terminos)
+                if (!planVectorial(t, T_INT, p, altura) || altura > MAX_XMM) return false;
+        } else if (!planVectorial(st.e, st.tipo, p, altura) || altura > MAX_XMM) {
+            return false;
+        }
+    }
+    p.registros = (int)p.invariantes.size();
+    for (auto& st : p.sentencias) {
+        if (st.clase != PlanVector::ELEMENTO) st.acumulador = p.registros++;
+    }
+    if (p.registros > MAX_XMM) return false;
+
+    // 3) Sin dependencias entre vueltas: cada arreglo escrito se accede
+    //    siempre con el mismo desplazamiento
+    unordered_map<string, long long> escritos;
+    for (auto& a : p.accesos) {
+        if (!a.escritura) continue;
+        auto it = escritos.find(a.arreglo);
+        if (it != escritos.end() && it->second != a.c) return false;
+        escritos[a.arreglo] = a.c;
+    }
+    for (auto& a : p.accesos) {
+        auto it = escritos.find(a.arreglo);
+        if (it != escritos.end() && it->second != a.c) return false;
+    }
+
+    // 4) Arreglos globales (base en registro) y desplazamientos representables
+    for (auto& a : p.accesos) {
+        const Variable* v = simbolos.buscar(a.arreglo);
+        if (v->lo < -(1LL << 28) || v->lo > (1LL << 28)) return false;
+        if (v->global && find(p.globales.begin(), p.globales.end(), a.arreglo) == p.globales.end())
+            p.globales.push_back(a.arreglo);
+    }
+    return p.globales.size() <= sizeof REG_BASE / sizeof REG_BASE[0];
+}
+
+// Calcula e (de a W elementos) en el temporal k
+void GenCodeVisitor::vectorial(Exp* e, int k, PlanVector& p) {
+    bool avx    = simd == SIMD_AVX2;
+    const char* x = avx ? "%ymm" : "%xmm";
+    bool entero = e->tipoDato == T_INT;
+
+    auto inv = p.regInvariante.find(e);
+    if (inv != p.regInvariante.end()) {
+        out << " " << (avx ? "v" : "") << (entero ? "movdqa " : "movaps ")
+            << x << 8 + inv->second << ", " << x << k << "\n";
+        return;
+    }
+
+    if (e->clase == EXP_INDICE) {
+        auto ix = static_cast<IndexExp*>(e);
+        long long c = 0;
+        desplazamiento(ix->indice, p.contador, c);
+        const Variable* v = simbolos.buscar(ix->nombre);
+        long long desp = (c - v->lo) * 4;
+        out << " " << (avx ? "v" : "") << (entero ? "movdqu " : "movups ");
+        if (v->global) {
+            size_t b = find(p.globales.begin(), p.globales.end(), ix->nombre) - p.globales.begin();
+            out << desp << "(" << REG_BASE[b] << ",%rcx,4)";
+        } else {
+            out << v->offset + desp << "(%rbp,%rcx,4)";
+        }
+        out << ", " << x << k << "\n";
+        return;
+    }
+
+    auto b = static_cast<BinaryExp*>(e);
+    const char* op = "";
+    switch (b->op) {
+        case PLUS_OP:  op = entero ? "paddd"  : "addps"; break;
+        case MINUS_OP: op = entero ? "psubd"  : "subps"; break;
+        case MUL_OP:   op = entero ? "pmulld" : "mulps"; break;
+        default:       op = "divps"; break;
+    }
+
+    vectorial(b->left, k, p);
+    string derecho;
+    auto invDer = p.regInvariante.find(b->right);
+    if (invDer != p.regInvariante.end()) {
+        derecho = x + std::to_string(8 + invDer->second);
+    } else {
+        vectorial(b->right, k + 1, p);
+        derecho = x + std::to_string(k + 1);
+    }
+    if (avx) out << " v" << op << " " << derecho << ", " << x << k << ", " << x << k << "\n";
+    else     out << " "  << op << " " << derecho << ", " << x << k << "\n";
+}
+
+// Lazo vectorial antes del escalar. Al entrar: %rcx = inicio (64 bits) y
+// %rax = vueltas (> 0), ya guardados en 'contador' y 'vueltas'. Al salir deja
+// en ellos lo que falta para el lazo escalar, o salta a 'salida' si no
+// falta nada.
+void GenCodeVisitor::generarVector(ForStm* stm, PlanVector& p, const string& contador,
+                                   const string& vueltas, const string& lazo,
+                                   const string& salida) {
+    bool avx = simd == SIMD_AVX2;
+    int  ancho = avx ? 8 : 4;
+    const char* x = avx ? "%ymm" : "%xmm";
+    const char* v = avx ? "v" : "";
+    bool largo = es64Entero(simbolos.buscar(stm->id)->tipo);
+    string vec = "vfor_" + nombreFuncion + "_" + std::to_string(labelcont++);
+
+    out << " cmpq $" << ancho << ", %rax\n";
+    out << " jl " << lazo << "\n";
+
+    // Rango de los accesos verificados: primer y último índice
+    std::set<pair<string, long long>> comprobados;
+    for (auto& a : p.accesos) {
+        if (!a.verificar || !comprobados.insert({a.arreglo, a.c}).second) continue;
+        const Variable* arr = simbolos.buscar(a.arreglo);
+        out << " leaq " << a.c - arr->lo << "(%rcx), %rdx\n";
+        out << " cmpq $" << arr->hi - arr->lo << ", %rdx\n";
+        out << " ja " << lazo << "\n";
+        out << " leaq " << a.c - arr->lo - 1 << "(%rcx,%rax), %rdx\n";
+        out << " cmpq $" << arr->hi - arr->lo << ", %rdx\n";
+        out << " ja " << lazo << "\n";
+    }
+
+    // Invariantes y acumuladores, difundidos a todos los elementos
+    auto difundir = [&](Tipo t, int r) {
+        if (t == T_INT) {
+            out << " " << v << "movd %eax, %xmm" << r << "\n";
+            if (avx) out << " vpbroadcastd %xmm" << r << ", %ymm" << r << "\n";
+            else     out << " pshufd $0, %xmm" << r << ", %xmm" << r << "\n";
+        } else if (avx) {
+            out << " vbroadcastss %xmm0, %ymm" << r << "\n";
+        } else {
+            out << " movaps %xmm0, %xmm" << r << "\n";
+            out << " shufps $0, %xmm" << r << ", %xmm" << r << "\n";
+        }
+    };
+    auto escalar = [&](const string& id) {
+        const Variable* s = simbolos.buscar(id);
+        return s->global ? id + "(%rip)" : std::to_string(s->offset) + "(%rbp)";
+    };
+
+    for (size_t i = 0; i < p.invariantes.size(); ++i) {
+        visitar(this, p.invariantes[i]);
+        difundir(p.invariantes[i]->tipoDato, 8 + (int)i);
+    }
+    for (auto& st : p.sentencias) {
+        int r = 8 + st.acumulador;
+        if (st.clase == PlanVector::SUMA) {
+            if (avx) out << " vpxor %ymm" << r << ", %ymm" << r << ", %ymm" << r << "\n";
+            else     out << " pxor %xmm" << r << ", %xmm" << r << "\n";
+        } else if (st.clase != PlanVector::ELEMENTO) {
+            out << " movl " << escalar(st.destino) << ", %eax\n";
+            difundir(T_INT, r);
+        }
+    }
+    for (size_t i = 0; i < p.globales.size(); ++i)
+        out << " leaq " << p.globales[i] << "(%rip), " << REG_BASE[i] << "\n";
+
+    out << " mov" << (largo ? "q " : "slq ") << contador << ", %rcx\n";
+    out << " movq " << vueltas << ", %rsi\n";
+    out << " shrq $" << (avx ? 3 : 2) << ", %rsi\n";
+
+    out << vec << ":\n";
+    for (auto& st : p.sentencias) {
+        int r = 8 + st.acumulador;
+        if (st.clase == PlanVector::SUMA) {
+            for (Exp* t : st.terminos) {
+                vectorial(t, 0, p);
+                if (avx) out << " vpaddd %ymm0, %ymm" << r << ", %ymm" << r << "\n";
+                else     out << " paddd %xmm0, %xmm" << r << "\n";
+            }
+            continue;
+        }
+        vectorial(st.e, 0, p);
+        bool entero = st.tipo == T_INT;
+        switch (st.clase) {
+            case PlanVector::ELEMENTO: {
+                const Variable* arr = simbolos.buscar(st.destino);
+                long long desp = (st.c - arr->lo) * 4;
+                out << " " << v << (entero ? "movdqu " : "movups ") << x << "0, ";
+                if (arr->global) {
+                    size_t b = find(p.globales.begin(), p.globales.end(), st.destino) - p.globales.begin();
+                    out << desp << "(" << REG_BASE[b] << ",%rcx,4)\n";
+                } else {
+                    out << arr->offset + desp << "(%rbp,%rcx,4)\n";
+                }
+                break;
+            }
+            default: {
+                // solo enteros y con AVX2 (ver el plan)
+                const char* op = st.clase == PlanVector::MINIMO ? "pminsd" : "pmaxsd";
+                out << " v" << op << " %ymm" << r << ", %ymm0, %ymm" << r << "\n";
+                break;
+            }
+        }
+    }
+    out << " addq $" << ancho << ", %rcx\n";
+    out << " decq %rsi\n";
+    out << " jnz " << vec << "\n";
+
+    // Reducciones (todas enteras): combinar los elementos del acumulador en
+    // la variable
+    for (auto& st : p.sentencias) {
+        if (st.clase == PlanVector::ELEMENTO) continue;
+        int r = 8 + st.acumulador;
+        const char* op = st.clase == PlanVector::SUMA   ? "paddd"
+                       : st.clase == PlanVector::MINIMO ? "pminsd" : "pmaxsd";
+        auto combinar = [&](const char* mezcla) {
+            out << " " << v << "pshufd $" << mezcla << ", %xmm" << r << ", %xmm0\n";
+            if (avx) out << " v" << op << " %xmm0, %xmm" << r << ", %xmm" << r << "\n";
+            else     out << " " << op << " %xmm0, %xmm" << r << "\n";
+        };
+        if (avx) {
+            out << " vextracti128 $1, %ymm" << r << ", %xmm0\n";
+            out << " v" << op << " %xmm0, %xmm" << r << ", %xmm" << r << "\n";
+        }
+        combinar("0x4e");
+        combinar("0xb1");
+
+        out << " " << v << "movd %xmm" << r << ", %eax\n";
+        if (st.clase == PlanVector::SUMA) out << " addl %eax, " << escalar(st.destino) << "\n";
+        else                              out << " movl %eax, " << escalar(st.destino) << "\n";
+    }
+    if (avx) out << " vzeroupper\n";
+
+    // Lo que queda para el lazo escalar
+    out << " mov" << (largo ? "q %rcx, " : "l %ecx, ") << contador << "\n";
+    out << " andq $" << ancho - 1 << ", " << vueltas << "\n";
+    out << " jz " << salida << "\n";
+}
+
+// for: los límites se evalúan una vez y el número de vueltas se calcula
+// antes de entrar; al pie del cuerpo basta avanzar el contador y
+// decrementar las vueltas restantes con un solo salto. Los dos niveles más
+// internos de cada anidamiento llevan contador y vueltas en registros
+// callee-saved (guardados por visit(FunDec)); los demás, y los que recorren
+// una global (que otra función puede leer), usan la variable en memoria y
+// un slot de la zona de bloques para las vueltas.
+int GenCodeVisitor::visit(ForStm* stm) {
+    if (!stm || !stm->inicio || !stm->fin) return 0;
+
+    const Variable* var = simbolos.buscar(stm->id);
+    if (!var || esFlotante(var->tipo) || var->referencia) {
+        *avisos << "[GenCodeVisitor] Error: la variable de control '" << stm->id
+                << "' del for en '" << nombreFuncion
+                << "' debe ser una variable entera declarada (no un parámetro var).\n";
+        return 0;
+    }
+    Variable v = *var;
+    bool largo = es64Entero(v.tipo);
+    const char* suf = largo ? "q" : "l";
+
+    int label = labelcont++;
+    std::string lazo = "for_"    + nombreFuncion + "_" + std::to_string(label);
+    std::string fin  = "endfor_" + nombreFuncion + "_" + std::to_string(label);
+
+    // inicio -> %rcx, fin -> %rax, ambos con signo (o sin) a 64 bits
+    visitar(this, stm->inicio);
+    out << " pushq %rax\n";
+    apilados += 8;
+    visitar(this, stm->fin);
+    out << " popq %rcx\n";
+    apilados -= 8;
+    if (v.tipo == T_INT || v.tipo == T_BOOL) {
+        out << " movslq %eax, %rax\n";
+        out << " movslq %ecx, %rcx\n";
+    }
+
+    // vueltas = fin - inicio + 1  (inicio - fin + 1 con downto)
+    out << " subq %rcx, %rax\n";
+    if (stm->descendente) out << " negq %rax\n";
+    out << " addq $1, %rax\n";
+    out << " jle " << fin << "\n";
+
+    int altura = alturaFor(stm->b);
+    bool enRegistro = !v.global && altura < 2;
+    int inicioBloque = offsetBloque;
+
+    std::string contador, vueltas;
+    if (enRegistro) {
+        contador = largo ? REG_FOR_64[2 * altura] : REG_FOR_32[2 * altura];
+        vueltas  = REG_FOR_64[2 * altura + 1];
+    } else {
+        offsetBloque -= 8;
+        vueltas  = std::to_string(offsetBloque) + "(%rbp)";
+        contador = v.global ? stm->id + "(%rip)"
+                            : std::to_string(v.offset) + "(%rbp)";
+    }
+    out << " mov" << suf << " " << (largo ? "%rcx" : "%ecx") << ", " << contador << "\n";
+    out << " movq %rax, " << vueltas << "\n";
+
+    // Dentro del cuerpo la variable vive en el registro
+    if (enRegistro) {
+        Variable enReg = v;
+        enReg.registro = 2 * altura;
+        simbolos.abrir();
+        simbolos.declarar(stm->id, enReg);
+    }
+
+    // Si el cuerpo se puede vectorizar, la mayor parte de las vueltas se
+    // hace antes, de a varios elementos; el lazo escalar hace el resto
+    PlanVector plan;
+    bool vectorizado = planificarVector(stm, plan);
+    std::string salida = "salfor_" + nombreFuncion + "_" + std::to_string(label);
+    if (vectorizado) generarVector(stm, plan, contador, vueltas, lazo, salida);
+
+    out << lazo << ":\n";
+    if (stm->b) visit(stm->b);
+    out << " " << (stm->descendente ? "dec" : "inc") << suf << " " << contador << "\n";
+    out << " decq " << vueltas << "\n";
+    out << " jnz " << lazo << "\n";
+    if (vectorizado) out << salida << ":\n";
+
+    // Al salir, la variable queda con el último valor recorrido
+    out << " " << (stm->descendente ? "inc" : "dec") << suf << " " << contador << "\n";
+    if (enRegistro) {
+        simbolos.cerrar();
+        out << " mov" << suf << " " << contador << ", " << v.offset << "(%rbp)\n";
+    }
+    out << fin << ":\n";
+
+    offsetBloque = inicioBloque;
     return 0;
 }
 
 int GenCodeVisitor::visit(ReturnStm* stm) {
     if (!stm || !stm->e) return 0;
-    stm->e->accept(this);
+    visitar(this, stm->e);
     out << " jmp .end_" << nombreFuncion << "\n";
     return 0;
 }
@@ -814,14 +2223,15 @@ int GenCodeVisitor::visit(FunDec* f) {
     if (!f) return 0;
 
     entornoFuncion = true;
-    memoria.clear();
-    tipoLocal.clear();
-    offset = -8;
+    saltaARango = false;
+    offset = 0;
+    apilados = 0;
+    labelcont = 0;
     nombreFuncion = f->nombre;
 
     // coherencia parámetros (debug)
     if (f->Pnombres.size() != f->Ptipos.size()) {
-        std::cerr << "[GenCodeVisitor] Error: en función '" << f->nombre
+        *avisos << "[GenCodeVisitor] Error: en función '" << f->nombre
                   << "' la cantidad de nombres de parámetros ("
                   << f->Pnombres.size() << ") difiere de la cantidad de tipos ("
                   << f->Ptipos.size() << ").\n";
@@ -837,123 +2247,282 @@ int GenCodeVisitor::visit(FunDec* f) {
         return 0;
     }
 
-    std::vector<std::string> intRegs   = {"%rdi","%rsi","%rdx","%rcx","%r8","%r9"};
-    std::vector<std::string> floatRegs = {"%xmm0","%xmm1","%xmm2","%xmm3","%xmm4","%xmm5"};
     int iInt = 0, iFlt = 0;
 
+    simbolos.abrir();   // parámetros y locales de la función
+
+    // Registros de los for (por pares, así %rsp sigue alineado). Se guardan
+    // antes de %rbp: el frame no cambia y 'leave' los deja en la cima.
+    int regsFor = f->cuerpo ? 2 * min(2, alturaFor(f->cuerpo)) : 0;
+
     out << ".globl " << f->nombre << "\n";
     out << f->nombre << ":\n";
+    for (int i = 0; i < regsFor; ++i)
+        out << " pushq " << REG_FOR_64[i] << "\n";
     out << " pushq %rbp\n";
     out << " movq %rsp, %rbp\n";
 
-    // Guardar parámetros en la pila (frame) según su tipo
+    // Parámetros: los que llegan en registros se guardan en el frame (un
+    // slot de 8 bytes cada uno, aunque float use solo 4); los que llegan en
+    // la pila se usan donde están, sobre la dirección de retorno y los
+    // registros de los for. Un parámetro var llega como dirección, en la
+    // clase entera.
+    int enPila = 16 + 8 * regsFor;
     for (size_t i = 0; i < f->Pnombres.size(); ++i) {
-        const std::string& pname = f->Pnombres[i];
-        Tipo tt = mapStr(f->Ptipos[i]);
-
-        memoria[pname]   = offset;
-        tipoLocal[pname] = tt;
+        Variable v;
+        v.tipo       = mapStr(f->Ptipos[i]);
+        v.referencia = f->porReferencia(i);
 
-        if (tt == T_FLOAT) {
-            if (iFlt < (int)floatRegs.size()) {
-                out << " movss " << floatRegs[iFlt++] << ", " << offset << "(%rbp)\n";
-            } else {
-                std::cerr
-                    << "[GenCodeVisitor] Advertencia: demasiados parámetros float en '"
-                    << f->nombre << "'.\n";
-            }
+        bool flotante = esFlotante(v.tipo) && !v.referencia;
+        if (flotante ? iFlt < ARGS_FLOAT : iInt < ARGS_ENTEROS) {
+            offset -= 8;
+            v.offset = offset;
+            if (flotante) out << " mov" << sse(v.tipo) << " " << REG_ARG_FLOAT[iFlt++] << ", " << offset << "(%rbp)\n";
+            else          out << " movq "  << REG_ARG_64[iInt++]    << ", " << offset << "(%rbp)\n";
         } else {
-            if (iInt < (int)intRegs.size()) {
-                out << " movq "  << intRegs[iInt++]   << ", " << offset << "(%rbp)\n";
-            } else {
-                std::cerr
-                    << "[GenCodeVisitor] Advertencia: demasiados parámetros enteros en '"
-                    << f->nombre << "'.\n";
-            }
+            v.offset = enPila;
+            enPila += 8;
         }
-        offset -= 8; // slot de 8 bytes para cada parámetro (aunque float use solo 4)
+        simbolos.declarar(f->Pnombres[i], v);
     }
 
     // Variables locales del cuerpo
     if (f->cuerpo) {
         for (auto vd : f->cuerpo->declarations) {
-            vd->accept(this);
+            visit(vd);
         }
     }
 
-    int reserva = -offset - 8;
-    if (reserva % 16 != 0)
-        reserva += 8;
-
-    if (reserva > 0)
-        out << " subq $" << reserva << ", %rsp\n";
+    // Zona para las variables de los bloques anidados: los bloques hermanos
+    // reutilizan los mismos slots, así que basta el anidamiento más costoso
+    offsetBloque = offset;
+    if (f->cuerpo) offset -= (tamBloques(f->cuerpo) + 7) & ~7;
 
-    // Sentencias
+    // Sentencias. Se generan aparte porque los temporales (argumentos de
+    // llamadas, operandos float) también bajan 'offset' y tienen que quedar
+    // dentro del frame: si no, un push o un call posterior los pisa.
+    std::stringbuf sentencias;
+    std::streambuf* destino = out.rdbuf(&sentencias);
     if (f->cuerpo) {
         for (auto s : f->cuerpo->StmList) {
-            if (s) s->accept(this);
+            if (s) visitar(this, s);
         }
     } else {
-        std::cerr << "[GenCodeVisitor] Advertencia: cuerpo nulo en función '"
+        *avisos << "[GenCodeVisitor] Advertencia: cuerpo nulo en función '"
                   << f->nombre << "'.\n";
     }
+    out.rdbuf(destino);
+
+    // Todo el frame, redondeado para que %rsp quede alineado a 16
+    int reserva = (-offset + 15) & ~15;
+
+    if (reserva > 0)
+        out << " subq $" << reserva << ", %rsp\n";
+    out << sentencias.str();
 
     out << ".end_" << f->nombre << ":\n";
     out << " leave\n";
+    for (int i = regsFor - 1; i >= 0; --i)
+        out << " popq " << REG_FOR_64[i] << "\n";
     out << " ret\n";
 
+    // Índice fuera de rango: mensaje en stderr y exit(1). Se llega desde
+    // cualquier punto de la función, así que se realinea la pila.
+    if (saltaARango) {
+        out << ".rango_" << f->nombre << ":\n";
+        out << " andq $-16, %rsp\n";
+        out << " movq stderr@GOTPCREL(%rip), %rdi\n";
+        out << " movq (%rdi), %rdi\n";
+        out << " leaq .rango_msg_" << f->nombre << "(%rip), %rsi\n";
+        out << " movl $0, %eax\n";
+        out << " call fprintf@PLT\n";
+        out << " movl $1, %edi\n";
+        out << " call exit@PLT\n";
+        out << " .pushsection .rodata\n";
+        out << ".rango_msg_" << f->nombre << ": .string \"Error: indice fuera de rango en "
+            << f->nombre << "\\n\"\n";
+        out << " .popsection\n";
+    }
+
+    simbolos.cerrar();
     entornoFuncion = false;
     return 0;
 }
 
+// Bytes de las variables declaradas en b
+long long GenCodeVisitor::tamDeclaraciones(Body* b) {
+    long long tam = 0;
+    for (auto vd : b->declarations) {
+        if (!vd) continue;
+        // un arreglo puede necesitar hasta 7 bytes para alinearse
+        tam += (tamVariable(vd) + (vd->arreglo ? 7 : 0)) * (long long)vd->vars.size();
+    }
+    return tam;
+}
+
+// Máximo de bytes que ocupan a la vez las variables de los bloques
+// anidados dentro de b (sin contar las de b)
+long long GenCodeVisitor::tamBloques(Body* b) {
+    long long maximo = 0;
+    for (auto s : b->StmList) {
+        if (!s) continue;
+        Body* hijos[2] = {nullptr, nullptr};
+        long long propio = 0;
+        if (s->clase == STM_IF) {
+            hijos[0] = static_cast<IfStm*>(s)->then;
+            hijos[1] = static_cast<IfStm*>(s)->els;
+        } else if (s->clase == STM_WHILE) {
+            hijos[0] = static_cast<WhileStm*>(s)->b;
+        } else if (s->clase == STM_FOR) {
+            hijos[0] = static_cast<ForStm*>(s)->b;
+            propio   = 8;   // vueltas restantes, si no van en registro
+        }
+        for (Body* h : hijos) {
+            if (h) maximo = max(maximo, propio + tamDeclaraciones(h) + tamBloques(h));
+        }
+    }
+    return maximo;
+}
+
+// Máximo de for anidados dentro de b (0 si no hay ninguno)
+int GenCodeVisitor::alturaFor(Body* b) {
+    if (!b) return 0;
+    int altura = 0;
+    for (auto s : b->StmList) {
+        if (!s) continue;
+        if (s->clase == STM_FOR) {
+            altura = max(altura, 1 + alturaFor(static_cast<ForStm*>(s)->b));
+        } else if (s->clase == STM_IF) {
+            altura = max(altura, alturaFor(static_cast<IfStm*>(s)->then));
+            altura = max(altura, alturaFor(static_cast<IfStm*>(s)->els));
+        } else if (s->clase == STM_WHILE) {
+            altura = max(altura, alturaFor(static_cast<WhileStm*>(s)->b));
+        }
+    }
+    return altura;
+}
+
 int GenCodeVisitor::visit(FcallExp* exp) {
     if (!exp) return 0;
-
-    vector<string> intRegs   = {"%rdi","%rsi","%rdx","%rcx","%r8","%r9"};
-    vector<string> floatRegs = {"%xmm0","%xmm1","%xmm2","%xmm3","%xmm4","%xmm5"};
+    if (esLectura(exp)) {
+        leer(exp);
+        return 0;
+    }
 
     struct TempArg {
-        bool isFloat;
+        Tipo tipo;      // de un var, T_LONG (la dirección)
         int  offset;
     };
 
     vector<TempArg> temps;
+    vector<pair<Variable, string>> recargar;
 
-    // 1) Evaluar argumentos de izquierda a derecha
+    // 1) Evaluar argumentos de izquierda a derecha (de los var, la dirección)
     for (size_t i = 0; i < exp->argumentos.size(); ++i) {
         Exp* arg = exp->argumentos[i];
-        arg->accept(this);
-
-        if (arg->tipoDato == T_FLOAT) {
-            offset -= 8;
-            out << " movss %xmm0, " << offset << "(%rbp)\n";
-            temps.push_back({true, offset});
-        } else {
+        if (exp->porReferencia(i)) {
+            direccionEnRax(arg, recargar);
             offset -= 8;
             out << " movq %rax, " << offset << "(%rbp)\n";
-            temps.push_back({false, offset});
+            temps.push_back({T_LONG, offset});
+            continue;
         }
+        visitar(this, arg);
+
+        offset -= 8;
+        if (esFlotante(arg->tipoDato))
+            out << " mov" << sse(arg->tipoDato) << " %xmm0, " << offset << "(%rbp)\n";
+        else
+            out << " movq %rax, " << offset << "(%rbp)\n";
+        temps.push_back({arg->tipoDato, offset});
     }
 
-    // 2) Asignar argumentos a los registros ABI en orden
+    // 2) Los que no caben en los registros de su clase van a la pila, en
+    //    orden (el primero en la cima) y con %rsp alineado a 16 en el call
     int iInt = 0;
     int iFlt = 0;
+    vector<bool> enRegistro(temps.size());
+    int nPila = 0;
+    for (size_t i = 0; i < temps.size(); ++i) {
+        enRegistro[i] = esFlotante(temps[i].tipo) ? iFlt++ < ARGS_FLOAT : iInt++ < ARGS_ENTEROS;
+        if (!enRegistro[i]) nPila++;
+    }
+    int relleno = (apilados + 8 * nPila) % 16;
+    if (relleno) out << " subq $" << relleno << ", %rsp\n";
+    for (size_t i = temps.size(); i-- > 0; ) {
+        if (!enRegistro[i]) out << " pushq " << temps[i].offset << "(%rbp)\n";
+    }
 
+    // 3) Y el resto a los registros, en orden
+    iInt = 0;
+    iFlt = 0;
     for (size_t i = 0; i < temps.size(); ++i) {
-        if (temps[i].isFloat) {
-            out << " movss " << temps[i].offset << "(%rbp), " 
-                << floatRegs[iFlt++] << "\n";
+        if (!enRegistro[i]) continue;
+        if (esFlotante(temps[i].tipo)) {
+            out << " mov" << sse(temps[i].tipo) << " " << temps[i].offset << "(%rbp), "
+                << REG_ARG_FLOAT[iFlt++] << "\n";
         } else {
-            out << " movq " << temps[i].offset << "(%rbp), " 
-                << intRegs[iInt++] << "\n";
+            out << " movq " << temps[i].offset << "(%rbp), "
+                << REG_ARG_64[iInt++] << "\n";
         }
     }
 
     out << " call " << exp->nombre << "\n";
+    if (relleno + 8 * nPila)
+        out << " addq $" << relleno + 8 * nPila << ", %rsp\n";
+
+    // Contadores en registro pasados por referencia: la llamada pudo
+    // cambiar su copia en el frame
+    for (auto& r : recargar)
+        out << " mov" << (es64Entero(r.first.tipo) ? "q " : "l ") << r.first.offset
+            << "(%rbp), " << r.second << "\n";
     return 0;
 }
 
+// Dirección de un argumento var en %rax. Un contador de for en registro se
+// copia a su lugar en el frame y se anota en 'recargar' para leerlo de
+// nuevo tras la llamada. Si el argumento no es una variable (el análisis
+// de tipos ya lo informó), se pasa la dirección de un temporal con su valor.
+void GenCodeVisitor::direccionEnRax(Exp* arg, vector<pair<Variable, string>>& recargar) {
+    if (arg->clase == EXP_ID) {
+        const string& id = static_cast<IdExp*>(arg)->value;
+        const Variable* v = simbolos.buscar(id);
+        if (v && !v->arreglo) {
+            if (v->referencia) {
+                out << " movq " << v->offset << "(%rbp), %rax\n";
+            } else if (v->global) {
+                out << " leaq " << id << "(%rip), %rax\n";
+            } else {
+                if (v->registro >= 0) {
+                    string reg = es64Entero(v->tipo) ? REG_FOR_64[v->registro] : REG_FOR_32[v->registro];
+                    out << " mov" << (es64Entero(v->tipo) ? "q " : "l ") << reg << ", "
+                        << v->offset << "(%rbp)\n";
+                    recargar.push_back({*v, reg});
+                }
+                out << " leaq " << v->offset << "(%rbp), %rax\n";
+            }
+            return;
+        }
+    } else if (arg->clase == EXP_INDICE) {
+        auto x = static_cast<IndexExp*>(arg);
+        const Variable* var = simbolos.buscar(x->nombre);
+        if (var && var->arreglo) {
+            Variable v = *var;
+            indiceEnRax(v, x->indice, x->verificar);
+            string op = elemento(v, x->nombre, "%rax", x->verificar);
+            out << " leaq " << op << ", %rax\n";
+            return;
+        }
+    }
+
+    visitar(this, arg);
+    offset -= 8;
+    if (esFlotante(arg->tipoDato)) out << " mov" << sse(arg->tipoDato) << " %xmm0, " << offset << "(%rbp)\n";
+    else                           out << " movq %rax, "   << offset << "(%rbp)\n";
+    out << " leaq " << offset << "(%rbp), %rax\n";
+}
+
 int GenCodeVisitor::visit(ExpStm* s) {
-    if (s && s->e) s->e->accept(this);
+    if (s && s->e) visitar(this, s->e);
     return 0;
 }
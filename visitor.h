@@ -2,18 +2,25 @@
 #define VISITOR_H
 
 #include "ast.h"
+#include "simbolos.h"
 #include <list>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
+#include <iostream>
 using namespace std;
 
+class ThreadPool;
+
 class BinaryExp;
 class NumberExp;
 class IdExp;
+class IndexExp;
 class Program;
 class PrintStm;
 class WhileStm;
+class ForStm;
 class IfStm;
 class AssignStm;
 class Body;
@@ -35,9 +42,11 @@ public:
     virtual int visit(BinaryExp* exp)   = 0;
     virtual int visit(NumberExp* exp)   = 0;
     virtual int visit(IdExp* exp)       = 0;
+    virtual int visit(IndexExp* exp)    = 0;
     virtual int visit(Program* p)       = 0;
     virtual int visit(PrintStm* stm)    = 0;
     virtual int visit(WhileStm* stm)    = 0;
+    virtual int visit(ForStm* stm)      = 0;
     virtual int visit(IfStm* stm)       = 0;
     virtual int visit(AssignStm* stm)   = 0;
     virtual int visit(Body* body)       = 0;
@@ -50,34 +59,144 @@ public:
     virtual int visit(ExpStm* s)        = 0;
 };
 
+// --------------------------------------
+// Despacho estático por clase de nodo
+// --------------------------------------
+// Equivale a e->accept(v) sin llamadas virtuales: un switch sobre la
+// etiqueta del nodo y una llamada directa a V::visit. Con V final, el
+// compilador resuelve (y puede inlinear) la llamada. Los visitors de las
+// fases (tipos, generación) recorren el árbol con esto; accept() queda
+// para los demás recorridos.
+template <class V>
+inline int visitar(V* v, Exp* e) {
+    switch (e->clase) {
+        case EXP_BINARIA: return v->visit(static_cast<BinaryExp*>(e));
+        case EXP_NUMERO:  return v->visit(static_cast<NumberExp*>(e));
+        case EXP_ID:      return v->visit(static_cast<IdExp*>(e));
+        case EXP_LLAMADA: return v->visit(static_cast<FcallExp*>(e));
+        case EXP_CAST:    return v->visit(static_cast<CastExp*>(e));
+        case EXP_INDICE:  return v->visit(static_cast<IndexExp*>(e));
+    }
+    return 0;
+}
+
+template <class V>
+inline int visitar(V* v, Stm* s) {
+    switch (s->clase) {
+        case STM_ASIGNACION: return v->visit(static_cast<AssignStm*>(s));
+        case STM_PRINT:      return v->visit(static_cast<PrintStm*>(s));
+        case STM_IF:         return v->visit(static_cast<IfStm*>(s));
+        case STM_WHILE:      return v->visit(static_cast<WhileStm*>(s));
+        case STM_RETURN:     return v->visit(static_cast<ReturnStm*>(s));
+        case STM_EXP:        return v->visit(static_cast<ExpStm*>(s));
+        case STM_FOR:        return v->visit(static_cast<ForStm*>(s));
+    }
+    return 0;
+}
+
 // --------------------------------------
 // TYPECHECK VISITOR (Pascal-like types)
 // --------------------------------------
-class TypeCheckVisitor : public Visitor {
+class TypeCheckVisitor final : public Visitor {
 public:
-    // Tabla de tipos globales y locales (variables)
-    unordered_map<string, Tipo> tipoGlobal;
-    unordered_map<string, Tipo> tipoLocal;
+    // Lo que se sabe de cada variable visible: globales en el nivel 0, un
+    // ámbito por función (parámetros), por cada cuerpo con declaraciones
+    // propias y por cada for cuyo contador tiene rango conocido
+    struct InfoVar {
+        Tipo      tipo    = T_INT;   // en un arreglo, el de sus elementos
+        bool      arreglo = false;
+        long long lo = 0, hi = 0;    // índices válidos del arreglo
+        bool      acotada = false;   // contador de for: siempre en [min, max]
+        long long min = 0, max = 0;
+        bool      referencia = false;   // parámetro var
+    };
+    TablaSimbolos<InfoVar> simbolos;
 
     // alias type x = y;
     unordered_map<string, string> aliasMap;
 
     string funcionActual;
 
+    // Llamada de la ExpStm que se está analizando: la única posición en la
+    // que puede aparecer un procedimiento
+    const Exp* sentencia = nullptr;
+
     // Tipo de retorno de funciones: funRet["f"] = T_INT / T_FLOAT / ...
     unordered_map<string, Tipo> funRet;
 
+    // Firmas por posición (índice en fdlist). Una llamada solo ve las
+    // funciones declaradas hasta la actual, igual que en el recorrido en orden.
+    struct Firma {
+        int          indice;
+        Tipo         retorno;
+        vector<Tipo> parametros;
+        vector<bool> referencia;      // parámetros var
+        bool         procedimiento;   // sin valor de retorno
+    };
+    unordered_map<string, vector<Firma>> firmas;
+    int indiceFuncion = 0;
+
+    // Llamadas a funciones aún no declaradas (análisis incremental): si la
+    // declaración llega después con parámetros var, la llamada ya pasó los
+    // argumentos por valor
+    unordered_map<string, string> llamadasAdelantadas;   // función -> quién la llama
+
+    // Errores de análisis (argumentos var que no son variables, etc.): se
+    // escriben en avisos y se cuentan; con alguno no se genera la unidad
+    std::ostream* avisos = &std::cerr;
+    int errores = 0;
+
     bool enFuncion = false;
 
-    int analizar(Program* p) { return p->accept(this); }
+    // Si se asigna, los cuerpos de las funciones se analizan en paralelo
+    // (fase 1: firmas y globales en orden; fase 2: un entorno local por cuerpo)
+    ThreadPool* hilos = nullptr;
+
+    int analizar(Program* p) { return visit(p); }
+
+    // Análisis incremental (streaming): primero los globales, después cada
+    // función en orden fuente con su posición (registra su firma y la
+    // analiza). Equivale a analizar(p) sobre el programa completo.
+    void registrarGlobales(Program* p);
+    void analizarFuncion(FunDec* fd, int indice);
+
+    // Limpia las tablas para analizar otra unidad (conserva su memoria)
+    void reiniciar() {
+        simbolos.reiniciar();
+        aliasMap.clear();
+        funRet.clear();
+        firmas.clear();
+        llamadasAdelantadas.clear();
+        funcionActual.clear();
+        errores = 0;
+        indiceFuncion = 0;
+        enFuncion = false;
+    }
+
+    // Firma de 'f' visible desde la función actual (nullptr si no hay)
+    const Firma* firma(const string& f) const {
+        auto it = firmas.find(f);
+        if (it == firmas.end()) return nullptr;
+        for (auto r = it->second.rbegin(); r != it->second.rend(); ++r) {
+            if (r->indice <= indiceFuncion) return &*r;
+        }
+        return nullptr;
+    }
+
+    // Tipo de retorno visible desde la función actual
+    bool tipoRetorno(const string& f, Tipo& t) const {
+        const Firma* s = firma(f);
+        if (s) t = s->retorno;
+        return s != nullptr;
+    }
 
     // Convierte strings Pascal a Tipo interno
     Tipo strToTipo(const string& s) {
         if (s == "integer" || s == "int")      return T_INT;
         if (s == "longint" || s == "long")     return T_LONG;
         if (s == "unsigned")                   return T_UNSIGNED;
-        if (s == "real" || s == "float" ||
-            s == "double")                     return T_FLOAT;
+        if (s == "float")                      return T_FLOAT;
+        if (s == "real" || s == "double")      return T_DOUBLE;
 
         auto it = aliasMap.find(s);
         if (it != aliasMap.end()) {
@@ -89,6 +208,7 @@ public:
 
     // Regla de promoción para binarios
     static Tipo unificarBin(Tipo a, Tipo b) {
+        if (a == T_DOUBLE || b == T_DOUBLE)    return T_DOUBLE;
         if (a == T_FLOAT  || b == T_FLOAT)     return T_FLOAT;
         if (a == T_LONG   || b == T_LONG)      return T_LONG;
         if (a == T_UNSIGNED || b == T_UNSIGNED)return T_UNSIGNED;
@@ -105,6 +225,10 @@ public:
     // Inserta un CastExp si hace falta
     static Exp* insertarCast(Exp* e, Tipo dst);
 
+    // Intervalo de valores enteros que puede tomar e, si se conoce:
+    // literales, contadores acotados y +, -, * entre ellos
+    bool rango(Exp* e, long long& min, long long& max) const;
+
     // Implementaciones de Visitor
     int visit(Program* p)      override;
     int visit(VarDec* vd)      override;
@@ -113,51 +237,136 @@ public:
     int visit(AssignStm* s)    override;
     int visit(PrintStm* s)     override;
     int visit(WhileStm* s)     override;
+    int visit(ForStm* s)       override;
     int visit(IfStm* s)        override;
     int visit(ReturnStm* r)    override;
     int visit(BinaryExp* e)    override;
     int visit(NumberExp* e)    override;
     int visit(IdExp* e)        override;
+    int visit(IndexExp* e)     override;
     int visit(FcallExp* f)     override;
     int visit(CastExp* e)      override;
     int visit(TypeAlias* tdef) override;
     int visit(ExpStm* s)       override;
+
+private:
+    void registrarFirma(FunDec* fd, int indice);
+
+    // Empieza un mensaje de error en avisos y lo cuenta
+    std::ostream& error() {
+        errores++;
+        return *avisos << "[TypeCheckVisitor] Error: ";
+    }
+
+    // Marca los argumentos por referencia de las llamadas de e según la
+    // firma visible (antes de mirar qué asigna un cuerpo)
+    void marcarReferencias(Exp* e);
+    bool asigna(Body* b, const string& id);
+    void analizarCuerposParalelo(const vector<FunDec*>& funs);
 };
 
 // --------------------------------------
 // CODEGEN VISITOR (x86-64 + printf)
 // --------------------------------------
-class GenCodeVisitor : public Visitor {
+// Extensión vectorial para los for vectorizables (ver visit(ForStm*)):
+// SSE2 (4 elementos, disponible en todo x86-64) o AVX2 (8 elementos).
+enum ExtensionSimd { SIMD_NINGUNA, SIMD_SSE2, SIMD_AVX2 };
+const char* nombreSimd(ExtensionSimd s);
+
+class GenCodeVisitor final : public Visitor {
 private:
     std::ostream& out;
 
 public:
     GenCodeVisitor(std::ostream& out) : out(out) {}
 
+    // Advertencias de generación (por compilación, no globales)
+    std::ostream* avisos = &std::cerr;
+
     int generar(Program* program);
 
-    // Layout de memoria y tipos
-    unordered_map<string, int>  memoria;       // offset local (%rbp)
-    unordered_map<string, bool> memoriaGlobal; // true si es global
-    unordered_map<string, Tipo> tipoGlobal;
-    unordered_map<string, Tipo> tipoLocal;
+    // Generación incremental (streaming): .data y globales, cada función en
+    // orden fuente directamente en 'out', y al final el pool de floats.
+    void generarInicio(Program* program);
+    void generarFuncion(FunDec* fd) { if (fd) visit(fd); }
+    void generarFin();
+
+    // Limpia el estado para generar otra unidad (conserva su memoria)
+    void reiniciar() {
+        simbolos.reiniciar();
+        aliasMap.clear();
+        poolFloats.clear();
+        enPool.clear();
+        poolDoubles.clear();
+        enPoolDoubles.clear();
+        offset         = 0;
+        offsetBloque   = 0;
+        apilados       = 0;
+        labelcont      = 0;
+        entornoFuncion = false;
+        usaEscritura   = false;
+        usaLectura     = false;
+        nombreFuncion.clear();
+    }
+
+    // Layout de memoria y tipos: variables visibles con ámbitos (globales,
+    // parámetros y locales de la función, y los de cada bloque anidado)
+    struct Variable {
+        Tipo tipo   = T_INT;
+        int  offset = 0;        // respecto de %rbp (si no es global)
+        bool global = false;
+        int  registro = -1;     // contador de un for en registro (ver visit(ForStm))
+        bool arreglo  = false;  // offset: primer elemento; 'tipo' el de los elementos
+        long long lo = 0, hi = 0;
+        bool referencia = false;  // parámetro var: en offset está la dirección
+    };
+    TablaSimbolos<Variable> simbolos;
     unordered_map<string, string> aliasMap;
 
-    int    offset       = -8;
-    int    labelcont    = 0;
+    int    offset       = 0;     // último byte ocupado del frame (respecto de %rbp)
+    int    offsetBloque = 0;     // último byte ocupado en la zona de bloques anidados
+    int    labelcont    = 0;     // por función: etiquetas <tipo>_<funcion>_<n>
     bool   entornoFuncion = false;
     string nombreFuncion;
+    bool   saltaARango = false;  // la función usa su rutina de índice fuera de rango
+    bool   usaEscritura = false; // la unidad llama a write_* (runtime de writeln)
+    bool   usaLectura   = false; // ídem read_* (runtime de readln)
+    int    apilados     = 0;     // bytes apilados sobre el frame (alineado a 16) en este punto
+
+    // Si se asigna, cada FunDec se genera en un buffer propio dentro del
+    // pool y luego se concatenan en orden fuente (salida idéntica a la
+    // secuencial).
+    ThreadPool* hilos = nullptr;
+
+    // Guardar el código de cada función en FunDec::codigo (caché
+    // incremental). Las funciones con codigo->deCache no se regeneran.
+    bool capturarFunciones = false;
+
+    // Vectorizar los for más internos que lo permitan
+    ExtensionSimd simd = SIMD_SSE2;
 
-    // Pool de constantes de punto flotante
-    vector<double> poolFloats;
-    string addFloatConst(double v);
+    // Pool de constantes de punto flotante: patrones de bits IEEE de 32 bits
+    // en orden de primer uso, más un conjunto para deduplicar en O(1) (0.0 y
+    // -0.0 son distintas; un NaN se deduplica consigo mismo). La etiqueta
+    // depende solo del patrón, no de la posición, así que el texto de cada
+    // función no depende de las demás.
+    vector<uint32_t>        poolFloats;
+    unordered_set<uint32_t> enPool;
+    string addFloatConst(uint32_t bits);
+    static string etiquetaFloat(uint32_t bits);
+
+    // Lo mismo para las constantes double (64 bits), en su propio pool
+    vector<uint64_t>        poolDoubles;
+    unordered_set<uint64_t> enPoolDoubles;
+    string addDoubleConst(uint64_t bits);
+    static string etiquetaDouble(uint64_t bits);
 
     Tipo mapStr(const string& s) const {
         if (s == "integer" || s == "int")      return T_INT;
         if (s == "longint" || s == "long")     return T_LONG;
         if (s == "unsigned")                   return T_UNSIGNED;
-        if (s == "real" || s == "float" ||
-            s == "double")                     return T_FLOAT;
+        if (s == "float")                      return T_FLOAT;
+        if (s == "real" || s == "double")      return T_DOUBLE;
 
         auto it = aliasMap.find(s);
         if (it != aliasMap.end())
@@ -174,15 +383,41 @@ public:
     int visit(AssignStm* stm)  override;
     int visit(PrintStm* stm)   override;
     int visit(WhileStm* stm)   override;
+    int visit(ForStm* stm)     override;
     int visit(IfStm* stm)      override;
     int visit(ReturnStm* r)    override;
     int visit(BinaryExp* exp)  override;
     int visit(NumberExp* exp)  override;
     int visit(IdExp* exp)      override;
+    int visit(IndexExp* exp)   override;
     int visit(FcallExp* fcall) override;
     int visit(CastExp* e)      override;
     int visit(TypeAlias* tdef) override;
     int visit(ExpStm* s)       override;
+
+private:
+    void generarFunciones(Program* p);
+    long long tamDeclaraciones(Body* b);
+    long long tamBloques(Body* b);
+    int  alturaFor(Body* b);
+    long long tamVariable(const VarDec* vd) const;
+    void indiceEnRax(const Variable& v, Exp* indice, bool verificar);
+    string elemento(const Variable& v, const string& nombre, const char* regIndice, bool verificado);
+    void guardarEn(Tipo t, const string& op);
+    void guardarVariable(const string& id);
+    void leer(FcallExp* f);
+    void llamar(const string& destino);
+    void direccionEnRax(Exp* arg, vector<pair<Variable, string>>& recargar);
+
+    // Vectorización de for (la definición de PlanVector está en visitor.cpp)
+    struct PlanVector;
+    bool planificarVector(ForStm* stm, PlanVector& p);
+    bool planVectorial(Exp* e, Tipo t, PlanVector& p, int& altura);
+    bool invariante(Exp* e, PlanVector& p);
+    void generarVector(ForStm* stm, PlanVector& p, const string& contador,
+                       const string& vueltas, const string& lazo, const string& salida);
+    void vectorial(Exp* e, int k, PlanVector& p);
+    void generarFuncionesEnBuffers(Program* p);
 };
 
 #endif // VISITOR_H